@@ -0,0 +1,97 @@
+// Cost of OPENBLAS_DETERMINISTIC for threaded ddot, zdotu and dgemm.
+// Times each call with the switch off and on in the same process:
+//   OPENBLAS_NUM_THREADS=n ./deterministic [dot length] [gemm size] [loops]
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <cblas.h>
+
+static double now(void) {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e3 + t.tv_nsec * 1e-6;
+}
+
+static int compare(const void * a, const void * b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double median(double * t, int loops) {
+    qsort(t, loops, sizeof(double), compare);
+    return t[loops / 2];
+}
+
+int main(int argc, char * argv[]) {
+    int n = 4000000, size = 1024, loops = 20;
+    int i, on;
+    double * x, * y, * a, * b, * c, * t;
+    double cost[2][3];
+    openblas_complex_double z;
+
+    if (argc > 1) n = atoi(argv[1]);
+    if (argc > 2) size = atoi(argv[2]);
+    if (argc > 3) loops = atoi(argv[3]);
+
+    x = malloc(sizeof(double) * 2 * n);
+    y = malloc(sizeof(double) * 2 * n);
+    a = malloc(sizeof(double) * size * size);
+    b = malloc(sizeof(double) * size * size);
+    c = malloc(sizeof(double) * size * size);
+    t = malloc(sizeof(double) * loops);
+
+    for (i = 0; i < 2 * n; i++) {
+        x[i] = (double)rand() / RAND_MAX - 0.5;
+        y[i] = (double)rand() / RAND_MAX - 0.5;
+    }
+    for (i = 0; i < size * size; i++) {
+        a[i] = (double)rand() / RAND_MAX - 0.5;
+        b[i] = (double)rand() / RAND_MAX - 0.5;
+    }
+
+    for (on = 0; on < 2; on++) {
+        openblas_set_deterministic(on);
+
+        // warm up the thread pool
+        cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, size, size, size,
+                    1.0, a, size, b, size, 0.0, c, size);
+
+        for (i = 0; i < loops; i++) {
+            t[i] = now();
+            cblas_ddot(n, x, 1, y, 1);
+            t[i] = now() - t[i];
+        }
+        cost[on][0] = median(t, loops);
+
+        for (i = 0; i < loops; i++) {
+            t[i] = now();
+            z = cblas_zdotu(n, x, 1, y, 1);
+            t[i] = now() - t[i];
+        }
+        cost[on][1] = median(t, loops);
+
+        for (i = 0; i < loops; i++) {
+            t[i] = now();
+            cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, size, size, size,
+                        1.0, a, size, b, size, 0.0, c, size);
+            t[i] = now() - t[i];
+        }
+        cost[on][2] = median(t, loops);
+    }
+    (void)z;
+
+    printf("threads=%d dot length=%d gemm size=%d loops=%d  (median ms)\n",
+           openblas_get_num_threads(), n, size, loops);
+    printf("           default  deterministic   ratio\n");
+    printf("  ddot   %9.3f  %13.3f  %6.2f\n", cost[0][0], cost[1][0], cost[1][0] / cost[0][0]);
+    printf("  zdotu  %9.3f  %13.3f  %6.2f\n", cost[0][1], cost[1][1], cost[1][1] / cost[0][1]);
+    printf("  dgemm  %9.3f  %13.3f  %6.2f\n", cost[0][2], cost[1][2], cost[1][2] / cost[0][2]);
+
+    free(x);
+    free(y);
+    free(a);
+    free(b);
+    free(c);
+    free(t);
+    return 0;
+}
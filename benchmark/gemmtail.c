@@ -0,0 +1,81 @@
+// Per-call latency of threaded dgemm while a busy thread competes for a core.
+// Compare the static partition with the work-stealing one:
+//   OPENBLAS_NUM_THREADS=n OPENBLAS_GEMM_DYNAMIC=0 ./gemmtail [size] [loops] [noise threads]
+//   OPENBLAS_NUM_THREADS=n OPENBLAS_GEMM_DYNAMIC=1 ./gemmtail [size] [loops] [noise threads]
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+#include <pthread.h>
+#include <cblas.h>
+
+static volatile int stop_noise = 0;
+
+static void * noise(void * arg) {
+    volatile double x = 1.0;
+    while (!stop_noise)
+        x = x * 1.0000001 + 1e-9;
+    return NULL;
+}
+
+static int compare(const void * a, const void * b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int main(int argc, char * argv[]) {
+    int size = 1024, loops = 50, nnoise = 1;
+    int i;
+    double * a, * b, * c, * t;
+    pthread_t * threads;
+    struct timespec tick, tock;
+
+    if (argc > 1) size = atoi(argv[1]);
+    if (argc > 2) loops = atoi(argv[2]);
+    if (argc > 3) nnoise = atoi(argv[3]);
+
+    a = malloc(sizeof(double) * size * size);
+    b = malloc(sizeof(double) * size * size);
+    c = malloc(sizeof(double) * size * size);
+    t = malloc(sizeof(double) * loops);
+    threads = malloc(sizeof(pthread_t) * (nnoise + 1));
+
+    for (i = 0; i < size * size; i++) {
+        a[i] = (double)(i % 7) - 3.0;
+        b[i] = (double)(i % 5) - 2.0;
+        c[i] = 0.0;
+    }
+
+    // warm up the thread pool before the noise starts
+    cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, size, size, size,
+                1.0, a, size, b, size, 0.0, c, size);
+
+    for (i = 0; i < nnoise; i++)
+        pthread_create(&threads[i], NULL, noise, NULL);
+
+    for (i = 0; i < loops; i++) {
+        clock_gettime(CLOCK_MONOTONIC, &tick);
+        cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, size, size, size,
+                    1.0, a, size, b, size, 0.0, c, size);
+        clock_gettime(CLOCK_MONOTONIC, &tock);
+        t[i] = (tock.tv_sec - tick.tv_sec) * 1e3 + (tock.tv_nsec - tick.tv_nsec) * 1e-6;
+    }
+
+    stop_noise = 1;
+    for (i = 0; i < nnoise; i++)
+        pthread_join(threads[i], NULL);
+
+    qsort(t, loops, sizeof(double), compare);
+
+    printf("%s size=%d loops=%d noise=%d  (ms)\n",
+           getenv("OPENBLAS_GEMM_DYNAMIC") && atoi(getenv("OPENBLAS_GEMM_DYNAMIC")) ? "dynamic" : "static",
+           size, loops, nnoise);
+    printf("  min %8.2f  p50 %8.2f  p90 %8.2f  p99 %8.2f  max %8.2f\n",
+           t[0], t[loops / 2], t[(loops * 9) / 10], t[(loops * 99) / 100], t[loops - 1]);
+
+    free(a);
+    free(b);
+    free(c);
+    free(t);
+    free(threads);
+    return 0;
+}
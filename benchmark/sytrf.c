@@ -0,0 +1,197 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#ifdef __CYGWIN32__
+#include <sys/time.h>
+#endif
+#include "common.h"
+
+/* ?sytrf on a KKT matrix [H A'; A 0], with H of order m - m / 4 and
+   A of m / 4 rows, which needs 2 by 2 pivots.  OPENBLAS_TEST=S times
+   ?sytrs with m right hand sides instead.
+     ./dsytrf.goto [from] [to] [step] */
+
+#undef SYTRF
+#undef SYTRS
+
+#ifdef DOUBLE
+#define SYTRF   BLASFUNC(dsytrf)
+#define SYTRS   BLASFUNC(dsytrs)
+#else
+#define SYTRF   BLASFUNC(ssytrf)
+#define SYTRS   BLASFUNC(ssytrs)
+#endif
+
+#if defined(__WIN32__) || defined(__WIN64__)
+
+#ifndef DELTA_EPOCH_IN_MICROSECS
+#define DELTA_EPOCH_IN_MICROSECS 11644473600000000ULL
+#endif
+
+int gettimeofday(struct timeval *tv, void *tz){
+
+  FILETIME ft;
+  unsigned __int64 tmpres = 0;
+  static int tzflag;
+
+  if (NULL != tv)
+    {
+      GetSystemTimeAsFileTime(&ft);
+
+      tmpres |= ft.dwHighDateTime;
+      tmpres <<= 32;
+      tmpres |= ft.dwLowDateTime;
+
+      /*converting file time to unix epoch*/
+      tmpres /= 10;  /*convert into microseconds*/
+      tmpres -= DELTA_EPOCH_IN_MICROSECS;
+      tv->tv_sec = (long)(tmpres / 1000000UL);
+      tv->tv_usec = (long)(tmpres % 1000000UL);
+    }
+
+  return 0;
+}
+
+#endif
+
+int main(int argc, char *argv[]){
+
+  char *uplo[]  = {"U", "L"};
+
+  FLOAT *a, *b, *work, query;
+  blasint *ipiv;
+
+  char *p;
+  char btest = 'F';
+
+  blasint m, h, i, j, info, lwork, uplos=0;
+  double flops;
+
+  int from =   1;
+  int to   = 200;
+  int step =   1;
+
+  struct timeval start, stop;
+  double time1;
+
+  argc--;argv++;
+
+  if (argc > 0) { from     = atol(*argv);		argc--; argv++;}
+  if (argc > 0) { to       = MAX(atol(*argv), from);	argc--; argv++;}
+  if (argc > 0) { step     = atol(*argv);		argc--; argv++;}
+
+  if ((p = getenv("OPENBLAS_UPLO")))
+	if (*p == 'L') uplos=1;
+
+  if ((p = getenv("OPENBLAS_TEST"))) btest=*p;
+
+  fprintf(stderr, "From : %3d  To : %3d Step = %3d Uplo = %c\n", from, to, step,*uplo[uplos]);
+
+  if (( a    = (FLOAT *)malloc(sizeof(FLOAT) * to * to)) == NULL){
+    fprintf(stderr,"Out of Memory!!\n");exit(1);
+  }
+
+  if (( b    = (FLOAT *)malloc(sizeof(FLOAT) * to * to)) == NULL){
+    fprintf(stderr,"Out of Memory!!\n");exit(1);
+  }
+
+  if (( ipiv = (blasint *)malloc(sizeof(blasint) * to)) == NULL){
+    fprintf(stderr,"Out of Memory!!\n");exit(1);
+  }
+
+  lwork = -1;
+  SYTRF(uplo[uplos], &to, a, &to, ipiv, &query, &lwork, &info);
+  lwork = (blasint)query;
+
+  if (( work = (FLOAT *)malloc(sizeof(FLOAT) * lwork)) == NULL){
+    fprintf(stderr,"Out of Memory!!\n");exit(1);
+  }
+
+  for(m = from; m <= to; m += step){
+
+      h = m - m / 4;
+
+      for (j = 0; j < m; j++) {
+	for (i = j; i < m; i++) {
+	  a[(long)i + (long)j * (long)m] = ((double) rand() / (double) RAND_MAX) - 0.5;
+	  if (i >= h && j >= h) a[(long)i + (long)j * (long)m] = 0.;
+	  a[(long)j + (long)i * (long)m] = a[(long)i + (long)j * (long)m];
+	}
+	if (j < h) a[(long)j + (long)j * (long)m] += 4.;
+      }
+
+      gettimeofday( &start, (struct timezone *)0);
+
+      SYTRF(uplo[uplos], &m, a, &m, ipiv, work, &lwork, &info);
+
+      gettimeofday( &stop, (struct timezone *)0);
+
+      if (info != 0) {
+	fprintf(stderr, "Sytrf info = %d\n", info);
+	exit(1);
+      }
+
+      time1 = (double)(stop.tv_sec - start.tv_sec) + (double)((stop.tv_usec - start.tv_usec)) * 1.e-6;
+      flops = (1.0/3.0 * (double)m * (double)m *(double)m) / time1 * 1.e-6;
+
+      if ( btest == 'S' )
+      {
+
+	for(i = 0; i < m * m; i++){
+	  b[i] = ((FLOAT) rand() / (FLOAT) RAND_MAX) - 0.5;
+	}
+
+	gettimeofday( &start, (struct timezone *)0);
+
+	SYTRS(uplo[uplos], &m, &m, a, &m, ipiv, b, &m, &info);
+
+	gettimeofday( &stop, (struct timezone *)0);
+
+	if (info != 0) {
+		fprintf(stderr, "Sytrs info = %d\n", info);
+		exit(1);
+	}
+
+	time1 = (double)(stop.tv_sec - start.tv_sec) + (double)((stop.tv_usec - start.tv_usec)) * 1.e-6;
+	flops = (2.0 * (double)m * (double)m *(double)m ) / time1 * 1.e-6;
+      }
+
+      fprintf(stderr, "%8d : %10.2f MFlops : %10.3f Sec : Test=%c\n",m,flops ,time1,btest);
+
+  }
+
+  return 0;
+}
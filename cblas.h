@@ -30,6 +30,92 @@ char* openblas_get_corename(void);
 int openblas_setaffinity(int thread_idx, size_t cpusetsize, cpu_set_t* cpu_set);
 #endif
 
+/* Thread pools owned by the caller.  Threaded calls made from a thread bound
+   to a pool run only on that pool, so callers on different pools do not wait
+   for each other.  If cpus is not NULL it lists num_threads CPUs: the pool
+   threads are pinned to cpus[1] and up, and cpus[0] is left for the caller.
+   Returns NULL when the library was not built with the pthreads server. */
+typedef struct openblas_threadpool openblas_threadpool_t;
+openblas_threadpool_t *openblas_threadpool_create(int num_threads, const int *cpus);
+void openblas_threadpool_destroy(openblas_threadpool_t *pool);
+/* Bind a pool to the calling thread, NULL goes back to the shared threads. */
+int openblas_threadpool_bind(openblas_threadpool_t *pool);
+
+/* Execution settings for the BLAS calls of the calling thread only, leaving
+   the global thread count alone.  max_threads caps the threads of a call
+   (0: no cap, the global count stays the upper bound); if cpus is not NULL
+   the helper threads run only on those ncpus CPUs while they work for this
+   thread; policy is one of the OPENBLAS_POLICY_ values.  Returns 0, or -1 on
+   bad arguments or when the library was not built with the pthreads server. */
+#define OPENBLAS_POLICY_DEFAULT     0 /* the usual size heuristics */
+#define OPENBLAS_POLICY_SEQUENTIAL  1 /* never use helper threads */
+#define OPENBLAS_POLICY_EAGER       2 /* thread ?axpy, ?gemv, ?trsm and ?trsv at any size */
+int openblas_set_thread_context(int max_threads, const int *cpus, int ncpus, int policy);
+/* Drop the calling thread's settings again. */
+void openblas_clear_thread_context(void);
+
+/* Report how many internal work buffers are homed on NUMA node `node` and how
+   many of those are in use; buffers kept in a thread's buffer cache count as in
+   use.  Returns the number of nodes, or -1 if node is out of range. */
+int openblas_get_buffer_usage(int node, int *allocated, int *in_use);
+
+/* Measure where the threaded code paths start to pay off on this machine and
+   save the result in $OPENBLAS_THRESHOLD_FILE (default ~/.cache/openblas_thresholds),
+   which later runs with the same core and thread count load.  Setting
+   OPENBLAS_CALIBRATE=1 does this on first use when no such file exists.
+   Returns 0 on success, -1 if there is nothing to calibrate. */
+int openblas_calibrate_threading(void);
+/* Problem size (n for ?axpy, m * n for ?gemv and ?trsm, n * n for ?trsv and
+   ?tpsv, n * k for ?tbsv) from which `routine`, e.g. "dgemv", runs threaded;
+   "?trsv" covers all three triangular solves.  -1 if unknown or not a
+   threaded build. */
+double openblas_get_thread_threshold(const char *routine);
+
+/* Time ?gemm with blocking sizes around the built-in ones for the active core
+   and keep the fastest, saved in $OPENBLAS_GEMM_TUNE_FILE (default
+   ~/.cache/openblas_gemm_blocking) for this core and CPUID signature and
+   applied at startup from then on.  OPENBLAS_TUNE_GEMM=1 tunes at startup when
+   the file has no entry for this host.  Do not call it while other threads run
+   BLAS calls.  Returns 0, or -1 if the library was not built with DYNAMIC_ARCH
+   (the blocking sizes are compile time constants then). */
+int openblas_tune_gemm(void);
+/* Current P, Q and R of ?gemm, precision one of 's', 'd', 'c', 'z'; -1 otherwise. */
+int openblas_get_gemm_blocking(char precision, int *p, int *q, int *r);
+
+/* Non-zero makes threaded ?dot and ?gemm return bit-identical results for any
+   number of threads: dot products are summed over fixed chunks in a fixed
+   order, and GEMM runs every tile through the single threaded driver.
+   OPENBLAS_DETERMINISTIC=1 sets it at startup. */
+void openblas_set_deterministic(int on);
+int openblas_get_deterministic(void);
+
+/* Per-call trace of ?gemm, ?gemv, ?trsm and s/daxpy.  Dimensions and options
+   are those of the column major call that is executed; pack_ns and kernel_ns
+   are summed over the threads of a level 3 call.  A JSON-lines stream may go
+   to stderr (path NULL or "-"); a binary one starts with the 8 bytes
+   "OBTRACE1" padded to 16, then the 32 bit record size, and continues with
+   the records as laid out here.  OPENBLAS_TRACE=json|binary and
+   OPENBLAS_TRACE_FILE select the same at startup.  Returns 0, -1 on bad
+   arguments or when the file cannot be opened. */
+#define OPENBLAS_TRACE_OFF     0
+#define OPENBLAS_TRACE_JSON    1
+#define OPENBLAS_TRACE_BINARY  2
+typedef struct {
+  char routine[16];      /* e.g. "dgemm" */
+  char options[8];       /* option characters as passed, e.g. "NT" */
+  long long m, n, k;
+  int threads;
+  int reserved;
+  unsigned long long start_ns;   /* wall clock at entry */
+  unsigned long long wall_ns, pack_ns, kernel_ns;
+} openblas_trace_record;
+int openblas_set_trace(int format, const char *path);
+/* Called by the calling thread at the end of every traced call, NULL to stop. */
+typedef void (*openblas_trace_callback)(const openblas_trace_record *record, void *data);
+void openblas_set_trace_callback(openblas_trace_callback callback, void *data);
+/* Write out the records still held in the per-thread buffers. */
+void openblas_trace_flush(void);
+
 /* Get the parallelization type which is used by OpenBLAS */
 int openblas_get_parallel(void);
 /* OpenBLAS is compiled for sequential use  */
@@ -56,6 +142,8 @@ typedef enum CBLAS_TRANSPOSE {CblasNoTrans=111, CblasTrans=112, CblasConjTrans=1
 typedef enum CBLAS_UPLO      {CblasUpper=121, CblasLower=122} CBLAS_UPLO;
 typedef enum CBLAS_DIAG      {CblasNonUnit=131, CblasUnit=132} CBLAS_DIAG;
 typedef enum CBLAS_SIDE      {CblasLeft=141, CblasRight=142} CBLAS_SIDE;
+typedef enum CBLAS_STORAGE   {CblasPacked=151} CBLAS_STORAGE;
+typedef enum CBLAS_IDENTIFIER {CblasAMatrix=161, CblasBMatrix=162} CBLAS_IDENTIFIER;
 typedef CBLAS_ORDER CBLAS_LAYOUT;
 	
 float  cblas_sdsdot(OPENBLAS_CONST blasint n, OPENBLAS_CONST float alpha, OPENBLAS_CONST float *x, OPENBLAS_CONST blasint incx, OPENBLAS_CONST float *y, OPENBLAS_CONST blasint incy);
@@ -282,6 +370,42 @@ void cblas_zgemm(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLA
 void cblas_zgemm3m(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
 		 OPENBLAS_CONST void *alpha, OPENBLAS_CONST void *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST void *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST void *beta, void *C, OPENBLAS_CONST blasint ldc);
 
+size_t cblas_sgemm_pack_get_size(OPENBLAS_CONST enum CBLAS_IDENTIFIER identifier, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K);
+void cblas_sgemm_pack(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_IDENTIFIER identifier, OPENBLAS_CONST enum CBLAS_TRANSPOSE Trans, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST float alpha, OPENBLAS_CONST float *src, OPENBLAS_CONST blasint ld, float *dest);
+void cblas_sgemm_compute(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST blasint TransA, OPENBLAS_CONST blasint TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST float *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST float *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST float beta, float *C, OPENBLAS_CONST blasint ldc);
+size_t cblas_dgemm_pack_get_size(OPENBLAS_CONST enum CBLAS_IDENTIFIER identifier, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K);
+void cblas_dgemm_pack(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_IDENTIFIER identifier, OPENBLAS_CONST enum CBLAS_TRANSPOSE Trans, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST double alpha, OPENBLAS_CONST double *src, OPENBLAS_CONST blasint ld, double *dest);
+void cblas_dgemm_compute(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST blasint TransA, OPENBLAS_CONST blasint TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST double *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST double *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST double beta, double *C, OPENBLAS_CONST blasint ldc);
+
+void cblas_sgemm_batch(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransA_array, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransB_array, OPENBLAS_CONST blasint *M_array, OPENBLAS_CONST blasint *N_array, OPENBLAS_CONST blasint *K_array,
+		 OPENBLAS_CONST float *alpha_array, float * OPENBLAS_CONST *A_array, OPENBLAS_CONST blasint *lda_array, float * OPENBLAS_CONST *B_array, OPENBLAS_CONST blasint *ldb_array, OPENBLAS_CONST float *beta_array, float * OPENBLAS_CONST *C_array, OPENBLAS_CONST blasint *ldc_array,
+		 OPENBLAS_CONST blasint group_count, OPENBLAS_CONST blasint *group_size);
+void cblas_dgemm_batch(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransA_array, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransB_array, OPENBLAS_CONST blasint *M_array, OPENBLAS_CONST blasint *N_array, OPENBLAS_CONST blasint *K_array,
+		 OPENBLAS_CONST double *alpha_array, double * OPENBLAS_CONST *A_array, OPENBLAS_CONST blasint *lda_array, double * OPENBLAS_CONST *B_array, OPENBLAS_CONST blasint *ldb_array, OPENBLAS_CONST double *beta_array, double * OPENBLAS_CONST *C_array, OPENBLAS_CONST blasint *ldc_array,
+		 OPENBLAS_CONST blasint group_count, OPENBLAS_CONST blasint *group_size);
+void cblas_cgemm_batch(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransA_array, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransB_array, OPENBLAS_CONST blasint *M_array, OPENBLAS_CONST blasint *N_array, OPENBLAS_CONST blasint *K_array,
+		 OPENBLAS_CONST void *alpha_array, void * OPENBLAS_CONST *A_array, OPENBLAS_CONST blasint *lda_array, void * OPENBLAS_CONST *B_array, OPENBLAS_CONST blasint *ldb_array, OPENBLAS_CONST void *beta_array, void * OPENBLAS_CONST *C_array, OPENBLAS_CONST blasint *ldc_array,
+		 OPENBLAS_CONST blasint group_count, OPENBLAS_CONST blasint *group_size);
+void cblas_zgemm_batch(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransA_array, OPENBLAS_CONST enum CBLAS_TRANSPOSE *TransB_array, OPENBLAS_CONST blasint *M_array, OPENBLAS_CONST blasint *N_array, OPENBLAS_CONST blasint *K_array,
+		 OPENBLAS_CONST void *alpha_array, void * OPENBLAS_CONST *A_array, OPENBLAS_CONST blasint *lda_array, void * OPENBLAS_CONST *B_array, OPENBLAS_CONST blasint *ldb_array, OPENBLAS_CONST void *beta_array, void * OPENBLAS_CONST *C_array, OPENBLAS_CONST blasint *ldc_array,
+		 OPENBLAS_CONST blasint group_count, OPENBLAS_CONST blasint *group_size);
+void cblas_sgemm_batch_strided(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST float alpha, OPENBLAS_CONST float *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST blasint stridea, OPENBLAS_CONST float *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST blasint strideb,
+		 OPENBLAS_CONST float beta, float *C, OPENBLAS_CONST blasint ldc, OPENBLAS_CONST blasint stridec, OPENBLAS_CONST blasint batch_size);
+void cblas_dgemm_batch_strided(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST double alpha, OPENBLAS_CONST double *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST blasint stridea, OPENBLAS_CONST double *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST blasint strideb,
+		 OPENBLAS_CONST double beta, double *C, OPENBLAS_CONST blasint ldc, OPENBLAS_CONST blasint stridec, OPENBLAS_CONST blasint batch_size);
+void cblas_cgemm_batch_strided(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST void *alpha, OPENBLAS_CONST void *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST blasint stridea, OPENBLAS_CONST void *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST blasint strideb,
+		 OPENBLAS_CONST void *beta, void *C, OPENBLAS_CONST blasint ldc, OPENBLAS_CONST blasint stridec, OPENBLAS_CONST blasint batch_size);
+void cblas_zgemm_batch_strided(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST void *alpha, OPENBLAS_CONST void *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST blasint stridea, OPENBLAS_CONST void *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST blasint strideb,
+		 OPENBLAS_CONST void *beta, void *C, OPENBLAS_CONST blasint ldc, OPENBLAS_CONST blasint stridec, OPENBLAS_CONST blasint batch_size);
+
 
 void cblas_ssymm(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_SIDE Side, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N,
                  OPENBLAS_CONST float alpha, OPENBLAS_CONST float *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST float *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST float beta, float *C, OPENBLAS_CONST blasint ldc);
@@ -310,6 +434,15 @@ void cblas_csyr2k(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBL
 void cblas_zsyr2k(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST enum CBLAS_TRANSPOSE Trans,
 		  OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K, OPENBLAS_CONST void *alpha, OPENBLAS_CONST void *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST void *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST void *beta, void *C, OPENBLAS_CONST blasint ldc);
 
+void cblas_sgemmt(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB,
+		  OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K, OPENBLAS_CONST float alpha, OPENBLAS_CONST float *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST float *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST float beta, float *C, OPENBLAS_CONST blasint ldc);
+void cblas_dgemmt(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB,
+		  OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K, OPENBLAS_CONST double alpha, OPENBLAS_CONST double *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST double *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST double beta, double *C, OPENBLAS_CONST blasint ldc);
+void cblas_cgemmt(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB,
+		  OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K, OPENBLAS_CONST void *alpha, OPENBLAS_CONST void *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST void *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST void *beta, void *C, OPENBLAS_CONST blasint ldc);
+void cblas_zgemmt(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB,
+		  OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K, OPENBLAS_CONST void *alpha, OPENBLAS_CONST void *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST void *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST void *beta, void *C, OPENBLAS_CONST blasint ldc);
+
 void cblas_strmm(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_SIDE Side, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA,
                  OPENBLAS_CONST enum CBLAS_DIAG Diag, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST float alpha, OPENBLAS_CONST float *A, OPENBLAS_CONST blasint lda, float *B, OPENBLAS_CONST blasint ldb);
 void cblas_dtrmm(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_SIDE Side, OPENBLAS_CONST enum CBLAS_UPLO Uplo, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA,
@@ -373,6 +506,18 @@ void cblas_cimatcopy(OPENBLAS_CONST enum CBLAS_ORDER CORDER, OPENBLAS_CONST enum
 void cblas_zimatcopy(OPENBLAS_CONST enum CBLAS_ORDER CORDER, OPENBLAS_CONST enum CBLAS_TRANSPOSE CTRANS, OPENBLAS_CONST blasint crows, OPENBLAS_CONST blasint ccols, OPENBLAS_CONST double* calpha, double* a, 
 		     OPENBLAS_CONST blasint clda, OPENBLAS_CONST blasint cldb); 
 
+/*** BFLOAT16 extensions ****/
+/* convert float array to BFLOAT16 array by rounding */
+void   cblas_shstobf16(OPENBLAS_CONST blasint n, OPENBLAS_CONST float *in, OPENBLAS_CONST blasint incin, bfloat16 *out, OPENBLAS_CONST blasint incout);
+/* convert BFLOAT16 array to float array */
+void   cblas_shbf16tos(OPENBLAS_CONST blasint n, OPENBLAS_CONST bfloat16 *in, OPENBLAS_CONST blasint incin, float *out, OPENBLAS_CONST blasint incout);
+/* y = alpha * op(A) * x + beta * y with A and x in BFLOAT16 */
+void cblas_shgemv(OPENBLAS_CONST enum CBLAS_ORDER order,  OPENBLAS_CONST enum CBLAS_TRANSPOSE trans,  OPENBLAS_CONST blasint m, OPENBLAS_CONST blasint n,
+		 OPENBLAS_CONST float alpha, OPENBLAS_CONST bfloat16 *a, OPENBLAS_CONST blasint lda,  OPENBLAS_CONST bfloat16 *x, OPENBLAS_CONST blasint incx,  OPENBLAS_CONST float beta,  float *y, OPENBLAS_CONST blasint incy);
+/* C = alpha * op(A) * op(B) + beta * C with A and B in BFLOAT16 */
+void cblas_shgemm(OPENBLAS_CONST enum CBLAS_ORDER Order, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransA, OPENBLAS_CONST enum CBLAS_TRANSPOSE TransB, OPENBLAS_CONST blasint M, OPENBLAS_CONST blasint N, OPENBLAS_CONST blasint K,
+		 OPENBLAS_CONST float alpha, OPENBLAS_CONST bfloat16 *A, OPENBLAS_CONST blasint lda, OPENBLAS_CONST bfloat16 *B, OPENBLAS_CONST blasint ldb, OPENBLAS_CONST float beta, float *C, OPENBLAS_CONST blasint ldc);
+
 void cblas_sgeadd(OPENBLAS_CONST enum CBLAS_ORDER CORDER,OPENBLAS_CONST blasint crows, OPENBLAS_CONST blasint ccols, OPENBLAS_CONST float calpha, float *a, OPENBLAS_CONST blasint clda, OPENBLAS_CONST float cbeta, 
 		  float *c, OPENBLAS_CONST blasint cldc); 
 void cblas_dgeadd(OPENBLAS_CONST enum CBLAS_ORDER CORDER,OPENBLAS_CONST blasint crows, OPENBLAS_CONST blasint ccols, OPENBLAS_CONST double calpha, double *a, OPENBLAS_CONST blasint clda, OPENBLAS_CONST double cbeta, 
@@ -75,6 +75,11 @@ macro(SetDefaultL1)
   set(CROTKERNEL zrot.S)
   set(ZROTKERNEL zrot.S)
   set(XROTKERNEL zrot.S)
+  set(SROTMKERNEL ../generic/rotm.c)
+  set(DROTMKERNEL ../generic/rotm.c)
+  set(QROTMKERNEL ../generic/rotm.c)
+  set(SROTSEQKERNEL ../generic/rotseq.c)
+  set(DROTSEQKERNEL ../generic/rotseq.c)
   set(SSCALKERNEL scal.S)
   set(DSCALKERNEL scal.S)
   set(CSCALKERNEL zscal.S)
@@ -132,6 +137,8 @@ if (BUILD_HALF)
   set(SHNRM2KERNEL ../arm/nrm2.c)
   set(SHSUMKERNEL ../arm/sum.c)
   set(SHSWAPKERNEL ../arm/swap.c)
+  set(SHSTOBF16KERNEL ../generic/shstobf16.c)
+  set(SHBF16TOSKERNEL ../generic/shbf16tos.c)
 endif ()
 endmacro ()
 
@@ -182,8 +189,8 @@ macro(SetDefaultL2)
   set(XHEMV_V_KERNEL ../generic/zhemv_k.c)
   set(XHEMV_M_KERNEL ../generic/zhemv_k.c)
 if (BUILD_HALF)
-  set(SHGEMVNKERNEL ../arm/gemv_n.c)
-  set(SHGEMVTKERNEL ../arm/gemv_t.c)
+  set(SHGEMVNKERNEL ../generic/shgemv_n.c)
+  set(SHGEMVTKERNEL ../generic/shgemv_t.c)
   set(SHGERKERNEL ../generic/ger.c)
 endif ()
 endmacro ()
@@ -193,6 +200,22 @@ macro(SetDefaultL3)
   set(DGEADD_KERNEL ../generic/geadd.c)
   set(CGEADD_KERNEL ../generic/zgeadd.c)
   set(ZGEADD_KERNEL ../generic/zgeadd.c)
+if (SMALL_MATRIX_OPT)
+  foreach (float_char S D)
+    set(${float_char}GEMM_SMALL_M_PERMIT ../generic/gemm_small_matrix_permit.c)
+    set(${float_char}GEMM_SMALL_K_NN ../generic/gemm_small_matrix_kernel_nn.c)
+    set(${float_char}GEMM_SMALL_K_NT ../generic/gemm_small_matrix_kernel_nt.c)
+    set(${float_char}GEMM_SMALL_K_TN ../generic/gemm_small_matrix_kernel_tn.c)
+    set(${float_char}GEMM_SMALL_K_TT ../generic/gemm_small_matrix_kernel_tt.c)
+  endforeach ()
+  foreach (float_char C Z)
+    set(${float_char}GEMM_SMALL_M_PERMIT ../generic/zgemm_small_matrix_permit.c)
+    set(${float_char}GEMM_SMALL_K_NN ../generic/zgemm_small_matrix_kernel_nn.c)
+    set(${float_char}GEMM_SMALL_K_NT ../generic/zgemm_small_matrix_kernel_nt.c)
+    set(${float_char}GEMM_SMALL_K_TN ../generic/zgemm_small_matrix_kernel_tn.c)
+    set(${float_char}GEMM_SMALL_K_TT ../generic/zgemm_small_matrix_kernel_tt.c)
+  endforeach ()
+endif ()
 if (BUILD_HALF)
   set(SHGEADD_KERNEL ../generic/geadd.c)
   set(SHGEMMKERNEL ../generic/gemmkernel_2x2.c)
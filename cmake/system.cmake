@@ -270,6 +270,18 @@ if (USE_TLS)
   set(CCOMMON_OPT "${CCOMMON_OPT} -DUSE_TLS")
 endif ()
 
+if (X86_64 AND NOT DEFINED SMALL_MATRIX_OPT)
+  set(SMALL_MATRIX_OPT 1)
+endif ()
+
+if (SMALL_MATRIX_OPT)
+  set(CCOMMON_OPT "${CCOMMON_OPT} -DSMALL_MATRIX_OPT")
+endif ()
+
+if (BUILD_HALF)
+  set(CCOMMON_OPT "${CCOMMON_OPT} -DBUILD_HALF")
+endif ()
+
 # Only for development
 # set(CCOMMON_OPT "${CCOMMON_OPT} -DPARAMTEST")
 # set(CCOMMON_OPT "${CCOMMON_OPT} -DPREFETCHTEST")
@@ -892,6 +892,38 @@ extern int gotoblas_profile;
 #define FUNCTION_PROFILE_END(COMP, AREA, OPS)
 #endif
 
+#ifndef ASSEMBLER
+/* Runtime per-call tracing (driver/others/openblas_trace.c).  The level 3
+   drivers add their packing and kernel cycles to blas_trace_current(). */
+typedef struct blas_trace {
+  unsigned long long start_ns, start_mono, start_cycles;
+  volatile unsigned long long pack, kernel;
+  struct blas_trace *outer;
+} blas_trace_t;
+
+extern int blas_trace_enabled;
+
+void blas_trace_begin(blas_trace_t *);
+void blas_trace_end(blas_trace_t *, const char *, const char *, BLASLONG, BLASLONG, BLASLONG, int);
+blas_trace_t *blas_trace_current(void);
+void blas_trace_set_current(blas_trace_t *);
+void blas_trace_cost(blas_trace_t *, unsigned long long, unsigned long long);
+void blas_trace_init(void);
+void blas_trace_quit(void);
+
+#define TRACE_START() \
+	blas_trace_t trace_call; int trace_on = blas_trace_enabled; \
+	if (trace_on) blas_trace_begin(&trace_call)
+#define TRACE_END(OPTIONS, M, N, K, THREADS) \
+	if (trace_on) blas_trace_end(&trace_call, CHAR_CNAME, OPTIONS, M, N, K, THREADS)
+
+#ifdef SMP
+#define TRACE_THREADS(N)	(N)
+#else
+#define TRACE_THREADS(N)	1
+#endif
+#endif
+
 #if 1
 #define PRINT_DEBUG_CNAME
 #define PRINT_DEBUG_NAME
@@ -232,6 +232,42 @@
 
 #define CGEADD_K                cgeadd_k 
 
+#ifdef SMALL_MATRIX_OPT
+#define CGEMM_SMALL_MATRIX_PERMIT        cgemm_small_matrix_permit
+#define CGEMM_SMALL_KERNEL_NN            cgemm_small_kernel_nn
+#define CGEMM_SMALL_KERNEL_TN            cgemm_small_kernel_tn
+#define CGEMM_SMALL_KERNEL_RN            cgemm_small_kernel_rn
+#define CGEMM_SMALL_KERNEL_CN            cgemm_small_kernel_cn
+#define CGEMM_SMALL_KERNEL_NT            cgemm_small_kernel_nt
+#define CGEMM_SMALL_KERNEL_TT            cgemm_small_kernel_tt
+#define CGEMM_SMALL_KERNEL_RT            cgemm_small_kernel_rt
+#define CGEMM_SMALL_KERNEL_CT            cgemm_small_kernel_ct
+#define CGEMM_SMALL_KERNEL_NR            cgemm_small_kernel_nr
+#define CGEMM_SMALL_KERNEL_TR            cgemm_small_kernel_tr
+#define CGEMM_SMALL_KERNEL_RR            cgemm_small_kernel_rr
+#define CGEMM_SMALL_KERNEL_CR            cgemm_small_kernel_cr
+#define CGEMM_SMALL_KERNEL_NC            cgemm_small_kernel_nc
+#define CGEMM_SMALL_KERNEL_TC            cgemm_small_kernel_tc
+#define CGEMM_SMALL_KERNEL_RC            cgemm_small_kernel_rc
+#define CGEMM_SMALL_KERNEL_CC            cgemm_small_kernel_cc
+#define CGEMM_SMALL_KERNEL_B0_NN         cgemm_small_kernel_b0_nn
+#define CGEMM_SMALL_KERNEL_B0_TN         cgemm_small_kernel_b0_tn
+#define CGEMM_SMALL_KERNEL_B0_RN         cgemm_small_kernel_b0_rn
+#define CGEMM_SMALL_KERNEL_B0_CN         cgemm_small_kernel_b0_cn
+#define CGEMM_SMALL_KERNEL_B0_NT         cgemm_small_kernel_b0_nt
+#define CGEMM_SMALL_KERNEL_B0_TT         cgemm_small_kernel_b0_tt
+#define CGEMM_SMALL_KERNEL_B0_RT         cgemm_small_kernel_b0_rt
+#define CGEMM_SMALL_KERNEL_B0_CT         cgemm_small_kernel_b0_ct
+#define CGEMM_SMALL_KERNEL_B0_NR         cgemm_small_kernel_b0_nr
+#define CGEMM_SMALL_KERNEL_B0_TR         cgemm_small_kernel_b0_tr
+#define CGEMM_SMALL_KERNEL_B0_RR         cgemm_small_kernel_b0_rr
+#define CGEMM_SMALL_KERNEL_B0_CR         cgemm_small_kernel_b0_cr
+#define CGEMM_SMALL_KERNEL_B0_NC         cgemm_small_kernel_b0_nc
+#define CGEMM_SMALL_KERNEL_B0_TC         cgemm_small_kernel_b0_tc
+#define CGEMM_SMALL_KERNEL_B0_RC         cgemm_small_kernel_b0_rc
+#define CGEMM_SMALL_KERNEL_B0_CC         cgemm_small_kernel_b0_cc
+#endif
+
 #else
 
 #define	CAMAX_K			gotoblas -> camax_k
@@ -426,6 +462,42 @@
 
 #define CGEADD_K                gotoblas -> cgeadd_k 
 
+#ifdef SMALL_MATRIX_OPT
+#define CGEMM_SMALL_MATRIX_PERMIT        gotoblas -> cgemm_small_matrix_permit
+#define CGEMM_SMALL_KERNEL_NN            FUNC_OFFSET(cgemm_small_kernel_nn)
+#define CGEMM_SMALL_KERNEL_TN            FUNC_OFFSET(cgemm_small_kernel_tn)
+#define CGEMM_SMALL_KERNEL_RN            FUNC_OFFSET(cgemm_small_kernel_rn)
+#define CGEMM_SMALL_KERNEL_CN            FUNC_OFFSET(cgemm_small_kernel_cn)
+#define CGEMM_SMALL_KERNEL_NT            FUNC_OFFSET(cgemm_small_kernel_nt)
+#define CGEMM_SMALL_KERNEL_TT            FUNC_OFFSET(cgemm_small_kernel_tt)
+#define CGEMM_SMALL_KERNEL_RT            FUNC_OFFSET(cgemm_small_kernel_rt)
+#define CGEMM_SMALL_KERNEL_CT            FUNC_OFFSET(cgemm_small_kernel_ct)
+#define CGEMM_SMALL_KERNEL_NR            FUNC_OFFSET(cgemm_small_kernel_nr)
+#define CGEMM_SMALL_KERNEL_TR            FUNC_OFFSET(cgemm_small_kernel_tr)
+#define CGEMM_SMALL_KERNEL_RR            FUNC_OFFSET(cgemm_small_kernel_rr)
+#define CGEMM_SMALL_KERNEL_CR            FUNC_OFFSET(cgemm_small_kernel_cr)
+#define CGEMM_SMALL_KERNEL_NC            FUNC_OFFSET(cgemm_small_kernel_nc)
+#define CGEMM_SMALL_KERNEL_TC            FUNC_OFFSET(cgemm_small_kernel_tc)
+#define CGEMM_SMALL_KERNEL_RC            FUNC_OFFSET(cgemm_small_kernel_rc)
+#define CGEMM_SMALL_KERNEL_CC            FUNC_OFFSET(cgemm_small_kernel_cc)
+#define CGEMM_SMALL_KERNEL_B0_NN         FUNC_OFFSET(cgemm_small_kernel_b0_nn)
+#define CGEMM_SMALL_KERNEL_B0_TN         FUNC_OFFSET(cgemm_small_kernel_b0_tn)
+#define CGEMM_SMALL_KERNEL_B0_RN         FUNC_OFFSET(cgemm_small_kernel_b0_rn)
+#define CGEMM_SMALL_KERNEL_B0_CN         FUNC_OFFSET(cgemm_small_kernel_b0_cn)
+#define CGEMM_SMALL_KERNEL_B0_NT         FUNC_OFFSET(cgemm_small_kernel_b0_nt)
+#define CGEMM_SMALL_KERNEL_B0_TT         FUNC_OFFSET(cgemm_small_kernel_b0_tt)
+#define CGEMM_SMALL_KERNEL_B0_RT         FUNC_OFFSET(cgemm_small_kernel_b0_rt)
+#define CGEMM_SMALL_KERNEL_B0_CT         FUNC_OFFSET(cgemm_small_kernel_b0_ct)
+#define CGEMM_SMALL_KERNEL_B0_NR         FUNC_OFFSET(cgemm_small_kernel_b0_nr)
+#define CGEMM_SMALL_KERNEL_B0_TR         FUNC_OFFSET(cgemm_small_kernel_b0_tr)
+#define CGEMM_SMALL_KERNEL_B0_RR         FUNC_OFFSET(cgemm_small_kernel_b0_rr)
+#define CGEMM_SMALL_KERNEL_B0_CR         FUNC_OFFSET(cgemm_small_kernel_b0_cr)
+#define CGEMM_SMALL_KERNEL_B0_NC         FUNC_OFFSET(cgemm_small_kernel_b0_nc)
+#define CGEMM_SMALL_KERNEL_B0_TC         FUNC_OFFSET(cgemm_small_kernel_b0_tc)
+#define CGEMM_SMALL_KERNEL_B0_RC         FUNC_OFFSET(cgemm_small_kernel_b0_rc)
+#define CGEMM_SMALL_KERNEL_B0_CC         FUNC_OFFSET(cgemm_small_kernel_b0_cc)
+#endif
+
 #endif
 
 #define	CGEMM_NN		cgemm_nn
@@ -572,6 +644,33 @@
 #define	CGEMM_THREAD_RC		cgemm_thread_rc
 #define	CGEMM_THREAD_RR		cgemm_thread_rr
 
+#define	CGEMM_BATCH_THREAD	cgemm_batch_thread
+
+#define	CGEMMT_UNN		cgemmt_UNN
+#define	CGEMMT_UNT		cgemmt_UNT
+#define	CGEMMT_UNC		cgemmt_UNC
+#define	CGEMMT_UTN		cgemmt_UTN
+#define	CGEMMT_UTT		cgemmt_UTT
+#define	CGEMMT_UTC		cgemmt_UTC
+#define	CGEMMT_UCN		cgemmt_UCN
+#define	CGEMMT_UCT		cgemmt_UCT
+#define	CGEMMT_UCC		cgemmt_UCC
+#define	CGEMMT_LNN		cgemmt_LNN
+#define	CGEMMT_LNT		cgemmt_LNT
+#define	CGEMMT_LNC		cgemmt_LNC
+#define	CGEMMT_LTN		cgemmt_LTN
+#define	CGEMMT_LTT		cgemmt_LTT
+#define	CGEMMT_LTC		cgemmt_LTC
+#define	CGEMMT_LCN		cgemmt_LCN
+#define	CGEMMT_LCT		cgemmt_LCT
+#define	CGEMMT_LCC		cgemmt_LCC
+#define	CGEMMT_KERNEL_UL	cgemmt_kernel_UL
+#define	CGEMMT_KERNEL_UR	cgemmt_kernel_UR
+#define	CGEMMT_KERNEL_UB	cgemmt_kernel_UB
+#define	CGEMMT_KERNEL_LL	cgemmt_kernel_LL
+#define	CGEMMT_KERNEL_LR	cgemmt_kernel_LR
+#define	CGEMMT_KERNEL_LB	cgemmt_kernel_LB
+
 #define	CSYMM_THREAD_LU		csymm_thread_LU
 #define	CSYMM_THREAD_LL		csymm_thread_LL
 #define	CSYMM_THREAD_RU		csymm_thread_RU
@@ -22,6 +22,8 @@
 #define	DSUM_K			dsum_k
 #define	DSWAP_K			dswap_k
 #define	DROT_K			drot_k
+#define	DROTM_K			drotm_k
+#define	DROTSEQ_K		drotseq_k
 
 #define	DGEMV_N			dgemv_n
 #define	DGEMV_T			dgemv_t
@@ -157,6 +159,18 @@
 #define DIMATCOPY_K_RT      dimatcopy_k_rt
 #define DGEADD_K                dgeadd_k 
 
+#ifdef SMALL_MATRIX_OPT
+#define DGEMM_SMALL_MATRIX_PERMIT        dgemm_small_matrix_permit
+#define DGEMM_SMALL_KERNEL_NN            dgemm_small_kernel_nn
+#define DGEMM_SMALL_KERNEL_TN            dgemm_small_kernel_tn
+#define DGEMM_SMALL_KERNEL_NT            dgemm_small_kernel_nt
+#define DGEMM_SMALL_KERNEL_TT            dgemm_small_kernel_tt
+#define DGEMM_SMALL_KERNEL_B0_NN         dgemm_small_kernel_b0_nn
+#define DGEMM_SMALL_KERNEL_B0_TN         dgemm_small_kernel_b0_tn
+#define DGEMM_SMALL_KERNEL_B0_NT         dgemm_small_kernel_b0_nt
+#define DGEMM_SMALL_KERNEL_B0_TT         dgemm_small_kernel_b0_tt
+#endif
+
 #else
 
 #define	DAMAX_K			gotoblas -> damax_k
@@ -178,6 +192,8 @@
 #define	DSUM_K			gotoblas -> dsum_k
 #define	DSWAP_K			gotoblas -> dswap_k
 #define	DROT_K			gotoblas -> drot_k
+#define	DROTM_K			gotoblas -> drotm_k
+#define	DROTSEQ_K		gotoblas -> drotseq_k
 
 #define	DGEMV_N			gotoblas -> dgemv_n
 #define	DGEMV_T			gotoblas -> dgemv_t
@@ -281,6 +297,18 @@
 
 #define DGEADD_K                gotoblas -> dgeadd_k 
 
+#ifdef SMALL_MATRIX_OPT
+#define DGEMM_SMALL_MATRIX_PERMIT        gotoblas -> dgemm_small_matrix_permit
+#define DGEMM_SMALL_KERNEL_NN            FUNC_OFFSET(dgemm_small_kernel_nn)
+#define DGEMM_SMALL_KERNEL_TN            FUNC_OFFSET(dgemm_small_kernel_tn)
+#define DGEMM_SMALL_KERNEL_NT            FUNC_OFFSET(dgemm_small_kernel_nt)
+#define DGEMM_SMALL_KERNEL_TT            FUNC_OFFSET(dgemm_small_kernel_tt)
+#define DGEMM_SMALL_KERNEL_B0_NN         FUNC_OFFSET(dgemm_small_kernel_b0_nn)
+#define DGEMM_SMALL_KERNEL_B0_TN         FUNC_OFFSET(dgemm_small_kernel_b0_tn)
+#define DGEMM_SMALL_KERNEL_B0_NT         FUNC_OFFSET(dgemm_small_kernel_b0_nt)
+#define DGEMM_SMALL_KERNEL_B0_TT         FUNC_OFFSET(dgemm_small_kernel_b0_tt)
+#endif
+
 #endif
 
 #define	DGEMM_NN		dgemm_nn
@@ -427,6 +455,27 @@
 #define	DGEMM_THREAD_RC		dgemm_thread_nt
 #define	DGEMM_THREAD_RR		dgemm_thread_nn
 
+#define	DGEMM_BATCH_THREAD	dgemm_batch_thread
+
+#define	DGEMM_PACK_AN		dgemm_pack_an
+#define	DGEMM_PACK_AT		dgemm_pack_at
+#define	DGEMM_PACK_BN		dgemm_pack_bn
+#define	DGEMM_PACK_BT		dgemm_pack_bt
+#define	DGEMM_COMPUTE_PN	dgemm_compute_pn
+#define	DGEMM_COMPUTE_PT	dgemm_compute_pt
+#define	DGEMM_COMPUTE_NP	dgemm_compute_np
+#define	DGEMM_COMPUTE_TP	dgemm_compute_tp
+#define	DGEMM_COMPUTE_PP	dgemm_compute_pp
+
+#define	DGEMMT_UNN		dgemmt_UNN
+#define	DGEMMT_UNT		dgemmt_UNT
+#define	DGEMMT_UTN		dgemmt_UTN
+#define	DGEMMT_UTT		dgemmt_UTT
+#define	DGEMMT_LNN		dgemmt_LNN
+#define	DGEMMT_LNT		dgemmt_LNT
+#define	DGEMMT_LTN		dgemmt_LTN
+#define	DGEMMT_LTT		dgemmt_LTT
+
 #define	DSYMM_THREAD_LU		dsymm_thread_LU
 #define	DSYMM_THREAD_LL		dsymm_thread_LL
 #define	DSYMM_THREAD_RU		dsymm_thread_RU
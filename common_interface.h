@@ -102,6 +102,8 @@ void    BLASFUNC(zaxpyc)(blasint *, double *, double *, blasint *, double *, bla
 void    BLASFUNC(xaxpyc)(blasint *, xdouble *, xdouble *, blasint *, xdouble *, blasint *);
 
 void    BLASFUNC(scopy) (blasint *, float  *, blasint *, float  *, blasint *);
+void    BLASFUNC(shstobf16)(blasint *, float  *, blasint *, bfloat16 *, blasint *);
+void    BLASFUNC(shbf16tos)(blasint *, bfloat16 *, blasint *, float  *, blasint *);
 void    BLASFUNC(dcopy) (blasint *, double *, blasint *, double *, blasint *);
 void    BLASFUNC(qcopy) (blasint *, xdouble *, blasint *, xdouble *, blasint *);
 void    BLASFUNC(ccopy) (blasint *, float  *, blasint *, float  *, blasint *);
@@ -245,6 +247,8 @@ void BLASFUNC(xgeru)(blasint *,    blasint *, xdouble *, xdouble *, blasint *,
 void BLASFUNC(xgerc)(blasint *,    blasint *, xdouble *, xdouble *, blasint *,
 		    xdouble *, blasint *, xdouble *, blasint *);
 
+void BLASFUNC(shgemv)(char *, blasint *, blasint *, float  *, bfloat16 *, blasint *,
+		    bfloat16 *, blasint *, float  *, float  *, blasint *);
 void BLASFUNC(sgemv)(char *, blasint *, blasint *, float  *, float  *, blasint *,
 		    float  *, blasint *, float  *, float  *, blasint *);
 void BLASFUNC(dgemv)(char *, blasint *, blasint *, double *, double *, blasint *,
@@ -563,6 +567,15 @@ void BLASFUNC(zsyrk)(char *, char *, blasint *, blasint *, double *, double *, b
 void BLASFUNC(xsyrk)(char *, char *, blasint *, blasint *, xdouble *, xdouble *, blasint *,
 	   xdouble *, xdouble *, blasint *);
 
+void BLASFUNC(sgemmt)(char *, char *, char *, blasint *, blasint *, float  *, float  *, blasint *,
+	   float  *, blasint *, float  *, float  *, blasint *);
+void BLASFUNC(dgemmt)(char *, char *, char *, blasint *, blasint *, double *, double *, blasint *,
+	   double *, blasint *, double *, double *, blasint *);
+void BLASFUNC(cgemmt)(char *, char *, char *, blasint *, blasint *, float  *, float  *, blasint *,
+	   float  *, blasint *, float  *, float  *, blasint *);
+void BLASFUNC(zgemmt)(char *, char *, char *, blasint *, blasint *, double *, double *, blasint *,
+	   double *, blasint *, double *, double *, blasint *);
+
 void BLASFUNC(ssyr2k)(char *, char *, blasint *, blasint *, float  *, float  *, blasint *,
 	   float *, blasint *, float  *, float  *, blasint *);
 void BLASFUNC(dsyr2k)(char *, char *, blasint *, blasint *, double *, double *, blasint *,
@@ -674,6 +687,30 @@ int BLASFUNC(claswp)(blasint *, float  *, blasint *, blasint *, blasint *, blasi
 int BLASFUNC(zlaswp)(blasint *, double *, blasint *, blasint *, blasint *, blasint *, blasint *);
 int BLASFUNC(xlaswp)(blasint *, xdouble *, blasint *, blasint *, blasint *, blasint *, blasint *);
 
+int BLASFUNC(slasr)(char *, char *, char *, blasint *, blasint *, float  *, float  *, float  *, blasint *);
+int BLASFUNC(dlasr)(char *, char *, char *, blasint *, blasint *, double *, double *, double *, blasint *);
+int BLASFUNC(clasr)(char *, char *, char *, blasint *, blasint *, float  *, float  *, float  *, blasint *);
+int BLASFUNC(zlasr)(char *, char *, char *, blasint *, blasint *, double *, double *, double *, blasint *);
+
+int BLASFUNC(sgeqrf)(blasint *, blasint *, float  *, blasint *, float  *, float  *, blasint *, blasint *);
+int BLASFUNC(dgeqrf)(blasint *, blasint *, double *, blasint *, double *, double *, blasint *, blasint *);
+
+int BLASFUNC(sormqr)(char *, char *, blasint *, blasint *, blasint *, float  *, blasint *, float  *, float  *, blasint *, float  *, blasint *, blasint *);
+int BLASFUNC(dormqr)(char *, char *, blasint *, blasint *, blasint *, double *, blasint *, double *, double *, blasint *, double *, blasint *, blasint *);
+
+int BLASFUNC(ssyevd)(char *, char *, blasint *, float  *, blasint *, float  *, float  *, blasint *, blasint *, blasint *, blasint *);
+int BLASFUNC(dsyevd)(char *, char *, blasint *, double *, blasint *, double *, double *, blasint *, blasint *, blasint *, blasint *);
+
+int BLASFUNC(sstedc)(char *, blasint *, float  *, float  *, float  *, blasint *, float  *, blasint *, blasint *, blasint *, blasint *);
+int BLASFUNC(dstedc)(char *, blasint *, double *, double *, double *, blasint *, double *, blasint *, blasint *, blasint *, blasint *);
+int BLASFUNC(ssterf)(blasint *, float  *, float  *, blasint *);
+int BLASFUNC(dsterf)(blasint *, double *, double *, blasint *);
+
+int BLASFUNC(ssytrf)(char *, blasint *, float  *, blasint *, blasint *, float  *, blasint *, blasint *);
+int BLASFUNC(dsytrf)(char *, blasint *, double *, blasint *, blasint *, double *, blasint *, blasint *);
+int BLASFUNC(ssytrs)(char *, blasint *, blasint *, float  *, blasint *, blasint *, float  *, blasint *, blasint *);
+int BLASFUNC(dsytrs)(char *, blasint *, blasint *, double *, blasint *, blasint *, double *, blasint *, blasint *);
+
 int BLASFUNC(sgetrs)(char *, blasint *, blasint *, float  *, blasint *, blasint *, float  *, blasint *, blasint *);
 int BLASFUNC(dgetrs)(char *, blasint *, blasint *, double *, blasint *, blasint *, double *, blasint *, blasint *);
 int BLASFUNC(qgetrs)(char *, blasint *, blasint *, xdouble *, blasint *, blasint *, xdouble *, blasint *, blasint *);
@@ -688,6 +725,13 @@ int BLASFUNC(cgesv)(blasint *, blasint *, float  *, blasint *, blasint *, float
 int BLASFUNC(zgesv)(blasint *, blasint *, double *, blasint *, blasint *, double*, blasint *, blasint *);
 int BLASFUNC(xgesv)(blasint *, blasint *, xdouble *, blasint *, blasint *, xdouble*, blasint *, blasint *);
 
+int BLASFUNC(dsgesv)(blasint *, blasint *, double *, blasint *, blasint *, double *, blasint *,
+		     double *, blasint *, double *, float *, blasint *, blasint *);
+int BLASFUNC(dshgesv)(blasint *, blasint *, double *, blasint *, blasint *, double *, blasint *,
+		     double *, blasint *, double *, float *, blasint *, blasint *);
+int BLASFUNC(dsposv)(char *, blasint *, blasint *, double *, blasint *, double *, blasint *,
+		     double *, blasint *, double *, float *, blasint *, blasint *);
+
 int BLASFUNC(spotf2)(char *, blasint *, float  *, blasint *, blasint *);
 int BLASFUNC(dpotf2)(char *, blasint *, double *, blasint *, blasint *);
 int BLASFUNC(qpotf2)(char *, blasint *, xdouble *, blasint *, blasint *);
@@ -120,6 +120,86 @@ blasint xgetrs_T_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, xdouble *, xdoub
 blasint xgetrs_R_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, xdouble *, xdouble *, BLASLONG);
 blasint xgetrs_C_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, xdouble *, xdouble *, BLASLONG);
 
+/* Block width of the native QR in lapack/geqrf.  geqrf needs a workspace
+   of nb * (3 * nb + n) elements and ormqr one of nb * (nb + max(m, n)). */
+#ifndef QR_BLOCKING
+#define QR_BLOCKING 64
+#endif
+
+blasint slarft_k(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dlarft_k(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint slarfb_LN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dlarfb_LN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint slarfb_LT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dlarfb_LT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint slarfb_RN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dlarfb_RN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint slarfb_RT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dlarfb_RT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint sgeqrf_panel(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dgeqrf_panel(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint sgeqrf_single(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dgeqrf_single(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint sgeqrf_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dgeqrf_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint sormqr_LN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dormqr_LN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint sormqr_LT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dormqr_LT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint sormqr_RN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dormqr_RN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint sormqr_RT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dormqr_RT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+
+/* Band half width of the native two-stage syevd in lapack/syevd; smaller
+   matrices are reduced directly to tridiagonal form (a band of one). */
+#ifndef SYEVD_BAND
+#define SYEVD_BAND 32
+#endif
+
+blasint ssy2sb(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsy2sb(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssb2st(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsb2st(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssb2st_back(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsb2st_back(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+
+/* Block width of the native Bunch-Kaufman sytrf in lapack/sytrf.  sytrf
+   needs a workspace of 2 * n * nb elements (n * nb without threads) and
+   sytrs one of n * (nb + 1) per thread. */
+#ifndef SYTRF_BLOCKING
+#define SYTRF_BLOCKING 64
+#endif
+
+/* Slices of the trailing update that the look-ahead panel of the
+   threaded sytrf waits for: slice i covers columns range[i] to
+   range[i + 1] and sets done[i] once they are updated. */
+typedef struct {
+  BLASLONG num, range[MAX_CPU_NUMBER + 1];
+  volatile BLASLONG done[MAX_CPU_NUMBER];
+} sytrf_sync_t;
+
+blasint ssytrf_panel_L(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrf_panel_L(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrf_panel_U(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrf_panel_U(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrf_L_single(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrf_L_single(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrf_U_single(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrf_U_single(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrf_L_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrf_L_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrf_U_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrf_U_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrs_L_single(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrs_L_single(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrs_U_single(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrs_U_single(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrs_L_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrs_L_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+blasint ssytrs_U_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+blasint dsytrs_U_parallel(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+
 blasint spotf2_U(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
 blasint spotf2_L(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
 blasint dpotf2_U(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
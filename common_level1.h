@@ -207,9 +207,12 @@ int    srotmg_k(float  *, float  *, float  *, float  *, float  *);
 int    drotmg_k(double *, double *, double *, double *, double *);
 int    qrotmg_k(xdouble *, xdouble *, xdouble *, xdouble *, xdouble *);
 
-int    srotm_k (BLASLONG, float,  BLASLONG, float,  BLASLONG, float);
-int    drotm_k (BLASLONG, double, BLASLONG, double, BLASLONG, double);
-int    qrotm_k (BLASLONG, xdouble, BLASLONG, xdouble, BLASLONG, xdouble);
+int    srotm_k (BLASLONG, float  *, BLASLONG, float  *, BLASLONG, float  *);
+int    drotm_k (BLASLONG, double *, BLASLONG, double *, BLASLONG, double *);
+int    qrotm_k (BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *);
+
+int    srotseq_k(BLASLONG, BLASLONG, float  *, BLASLONG, float  *, float  *, BLASLONG);
+int    drotseq_k(BLASLONG, BLASLONG, double *, BLASLONG, double *, double *, BLASLONG);
 
 
 int    saxpby_k (BLASLONG, float,  float  *, BLASLONG, float,  float  *, BLASLONG);
@@ -217,6 +220,9 @@ int    daxpby_k (BLASLONG, double, double *, BLASLONG, double, double *, BLASLON
 int    caxpby_k (BLASLONG, float,  float,  float  *, BLASLONG, float,  float,  float  *, BLASLONG);
 int    zaxpby_k (BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
 
+int    shstobf16_k (BLASLONG, float *, BLASLONG, bfloat16 *, BLASLONG);
+int    shbf16tos_k (BLASLONG, bfloat16 *, BLASLONG, float *, BLASLONG);
+
 
 #ifdef __CUDACC__
 }
@@ -76,6 +76,8 @@ int xger_thread_C(BLASLONG, BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *,
 int xger_thread_V(BLASLONG, BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
 int xger_thread_D(BLASLONG, BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
 
+int shgemv_n(BLASLONG, BLASLONG, float, bfloat16 *, BLASLONG, bfloat16 *, BLASLONG, float, float *, BLASLONG);
+int shgemv_t(BLASLONG, BLASLONG, float, bfloat16 *, BLASLONG, bfloat16 *, BLASLONG, float, float *, BLASLONG);
 int sgemv_n(BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *buffer);
 int sgemv_t(BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *buffer);
 int dgemv_n(BLASLONG, BLASLONG, BLASLONG, double, double *, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *buffer);
@@ -378,6 +380,84 @@ int xtrmv_thread_CUN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble
 int xtrmv_thread_CLU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
 int xtrmv_thread_CLN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
 
+int strsv_thread_NUU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int strsv_thread_NUN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int strsv_thread_NLU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int strsv_thread_NLN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int strsv_thread_TUU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int strsv_thread_TUN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int strsv_thread_TLU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int strsv_thread_TLN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+
+int dtrsv_thread_NUU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtrsv_thread_NUN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtrsv_thread_NLU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtrsv_thread_NLN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtrsv_thread_TUU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtrsv_thread_TUN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtrsv_thread_TLU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtrsv_thread_TLN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+
+int qtrsv_thread_NUU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtrsv_thread_NUN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtrsv_thread_NLU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtrsv_thread_NLN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtrsv_thread_TUU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtrsv_thread_TUN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtrsv_thread_TLU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtrsv_thread_TLN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+
+int ctrsv_thread_NUU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_NUN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_NLU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_NLN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_TUU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_TUN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_TLU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_TLN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_RUU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_RUN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_RLU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_RLN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_CUU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_CUN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_CLU(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctrsv_thread_CLN(BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+
+int ztrsv_thread_NUU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_NUN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_NLU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_NLN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_TUU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_TUN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_TLU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_TLN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_RUU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_RUN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_RLU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_RLN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_CUU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_CUN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_CLU(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztrsv_thread_CLN(BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+
+int xtrsv_thread_NUU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_NUN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_NLU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_NLN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_TUU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_TUN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_TLU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_TLN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_RUU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_RUN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_RLU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_RLN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_CUU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_CUN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_CLU(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtrsv_thread_CLN(BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+
 int stpsv_NUU(BLASLONG, float *, float *, BLASLONG, void *);
 int stpsv_NUN(BLASLONG, float *, float *, BLASLONG, void *);
 int stpsv_NLU(BLASLONG, float *, float *, BLASLONG, void *);
@@ -612,6 +692,84 @@ int xtpmv_thread_CUN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
 int xtpmv_thread_CLU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
 int xtpmv_thread_CLN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
 
+int stpsv_thread_NUU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int stpsv_thread_NUN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int stpsv_thread_NLU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int stpsv_thread_NLN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int stpsv_thread_TUU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int stpsv_thread_TUN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int stpsv_thread_TLU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int stpsv_thread_TLN(BLASLONG, float *, float *, BLASLONG, float *, int);
+
+int dtpsv_thread_NUU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int dtpsv_thread_NUN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int dtpsv_thread_NLU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int dtpsv_thread_NLN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int dtpsv_thread_TUU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int dtpsv_thread_TUN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int dtpsv_thread_TLU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int dtpsv_thread_TLN(BLASLONG, double *, double *, BLASLONG, double *, int);
+
+int qtpsv_thread_NUU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int qtpsv_thread_NUN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int qtpsv_thread_NLU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int qtpsv_thread_NLN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int qtpsv_thread_TUU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int qtpsv_thread_TUN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int qtpsv_thread_TLU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int qtpsv_thread_TLN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+
+int ctpsv_thread_NUU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_NUN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_NLU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_NLN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_TUU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_TUN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_TLU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_TLN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_RUU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_RUN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_RLU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_RLN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_CUU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_CUN(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_CLU(BLASLONG, float *, float *, BLASLONG, float *, int);
+int ctpsv_thread_CLN(BLASLONG, float *, float *, BLASLONG, float *, int);
+
+int ztpsv_thread_NUU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_NUN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_NLU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_NLN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_TUU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_TUN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_TLU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_TLN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_RUU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_RUN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_RLU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_RLN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_CUU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_CUN(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_CLU(BLASLONG, double *, double *, BLASLONG, double *, int);
+int ztpsv_thread_CLN(BLASLONG, double *, double *, BLASLONG, double *, int);
+
+int xtpsv_thread_NUU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_NUN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_NLU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_NLN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_TUU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_TUN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_TLU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_TLN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_RUU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_RUN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_RLU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_RLN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_CUU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_CUN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_CLU(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+int xtpsv_thread_CLN(BLASLONG, xdouble *, xdouble *, BLASLONG, xdouble *, int);
+
 int ssymv_L(BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *);
 int ssymv_U(BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *);
 int dsymv_L(BLASLONG, BLASLONG, double, double *, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *);
@@ -1274,6 +1432,84 @@ int xtbmv_thread_CUN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLON
 int xtbmv_thread_CLU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
 int xtbmv_thread_CLN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
 
+int stbsv_thread_NUU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int stbsv_thread_NUN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int stbsv_thread_NLU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int stbsv_thread_NLN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int stbsv_thread_TUU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int stbsv_thread_TUN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int stbsv_thread_TLU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int stbsv_thread_TLN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+
+int dtbsv_thread_NUU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtbsv_thread_NUN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtbsv_thread_NLU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtbsv_thread_NLN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtbsv_thread_TUU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtbsv_thread_TUN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtbsv_thread_TLU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int dtbsv_thread_TLN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+
+int qtbsv_thread_NUU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtbsv_thread_NUN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtbsv_thread_NLU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtbsv_thread_NLN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtbsv_thread_TUU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtbsv_thread_TUN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtbsv_thread_TLU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int qtbsv_thread_TLN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+
+int ctbsv_thread_NUU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_NUN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_NLU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_NLN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_TUU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_TUN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_TLU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_TLN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_RUU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_RUN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_RLU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_RLN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_CUU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_CUN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_CLU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+int ctbsv_thread_CLN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *, int);
+
+int ztbsv_thread_NUU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_NUN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_NLU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_NLN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_TUU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_TUN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_TLU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_TLN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_RUU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_RUN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_RLU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_RLN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_CUU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_CUN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_CLU(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+int ztbsv_thread_CLN(BLASLONG, BLASLONG, double *, BLASLONG, double *, BLASLONG, double *, int);
+
+int xtbsv_thread_NUU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_NUN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_NLU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_NLN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_TUU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_TUN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_TLU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_TLN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_RUU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_RUN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_RLU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_RLN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_CUU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_CUN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_CLU(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+int xtbsv_thread_CLN(BLASLONG, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, int);
+
 int stbsv_NUU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, void *);
 int stbsv_NUN(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, void *);
 int stbsv_NLU(BLASLONG, BLASLONG, float *, BLASLONG, float *, BLASLONG, void *);
@@ -709,6 +709,103 @@ int xgemm_thread_ct(blas_arg_t *, BLASLONG *, BLASLONG *, xdouble *, xdouble *,
 int xgemm_thread_cr(blas_arg_t *, BLASLONG *, BLASLONG *, xdouble *, xdouble *, BLASLONG);
 int xgemm_thread_cc(blas_arg_t *, BLASLONG *, BLASLONG *, xdouble *, xdouble *, BLASLONG);
 
+int sgemm_batch_thread(blas_arg_t *, BLASLONG);
+int dgemm_batch_thread(blas_arg_t *, BLASLONG);
+int cgemm_batch_thread(blas_arg_t *, BLASLONG);
+int zgemm_batch_thread(blas_arg_t *, BLASLONG);
+
+int sgemm_pack_an(blas_arg_t *);
+int sgemm_pack_at(blas_arg_t *);
+int sgemm_pack_bn(blas_arg_t *);
+int sgemm_pack_bt(blas_arg_t *);
+
+int dgemm_pack_an(blas_arg_t *);
+int dgemm_pack_at(blas_arg_t *);
+int dgemm_pack_bn(blas_arg_t *);
+int dgemm_pack_bt(blas_arg_t *);
+
+int sgemm_compute_pn(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemm_compute_pt(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemm_compute_np(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemm_compute_tp(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemm_compute_pp(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+
+int dgemm_compute_pn(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemm_compute_pt(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemm_compute_np(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemm_compute_tp(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemm_compute_pp(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+
+int sgemmt_UNN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemmt_UNT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemmt_UTN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemmt_UTT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemmt_LNN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemmt_LNT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemmt_LTN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int sgemmt_LTT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+
+int dgemmt_UNN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemmt_UNT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemmt_UTN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemmt_UTT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemmt_LNN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemmt_LNT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemmt_LTN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int dgemmt_LTT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+
+int cgemmt_UNN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UNT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UNC(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UTN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UTT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UTC(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UCN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UCT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_UCC(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LNN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LNT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LNC(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LTN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LTT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LTC(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LCN(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LCT(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+int cgemmt_LCC(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
+
+int zgemmt_UNN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UNT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UNC(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UTN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UTT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UTC(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UCN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UCT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_UCC(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LNN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LNT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LNC(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LTN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LTT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LTC(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LCN(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LCT(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+int zgemmt_LCC(blas_arg_t *, BLASLONG *, BLASLONG *, double *, double *, BLASLONG);
+
+int cgemmt_kernel_UL(BLASLONG m, BLASLONG n, BLASLONG k, float alpha_r, float alpha_i, float *a, float *b, float *c, BLASLONG ldc, BLASLONG offset);
+int cgemmt_kernel_UR(BLASLONG m, BLASLONG n, BLASLONG k, float alpha_r, float alpha_i, float *a, float *b, float *c, BLASLONG ldc, BLASLONG offset);
+int cgemmt_kernel_UB(BLASLONG m, BLASLONG n, BLASLONG k, float alpha_r, float alpha_i, float *a, float *b, float *c, BLASLONG ldc, BLASLONG offset);
+int cgemmt_kernel_LL(BLASLONG m, BLASLONG n, BLASLONG k, float alpha_r, float alpha_i, float *a, float *b, float *c, BLASLONG ldc, BLASLONG offset);
+int cgemmt_kernel_LR(BLASLONG m, BLASLONG n, BLASLONG k, float alpha_r, float alpha_i, float *a, float *b, float *c, BLASLONG ldc, BLASLONG offset);
+int cgemmt_kernel_LB(BLASLONG m, BLASLONG n, BLASLONG k, float alpha_r, float alpha_i, float *a, float *b, float *c, BLASLONG ldc, BLASLONG offset);
+
+int zgemmt_kernel_UL(BLASLONG m, BLASLONG n, BLASLONG k, double alpha_r, double alpha_i, double *a, double *b, double *c, BLASLONG ldc, BLASLONG offset);
+int zgemmt_kernel_UR(BLASLONG m, BLASLONG n, BLASLONG k, double alpha_r, double alpha_i, double *a, double *b, double *c, BLASLONG ldc, BLASLONG offset);
+int zgemmt_kernel_UB(BLASLONG m, BLASLONG n, BLASLONG k, double alpha_r, double alpha_i, double *a, double *b, double *c, BLASLONG ldc, BLASLONG offset);
+int zgemmt_kernel_LL(BLASLONG m, BLASLONG n, BLASLONG k, double alpha_r, double alpha_i, double *a, double *b, double *c, BLASLONG ldc, BLASLONG offset);
+int zgemmt_kernel_LR(BLASLONG m, BLASLONG n, BLASLONG k, double alpha_r, double alpha_i, double *a, double *b, double *c, BLASLONG ldc, BLASLONG offset);
+int zgemmt_kernel_LB(BLASLONG m, BLASLONG n, BLASLONG k, double alpha_r, double alpha_i, double *a, double *b, double *c, BLASLONG ldc, BLASLONG offset);
+
 int cgemm3m_nn(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
 int cgemm3m_nt(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
 int cgemm3m_nr(blas_arg_t *, BLASLONG *, BLASLONG *, float *, float *, BLASLONG);
@@ -1816,6 +1913,96 @@ int dgeadd_k(BLASLONG, BLASLONG, double, double*, BLASLONG, double, double *, BL
 int cgeadd_k(BLASLONG, BLASLONG, float, float, float*, BLASLONG, float, float, float *, BLASLONG); 
 int zgeadd_k(BLASLONG, BLASLONG, double,double, double*, BLASLONG, double, double, double *, BLASLONG); 
 
+#ifdef SMALL_MATRIX_OPT
+int sgemm_small_matrix_permit(int, int, BLASLONG, BLASLONG, BLASLONG, float, float);
+int sgemm_small_kernel_nn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+int sgemm_small_kernel_tn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+int sgemm_small_kernel_nt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+int sgemm_small_kernel_tt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+int sgemm_small_kernel_b0_nn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+int sgemm_small_kernel_b0_tn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+int sgemm_small_kernel_b0_nt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+int sgemm_small_kernel_b0_tt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+
+int dgemm_small_matrix_permit(int, int, BLASLONG, BLASLONG, BLASLONG, double, double);
+int dgemm_small_kernel_nn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+int dgemm_small_kernel_tn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+int dgemm_small_kernel_nt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+int dgemm_small_kernel_tt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+int dgemm_small_kernel_b0_nn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+int dgemm_small_kernel_b0_tn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+int dgemm_small_kernel_b0_nt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+int dgemm_small_kernel_b0_tt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+
+int cgemm_small_matrix_permit(int, int, BLASLONG, BLASLONG, BLASLONG, float, float, float, float);
+int cgemm_small_kernel_nn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_tn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_rn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_cn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_nt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_tt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_rt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_ct(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_nr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_tr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_rr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_cr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_nc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_tc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_rc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_cc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+int cgemm_small_kernel_b0_nn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_tn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_rn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_cn(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_nt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_tt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_rt(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_ct(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_nr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_tr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_rr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_cr(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_nc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_tc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_rc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+int cgemm_small_kernel_b0_cc(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+
+int zgemm_small_matrix_permit(int, int, BLASLONG, BLASLONG, BLASLONG, double, double, double, double);
+int zgemm_small_kernel_nn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_tn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_rn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_cn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_nt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_tt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_rt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_ct(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_nr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_tr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_rr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_cr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_nc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_tc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_rc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_cc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+int zgemm_small_kernel_b0_nn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_tn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_rn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_cn(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_nt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_tt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_rt(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_ct(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_nr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_tr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_rr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_cr(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_nc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_tc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_rc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+int zgemm_small_kernel_b0_cc(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+#endif
+
 
 #ifdef __CUDACC__
 }
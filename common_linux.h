@@ -53,6 +53,10 @@ extern long int syscall (long int __sysno, ...);
 #define MPOL_INTERLEAVE 3
 #endif
 
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE (1 << 1)
+#endif
+
 #if defined(ARCH_IA64) && defined(__ECC)
 #ifndef __NR_mbind
 #define __NR_mbind			1259
@@ -99,6 +103,33 @@ static inline int my_set_mempolicy(int mode, const unsigned long *addr, unsigned
 #endif
 }
 
+#ifdef SYS_futex
+#ifndef FUTEX_WAIT_PRIVATE
+#define FUTEX_WAIT_PRIVATE		128
+#endif
+#ifndef FUTEX_WAKE_PRIVATE
+#define FUTEX_WAKE_PRIVATE		129
+#endif
+
+static inline int my_futex_wait(volatile int *addr, int val) {
+  return syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, NULL, NULL, 0);
+}
+
+static inline int my_futex_wake(volatile int *addr, int count) {
+  return syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, count, NULL, NULL, 0);
+}
+#endif
+
+/* NUMA node of the cpu the caller is running on, or 0 if unknown */
+static inline int my_getcpu_node(void) {
+#if defined(SYS_getcpu) && !defined(__LSB_VERSION__)
+  unsigned int cpu, node;
+
+  if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0) return node;
+#endif
+  return 0;
+}
+
 static inline int my_gettid(void) {
 #ifdef SYS_gettid
 return syscall(SYS_gettid);
@@ -70,6 +70,7 @@
 #define	SUM_K			QSUM_K
 #define	SWAP_K			QSWAP_K
 #define	ROT_K			QROT_K
+#define	ROTM_K			QROTM_K
 
 #define	GEMV_N			QGEMV_N
 #define	GEMV_T			QGEMV_T
@@ -361,6 +362,8 @@
 #define	SUM_K			DSUM_K
 #define	SWAP_K			DSWAP_K
 #define	ROT_K			DROT_K
+#define	ROTM_K			DROTM_K
+#define	ROTSEQ_K		DROTSEQ_K
 
 #define	GEMV_N			DGEMV_N
 #define	GEMV_T			DGEMV_T
@@ -603,6 +606,27 @@
 #define	GEMM_THREAD_RC		DGEMM_THREAD_NT
 #define	GEMM_THREAD_RR		DGEMM_THREAD_NN
 
+#define	GEMM_BATCH_THREAD	DGEMM_BATCH_THREAD
+
+#define	GEMM_PACK_AN		DGEMM_PACK_AN
+#define	GEMM_PACK_AT		DGEMM_PACK_AT
+#define	GEMM_PACK_BN		DGEMM_PACK_BN
+#define	GEMM_PACK_BT		DGEMM_PACK_BT
+#define	GEMM_COMPUTE_PN	DGEMM_COMPUTE_PN
+#define	GEMM_COMPUTE_PT	DGEMM_COMPUTE_PT
+#define	GEMM_COMPUTE_NP	DGEMM_COMPUTE_NP
+#define	GEMM_COMPUTE_TP	DGEMM_COMPUTE_TP
+#define	GEMM_COMPUTE_PP	DGEMM_COMPUTE_PP
+
+#define	GEMMT_UNN		DGEMMT_UNN
+#define	GEMMT_UNT		DGEMMT_UNT
+#define	GEMMT_UTN		DGEMMT_UTN
+#define	GEMMT_UTT		DGEMMT_UTT
+#define	GEMMT_LNN		DGEMMT_LNN
+#define	GEMMT_LNT		DGEMMT_LNT
+#define	GEMMT_LTN		DGEMMT_LTN
+#define	GEMMT_LTT		DGEMMT_LTT
+
 #define	SYMM_THREAD_LU		DSYMM_THREAD_LU
 #define	SYMM_THREAD_LL		DSYMM_THREAD_LL
 #define	SYMM_THREAD_RU		DSYMM_THREAD_RU
@@ -644,6 +668,18 @@
 
 #define GEADD_K                 DGEADD_K
 
+#ifdef SMALL_MATRIX_OPT
+#define GEMM_SMALL_MATRIX_PERMIT	DGEMM_SMALL_MATRIX_PERMIT
+#define GEMM_SMALL_KERNEL_NN	DGEMM_SMALL_KERNEL_NN
+#define GEMM_SMALL_KERNEL_TN	DGEMM_SMALL_KERNEL_TN
+#define GEMM_SMALL_KERNEL_NT	DGEMM_SMALL_KERNEL_NT
+#define GEMM_SMALL_KERNEL_TT	DGEMM_SMALL_KERNEL_TT
+#define GEMM_SMALL_KERNEL_B0_NN	DGEMM_SMALL_KERNEL_B0_NN
+#define GEMM_SMALL_KERNEL_B0_TN	DGEMM_SMALL_KERNEL_B0_TN
+#define GEMM_SMALL_KERNEL_B0_NT	DGEMM_SMALL_KERNEL_B0_NT
+#define GEMM_SMALL_KERNEL_B0_TT	DGEMM_SMALL_KERNEL_B0_TT
+#endif
+
 #elif defined(HALF)
 
 #define	AMAX_K			SAMAX_K
@@ -672,6 +708,8 @@
 #define	SUM_K			SSUM_K
 #define	SWAP_K			SSWAP_K
 #define	ROT_K			SROT_K
+#define	ROTM_K			SROTM_K
+#define	ROTSEQ_K		SROTSEQ_K
 #define COPY_K    SCOPY_K
 #define NRM2_K    SNRM2_K
 #define SYMV_THREAD_U		SSYMV_THREAD_U
@@ -946,6 +984,8 @@
 #define	SUM_K			SSUM_K
 #define	SWAP_K			SSWAP_K
 #define	ROT_K			SROT_K
+#define	ROTM_K			SROTM_K
+#define	ROTSEQ_K		SROTSEQ_K
 
 #define	GEMV_N			SGEMV_N
 #define	GEMV_T			SGEMV_T
@@ -1188,6 +1228,27 @@
 #define	GEMM_THREAD_RC		SGEMM_THREAD_NT
 #define	GEMM_THREAD_RR		SGEMM_THREAD_NN
 
+#define	GEMM_BATCH_THREAD	SGEMM_BATCH_THREAD
+
+#define	GEMM_PACK_AN		SGEMM_PACK_AN
+#define	GEMM_PACK_AT		SGEMM_PACK_AT
+#define	GEMM_PACK_BN		SGEMM_PACK_BN
+#define	GEMM_PACK_BT		SGEMM_PACK_BT
+#define	GEMM_COMPUTE_PN	SGEMM_COMPUTE_PN
+#define	GEMM_COMPUTE_PT	SGEMM_COMPUTE_PT
+#define	GEMM_COMPUTE_NP	SGEMM_COMPUTE_NP
+#define	GEMM_COMPUTE_TP	SGEMM_COMPUTE_TP
+#define	GEMM_COMPUTE_PP	SGEMM_COMPUTE_PP
+
+#define	GEMMT_UNN		SGEMMT_UNN
+#define	GEMMT_UNT		SGEMMT_UNT
+#define	GEMMT_UTN		SGEMMT_UTN
+#define	GEMMT_UTT		SGEMMT_UTT
+#define	GEMMT_LNN		SGEMMT_LNN
+#define	GEMMT_LNT		SGEMMT_LNT
+#define	GEMMT_LTN		SGEMMT_LTN
+#define	GEMMT_LTT		SGEMMT_LTT
+
 #define	SYMM_THREAD_LU		SSYMM_THREAD_LU
 #define	SYMM_THREAD_LL		SSYMM_THREAD_LL
 #define	SYMM_THREAD_RU		SSYMM_THREAD_RU
@@ -1228,6 +1289,18 @@
 #define IMATCOPY_K_RT		SIMATCOPY_K_RT
 
 #define GEADD_K 		SGEADD_K
+
+#ifdef SMALL_MATRIX_OPT
+#define GEMM_SMALL_MATRIX_PERMIT	SGEMM_SMALL_MATRIX_PERMIT
+#define GEMM_SMALL_KERNEL_NN	SGEMM_SMALL_KERNEL_NN
+#define GEMM_SMALL_KERNEL_TN	SGEMM_SMALL_KERNEL_TN
+#define GEMM_SMALL_KERNEL_NT	SGEMM_SMALL_KERNEL_NT
+#define GEMM_SMALL_KERNEL_TT	SGEMM_SMALL_KERNEL_TT
+#define GEMM_SMALL_KERNEL_B0_NN	SGEMM_SMALL_KERNEL_B0_NN
+#define GEMM_SMALL_KERNEL_B0_TN	SGEMM_SMALL_KERNEL_B0_TN
+#define GEMM_SMALL_KERNEL_B0_NT	SGEMM_SMALL_KERNEL_B0_NT
+#define GEMM_SMALL_KERNEL_B0_TT	SGEMM_SMALL_KERNEL_B0_TT
+#endif
 #endif
 #else
 #ifdef XDOUBLE
@@ -1947,6 +2020,33 @@
 #define	GEMM_THREAD_RC		ZGEMM_THREAD_RC
 #define	GEMM_THREAD_RR		ZGEMM_THREAD_RR
 
+#define	GEMM_BATCH_THREAD	ZGEMM_BATCH_THREAD
+
+#define	GEMMT_UNN		ZGEMMT_UNN
+#define	GEMMT_UNT		ZGEMMT_UNT
+#define	GEMMT_UNC		ZGEMMT_UNC
+#define	GEMMT_UTN		ZGEMMT_UTN
+#define	GEMMT_UTT		ZGEMMT_UTT
+#define	GEMMT_UTC		ZGEMMT_UTC
+#define	GEMMT_UCN		ZGEMMT_UCN
+#define	GEMMT_UCT		ZGEMMT_UCT
+#define	GEMMT_UCC		ZGEMMT_UCC
+#define	GEMMT_LNN		ZGEMMT_LNN
+#define	GEMMT_LNT		ZGEMMT_LNT
+#define	GEMMT_LNC		ZGEMMT_LNC
+#define	GEMMT_LTN		ZGEMMT_LTN
+#define	GEMMT_LTT		ZGEMMT_LTT
+#define	GEMMT_LTC		ZGEMMT_LTC
+#define	GEMMT_LCN		ZGEMMT_LCN
+#define	GEMMT_LCT		ZGEMMT_LCT
+#define	GEMMT_LCC		ZGEMMT_LCC
+#define	GEMMT_KERNEL_UL	ZGEMMT_KERNEL_UL
+#define	GEMMT_KERNEL_UR	ZGEMMT_KERNEL_UR
+#define	GEMMT_KERNEL_UB	ZGEMMT_KERNEL_UB
+#define	GEMMT_KERNEL_LL	ZGEMMT_KERNEL_LL
+#define	GEMMT_KERNEL_LR	ZGEMMT_KERNEL_LR
+#define	GEMMT_KERNEL_LB	ZGEMMT_KERNEL_LB
+
 #define	SYMM_THREAD_LU		ZSYMM_THREAD_LU
 #define	SYMM_THREAD_LL		ZSYMM_THREAD_LL
 #define	SYMM_THREAD_RU		ZSYMM_THREAD_RU
@@ -2055,6 +2155,42 @@
 
 #define GEADD_K                 ZGEADD_K
 
+#ifdef SMALL_MATRIX_OPT
+#define GEMM_SMALL_MATRIX_PERMIT	ZGEMM_SMALL_MATRIX_PERMIT
+#define GEMM_SMALL_KERNEL_NN	ZGEMM_SMALL_KERNEL_NN
+#define GEMM_SMALL_KERNEL_TN	ZGEMM_SMALL_KERNEL_TN
+#define GEMM_SMALL_KERNEL_RN	ZGEMM_SMALL_KERNEL_RN
+#define GEMM_SMALL_KERNEL_CN	ZGEMM_SMALL_KERNEL_CN
+#define GEMM_SMALL_KERNEL_NT	ZGEMM_SMALL_KERNEL_NT
+#define GEMM_SMALL_KERNEL_TT	ZGEMM_SMALL_KERNEL_TT
+#define GEMM_SMALL_KERNEL_RT	ZGEMM_SMALL_KERNEL_RT
+#define GEMM_SMALL_KERNEL_CT	ZGEMM_SMALL_KERNEL_CT
+#define GEMM_SMALL_KERNEL_NR	ZGEMM_SMALL_KERNEL_NR
+#define GEMM_SMALL_KERNEL_TR	ZGEMM_SMALL_KERNEL_TR
+#define GEMM_SMALL_KERNEL_RR	ZGEMM_SMALL_KERNEL_RR
+#define GEMM_SMALL_KERNEL_CR	ZGEMM_SMALL_KERNEL_CR
+#define GEMM_SMALL_KERNEL_NC	ZGEMM_SMALL_KERNEL_NC
+#define GEMM_SMALL_KERNEL_TC	ZGEMM_SMALL_KERNEL_TC
+#define GEMM_SMALL_KERNEL_RC	ZGEMM_SMALL_KERNEL_RC
+#define GEMM_SMALL_KERNEL_CC	ZGEMM_SMALL_KERNEL_CC
+#define GEMM_SMALL_KERNEL_B0_NN	ZGEMM_SMALL_KERNEL_B0_NN
+#define GEMM_SMALL_KERNEL_B0_TN	ZGEMM_SMALL_KERNEL_B0_TN
+#define GEMM_SMALL_KERNEL_B0_RN	ZGEMM_SMALL_KERNEL_B0_RN
+#define GEMM_SMALL_KERNEL_B0_CN	ZGEMM_SMALL_KERNEL_B0_CN
+#define GEMM_SMALL_KERNEL_B0_NT	ZGEMM_SMALL_KERNEL_B0_NT
+#define GEMM_SMALL_KERNEL_B0_TT	ZGEMM_SMALL_KERNEL_B0_TT
+#define GEMM_SMALL_KERNEL_B0_RT	ZGEMM_SMALL_KERNEL_B0_RT
+#define GEMM_SMALL_KERNEL_B0_CT	ZGEMM_SMALL_KERNEL_B0_CT
+#define GEMM_SMALL_KERNEL_B0_NR	ZGEMM_SMALL_KERNEL_B0_NR
+#define GEMM_SMALL_KERNEL_B0_TR	ZGEMM_SMALL_KERNEL_B0_TR
+#define GEMM_SMALL_KERNEL_B0_RR	ZGEMM_SMALL_KERNEL_B0_RR
+#define GEMM_SMALL_KERNEL_B0_CR	ZGEMM_SMALL_KERNEL_B0_CR
+#define GEMM_SMALL_KERNEL_B0_NC	ZGEMM_SMALL_KERNEL_B0_NC
+#define GEMM_SMALL_KERNEL_B0_TC	ZGEMM_SMALL_KERNEL_B0_TC
+#define GEMM_SMALL_KERNEL_B0_RC	ZGEMM_SMALL_KERNEL_B0_RC
+#define GEMM_SMALL_KERNEL_B0_CC	ZGEMM_SMALL_KERNEL_B0_CC
+#endif
+
 #else
 
 #define	AMAX_K			CAMAX_K
@@ -2370,6 +2506,33 @@
 #define	GEMM_THREAD_RC		CGEMM_THREAD_RC
 #define	GEMM_THREAD_RR		CGEMM_THREAD_RR
 
+#define	GEMM_BATCH_THREAD	CGEMM_BATCH_THREAD
+
+#define	GEMMT_UNN		CGEMMT_UNN
+#define	GEMMT_UNT		CGEMMT_UNT
+#define	GEMMT_UNC		CGEMMT_UNC
+#define	GEMMT_UTN		CGEMMT_UTN
+#define	GEMMT_UTT		CGEMMT_UTT
+#define	GEMMT_UTC		CGEMMT_UTC
+#define	GEMMT_UCN		CGEMMT_UCN
+#define	GEMMT_UCT		CGEMMT_UCT
+#define	GEMMT_UCC		CGEMMT_UCC
+#define	GEMMT_LNN		CGEMMT_LNN
+#define	GEMMT_LNT		CGEMMT_LNT
+#define	GEMMT_LNC		CGEMMT_LNC
+#define	GEMMT_LTN		CGEMMT_LTN
+#define	GEMMT_LTT		CGEMMT_LTT
+#define	GEMMT_LTC		CGEMMT_LTC
+#define	GEMMT_LCN		CGEMMT_LCN
+#define	GEMMT_LCT		CGEMMT_LCT
+#define	GEMMT_LCC		CGEMMT_LCC
+#define	GEMMT_KERNEL_UL	CGEMMT_KERNEL_UL
+#define	GEMMT_KERNEL_UR	CGEMMT_KERNEL_UR
+#define	GEMMT_KERNEL_UB	CGEMMT_KERNEL_UB
+#define	GEMMT_KERNEL_LL	CGEMMT_KERNEL_LL
+#define	GEMMT_KERNEL_LR	CGEMMT_KERNEL_LR
+#define	GEMMT_KERNEL_LB	CGEMMT_KERNEL_LB
+
 #define	SYMM_THREAD_LU		CSYMM_THREAD_LU
 #define	SYMM_THREAD_LL		CSYMM_THREAD_LL
 #define	SYMM_THREAD_RU		CSYMM_THREAD_RU
@@ -2478,6 +2641,42 @@
 
 #define GEADD_K                 CGEADD_K
 
+#ifdef SMALL_MATRIX_OPT
+#define GEMM_SMALL_MATRIX_PERMIT	CGEMM_SMALL_MATRIX_PERMIT
+#define GEMM_SMALL_KERNEL_NN	CGEMM_SMALL_KERNEL_NN
+#define GEMM_SMALL_KERNEL_TN	CGEMM_SMALL_KERNEL_TN
+#define GEMM_SMALL_KERNEL_RN	CGEMM_SMALL_KERNEL_RN
+#define GEMM_SMALL_KERNEL_CN	CGEMM_SMALL_KERNEL_CN
+#define GEMM_SMALL_KERNEL_NT	CGEMM_SMALL_KERNEL_NT
+#define GEMM_SMALL_KERNEL_TT	CGEMM_SMALL_KERNEL_TT
+#define GEMM_SMALL_KERNEL_RT	CGEMM_SMALL_KERNEL_RT
+#define GEMM_SMALL_KERNEL_CT	CGEMM_SMALL_KERNEL_CT
+#define GEMM_SMALL_KERNEL_NR	CGEMM_SMALL_KERNEL_NR
+#define GEMM_SMALL_KERNEL_TR	CGEMM_SMALL_KERNEL_TR
+#define GEMM_SMALL_KERNEL_RR	CGEMM_SMALL_KERNEL_RR
+#define GEMM_SMALL_KERNEL_CR	CGEMM_SMALL_KERNEL_CR
+#define GEMM_SMALL_KERNEL_NC	CGEMM_SMALL_KERNEL_NC
+#define GEMM_SMALL_KERNEL_TC	CGEMM_SMALL_KERNEL_TC
+#define GEMM_SMALL_KERNEL_RC	CGEMM_SMALL_KERNEL_RC
+#define GEMM_SMALL_KERNEL_CC	CGEMM_SMALL_KERNEL_CC
+#define GEMM_SMALL_KERNEL_B0_NN	CGEMM_SMALL_KERNEL_B0_NN
+#define GEMM_SMALL_KERNEL_B0_TN	CGEMM_SMALL_KERNEL_B0_TN
+#define GEMM_SMALL_KERNEL_B0_RN	CGEMM_SMALL_KERNEL_B0_RN
+#define GEMM_SMALL_KERNEL_B0_CN	CGEMM_SMALL_KERNEL_B0_CN
+#define GEMM_SMALL_KERNEL_B0_NT	CGEMM_SMALL_KERNEL_B0_NT
+#define GEMM_SMALL_KERNEL_B0_TT	CGEMM_SMALL_KERNEL_B0_TT
+#define GEMM_SMALL_KERNEL_B0_RT	CGEMM_SMALL_KERNEL_B0_RT
+#define GEMM_SMALL_KERNEL_B0_CT	CGEMM_SMALL_KERNEL_B0_CT
+#define GEMM_SMALL_KERNEL_B0_NR	CGEMM_SMALL_KERNEL_B0_NR
+#define GEMM_SMALL_KERNEL_B0_TR	CGEMM_SMALL_KERNEL_B0_TR
+#define GEMM_SMALL_KERNEL_B0_RR	CGEMM_SMALL_KERNEL_B0_RR
+#define GEMM_SMALL_KERNEL_B0_CR	CGEMM_SMALL_KERNEL_B0_CR
+#define GEMM_SMALL_KERNEL_B0_NC	CGEMM_SMALL_KERNEL_B0_NC
+#define GEMM_SMALL_KERNEL_B0_TC	CGEMM_SMALL_KERNEL_B0_TC
+#define GEMM_SMALL_KERNEL_B0_RC	CGEMM_SMALL_KERNEL_B0_RC
+#define GEMM_SMALL_KERNEL_B0_CC	CGEMM_SMALL_KERNEL_B0_CC
+#endif
+
 #endif
 #endif
 
@@ -2525,7 +2724,30 @@ typedef struct {
   BLASLONG prea, preb, prec, pred;
 #endif
 
+  /* per-entry routine for the batch GEMM driver */
+  void *routine;
+  int routine_mode;
+
 } blas_arg_t;
+
+/* routine_mode values: level3 driver (0) or small matrix kernel */
+#define BLAS_SMALL_OPT		0x10000U
+#define BLAS_SMALL_B0_OPT	0x30000U
+
+/* header of a ?gemm_pack buffer; the packed panels follow, aligned */
+typedef struct {
+  BLASLONG identifier;		/* 0 : A operand, 1 : B operand */
+  BLASLONG dim, k;		/* m (A) or n (B), and k */
+  BLASLONG q, unroll_m, unroll_n;	/* blocking the panels were packed with */
+} gemm_pack_t;
+
+#define GEMM_PACK_ALIGN		64
+#define GEMM_PACK_DATA(handle)	((FLOAT *)(((BLASULONG)(handle) + sizeof(gemm_pack_t) + GEMM_PACK_ALIGN - 1) \
+					   & ~(BLASULONG)(GEMM_PACK_ALIGN - 1)))
+
+/* k blocking shared by ?gemm_pack and ?gemm_compute, as in level3.c */
+#define GEMM_PACK_MIN_L(rest)	((rest) >= GEMM_Q * 2 ? GEMM_Q : \
+				 (rest) > GEMM_Q ? (((rest) / 2 + GEMM_UNROLL_M - 1) / GEMM_UNROLL_M) * GEMM_UNROLL_M : (rest))
 #endif
 
 #ifdef XDOUBLE
@@ -2843,6 +3065,31 @@ typedef struct {
 #define GETRS_T		DGETRS_T
 #define GETRF_SINGLE	dgetrf_single
 #define GETRF_PARALLEL	dgetrf_parallel
+#define LARFT_K	dlarft_k
+#define LARFB_LN	dlarfb_LN
+#define LARFB_LT	dlarfb_LT
+#define LARFB_RN	dlarfb_RN
+#define LARFB_RT	dlarfb_RT
+#define GEQRF_PANEL	dgeqrf_panel
+#define GEQRF_SINGLE	dgeqrf_single
+#define GEQRF_PARALLEL	dgeqrf_parallel
+#define ORMQR_LN	dormqr_LN
+#define ORMQR_LT	dormqr_LT
+#define ORMQR_RN	dormqr_RN
+#define ORMQR_RT	dormqr_RT
+#define SY2SB		dsy2sb
+#define SB2ST		dsb2st
+#define SB2ST_BACK	dsb2st_back
+#define SYTRF_PANEL_L	dsytrf_panel_L
+#define SYTRF_PANEL_U	dsytrf_panel_U
+#define SYTRF_L_SINGLE	dsytrf_L_single
+#define SYTRF_U_SINGLE	dsytrf_U_single
+#define SYTRF_L_PARALLEL	dsytrf_L_parallel
+#define SYTRF_U_PARALLEL	dsytrf_U_parallel
+#define SYTRS_L_SINGLE	dsytrs_L_single
+#define SYTRS_U_SINGLE	dsytrs_U_single
+#define SYTRS_L_PARALLEL	dsytrs_L_parallel
+#define SYTRS_U_PARALLEL	dsytrs_U_parallel
 #define NEG_TCOPY	DNEG_TCOPY
 #define	LARF_L		DLARF_L
 #define	LARF_R		DLARF_R
@@ -2864,6 +3111,31 @@ typedef struct {
 #define GETRS_T		SGETRS_T
 #define GETRF_SINGLE	sgetrf_single
 #define GETRF_PARALLEL	sgetrf_parallel
+#define LARFT_K	slarft_k
+#define LARFB_LN	slarfb_LN
+#define LARFB_LT	slarfb_LT
+#define LARFB_RN	slarfb_RN
+#define LARFB_RT	slarfb_RT
+#define GEQRF_PANEL	sgeqrf_panel
+#define GEQRF_SINGLE	sgeqrf_single
+#define GEQRF_PARALLEL	sgeqrf_parallel
+#define ORMQR_LN	sormqr_LN
+#define ORMQR_LT	sormqr_LT
+#define ORMQR_RN	sormqr_RN
+#define ORMQR_RT	sormqr_RT
+#define SY2SB		ssy2sb
+#define SB2ST		ssb2st
+#define SB2ST_BACK	ssb2st_back
+#define SYTRF_PANEL_L	ssytrf_panel_L
+#define SYTRF_PANEL_U	ssytrf_panel_U
+#define SYTRF_L_SINGLE	ssytrf_L_single
+#define SYTRF_U_SINGLE	ssytrf_U_single
+#define SYTRF_L_PARALLEL	ssytrf_L_parallel
+#define SYTRF_U_PARALLEL	ssytrf_U_parallel
+#define SYTRS_L_SINGLE	ssytrs_L_single
+#define SYTRS_U_SINGLE	ssytrs_U_single
+#define SYTRS_L_PARALLEL	ssytrs_L_parallel
+#define SYTRS_U_PARALLEL	ssytrs_U_parallel
 #define NEG_TCOPY	SNEG_TCOPY
 #define	LARF_L		SLARF_L
 #define	LARF_R		SLARF_R
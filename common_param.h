@@ -72,9 +72,11 @@ BLASLONG (*ishmin_k) (BLASLONG, float *, BLASLONG);
   int    (*shaxpy_k) (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG);
   int    (*shscal_k) (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG);
   int    (*shswap_k) (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG);
+  int    (*shstobf16_k) (BLASLONG, float *, BLASLONG, bfloat16 *, BLASLONG);
+  int    (*shbf16tos_k) (BLASLONG, bfloat16 *, BLASLONG, float *, BLASLONG);
 
-  int    (*shgemv_n) (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *);
-  int    (*shgemv_t) (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *);
+  int    (*shgemv_n) (BLASLONG, BLASLONG, float, bfloat16 *, BLASLONG, bfloat16 *, BLASLONG, float, float *, BLASLONG);
+  int    (*shgemv_t) (BLASLONG, BLASLONG, float, bfloat16 *, BLASLONG, bfloat16 *, BLASLONG, float, float *, BLASLONG);
   int    (*shger_k)  (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG, float *);
 
   int    (*shsymv_L) (BLASLONG, BLASLONG, float,  float  *, BLASLONG, float  *, BLASLONG, float  *, BLASLONG, float *);
@@ -163,6 +165,8 @@ BLASLONG (*ismin_k) (BLASLONG, float *, BLASLONG);
   double (*dsdot_k) (BLASLONG, float *, BLASLONG, float *, BLASLONG);
 
   int    (*srot_k)  (BLASLONG, float *, BLASLONG, float *, BLASLONG, float, float);
+  int    (*srotm_k) (BLASLONG, float *, BLASLONG, float *, BLASLONG, float *);
+  int    (*srotseq_k) (BLASLONG, BLASLONG, float *, BLASLONG, float *, float *, BLASLONG);
 
   int    (*saxpy_k) (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG);
   int    (*sscal_k) (BLASLONG, BLASLONG, BLASLONG, float, float *, BLASLONG, float *, BLASLONG, float *, BLASLONG);
@@ -254,6 +258,8 @@ BLASLONG (*idmin_k) (BLASLONG, double *, BLASLONG);
   int    (*dcopy_k) (BLASLONG, double *, BLASLONG, double *, BLASLONG);
   double (*ddot_k)  (BLASLONG, double *, BLASLONG, double *, BLASLONG);
   int    (*drot_k)  (BLASLONG, double *, BLASLONG, double *, BLASLONG, double, double);
+  int    (*drotm_k) (BLASLONG, double *, BLASLONG, double *, BLASLONG, double *);
+  int    (*drotseq_k) (BLASLONG, BLASLONG, double *, BLASLONG, double *, double *, BLASLONG);
 
   int    (*daxpy_k) (BLASLONG, BLASLONG, BLASLONG, double, double *, BLASLONG, double *, BLASLONG, double *, BLASLONG);
   int    (*dscal_k) (BLASLONG, BLASLONG, BLASLONG, double, double *, BLASLONG, double *, BLASLONG, double *, BLASLONG);
@@ -346,6 +352,7 @@ BLASLONG (*iqmin_k) (BLASLONG, xdouble *, BLASLONG);
   int    (*qcopy_k) (BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG);
  xdouble (*qdot_k)  (BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG);
   int    (*qrot_k)  (BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble, xdouble);
+  int    (*qrotm_k) (BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *);
 
   int    (*qaxpy_k) (BLASLONG, BLASLONG, BLASLONG, xdouble, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG);
   int    (*qscal_k) (BLASLONG, BLASLONG, BLASLONG, xdouble, xdouble *, BLASLONG, xdouble *, BLASLONG, xdouble *, BLASLONG);
@@ -991,10 +998,104 @@ BLASLONG (*ixamin_k)(BLASLONG, xdouble *, BLASLONG);
   int    (*cgeadd_k) (BLASLONG, BLASLONG, float, float,  float *,  BLASLONG, float, float, float *, BLASLONG); 
   int    (*zgeadd_k) (BLASLONG, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG); 
 
+#ifdef SMALL_MATRIX_OPT
+  int    (*sgemm_small_matrix_permit)(int, int, BLASLONG, BLASLONG, BLASLONG, float, float);
+  int    (*sgemm_small_kernel_nn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+  int    (*sgemm_small_kernel_tn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+  int    (*sgemm_small_kernel_nt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+  int    (*sgemm_small_kernel_tt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float, float *, BLASLONG);
+  int    (*sgemm_small_kernel_b0_nn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*sgemm_small_kernel_b0_tn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*sgemm_small_kernel_b0_nt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*sgemm_small_kernel_b0_tt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float *, BLASLONG, float *, BLASLONG);
+
+  int    (*dgemm_small_matrix_permit)(int, int, BLASLONG, BLASLONG, BLASLONG, double, double);
+  int    (*dgemm_small_kernel_nn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+  int    (*dgemm_small_kernel_tn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+  int    (*dgemm_small_kernel_nt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+  int    (*dgemm_small_kernel_tt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double, double *, BLASLONG);
+  int    (*dgemm_small_kernel_b0_nn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*dgemm_small_kernel_b0_tn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*dgemm_small_kernel_b0_nt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*dgemm_small_kernel_b0_tt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double *, BLASLONG, double *, BLASLONG);
+
+  int    (*cgemm_small_matrix_permit)(int, int, BLASLONG, BLASLONG, BLASLONG, float, float, float, float);
+  int    (*cgemm_small_kernel_nn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_tn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_rn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_cn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_nt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_tt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_rt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_ct)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_nr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_tr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_rr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_cr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_nc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_tc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_rc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_cc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float, float, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_nn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_tn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_rn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_cn)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_nt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_tt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_rt)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_ct)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_nr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_tr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_rr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_cr)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_nc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_tc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_rc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+  int    (*cgemm_small_kernel_b0_cc)(BLASLONG, BLASLONG, BLASLONG, float *, BLASLONG, float, float, float *, BLASLONG, float *, BLASLONG);
+
+  int    (*zgemm_small_matrix_permit)(int, int, BLASLONG, BLASLONG, BLASLONG, double, double, double, double);
+  int    (*zgemm_small_kernel_nn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_tn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_rn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_cn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_nt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_tt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_rt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_ct)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_nr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_tr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_rr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_cr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_nc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_tc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_rc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_cc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double, double, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_nn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_tn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_rn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_cn)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_nt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_tt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_rt)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_ct)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_nr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_tr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_rr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_cr)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_nc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_tc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_rc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+  int    (*zgemm_small_kernel_b0_cc)(BLASLONG, BLASLONG, BLASLONG, double *, BLASLONG, double, double, double *, BLASLONG, double *, BLASLONG);
+#endif
+
 } gotoblas_t;
 
 extern gotoblas_t *gotoblas;
 
+/* byte offset of a kernel in gotoblas_t, used for tables of kernels that
+   have to be resolved against the runtime-selected core */
+#define FUNC_OFFSET(func)	(size_t)(&((gotoblas_t *)NULL) -> func)
+
 #define DTB_ENTRIES  gotoblas -> dtb_entries
 #define GEMM_OFFSET_A	gotoblas -> offsetA
 #define GEMM_OFFSET_B	gotoblas -> offsetB
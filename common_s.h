@@ -24,6 +24,8 @@
 #define	SSCAL_K			sscal_k
 #define	SSWAP_K			sswap_k
 #define	SROT_K			srot_k
+#define	SROTM_K			srotm_k
+#define	SROTSEQ_K		srotseq_k
 
 #define	SGEMV_N			sgemv_n
 #define	SGEMV_T			sgemv_t
@@ -160,6 +162,18 @@
 
 #define SGEADD_K                sgeadd_k 
 
+#ifdef SMALL_MATRIX_OPT
+#define SGEMM_SMALL_MATRIX_PERMIT        sgemm_small_matrix_permit
+#define SGEMM_SMALL_KERNEL_NN            sgemm_small_kernel_nn
+#define SGEMM_SMALL_KERNEL_TN            sgemm_small_kernel_tn
+#define SGEMM_SMALL_KERNEL_NT            sgemm_small_kernel_nt
+#define SGEMM_SMALL_KERNEL_TT            sgemm_small_kernel_tt
+#define SGEMM_SMALL_KERNEL_B0_NN         sgemm_small_kernel_b0_nn
+#define SGEMM_SMALL_KERNEL_B0_TN         sgemm_small_kernel_b0_tn
+#define SGEMM_SMALL_KERNEL_B0_NT         sgemm_small_kernel_b0_nt
+#define SGEMM_SMALL_KERNEL_B0_TT         sgemm_small_kernel_b0_tt
+#endif
+
 #else
 
 #define	SAMAX_K			gotoblas -> samax_k
@@ -183,6 +197,8 @@
 #define	SSCAL_K			gotoblas -> sscal_k
 #define	SSWAP_K			gotoblas -> sswap_k
 #define	SROT_K			gotoblas -> srot_k
+#define	SROTM_K			gotoblas -> srotm_k
+#define	SROTSEQ_K		gotoblas -> srotseq_k
 
 #define	SGEMV_N			gotoblas -> sgemv_n
 #define	SGEMV_T			gotoblas -> sgemv_t
@@ -287,6 +303,18 @@
 
 #define SGEADD_K                gotoblas -> sgeadd_k 
 
+#ifdef SMALL_MATRIX_OPT
+#define SGEMM_SMALL_MATRIX_PERMIT        gotoblas -> sgemm_small_matrix_permit
+#define SGEMM_SMALL_KERNEL_NN            FUNC_OFFSET(sgemm_small_kernel_nn)
+#define SGEMM_SMALL_KERNEL_TN            FUNC_OFFSET(sgemm_small_kernel_tn)
+#define SGEMM_SMALL_KERNEL_NT            FUNC_OFFSET(sgemm_small_kernel_nt)
+#define SGEMM_SMALL_KERNEL_TT            FUNC_OFFSET(sgemm_small_kernel_tt)
+#define SGEMM_SMALL_KERNEL_B0_NN         FUNC_OFFSET(sgemm_small_kernel_b0_nn)
+#define SGEMM_SMALL_KERNEL_B0_TN         FUNC_OFFSET(sgemm_small_kernel_b0_tn)
+#define SGEMM_SMALL_KERNEL_B0_NT         FUNC_OFFSET(sgemm_small_kernel_b0_nt)
+#define SGEMM_SMALL_KERNEL_B0_TT         FUNC_OFFSET(sgemm_small_kernel_b0_tt)
+#endif
+
 #endif
 
 #define	SGEMM_NN		sgemm_nn
@@ -433,6 +461,27 @@
 #define	SGEMM_THREAD_RC		sgemm_thread_nt
 #define	SGEMM_THREAD_RR		sgemm_thread_nn
 
+#define	SGEMM_BATCH_THREAD	sgemm_batch_thread
+
+#define	SGEMM_PACK_AN		sgemm_pack_an
+#define	SGEMM_PACK_AT		sgemm_pack_at
+#define	SGEMM_PACK_BN		sgemm_pack_bn
+#define	SGEMM_PACK_BT		sgemm_pack_bt
+#define	SGEMM_COMPUTE_PN	sgemm_compute_pn
+#define	SGEMM_COMPUTE_PT	sgemm_compute_pt
+#define	SGEMM_COMPUTE_NP	sgemm_compute_np
+#define	SGEMM_COMPUTE_TP	sgemm_compute_tp
+#define	SGEMM_COMPUTE_PP	sgemm_compute_pp
+
+#define	SGEMMT_UNN		sgemmt_UNN
+#define	SGEMMT_UNT		sgemmt_UNT
+#define	SGEMMT_UTN		sgemmt_UTN
+#define	SGEMMT_UTT		sgemmt_UTT
+#define	SGEMMT_LNN		sgemmt_LNN
+#define	SGEMMT_LNT		sgemmt_LNT
+#define	SGEMMT_LTN		sgemmt_LTN
+#define	SGEMMT_LTT		sgemmt_LTT
+
 #define	SSYMM_THREAD_LU		ssymm_thread_LU
 #define	SSYMM_THREAD_LL		ssymm_thread_LL
 #define	SSYMM_THREAD_RU		ssymm_thread_RU
@@ -16,6 +16,11 @@
 #define	SHGEMM_BETA		shgemm_beta
 #define SHGEMM_KERNEL            shgemm_kernel
 
+#define	SHGEMV_N		shgemv_n
+#define	SHGEMV_T		shgemv_t
+#define	SHSTOBF16_K		shstobf16_k
+#define	SHBF16TOS_K		shbf16tos_k
+
 #else
 
 #define	SHGEMM_ONCOPY		gotoblas -> shgemm_oncopy
@@ -25,6 +30,11 @@
 #define	SHGEMM_BETA		gotoblas -> shgemm_beta
 #define	SHGEMM_KERNEL		gotoblas -> shgemm_kernel
 
+#define	SHGEMV_N		gotoblas -> shgemv_n
+#define	SHGEMV_T		gotoblas -> shgemv_t
+#define	SHSTOBF16_K		gotoblas -> shstobf16_k
+#define	SHBF16TOS_K		gotoblas -> shbf16tos_k
+
 #endif
 
 #define	SHGEMM_NN		shgemm_nn
@@ -129,10 +129,26 @@ typedef struct blas_queue {
 
 extern int blas_server_avail;
 
+int blas_pool_threads(void);
+
+/* Threading policies of openblas_set_thread_context, see cblas.h */
+#define BLAS_POLICY_DEFAULT	0
+#define BLAS_POLICY_SEQUENTIAL	1
+#define BLAS_POLICY_EAGER	2
+
+/* nthreads capped by the calling thread's context */
+int blas_context_threads(int nthreads);
+int blas_context_policy(void);
+
 static __inline int num_cpu_avail(int level) {
 
 #ifdef USE_OPENMP
 	int openmp_nthreads=0;
+#else
+  /* A pool bound with openblas_threadpool_bind sets the thread count */
+  int pool_nthreads = blas_pool_threads();
+
+  if (pool_nthreads > 0) return blas_context_threads(pool_nthreads);
 #endif
 
   if (blas_cpu_number == 1
@@ -149,7 +165,7 @@ static __inline int num_cpu_avail(int level) {
   }
 #endif
 
-  return blas_cpu_number;
+  return blas_context_threads(blas_cpu_number);
 
 }
 
@@ -187,6 +203,40 @@ int gemm_thread_mn(int mode, blas_arg_t *, BLASLONG *, BLASLONG *, int (*functio
 
 int gemm_thread_variable(int mode, blas_arg_t *, BLASLONG *, BLASLONG *, int (*function)(), void *, void *, BLASLONG, BLASLONG);
 
+int gemm_thread_dynamic(int mode, blas_arg_t *, BLASLONG *, BLASLONG *, int (*function)(), void *, void *, BLASLONG);
+
+/* Non-zero when OPENBLAS_GEMM_DYNAMIC selects gemm_thread_dynamic for GEMM */
+int openblas_gemm_dynamic(void);
+
+/* Non-zero when results must not depend on the number of threads,
+   set by OPENBLAS_DETERMINISTIC or openblas_set_deterministic() */
+int openblas_get_deterministic(void);
+
+int blas_level1_thread_reduce(int mode, BLASLONG n,
+			      void *x, BLASLONG incx,
+			      void *y, BLASLONG incy,
+			      double *result, int (*leaf)(), int threads);
+
+/* Problem sizes below which the interface routines stay single threaded,
+   either the built-in defaults or values measured on this machine. */
+#define BLAS_THRESHOLD_AXPY	0
+#define BLAS_THRESHOLD_GEMV	1
+#define BLAS_THRESHOLD_TRSM	2
+#define BLAS_THRESHOLD_TRSV	3
+#define BLAS_THRESHOLD_ROUTINES	4
+
+#if   defined(COMPLEX) && (defined(DOUBLE) || defined(XDOUBLE))
+#define BLAS_THRESHOLD_PREC	3
+#elif defined(COMPLEX)
+#define BLAS_THRESHOLD_PREC	2
+#elif defined(DOUBLE) || defined(XDOUBLE)
+#define BLAS_THRESHOLD_PREC	1
+#else
+#define BLAS_THRESHOLD_PREC	0
+#endif
+
+BLASLONG blas_thread_threshold(int routine, int prec);
+
 int trsm_thread(int mode, BLASLONG m, BLASLONG n,
 		double alpha_r, double alpha_i,
 		void *a, BLASLONG lda,
@@ -0,0 +1,467 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Triangular solve by blocked substitution on several threads.
+
+   The vector is cut into steps of nb elements, numbered in the order the
+   substitution reaches them, and step s belongs to thread s % nthreads.
+   Each thread applies the updates from the steps solved so far to the
+   steps it owns; once every earlier step is in, the owner solves the
+   diagonal block of its next step and publishes it.  Only the diagonal
+   blocks are sequential, the updates run in parallel behind them.
+
+   trsv uses GEMV for the updates.  tpsv (PACKED) and tbsv (BANDED)
+   include this file and go column by column, since their blocks are not
+   strided like a full matrix. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "common.h"
+
+#ifndef COMPLEX
+#ifndef TRANSA
+#define MYGEMV	GEMV_N
+#undef TRANS
+#else
+#define MYGEMV	GEMV_T
+#define TRANS
+#endif
+#define MYDOT	DOTU_K
+#define MYAXPY	AXPYU_K
+#else
+#if    TRANSA == 1
+#define MYGEMV	GEMV_N
+#undef TRANS
+#define MYDOT	DOTU_K
+#define MYAXPY	AXPYU_K
+#elif  TRANSA == 2
+#define MYGEMV	GEMV_T
+#define TRANS
+#define MYDOT	DOTU_K
+#define MYAXPY	AXPYU_K
+#elif  TRANSA == 3
+#define MYGEMV	GEMV_R
+#undef TRANS
+#define MYDOT	DOTC_K
+#define MYAXPY	AXPYC_K
+#else
+#define MYGEMV	GEMV_C
+#define TRANS
+#define MYDOT	DOTC_K
+#define MYAXPY	AXPYC_K
+#endif
+#endif
+
+/* L x = b and U' x = b run from the first row down, the others up */
+#if (defined(LOWER) && !defined(TRANS)) || (!defined(LOWER) && defined(TRANS))
+#define FORWARD
+#endif
+
+#if defined(PACKED)
+#ifndef LOWER
+#define ELEMENT(i, j)	(a + ((i) + (j) * ((j) + 1) / 2) * COMPSIZE)
+#else
+#define ELEMENT(i, j)	(a + ((i) + (j) * (2 * n - (j) - 1) / 2) * COMPSIZE)
+#endif
+#elif defined(BANDED)
+#ifndef LOWER
+#define ELEMENT(i, j)	(a + (k + (i) - (j) + (j) * lda) * COMPSIZE)
+#else
+#define ELEMENT(i, j)	(a + ((i) - (j) + (j) * lda) * COMPSIZE)
+#endif
+#else
+#define ELEMENT(i, j)	(a + ((i) + (j) * lda) * COMPSIZE)
+#endif
+
+/* rows [COLUMN_FROM(j), COLUMN_TO(j)) of column j are stored */
+#ifndef LOWER
+#ifdef BANDED
+#define COLUMN_FROM(j)	MAX(0, (j) - k)
+#else
+#define COLUMN_FROM(j)	0
+#endif
+#define COLUMN_TO(j)	((j) + 1)
+#else
+#define COLUMN_FROM(j)	(j)
+#ifdef BANDED
+#define COLUMN_TO(j)	MIN(n, (j) + k + 1)
+#else
+#define COLUMN_TO(j)	n
+#endif
+#endif
+
+/* rows [STEP_FROM(s), STEP_TO(s)) make up step s */
+#ifdef FORWARD
+#define STEP_FROM(s)	MIN(n, (s) * nb)
+#define STEP_TO(s)	MIN(n, ((s) + 1) * nb)
+#else
+#define STEP_FROM(s)	MAX(0, n - ((s) + 1) * nb)
+#define STEP_TO(s)	MAX(0, n - (s) * nb)
+#endif
+
+/* keeps the table of applied steps small for long banded systems */
+#define MAX_STEPS	8192
+
+typedef struct {
+  volatile BLASLONG solved;
+  BLASLONG pad[15];
+  BLASLONG nb, steps;
+  BLASLONG *applied;
+} trsv_job_t;
+
+#if !defined(PACKED) && !defined(BANDED)
+const static FLOAT dm1 = -1.;
+#endif
+
+/* Subtracts from the rows of step s what steps [from, to) contribute */
+static void trsv_update(blas_arg_t *args, BLASLONG nb, BLASLONG s,
+			BLASLONG from, BLASLONG to, FLOAT *buffer) {
+
+  FLOAT *a = (FLOAT *)args -> a;
+  FLOAT *x = (FLOAT *)args -> b;
+  BLASLONG n = args -> m;
+#ifndef PACKED
+  BLASLONG lda = args -> lda;
+#endif
+#ifdef BANDED
+  BLASLONG k = args -> k;
+#endif
+  BLASLONG r0 = STEP_FROM(s), r1 = STEP_TO(s), c0, c1;
+#if defined(PACKED) || defined(BANDED)
+  BLASLONG i, lo, hi;
+#ifdef TRANS
+#ifndef COMPLEX
+  FLOAT result;
+#else
+  OPENBLAS_COMPLEX_FLOAT result;
+#endif
+#endif
+#endif
+
+#ifdef FORWARD
+  c0 = STEP_FROM(from);
+  c1 = STEP_TO(to - 1);
+#ifdef BANDED
+  c0 = MAX(c0, r0 - k);
+#endif
+#else
+  c0 = STEP_FROM(to - 1);
+  c1 = STEP_TO(from);
+#ifdef BANDED
+  c1 = MIN(c1, r1 + k);
+#endif
+#endif
+
+  if (c1 <= c0) return;
+
+#if !defined(PACKED) && !defined(BANDED)
+
+#ifndef TRANS
+  MYGEMV(r1 - r0, c1 - c0, 0, dm1,
+#ifdef COMPLEX
+	 ZERO,
+#endif
+	 ELEMENT(r0, c0), lda, x + c0 * COMPSIZE, 1, x + r0 * COMPSIZE, 1, buffer);
+#else
+  MYGEMV(c1 - c0, r1 - r0, 0, dm1,
+#ifdef COMPLEX
+	 ZERO,
+#endif
+	 ELEMENT(c0, r0), lda, x + c0 * COMPSIZE, 1, x + r0 * COMPSIZE, 1, buffer);
+#endif
+
+#else
+
+#ifndef TRANS
+  for (i = c0; i < c1; i++) {
+    lo = MAX(r0, COLUMN_FROM(i));
+    hi = MIN(r1, COLUMN_TO(i));
+    if (hi > lo)
+      MYAXPY(hi - lo, 0, 0, -x[i * COMPSIZE + 0],
+#ifdef COMPLEX
+	     -x[i * COMPSIZE + 1],
+#endif
+	     ELEMENT(lo, i), 1, x + lo * COMPSIZE, 1, NULL, 0);
+  }
+#else
+  for (i = r0; i < r1; i++) {
+    lo = MAX(c0, COLUMN_FROM(i));
+    hi = MIN(c1, COLUMN_TO(i));
+    if (hi > lo) {
+      result = MYDOT(hi - lo, ELEMENT(lo, i), 1, x + lo * COMPSIZE, 1);
+#ifndef COMPLEX
+      x[i] -= result;
+#else
+      x[i * COMPSIZE + 0] -= CREAL(result);
+      x[i * COMPSIZE + 1] -= CIMAG(result);
+#endif
+    }
+  }
+#endif
+
+#endif
+}
+
+/* Solves the diagonal block of step s, all earlier steps applied */
+static void trsv_solve(blas_arg_t *args, BLASLONG nb, BLASLONG s) {
+
+  FLOAT *a = (FLOAT *)args -> a;
+  FLOAT *x = (FLOAT *)args -> b;
+  BLASLONG n = args -> m;
+#ifndef PACKED
+  BLASLONG lda = args -> lda;
+#endif
+#ifdef BANDED
+  BLASLONG k = args -> k;
+#endif
+  BLASLONG r0 = STEP_FROM(s), r1 = STEP_TO(s);
+  BLASLONG i, lo, hi;
+#ifdef TRANS
+#ifndef COMPLEX
+  FLOAT result;
+#else
+  OPENBLAS_COMPLEX_FLOAT result;
+#endif
+#endif
+#if defined(COMPLEX) && !defined(UNIT)
+  FLOAT ar, ai, br, bi, ratio, den;
+#endif
+
+#ifdef FORWARD
+  for (i = r0; i < r1; i++) {
+#else
+  for (i = r1 - 1; i >= r0; i--) {
+#endif
+
+#ifdef LOWER
+    lo = i + 1;
+    hi = MIN(r1, COLUMN_TO(i));
+#else
+    lo = MAX(r0, COLUMN_FROM(i));
+    hi = i;
+#endif
+
+#ifdef TRANS
+    if (hi > lo) {
+      result = MYDOT(hi - lo, ELEMENT(lo, i), 1, x + lo * COMPSIZE, 1);
+#ifndef COMPLEX
+      x[i] -= result;
+#else
+      x[i * COMPSIZE + 0] -= CREAL(result);
+      x[i * COMPSIZE + 1] -= CIMAG(result);
+#endif
+    }
+#endif
+
+#ifndef UNIT
+#ifndef COMPLEX
+    x[i] /= *ELEMENT(i, i);
+#else
+    ar = ELEMENT(i, i)[0];
+    ai = ELEMENT(i, i)[1];
+
+    if (fabs(ar) >= fabs(ai)) {
+      ratio = ai / ar;
+      den = 1. / (ar * (1 + ratio * ratio));
+      ar =  den;
+#if TRANSA < 3
+      ai = -ratio * den;
+#else
+      ai =  ratio * den;
+#endif
+    } else {
+      ratio = ar / ai;
+      den = 1. / (ai * (1 + ratio * ratio));
+      ar =  ratio * den;
+#if TRANSA < 3
+      ai = -den;
+#else
+      ai =  den;
+#endif
+    }
+
+    br = x[i * COMPSIZE + 0];
+    bi = x[i * COMPSIZE + 1];
+
+    x[i * COMPSIZE + 0] = ar * br - ai * bi;
+    x[i * COMPSIZE + 1] = ar * bi + ai * br;
+#endif
+#endif
+
+#ifndef TRANS
+    if (hi > lo)
+      MYAXPY(hi - lo, 0, 0, -x[i * COMPSIZE + 0],
+#ifdef COMPLEX
+	     -x[i * COMPSIZE + 1],
+#endif
+	     ELEMENT(lo, i), 1, x + lo * COMPSIZE, 1, NULL, 0);
+#endif
+  }
+}
+
+static int trsv_kernel(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n,
+		       FLOAT *sa, FLOAT *buffer, BLASLONG pos) {
+
+  trsv_job_t *job = (trsv_job_t *)args -> common;
+  BLASLONG nthreads = args -> nthreads;
+  BLASLONG nb = job -> nb, steps = job -> steps;
+  BLASLONG *applied = job -> applied;
+  BLASLONG next = *range_m, s, avail, to, busy;
+#ifdef BANDED
+  BLASLONG k = args -> k;
+#endif
+
+  while (next < steps) {
+
+    avail = job -> solved;
+    MB;
+
+    /* everything before our next step is solved: finish it first */
+    if (avail == next) {
+      if (applied[next] < next) trsv_update(args, nb, next, applied[next], next, buffer);
+      trsv_solve(args, nb, next);
+      WMB;
+      job -> solved = next + 1;
+      next += nthreads;
+      continue;
+    }
+
+    /* otherwise bring the later steps up to date, a few steps at a time
+       so that the diagonal block is not kept waiting */
+    busy = 0;
+    for (s = next; s < steps; s += nthreads) {
+#ifdef BANDED
+      if ((s - avail) * nb > k) break;
+#endif
+      if (applied[s] < avail) {
+	to = MIN(avail, applied[s] + nthreads);
+	trsv_update(args, nb, s, applied[s], to, buffer);
+	applied[s] = to;
+	busy = 1;
+      }
+      if (job -> solved == next) break;
+    }
+
+    if (!busy) YIELDING;
+  }
+
+  return 0;
+}
+
+#if defined(PACKED)
+int CNAME(BLASLONG n, FLOAT *a, FLOAT *x, BLASLONG incx, FLOAT *buffer, int nthreads){
+#elif defined(BANDED)
+int CNAME(BLASLONG n, BLASLONG k, FLOAT *a, BLASLONG lda, FLOAT *x, BLASLONG incx, FLOAT *buffer, int nthreads){
+#else
+int CNAME(BLASLONG n, FLOAT *a, BLASLONG lda, FLOAT *x, BLASLONG incx, FLOAT *buffer, int nthreads){
+#endif
+
+  blas_arg_t args;
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  BLASLONG range[MAX_CPU_NUMBER];
+  trsv_job_t job;
+  FLOAT *X = x;
+  BLASLONG i, nb, steps;
+
+#ifndef COMPLEX
+#ifdef XDOUBLE
+  int mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  int mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#else
+#ifdef XDOUBLE
+  int mode  =  BLAS_XDOUBLE | BLAS_COMPLEX;
+#elif defined(DOUBLE)
+  int mode  =  BLAS_DOUBLE  | BLAS_COMPLEX;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_COMPLEX;
+#endif
+#endif
+
+  if (incx != 1) {
+    X = buffer;
+    buffer += (n * COMPSIZE + 15) & ~15;
+    COPY_K(n, x, incx, X, 1);
+  }
+
+  /* Short steps keep the sequential part small; a band of width k only
+     leaves k / nb steps that can be worked on at the same time. */
+#ifdef BANDED
+  nb = MAX(16, k / (nthreads * 2));
+#else
+  nb = MAX(DTB_ENTRIES, n / (nthreads * 32));
+#endif
+  if (n > nb * MAX_STEPS) nb = (n + MAX_STEPS - 1) / MAX_STEPS;
+
+  steps = (n + nb - 1) / nb;
+  if (nthreads > steps) nthreads = steps;
+
+  job.solved  = 0;
+  job.nb      = nb;
+  job.steps   = steps;
+  job.applied = (BLASLONG *)buffer;
+  for (i = 0; i < steps; i++) job.applied[i] = 0;
+
+  buffer = (FLOAT *)(((BLASLONG)(job.applied + steps) + GEMM_ALIGN) & ~GEMM_ALIGN);
+
+  args.m = n;
+#ifdef BANDED
+  args.k = k;
+#endif
+  args.a = (void *)a;
+  args.b = (void *)X;
+#ifndef PACKED
+  args.lda = lda;
+#endif
+  args.nthreads = nthreads;
+  args.common = (void *)&job;
+
+  for (i = 0; i < nthreads; i++) {
+    range[i] = i;
+
+    queue[i].mode    = mode;
+    queue[i].routine = trsv_kernel;
+    queue[i].args    = &args;
+    queue[i].range_m = &range[i];
+    queue[i].range_n = NULL;
+    queue[i].sa      = NULL;
+    queue[i].sb      = NULL;
+    queue[i].next    = &queue[i + 1];
+  }
+
+  queue[0].sb = buffer;
+  queue[nthreads - 1].next = NULL;
+
+  exec_blas(nthreads, queue);
+
+  if (incx != 1) COPY_K(n, X, 1, x, incx);
+
+  return 0;
+}
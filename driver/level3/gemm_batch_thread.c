@@ -0,0 +1,302 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include "common.h"
+
+/*
+ * Driver behind the ?gemm_batch interfaces.  Every entry of the batch is a
+ * complete, independent GEMM described by its own blas_arg_t; the
+ * interface stores the transpose combination in routine_mode, indexed like
+ * the gemm[] table below.
+ *
+ * Rather than threading each (typically small) GEMM on its own, the batch
+ * is cut into contiguous runs of entries of roughly equal work and every
+ * thread of the pool works through its run sequentially, using its own
+ * packing buffer.  Batches with fewer entries than threads fall back to
+ * the threaded level3 driver for each entry.
+ */
+
+static int (*gemm[])(blas_arg_t *, BLASLONG *, BLASLONG *, IFLOAT *, IFLOAT *, BLASLONG) = {
+  GEMM_NN, GEMM_TN, GEMM_RN, GEMM_CN,
+  GEMM_NT, GEMM_TT, GEMM_RT, GEMM_CT,
+  GEMM_NR, GEMM_TR, GEMM_RR, GEMM_CR,
+  GEMM_NC, GEMM_TC, GEMM_RC, GEMM_CC,
+};
+
+#if defined(SMP) && !defined(USE_SIMPLE_THREADED_LEVEL3)
+static int (*gemm_thread[])(blas_arg_t *, BLASLONG *, BLASLONG *, IFLOAT *, IFLOAT *, BLASLONG) = {
+  GEMM_THREAD_NN, GEMM_THREAD_TN, GEMM_THREAD_RN, GEMM_THREAD_CN,
+  GEMM_THREAD_NT, GEMM_THREAD_TT, GEMM_THREAD_RT, GEMM_THREAD_CT,
+  GEMM_THREAD_NR, GEMM_THREAD_TR, GEMM_THREAD_RR, GEMM_THREAD_CR,
+  GEMM_THREAD_NC, GEMM_THREAD_TC, GEMM_THREAD_RC, GEMM_THREAD_CC,
+};
+#endif
+
+#ifdef SMALL_MATRIX_OPT
+
+#ifdef DYNAMIC_ARCH
+#define SMALL_KERNEL_ADDR(table, idx) (*(void **)((char *)gotoblas + (size_t)(table[idx])))
+#else
+#define SMALL_KERNEL_ADDR(table, idx) ((void *)(table[idx]))
+#endif
+
+#ifndef COMPLEX
+static void *gemm_small_kernel[] = {
+  (void *)GEMM_SMALL_KERNEL_NN, (void *)GEMM_SMALL_KERNEL_TN, NULL, NULL,
+  (void *)GEMM_SMALL_KERNEL_NT, (void *)GEMM_SMALL_KERNEL_TT, NULL, NULL,
+};
+
+static void *gemm_small_kernel_b0[] = {
+  (void *)GEMM_SMALL_KERNEL_B0_NN, (void *)GEMM_SMALL_KERNEL_B0_TN, NULL, NULL,
+  (void *)GEMM_SMALL_KERNEL_B0_NT, (void *)GEMM_SMALL_KERNEL_B0_TT, NULL, NULL,
+};
+#else
+static void *gemm_small_kernel[] = {
+  (void *)GEMM_SMALL_KERNEL_NN, (void *)GEMM_SMALL_KERNEL_TN, (void *)GEMM_SMALL_KERNEL_RN, (void *)GEMM_SMALL_KERNEL_CN,
+  (void *)GEMM_SMALL_KERNEL_NT, (void *)GEMM_SMALL_KERNEL_TT, (void *)GEMM_SMALL_KERNEL_RT, (void *)GEMM_SMALL_KERNEL_CT,
+  (void *)GEMM_SMALL_KERNEL_NR, (void *)GEMM_SMALL_KERNEL_TR, (void *)GEMM_SMALL_KERNEL_RR, (void *)GEMM_SMALL_KERNEL_CR,
+  (void *)GEMM_SMALL_KERNEL_NC, (void *)GEMM_SMALL_KERNEL_TC, (void *)GEMM_SMALL_KERNEL_RC, (void *)GEMM_SMALL_KERNEL_CC,
+};
+
+static void *gemm_small_kernel_b0[] = {
+  (void *)GEMM_SMALL_KERNEL_B0_NN, (void *)GEMM_SMALL_KERNEL_B0_TN, (void *)GEMM_SMALL_KERNEL_B0_RN, (void *)GEMM_SMALL_KERNEL_B0_CN,
+  (void *)GEMM_SMALL_KERNEL_B0_NT, (void *)GEMM_SMALL_KERNEL_B0_TT, (void *)GEMM_SMALL_KERNEL_B0_RT, (void *)GEMM_SMALL_KERNEL_B0_CT,
+  (void *)GEMM_SMALL_KERNEL_B0_NR, (void *)GEMM_SMALL_KERNEL_B0_TR, (void *)GEMM_SMALL_KERNEL_B0_RR, (void *)GEMM_SMALL_KERNEL_B0_CR,
+  (void *)GEMM_SMALL_KERNEL_B0_NC, (void *)GEMM_SMALL_KERNEL_B0_TC, (void *)GEMM_SMALL_KERNEL_B0_RC, (void *)GEMM_SMALL_KERNEL_B0_CC,
+};
+#endif
+#endif
+
+#define TRANS_INDEX(args)	((args) -> routine_mode & 15)
+
+/* Pick the routine for one entry: an unpacked small matrix kernel when
+   the target permits it, the single-threaded level3 driver otherwise. */
+static void resolve_routine(blas_arg_t *args){
+
+  int idx = TRANS_INDEX(args);
+
+  args -> routine = (void *)gemm[idx];
+
+#ifdef SMALL_MATRIX_OPT
+#ifndef COMPLEX
+  {
+    FLOAT alpha = *(FLOAT *)args -> alpha, beta = *(FLOAT *)args -> beta;
+
+    if (alpha != ZERO && GEMM_SMALL_MATRIX_PERMIT(idx & 3, idx >> 2, args -> m, args -> n, args -> k, alpha, beta)) {
+      if (beta == ZERO) {
+	args -> routine = SMALL_KERNEL_ADDR(gemm_small_kernel_b0, idx);
+	args -> routine_mode |= BLAS_SMALL_B0_OPT;
+      } else {
+	args -> routine = SMALL_KERNEL_ADDR(gemm_small_kernel, idx);
+	args -> routine_mode |= BLAS_SMALL_OPT;
+      }
+    }
+  }
+#else
+  {
+    FLOAT *alpha = (FLOAT *)args -> alpha, *beta = (FLOAT *)args -> beta;
+
+    if ((alpha[0] != ZERO || alpha[1] != ZERO) &&
+	GEMM_SMALL_MATRIX_PERMIT(idx & 3, idx >> 2, args -> m, args -> n, args -> k, alpha[0], alpha[1], beta[0], beta[1])) {
+      if (beta[0] == ZERO && beta[1] == ZERO) {
+	args -> routine = SMALL_KERNEL_ADDR(gemm_small_kernel_b0, idx);
+	args -> routine_mode |= BLAS_SMALL_B0_OPT;
+      } else {
+	args -> routine = SMALL_KERNEL_ADDR(gemm_small_kernel, idx);
+	args -> routine_mode |= BLAS_SMALL_OPT;
+      }
+    }
+  }
+#endif
+#endif
+}
+
+static void exec_entry(blas_arg_t *args, IFLOAT *sa, IFLOAT *sb){
+
+#ifdef SMALL_MATRIX_OPT
+  if ((args -> routine_mode & BLAS_SMALL_B0_OPT) == BLAS_SMALL_B0_OPT) {
+#ifndef COMPLEX
+    int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT *, BLASLONG, FLOAT *, BLASLONG) = args -> routine;
+    kernel(args -> m, args -> n, args -> k, args -> a, args -> lda, *(FLOAT *)args -> alpha,
+	   args -> b, args -> ldb, args -> c, args -> ldc);
+#else
+    int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT, FLOAT *, BLASLONG, FLOAT *, BLASLONG) = args -> routine;
+    kernel(args -> m, args -> n, args -> k, args -> a, args -> lda, ((FLOAT *)args -> alpha)[0], ((FLOAT *)args -> alpha)[1],
+	   args -> b, args -> ldb, args -> c, args -> ldc);
+#endif
+    return;
+  }
+
+  if (args -> routine_mode & BLAS_SMALL_OPT) {
+#ifndef COMPLEX
+    int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT *, BLASLONG, FLOAT, FLOAT *, BLASLONG) = args -> routine;
+    kernel(args -> m, args -> n, args -> k, args -> a, args -> lda, *(FLOAT *)args -> alpha,
+	   args -> b, args -> ldb, *(FLOAT *)args -> beta, args -> c, args -> ldc);
+#else
+    int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT, FLOAT *, BLASLONG, FLOAT, FLOAT, FLOAT *, BLASLONG) = args -> routine;
+    kernel(args -> m, args -> n, args -> k, args -> a, args -> lda, ((FLOAT *)args -> alpha)[0], ((FLOAT *)args -> alpha)[1],
+	   args -> b, args -> ldb, ((FLOAT *)args -> beta)[0], ((FLOAT *)args -> beta)[1], args -> c, args -> ldc);
+#endif
+    return;
+  }
+#endif
+
+  ((int (*)(blas_arg_t *, BLASLONG *, BLASLONG *, IFLOAT *, IFLOAT *, BLASLONG))args -> routine)(args, NULL, NULL, sa, sb, 0);
+}
+
+#ifdef SMP
+
+/* Entries below this size are not worth threading on their own */
+#ifndef COMPLEX
+#define SMP_THRESHOLD_MIN 65536.0
+#else
+#define SMP_THRESHOLD_MIN 8192.0
+#endif
+
+#ifndef GEMM_MULTITHREAD_THRESHOLD
+#define GEMM_MULTITHREAD_THRESHOLD 4
+#endif
+
+static int inner_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, IFLOAT *sa, IFLOAT *sb, BLASLONG mypos){
+
+  BLASLONG i;
+
+  for (i = range_m[0]; i < range_m[1]; i++) exec_entry(&args[i], sa, sb);
+
+  return 0;
+}
+
+static double entry_work(blas_arg_t *args){
+  /* k == 0 still scales C, count it as one rank-1 update */
+  return (double)args -> m * (double)args -> n * (double)MAX(args -> k, 1);
+}
+
+#endif
+
+int CNAME(blas_arg_t *args_array, BLASLONG nums){
+
+  XFLOAT *buffer, *sa, *sb;
+  BLASLONG i;
+
+#ifdef SMP
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  BLASLONG range[MAX_CPU_NUMBER + 1];
+  BLASLONG nthreads, num_cpu;
+  double total, work, target;
+#ifndef COMPLEX
+#ifdef DOUBLE
+  int mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#else
+#ifdef DOUBLE
+  int mode  =  BLAS_DOUBLE  | BLAS_COMPLEX;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_COMPLEX;
+#endif
+#endif
+#endif
+
+  if (nums <= 0) return 0;
+
+  for (i = 0; i < nums; i++) resolve_routine(&args_array[i]);
+
+  buffer = (XFLOAT *)blas_memory_alloc(0);
+
+  sa = (XFLOAT *)((BLASLONG)buffer + GEMM_OFFSET_A);
+  sb = (XFLOAT *)(((BLASLONG)sa + ((GEMM_P * GEMM_Q * COMPSIZE * SIZE + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+#ifdef SMP
+  nthreads = num_cpu_avail(3);
+
+  if (nthreads > 1 && nums >= nthreads) {
+
+    total = 0.;
+    for (i = 0; i < nums; i++) total += entry_work(&args_array[i]);
+
+    /* contiguous runs of roughly total / nthreads work each, keeping
+       enough entries back that every thread gets at least one */
+    range[0] = 0;
+    num_cpu  = 0;
+    work     = 0.;
+    target   = total / (double)nthreads;
+
+    for (i = 0; i < nums; i++) {
+      work += entry_work(&args_array[i]);
+
+      if ((work >= target * (double)(num_cpu + 1) || nums - i - 1 <= nthreads - num_cpu - 1)
+	  && num_cpu < nthreads - 1 && i < nums - 1) {
+	range[num_cpu + 1] = i + 1;
+	num_cpu ++;
+      }
+    }
+    range[num_cpu + 1] = nums;
+    num_cpu ++;
+
+    for (i = 0; i < num_cpu; i++) {
+      queue[i].mode    = mode;
+      queue[i].routine = inner_thread;
+      queue[i].args    = args_array;
+      queue[i].range_m = &range[i];
+      queue[i].range_n = NULL;
+      queue[i].sa      = NULL;
+      queue[i].sb      = NULL;
+      queue[i].next    = &queue[i + 1];
+    }
+    queue[0].sa = sa;
+    queue[0].sb = sb;
+    queue[num_cpu - 1].next = NULL;
+
+    exec_blas(num_cpu, queue);
+
+  } else {
+
+    for (i = 0; i < nums; i++) {
+#ifndef USE_SIMPLE_THREADED_LEVEL3
+      if (nthreads > 1 && !(args_array[i].routine_mode & BLAS_SMALL_OPT) &&
+	  (double)args_array[i].m * (double)args_array[i].n * (double)args_array[i].k
+	  > SMP_THRESHOLD_MIN * (double)GEMM_MULTITHREAD_THRESHOLD) {
+	args_array[i].nthreads = nthreads;
+	args_array[i].common   = NULL;
+	(gemm_thread[TRANS_INDEX(&args_array[i])])(&args_array[i], NULL, NULL, sa, sb, 0);
+	continue;
+      }
+#endif
+      args_array[i].nthreads = 1;
+      exec_entry(&args_array[i], sa, sb);
+    }
+  }
+#else
+  for (i = 0; i < nums; i++) exec_entry(&args_array[i], sa, sb);
+#endif
+
+  blas_memory_free(buffer);
+
+  return 0;
+}
@@ -0,0 +1,196 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include "common.h"
+
+/*
+ * C := op(A) * op(B) + beta * C where A (PACKED_A), B (PACKED_B) or both
+ * were packed by ?gemm_pack.  The blocking follows level3.c, but a packed
+ * operand is handed to the kernel in place: block ls of a packed panel
+ * starts at ls * dim, and rows / columns inside a block are offset by
+ * min_l per row / column.  alpha is already part of the packed operand;
+ * args -> alpha is passed to the kernel unchanged (normally one).
+ *
+ * With more than one thread the columns of C are split into ranges
+ * aligned to GEMM_UNROLL_N, so each thread owns whole column groups of a
+ * packed B and packs its own copies of any unpacked operand.
+ */
+
+#ifndef TRANSA
+#define ICOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_ITCOPY(M, N, (FLOAT *)(A) + ((Y) + (X) * (LDA)), LDA, BUFFER);
+#else
+#define ICOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_INCOPY(M, N, (FLOAT *)(A) + ((X) + (Y) * (LDA)), LDA, BUFFER);
+#endif
+
+#ifndef TRANSB
+#define OCOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_ONCOPY(M, N, (FLOAT *)(A) + ((X) + (Y) * (LDA)), LDA, BUFFER);
+#else
+#define OCOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_OTCOPY(M, N, (FLOAT *)(A) + ((Y) + (X) * (LDA)), LDA, BUFFER);
+#endif
+
+static int inner_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG mypos){
+
+  FLOAT *a, *b, *c, *alpha, *beta;
+  FLOAT *pa, *pb;
+  BLASLONG m, n, k, ldc;
+#ifndef PACKED_A
+  BLASLONG lda;
+#endif
+#ifndef PACKED_B
+  BLASLONG ldb;
+#endif
+  BLASLONG n_from, n_to;
+  BLASLONG ls, is, js, min_l, min_i, min_j, gemm_r;
+
+  m = args -> m;
+  n = args -> n;
+  k = args -> k;
+
+#ifdef PACKED_A
+  a = GEMM_PACK_DATA(args -> a);
+#else
+  a = (FLOAT *)args -> a;
+  lda = args -> lda;
+#endif
+#ifdef PACKED_B
+  b = GEMM_PACK_DATA(args -> b);
+#else
+  b = (FLOAT *)args -> b;
+  ldb = args -> ldb;
+#endif
+  c = (FLOAT *)args -> c;
+
+  ldc = args -> ldc;
+
+  alpha = (FLOAT *)args -> alpha;
+  beta  = (FLOAT *)args -> beta;
+
+  n_from = 0;
+  n_to   = n;
+
+  if (range_n) {
+    n_from = range_n[0];
+    n_to   = range_n[1];
+  }
+
+  if (beta[0] != ONE)
+    GEMM_BETA(m, n_to - n_from, 0, beta[0], NULL, 0, NULL, 0, c + n_from * ldc, ldc);
+
+  if (k == 0 || alpha[0] == ZERO) return 0;
+
+  /* column blocks must start on a column group of the packed B */
+  gemm_r = (GEMM_R / GEMM_UNROLL_N) * GEMM_UNROLL_N;
+  if (gemm_r <= 0) gemm_r = GEMM_UNROLL_N;
+
+  for (js = n_from; js < n_to; js += min_j) {
+    min_j = n_to - js;
+    if (min_j > gemm_r) min_j = gemm_r;
+
+    for (ls = 0; ls < k; ls += min_l) {
+      min_l = GEMM_PACK_MIN_L(k - ls);
+
+#ifdef PACKED_B
+      pb = b + ls * n + min_l * js;
+#else
+      OCOPY_OPERATION(min_l, min_j, b, ldb, ls, js, sb);
+      pb = sb;
+#endif
+
+      for (is = 0; is < m; is += min_i) {
+	min_i = m - is;
+
+	if (min_i >= GEMM_P * 2) {
+	  min_i = GEMM_P;
+	} else
+	  if (min_i > GEMM_P) {
+	    min_i = ((min_i / 2 + GEMM_UNROLL_M - 1)/GEMM_UNROLL_M) * GEMM_UNROLL_M;
+	  }
+
+#ifdef PACKED_A
+	pa = a + ls * m + min_l * is;
+#else
+	ICOPY_OPERATION(min_l, min_i, a, lda, ls, is, sa);
+	pa = sa;
+#endif
+
+	GEMM_KERNEL_N(min_i, min_j, min_l, alpha[0], pa, pb, c + is + js * ldc, ldc);
+      }
+    }
+  }
+
+  return 0;
+}
+
+int CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG mypos){
+
+#ifdef SMP
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  BLASLONG range[MAX_CPU_NUMBER + 1];
+  BLASLONG n, width, num_cpu;
+#ifdef DOUBLE
+  int mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+
+  n = args -> n;
+
+  if (args -> nthreads > 1 && n > GEMM_UNROLL_N) {
+
+    width = (n + args -> nthreads - 1) / args -> nthreads;
+    width = ((width + GEMM_UNROLL_N - 1) / GEMM_UNROLL_N) * GEMM_UNROLL_N;
+
+    num_cpu  = 0;
+    range[0] = 0;
+
+    while (range[num_cpu] < n) {
+      range[num_cpu + 1] = MIN(range[num_cpu] + width, n);
+
+      queue[num_cpu].mode    = mode;
+      queue[num_cpu].routine = inner_thread;
+      queue[num_cpu].args    = args;
+      queue[num_cpu].range_m = NULL;
+      queue[num_cpu].range_n = &range[num_cpu];
+      queue[num_cpu].sa      = NULL;
+      queue[num_cpu].sb      = NULL;
+      queue[num_cpu].next    = &queue[num_cpu + 1];
+      num_cpu ++;
+    }
+
+    queue[0].sa = sa;
+    queue[0].sb = sb;
+    queue[num_cpu - 1].next = NULL;
+
+    exec_blas(num_cpu, queue);
+
+    return 0;
+  }
+#endif
+
+  return inner_thread(args, range_m, range_n, sa, sb, mypos);
+}
@@ -0,0 +1,89 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include "common.h"
+
+/*
+ * Packs one GEMM operand for ?gemm_compute.  The operand is cut into the
+ * same k blocks the compute driver walks (GEMM_PACK_MIN_L) and every block
+ * is copied with the level3 copy routines, so block ls starts at ls * dim
+ * and holds exactly what level3.c would have built in sa (PACK_A) or sb.
+ * alpha is folded into the packed values.
+ */
+
+#ifdef PACK_A
+#ifndef TRANSA
+#define COPY_OPERATION(M, N, A, LDA, X, BUFFER) GEMM_ITCOPY(M, N, (FLOAT *)(A) + (X) * (LDA), LDA, BUFFER)
+#else
+#define COPY_OPERATION(M, N, A, LDA, X, BUFFER) GEMM_INCOPY(M, N, (FLOAT *)(A) + (X), LDA, BUFFER)
+#endif
+#define DIM(args)	((args) -> m)
+#else
+#ifndef TRANSB
+#define COPY_OPERATION(M, N, A, LDA, X, BUFFER) GEMM_ONCOPY(M, N, (FLOAT *)(A) + (X), LDA, BUFFER)
+#else
+#define COPY_OPERATION(M, N, A, LDA, X, BUFFER) GEMM_OTCOPY(M, N, (FLOAT *)(A) + (X) * (LDA), LDA, BUFFER)
+#endif
+#define DIM(args)	((args) -> n)
+#endif
+
+int CNAME(blas_arg_t *args){
+
+  gemm_pack_t *handle = (gemm_pack_t *)args -> c;
+  FLOAT *a, *packed, alpha;
+  BLASLONG k, lda, dim, ls, min_l;
+
+  a     = (FLOAT *)args -> a;
+  lda   = args -> lda;
+  k     = args -> k;
+  dim   = DIM(args);
+  alpha = *(FLOAT *)args -> alpha;
+
+#ifdef PACK_A
+  handle -> identifier = 0;
+#else
+  handle -> identifier = 1;
+#endif
+  handle -> dim      = dim;
+  handle -> k        = k;
+  handle -> q        = GEMM_Q;
+  handle -> unroll_m = GEMM_UNROLL_M;
+  handle -> unroll_n = GEMM_UNROLL_N;
+
+  packed = GEMM_PACK_DATA(handle);
+
+  for (ls = 0; ls < k; ls += min_l) {
+    min_l = GEMM_PACK_MIN_L(k - ls);
+
+    COPY_OPERATION(min_l, dim, a, lda, ls, packed + ls * dim);
+  }
+
+  if (alpha != ONE) SCAL_K(dim * k, 0, 0, alpha, packed, 1, NULL, 0, NULL, 0);
+
+  return 0;
+}
@@ -0,0 +1,254 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "common.h"
+
+/* Dynamic tile scheduler.  The (m, n) range is cut into about
+   GEMM_DYNAMIC_TILES tiles per thread.  Each thread starts with a
+   contiguous run of tiles in its own queue and takes them from the
+   front.  A thread whose queue is empty steals the back half of
+   another thread's queue, so a slow core hands its remaining work to
+   the others instead of holding up the whole call.  Every tile is
+   computed by the single-threaded routine in function. */
+
+#ifndef GEMM_DYNAMIC_TILES
+#define GEMM_DYNAMIC_TILES	4
+#endif
+
+#define MAX_TILE_SPLIT	(MAX_CPU_NUMBER * GEMM_DYNAMIC_TILES)
+
+typedef struct {
+  volatile BLASULONG lock;
+  volatile BLASLONG  head, tail;
+  BLASLONG pad[13];
+} tile_queue_t;
+
+typedef struct {
+  blas_arg_t *args;
+  int (*function)();
+  BLASLONG *range_M, *range_N;
+  BLASLONG tiles_m, nthreads;
+  tile_queue_t *queue;
+} tile_sched_t;
+
+static BLASLONG tile_pop(tile_queue_t *q){
+
+  BLASLONG tile = -1;
+
+  blas_lock(&q -> lock);
+  if (q -> head < q -> tail) tile = q -> head ++;
+  blas_unlock(&q -> lock);
+
+  return tile;
+}
+
+static BLASLONG tile_steal(tile_sched_t *s, BLASLONG mypos){
+
+  tile_queue_t *mine = &s -> queue[mypos], *victim;
+  BLASLONG i, from, to;
+
+  for (i = 1; i < s -> nthreads; i++) {
+
+    victim = &s -> queue[(mypos + i) % s -> nthreads];
+
+    if (victim -> head >= victim -> tail) continue;
+
+    blas_lock(&victim -> lock);
+    to   = victim -> tail;
+    from = to - (to - victim -> head + 1) / 2;
+    if (from < to) victim -> tail = from;
+    blas_unlock(&victim -> lock);
+
+    if (from < to) {
+      /* Keep the first stolen tile, queue the rest so they can be stolen back */
+      blas_lock(&mine -> lock);
+      mine -> head = from + 1;
+      mine -> tail = to;
+      blas_unlock(&mine -> lock);
+      return from;
+    }
+  }
+
+  return -1;
+}
+
+static int tile_worker(blas_arg_t *arg, BLASLONG *range_m, BLASLONG *range_n, void *sa, void *sb, BLASLONG mypos){
+
+  tile_sched_t *s = (tile_sched_t *)arg -> common;
+  BLASLONG tile, i, j;
+  BLASLONG tile_m[2], tile_n[2];
+
+  while (1) {
+
+    tile = tile_pop(&s -> queue[mypos]);
+    if (tile < 0) tile = tile_steal(s, mypos);
+    if (tile < 0) break;
+
+    j = tile / s -> tiles_m;
+    i = tile - j * s -> tiles_m;
+
+    tile_m[0] = s -> range_M[i];
+    tile_m[1] = s -> range_M[i + 1];
+    tile_n[0] = s -> range_N[j];
+    tile_n[1] = s -> range_N[j + 1];
+
+    (s -> function)(s -> args, tile_m, tile_n, sa, sb, mypos);
+  }
+
+  return 0;
+}
+
+static BLASLONG split_range(BLASLONG from, BLASLONG length, BLASLONG parts, BLASLONG unroll, BLASLONG *range){
+
+  BLASLONG width, num = 0;
+
+  range[0] = from;
+
+  while (length > 0) {
+
+    width = blas_quickdivide(length + parts - num - 1, parts - num);
+    width = ((width + unroll - 1) / unroll) * unroll;
+    if (width > length) width = length;
+
+    length -= width;
+    range[num + 1] = range[num] + width;
+
+    num ++;
+  }
+
+  return num;
+}
+
+int CNAME(int mode, blas_arg_t *arg, BLASLONG *range_m, BLASLONG *range_n, int (*function)(), void *sa, void *sb, BLASLONG nthreads) {
+
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  tile_queue_t tiles[MAX_CPU_NUMBER];
+
+  BLASLONG range_M[MAX_TILE_SPLIT + 1], range_N[MAX_TILE_SPLIT + 1];
+
+  blas_arg_t newarg;
+  tile_sched_t sched;
+
+  BLASLONG m_from, m, n_from, n;
+  BLASLONG unroll_m, unroll_n;
+  BLASLONG target, tiles_m, tiles_n, num_tiles, i;
+
+  if (!range_m) {
+    m_from = 0;
+    m      = arg -> m;
+  } else {
+    m_from = range_m[0];
+    m      = range_m[1] - range_m[0];
+  }
+
+  if (!range_n) {
+    n_from = 0;
+    n      = arg -> n;
+  } else {
+    n_from = range_n[0];
+    n      = range_n[1] - range_n[0];
+  }
+
+  if ((m <= 0) || (n <= 0)) return 0;
+
+  /* Keep tile edges on the kernel unroll so no tile needs an edge kernel */
+  switch (mode & (BLAS_PREC | BLAS_COMPLEX)) {
+  case BLAS_SINGLE | BLAS_REAL :
+    unroll_m = SGEMM_UNROLL_M;
+    unroll_n = SGEMM_UNROLL_N;
+    break;
+  case BLAS_SINGLE | BLAS_COMPLEX :
+    unroll_m = CGEMM_UNROLL_M;
+    unroll_n = CGEMM_UNROLL_N;
+    break;
+  case BLAS_DOUBLE | BLAS_COMPLEX :
+    unroll_m = ZGEMM_UNROLL_M;
+    unroll_n = ZGEMM_UNROLL_N;
+    break;
+  default :
+    unroll_m = DGEMM_UNROLL_M;
+    unroll_n = DGEMM_UNROLL_N;
+    break;
+  }
+
+  /* Choose a grid of roughly square tiles */
+  target  = nthreads * GEMM_DYNAMIC_TILES;
+  tiles_m = 1;
+  while ((tiles_m < target) && (tiles_m * tiles_m * n < target * m)) tiles_m ++;
+  tiles_n = (target + tiles_m - 1) / tiles_m;
+
+  if (tiles_m > (m + unroll_m - 1) / unroll_m) tiles_m = (m + unroll_m - 1) / unroll_m;
+  if (tiles_n > (n + unroll_n - 1) / unroll_n) tiles_n = (n + unroll_n - 1) / unroll_n;
+  if (tiles_m > MAX_TILE_SPLIT) tiles_m = MAX_TILE_SPLIT;
+  if (tiles_n > MAX_TILE_SPLIT) tiles_n = MAX_TILE_SPLIT;
+
+  tiles_m = split_range(m_from, m, tiles_m, unroll_m, range_M);
+  tiles_n = split_range(n_from, n, tiles_n, unroll_n, range_N);
+
+  num_tiles = tiles_m * tiles_n;
+  if (nthreads > num_tiles) nthreads = num_tiles;
+
+  newarg = *arg;
+  newarg.common = (void *)&sched;
+
+  sched.args     = arg;
+  sched.function = function;
+  sched.range_M  = range_M;
+  sched.range_N  = range_N;
+  sched.tiles_m  = tiles_m;
+  sched.nthreads = nthreads;
+  sched.queue    = tiles;
+
+  /* Tiles are numbered down the columns, so the initial runs share B panels */
+  for (i = 0; i < nthreads; i++) {
+    tiles[i].lock = 0;
+    tiles[i].head = blas_quickdivide(num_tiles *  i,      nthreads);
+    tiles[i].tail = blas_quickdivide(num_tiles * (i + 1), nthreads);
+
+    queue[i].mode    = mode;
+    queue[i].routine = tile_worker;
+    queue[i].args    = &newarg;
+    queue[i].range_m = NULL;
+    queue[i].range_n = NULL;
+    queue[i].sa      = NULL;
+    queue[i].sb      = NULL;
+    queue[i].next    = &queue[i + 1];
+  }
+
+  queue[0].sa = sa;
+  queue[0].sb = sb;
+
+  queue[nthreads - 1].next = NULL;
+
+  WMB;
+
+  exec_blas(nthreads, queue);
+
+  return 0;
+}
@@ -0,0 +1,209 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include "common.h"
+
+/*
+ * GEMMT : C := alpha * op(A) * op(B) + beta * C, updating only the UPPER
+ * (default) or LOWER triangle of the n x n matrix C.
+ *
+ * The loop nest is the one of level3.c restricted to the row blocks that
+ * reach the triangle of each column panel; blocks that straddle the
+ * diagonal go through the syrk kernel, which computes the triangular part
+ * only and falls back to the gemm kernel for tiles entirely inside the
+ * triangle.  A and B are packed with the gemm copy routines, so unlike
+ * SYRK the two operands may differ.  Threaded through syrk_thread().
+ */
+
+#ifndef TRANSA
+#define ICOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_ITCOPY(M, N, (FLOAT *)(A) + ((Y) + (X) * (LDA)) * COMPSIZE, LDA, BUFFER);
+#else
+#define ICOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_INCOPY(M, N, (FLOAT *)(A) + ((X) + (Y) * (LDA)) * COMPSIZE, LDA, BUFFER);
+#endif
+
+#ifndef TRANSB
+#define OCOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_ONCOPY(M, N, (FLOAT *)(A) + ((X) + (Y) * (LDA)) * COMPSIZE, LDA, BUFFER);
+#else
+#define OCOPY_OPERATION(M, N, A, LDA, X, Y, BUFFER) GEMM_OTCOPY(M, N, (FLOAT *)(A) + ((Y) + (X) * (LDA)) * COMPSIZE, LDA, BUFFER);
+#endif
+
+#ifndef COMPLEX
+#ifndef LOWER
+#define KERNEL_FUNC	SYRK_KERNEL_U
+#else
+#define KERNEL_FUNC	SYRK_KERNEL_L
+#endif
+#else
+#if   !defined(CONJA) && !defined(CONJB)
+#ifndef LOWER
+#define KERNEL_FUNC	SYRK_KERNEL_U
+#else
+#define KERNEL_FUNC	SYRK_KERNEL_L
+#endif
+#elif  defined(CONJA) && !defined(CONJB)
+#ifndef LOWER
+#define KERNEL_FUNC	GEMMT_KERNEL_UL
+#else
+#define KERNEL_FUNC	GEMMT_KERNEL_LL
+#endif
+#elif !defined(CONJA) &&  defined(CONJB)
+#ifndef LOWER
+#define KERNEL_FUNC	GEMMT_KERNEL_UR
+#else
+#define KERNEL_FUNC	GEMMT_KERNEL_LR
+#endif
+#else
+#ifndef LOWER
+#define KERNEL_FUNC	GEMMT_KERNEL_UB
+#else
+#define KERNEL_FUNC	GEMMT_KERNEL_LB
+#endif
+#endif
+#endif
+
+#ifndef COMPLEX
+#define KERNEL_OPERATION(M, N, K, ALPHA, SA, SB, C, LDC, X, Y) \
+	KERNEL_FUNC(M, N, K, ALPHA[0], SA, SB, (FLOAT *)(C) + ((X) + (Y) * LDC) * COMPSIZE, LDC, (X) - (Y))
+#else
+#define KERNEL_OPERATION(M, N, K, ALPHA, SA, SB, C, LDC, X, Y) \
+	KERNEL_FUNC(M, N, K, ALPHA[0], ALPHA[1], SA, SB, (FLOAT *)(C) + ((X) + (Y) * LDC) * COMPSIZE, LDC, (X) - (Y))
+#endif
+
+/* scale the triangle of columns n_from .. n_to by beta */
+static __inline void gemmt_beta(BLASLONG n, BLASLONG n_from, BLASLONG n_to, FLOAT *beta, FLOAT *c, BLASLONG ldc) {
+
+  BLASLONG j;
+
+  for (j = n_from; j < n_to; j++) {
+#ifndef LOWER
+    SCAL_K(j + 1, 0, 0, beta[0],
+#ifdef COMPLEX
+	   beta[1],
+#endif
+	   c + j * ldc * COMPSIZE, 1, NULL, 0, NULL, 0);
+#else
+    SCAL_K(n - j, 0, 0, beta[0],
+#ifdef COMPLEX
+	   beta[1],
+#endif
+	   c + (j + j * ldc) * COMPSIZE, 1, NULL, 0, NULL, 0);
+#endif
+  }
+}
+
+int CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG dummy) {
+
+  BLASLONG n, k, lda, ldb, ldc;
+  BLASLONG n_from, n_to;
+  FLOAT *a, *b, *c, *alpha, *beta;
+
+  BLASLONG ls, is, js;
+  BLASLONG min_l, min_i, min_j;
+  BLASLONG m_start, m_end;
+
+  n = args -> n;
+  k = args -> k;
+
+  a = (FLOAT *)args -> a;
+  b = (FLOAT *)args -> b;
+  c = (FLOAT *)args -> c;
+
+  lda = args -> lda;
+  ldb = args -> ldb;
+  ldc = args -> ldc;
+
+  alpha = (FLOAT *)args -> alpha;
+  beta  = (FLOAT *)args -> beta;
+
+  n_from = 0;
+  n_to   = n;
+
+  if (range_n) {
+    n_from = *(((BLASLONG *)range_n) + 0);
+    n_to   = *(((BLASLONG *)range_n) + 1);
+  }
+
+  if (beta) {
+#ifndef COMPLEX
+    if (beta[0] != ONE)
+#else
+    if ((beta[0] != ONE) || (beta[1] != ZERO))
+#endif
+      gemmt_beta(n, n_from, n_to, beta, c, ldc);
+  }
+
+  if ((k == 0) || (alpha == NULL)) return 0;
+
+  if (alpha[0] == ZERO
+#ifdef COMPLEX
+      && alpha[1] == ZERO
+#endif
+      ) return 0;
+
+  for(js = n_from; js < n_to; js += GEMM_R){
+    min_j = n_to - js;
+    if (min_j > GEMM_R) min_j = GEMM_R;
+
+    /* rows that meet the triangle inside this column panel */
+#ifndef LOWER
+    m_start = 0;
+    m_end   = js + min_j;
+#else
+    m_start = js;
+    m_end   = n;
+#endif
+
+    for(ls = 0; ls < k; ls += min_l){
+      min_l = k - ls;
+      if (min_l >= GEMM_Q * 2) {
+	min_l = GEMM_Q;
+      } else
+	if (min_l > GEMM_Q) {
+	  min_l = ((min_l / 2 + GEMM_UNROLL_MN - 1)/GEMM_UNROLL_MN) * GEMM_UNROLL_MN;
+	}
+
+      OCOPY_OPERATION(min_l, min_j, b, ldb, ls, js, sb);
+
+      for(is = m_start; is < m_end; is += min_i){
+	min_i = m_end - is;
+	if (min_i >= GEMM_P * 2) {
+	  min_i = GEMM_P;
+	} else
+	  if (min_i > GEMM_P) {
+	    min_i = ((min_i / 2 + GEMM_UNROLL_MN - 1)/GEMM_UNROLL_MN) * GEMM_UNROLL_MN;
+	  }
+
+	ICOPY_OPERATION(min_l, min_i, a, lda, ls, is, sa);
+
+	KERNEL_OPERATION(min_i, min_j, min_l, alpha, sa, sb, c, ldc, is, js);
+      }
+    }
+  }
+
+  return 0;
+}
@@ -165,8 +165,9 @@
 #define START_RPCC()		rpcc_counter = rpcc()
 #define STOP_RPCC(COUNTER)	COUNTER  += rpcc() - rpcc_counter
 #else
-#define START_RPCC()
-#define STOP_RPCC(COUNTER)
+/* only a traced call pays for the counters */
+#define START_RPCC()		if (trace) rpcc_counter = rpcc()
+#define STOP_RPCC(COUNTER)	if (trace) COUNTER  += rpcc() - rpcc_counter
 #endif
 
 int CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n,
@@ -189,11 +190,12 @@ int CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n,
   xidouble xalpha;
 #endif
 
-#ifdef TIMING
-  unsigned long long rpcc_counter;
+  blas_trace_t *trace = blas_trace_current();
+  unsigned long long rpcc_counter = 0;
   unsigned long long innercost  = 0;
   unsigned long long outercost  = 0;
   unsigned long long kernelcost = 0;
+#ifdef TIMING
   double total;
 #endif
 
@@ -396,6 +398,7 @@ int CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n,
     } /* end of js */
   } /* end of ls */
 
+  if (trace) blas_trace_cost(trace, innercost + outercost, kernelcost);
 
 #ifdef TIMING
   total = (double)outercost + (double)innercost + (double)kernelcost;
@@ -886,7 +886,8 @@ InitializeCriticalSection((PCRITICAL_SECTION)&level3_lock);
 
 #ifndef USE_OPENMP
 #ifndef OS_WINDOWS
-pthread_mutex_lock(&level3_lock);
+/* A caller on its own thread pool shares no threads with other callers */
+if (!blas_pool_threads()) pthread_mutex_lock(&level3_lock);
 #else
 EnterCriticalSection((PCRITICAL_SECTION)&level3_lock);
 #endif
@@ -998,7 +999,7 @@ EnterCriticalSection((PCRITICAL_SECTION)&level3_lock);
 
 #ifndef USE_OPENMP
 #ifndef OS_WINDOWS
-  pthread_mutex_unlock(&level3_lock);
+  if (!blas_pool_threads()) pthread_mutex_unlock(&level3_lock);
 #else
   LeaveCriticalSection((PCRITICAL_SECTION)&level3_lock);
 #endif
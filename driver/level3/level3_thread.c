@@ -215,8 +215,9 @@ typedef struct {
 #define START_RPCC()		rpcc_counter = rpcc()
 #define STOP_RPCC(COUNTER)	COUNTER  += rpcc() - rpcc_counter
 #else
-#define START_RPCC()
-#define STOP_RPCC(COUNTER)
+/* only a traced call pays for the counters */
+#define START_RPCC()		if (trace) rpcc_counter = rpcc()
+#define STOP_RPCC(COUNTER)	if (trace) COUNTER  += rpcc() - rpcc_counter
 #endif
 
 static int inner_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, IFLOAT *sa, IFLOAT *sb, BLASLONG mypos){
@@ -240,14 +241,15 @@ static int inner_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n,
   BLASLONG i, current;
   BLASLONG l1stride;
 
+  blas_trace_t *trace = blas_trace_current();
+  unsigned long long rpcc_counter = 0;
+  unsigned long long copy_A = 0;
+  unsigned long long copy_B = 0;
+  unsigned long long kernel = 0;
+  unsigned long long waiting1 = 0;
+  unsigned long long waiting2 = 0;
+  unsigned long long waiting3 = 0;
 #ifdef TIMING
-  BLASULONG rpcc_counter;
-  BLASULONG copy_A = 0;
-  BLASULONG copy_B = 0;
-  BLASULONG kernel = 0;
-  BLASULONG waiting1 = 0;
-  BLASULONG waiting2 = 0;
-  BLASULONG waiting3 = 0;
   BLASULONG waiting6[MAX_CPU_NUMBER];
   BLASULONG ops    = 0;
 
@@ -506,6 +508,8 @@ static int inner_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n,
   STOP_RPCC(waiting3);
   MB;
 
+  if (trace) blas_trace_cost(trace, copy_A + copy_B, kernel);
+
 #ifdef TIMING
   BLASLONG waiting = waiting1 + waiting2 + waiting3;
   BLASLONG total = copy_A + copy_B + kernel + waiting;
@@ -587,7 +591,8 @@ InitializeCriticalSection((PCRITICAL_SECTION)&level3_lock);
 
 #ifndef USE_OPENMP
 #ifndef OS_WINDOWS
-pthread_mutex_lock(&level3_lock);
+/* A caller on its own thread pool shares no threads with other callers */
+if (!blas_pool_threads()) pthread_mutex_lock(&level3_lock);
 #else
 EnterCriticalSection((PCRITICAL_SECTION)&level3_lock);
 #endif
@@ -720,7 +725,7 @@ EnterCriticalSection((PCRITICAL_SECTION)&level3_lock);
 
 #ifndef USE_OPENMP
 #ifndef OS_WINDOWS
-  pthread_mutex_unlock(&level3_lock);
+  if (!blas_pool_threads()) pthread_mutex_unlock(&level3_lock);
 #else
   LeaveCriticalSection((PCRITICAL_SECTION)&level3_lock);
 #endif
@@ -181,3 +181,106 @@ int blas_level1_thread_with_return_value(int mode, BLASLONG m, BLASLONG n, BLASL
 
   return 0;
 }
+
+/* Deterministic reductions.  The vector is cut into leaves whose
+   boundaries depend only on its length, each leaf is reduced on its own
+   and the leaf partials are summed along a fixed pairwise tree, so the
+   result does not depend on how many threads take part. */
+
+#define REDUCE_LEAF_MIN	2048
+#define REDUCE_LEAVES	256
+#define REDUCE_PARTS	4
+
+static BLASLONG reduce_leaf_start(BLASLONG n, BLASLONG leaves, BLASLONG i){
+  return (n / leaves) * i + MIN(i, n % leaves);
+}
+
+static int reduce_leaves(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n,
+			 void *sa, void *sb, BLASLONG pos){
+
+  int (*leaf)(BLASLONG, void *, BLASLONG, void *, BLASLONG, double *) = args -> common;
+  double *partial = (double *)args -> c;
+  BLASLONG i, from, to, size = args -> k;
+
+  for (i = range_m[0]; i < range_m[1]; i++) {
+    from = reduce_leaf_start(args -> m, args -> n, i);
+    to   = reduce_leaf_start(args -> m, args -> n, i + 1);
+
+    leaf(to - from,
+	 (char *)args -> a + from * args -> lda * size, args -> lda,
+	 (char *)args -> b + from * args -> ldb * size, args -> ldb,
+	 partial + i * REDUCE_PARTS);
+  }
+
+  return 0;
+}
+
+/* leaf(n, x, incx, y, incy, partial) stores up to four components of its
+   partial result, the others stay zero; result receives their sums over
+   all leaves. */
+int blas_level1_thread_reduce(int mode, BLASLONG n,
+			      void *x, BLASLONG incx,
+			      void *y, BLASLONG incy,
+			      double *result, int (*leaf)(), int nthreads){
+
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  blas_arg_t   args;
+  BLASLONG     range[MAX_CPU_NUMBER + 1];
+  double       partial[REDUCE_LEAVES * REDUCE_PARTS];
+
+  BLASLONG i, j, step, leaves;
+  int num_cpu;
+
+  leaves = MIN(MAX(n / REDUCE_LEAF_MIN, 1), REDUCE_LEAVES);
+
+  for (i = 0; i < leaves * REDUCE_PARTS; i++) partial[i] = 0.0;
+
+  args.m = n;
+  args.n = leaves;
+  args.k = (BLASLONG)1 << ((mode & BLAS_PREC) + ((mode & BLAS_COMPLEX) != 0) + 2);
+  args.a = x;
+  args.b = y;
+  args.c = (void *)partial;
+  args.lda = incx;
+  args.ldb = incy;
+  args.common = (void *)leaf;
+
+  if (nthreads > leaves) nthreads = leaves;
+
+  range[0] = 0;
+
+  if (nthreads <= 1) {
+
+    range[1] = leaves;
+    reduce_leaves(&args, range, NULL, NULL, NULL, 0);
+
+  } else {
+
+    for (num_cpu = 0; num_cpu < nthreads; num_cpu ++) {
+      range[num_cpu + 1] = (leaves * (num_cpu + 1)) / nthreads;
+
+      blas_queue_init(&queue[num_cpu]);
+      queue[num_cpu].mode    = mode;
+      queue[num_cpu].routine = reduce_leaves;
+      queue[num_cpu].args    = &args;
+      queue[num_cpu].range_m = &range[num_cpu];
+      queue[num_cpu].range_n = NULL;
+      queue[num_cpu].next    = &queue[num_cpu + 1];
+    }
+
+    queue[num_cpu - 1].next = NULL;
+
+    exec_blas(num_cpu, queue);
+  }
+
+  for (step = 1; step < leaves; step *= 2) {
+    for (i = 0; i + step < leaves; i += step * 2) {
+      for (j = 0; j < REDUCE_PARTS; j++)
+	partial[i * REDUCE_PARTS + j] += partial[(i + step) * REDUCE_PARTS + j];
+    }
+  }
+
+  for (j = 0; j < REDUCE_PARTS; j++) result[j] = partial[j];
+
+  return 0;
+}
@@ -125,6 +125,12 @@ static unsigned long server_lock       = 0;
 #define THREAD_STATUS_SLEEP		2
 #define THREAD_STATUS_WAKEUP		4
 
+/* On Linux an idle thread parks on a futex word instead of the      */
+/* condition variable, so waking it needs no mutex at all.           */
+#if defined(OS_LINUX) && defined(SYS_futex) && !defined(__LSB_VERSION__)
+#define USE_FUTEX_WAIT
+#endif
+
 static pthread_t       blas_threads [MAX_CPU_NUMBER];
 
 typedef struct {
@@ -139,6 +145,26 @@ typedef struct {
   pthread_mutex_t	 lock;
   pthread_cond_t	 wakeup;
 
+#ifdef USE_FUTEX_WAIT
+  volatile int		 parked;
+#endif
+
+  /* Spin window and running average of the idle gaps (in rpcc ticks) */
+  unsigned int		 spin;
+  unsigned int		 gap;
+
+#ifdef OS_LINUX
+  /* CPUs the queued job may use (cpuset_id 0: no limit), the set the */
+  /* thread currently runs with and its affinity before the first one */
+  BLASULONG		 cpuset_id;
+  BLASULONG		 applied_id;
+  cpu_set_t		*cpuset;
+  cpu_set_t		 home;
+#endif
+
+  /* Traced call the queued job works for, if any */
+  blas_trace_t		*trace;
+
 } thread_status_t;
 
 #if (__STDC_VERSION__ >= 201112L)
@@ -159,6 +185,152 @@ static thread_status_t thread_status[MAX_CPU_NUMBER] __attribute__((aligned(ATTR
 
 static unsigned int thread_timeout = (1U << (THREAD_TIMEOUT));
 
+/* Shortest spin before an idle thread parks itself */
+#ifndef THREAD_SPIN_MIN
+#define THREAD_SPIN_MIN	14
+#endif
+
+/* The spin window follows the gaps between jobs seen by the thread. */
+/* It is twice their running average, so back-to-back calls are      */
+/* caught while spinning, and never more than thread_timeout.  When  */
+/* the gaps are longer than that, spinning cannot catch them anyway  */
+/* and the thread parks after the minimum spin.                      */
+static inline void adapt_spin(thread_status_t *ts, unsigned int gap){
+
+  unsigned long avg;
+  unsigned int spin = (1U << THREAD_SPIN_MIN);
+
+  if (gap > (thread_timeout << 1)) gap = thread_timeout << 1;
+
+  avg = ((unsigned long)ts -> gap * 3 + gap) >> 2;
+  ts -> gap = (unsigned int)avg;
+
+  if ((avg << 1) <= thread_timeout && (avg << 1) > spin) spin = (unsigned int)(avg << 1);
+  if (spin > thread_timeout) spin = thread_timeout;
+
+  ts -> spin = spin;
+}
+
+static inline void init_thread_status(thread_status_t *ts){
+
+  atomic_store_queue(&ts -> queue, (blas_queue_t *)0);
+  ts -> status = THREAD_STATUS_WAKEUP;
+#ifdef USE_FUTEX_WAIT
+  ts -> parked = 0;
+#endif
+  ts -> spin = thread_timeout;
+  ts -> gap  = 0;
+#ifdef OS_LINUX
+  ts -> cpuset_id  = 0;
+  ts -> applied_id = 0;
+  ts -> cpuset     = NULL;
+#endif
+  ts -> trace = NULL;
+
+  pthread_mutex_init(&ts -> lock, NULL);
+  pthread_cond_init (&ts -> wakeup, NULL);
+}
+
+/* Ask the thread to leave its server loop and wake it up */
+static void stop_thread(thread_status_t *ts){
+
+  pthread_mutex_lock (&ts -> lock);
+
+  atomic_store_queue(&ts -> queue, (blas_queue_t *)-1);
+  ts -> status = THREAD_STATUS_WAKEUP;
+  pthread_cond_signal (&ts -> wakeup);
+
+  pthread_mutex_unlock(&ts -> lock);
+
+#ifdef USE_FUTEX_WAIT
+  __atomic_store_n(&ts -> parked, 0, __ATOMIC_SEQ_CST);
+  my_futex_wake(&ts -> parked, 1);
+#endif
+}
+
+/* A caller-owned pool has its own threads and queue lock, so callers */
+/* bound to different pools never wait for each other.  The calling   */
+/* thread works as position 0, like it does for the shared pool.      */
+typedef struct openblas_threadpool {
+  thread_status_t	 status[MAX_CPU_NUMBER];
+  pthread_t		 threads[MAX_CPU_NUMBER];
+  BLASLONG		 nthreads;
+  BLASULONG		 queue_lock;
+} blas_pool_t;
+
+/* Settings of openblas_set_thread_context for one calling thread.    */
+/* Every CPU list gets a new id, so the threads can tell cheaply      */
+/* whether they already run with it.                                  */
+typedef struct {
+  int			 nthreads;
+  int			 policy;
+  int			 ncpus;
+  BLASULONG		 id;
+#ifdef OS_LINUX
+  cpu_set_t		 cpuset;
+#endif
+} blas_context_t;
+
+static pthread_key_t  blas_pool_key;
+static pthread_key_t  blas_context_key;
+static pthread_once_t blas_pool_once = PTHREAD_ONCE_INIT;
+static volatile int   blas_pool_ready = 0;
+static BLASULONG      blas_context_ids = 0;
+
+static void blas_pool_key_init(void){
+  pthread_key_create(&blas_pool_key, NULL);
+  pthread_key_create(&blas_context_key, free);
+  blas_pool_ready = 1;
+}
+
+static inline blas_pool_t *blas_pool_current(void){
+  if (!blas_pool_ready) return NULL;
+  return (blas_pool_t *)pthread_getspecific(blas_pool_key);
+}
+
+static inline blas_context_t *blas_context_current(void){
+  if (!blas_pool_ready) return NULL;
+  return (blas_context_t *)pthread_getspecific(blas_context_key);
+}
+
+int blas_pool_threads(void){
+  blas_pool_t *pool = blas_pool_current();
+  return pool ? (int)pool -> nthreads : 0;
+}
+
+int blas_context_threads(int nthreads){
+
+  blas_context_t *ctx = blas_context_current();
+
+  if (ctx == NULL) return nthreads;
+
+  if (ctx -> policy == BLAS_POLICY_SEQUENTIAL) return 1;
+  if (ctx -> nthreads > 0 && ctx -> nthreads < nthreads) nthreads = ctx -> nthreads;
+  if (ctx -> ncpus    > 0 && ctx -> ncpus    < nthreads) nthreads = ctx -> ncpus;
+
+  return nthreads;
+}
+
+int blas_context_policy(void){
+  blas_context_t *ctx = blas_context_current();
+  return ctx ? ctx -> policy : BLAS_POLICY_DEFAULT;
+}
+
+#ifdef OS_LINUX
+/* Move the thread onto the CPUs of the job it was handed, or back */
+/* to where it ran before when the job has no CPU list.           */
+static void apply_cpuset(thread_status_t *ts){
+
+  if (ts -> applied_id == 0)
+    pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &ts -> home);
+
+  pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t),
+			 ts -> cpuset_id ? ts -> cpuset : &ts -> home);
+
+  ts -> applied_id = ts -> cpuset_id;
+}
+#endif
+
 #ifdef MONITOR
 
 /* Monitor is a function to see thread's status for every second. */
@@ -179,6 +351,9 @@ static int main_status[MAX_CPU_NUMBER];
 #define MAIN_SLEEPING	 0x0b
 #define MAIN_FINISH      0x0c
 #define MAIN_DONE	 0x0d
+
+/* Threads of a caller-owned pool (cpu < 0) have no status slot */
+#define MAIN_STATUS(cpu, st)	do { if ((cpu) >= 0) main_status[cpu] = (st); } while (0)
 #endif
 
 #define BLAS_QUEUE_FINISHED	3
@@ -299,11 +474,11 @@ int openblas_setaffinity(int thread_idx, size_t cpusetsize, cpu_set_t* cpu_set)
 }
 #endif
 
-static void* blas_thread_server(void *arg){
+/* Server loop of one thread, cpu is its position in the shared pool */
+/* or -1 for a thread of a caller-owned pool.                         */
+static void blas_thread_loop(thread_status_t *ts, BLASLONG cpu){
 
-  /* Thread identifier */
-  BLASLONG  cpu = (BLASLONG)arg;
-  unsigned int last_tick;
+  unsigned int last_tick, idle_start;
   void *buffer, *sa, *sb;
   blas_queue_t	*queue;
 
@@ -313,15 +488,8 @@ blas_queue_t *tscq;
   unsigned long start, stop;
 #endif
 
-#if defined(OS_LINUX) && !defined(NO_AFFINITY)
-  if (!increased_threads)
-    thread_status[cpu].node = gotoblas_set_affinity(cpu + 1);
-  else
-    thread_status[cpu].node = gotoblas_set_affinity(-1);
-#endif
-
 #ifdef MONITOR
-  main_status[cpu] = MAIN_ENTER;
+  MAIN_STATUS(cpu, MAIN_ENTER);
 #endif
 
   buffer = blas_memory_alloc(2);
@@ -333,52 +501,72 @@ blas_queue_t *tscq;
   while (1){
 
 #ifdef MONITOR
-    main_status[cpu] = MAIN_QUEUING;
+    MAIN_STATUS(cpu, MAIN_QUEUING);
 #endif
 
 #ifdef TIMING
-    exit_time[cpu] = rpcc();
+    if (cpu >= 0) exit_time[cpu] = rpcc();
 #endif
 
-      last_tick = (unsigned int)rpcc();
+      last_tick = idle_start = (unsigned int)rpcc();
 
-      tscq = atomic_load_queue(&thread_status[cpu].queue);
+      tscq = atomic_load_queue(&ts -> queue);
 
 	while(!tscq) {
 	YIELDING;
 
-	if ((unsigned int)rpcc() - last_tick > thread_timeout) {
+	if ((unsigned int)rpcc() - last_tick > ts -> spin) {
 
 
-	  if (!atomic_load_queue(&thread_status[cpu].queue)) {
-	    pthread_mutex_lock  (&thread_status[cpu].lock);
-	    thread_status[cpu].status = THREAD_STATUS_SLEEP;
-	    while (thread_status[cpu].status == THREAD_STATUS_SLEEP && 
-			    !atomic_load_queue(&thread_status[cpu].queue)) {
+	  if (!atomic_load_queue(&ts -> queue)) {
+#ifdef USE_FUTEX_WAIT
+	    /* Publish parked before the last look at the queue, exec_blas_async */
+	    /* posts the queue before it looks at parked.                        */
+	    __atomic_store_n(&ts -> parked, 1, __ATOMIC_SEQ_CST);
+	    while (__atomic_load_n(&ts -> parked, __ATOMIC_ACQUIRE) &&
+		   !atomic_load_queue(&ts -> queue)) {
 
 #ifdef MONITOR
-	      main_status[cpu] = MAIN_SLEEPING;
+	      MAIN_STATUS(cpu, MAIN_SLEEPING);
 #endif
 
-	      pthread_cond_wait(&thread_status[cpu].wakeup, &thread_status[cpu].lock);
+	      my_futex_wait(&ts -> parked, 1);
 	    }
-	    pthread_mutex_unlock(&thread_status[cpu].lock);
+	    __atomic_store_n(&ts -> parked, 0, __ATOMIC_RELAXED);
+#else
+	    pthread_mutex_lock  (&ts -> lock);
+	    ts -> status = THREAD_STATUS_SLEEP;
+	    __sync_synchronize();
+	    while (ts -> status == THREAD_STATUS_SLEEP && 
+			    !atomic_load_queue(&ts -> queue)) {
+
+#ifdef MONITOR
+	      MAIN_STATUS(cpu, MAIN_SLEEPING);
+#endif
+
+	      pthread_cond_wait(&ts -> wakeup, &ts -> lock);
+	    }
+	    ts -> status = THREAD_STATUS_WAKEUP;
+	    pthread_mutex_unlock(&ts -> lock);
+#endif
 	  }
 
 	  last_tick = (unsigned int)rpcc();
 	}
 
-	tscq = atomic_load_queue(&thread_status[cpu].queue);
+	tscq = atomic_load_queue(&ts -> queue);
 
       }
 
-      queue = atomic_load_queue(&thread_status[cpu].queue);
+      adapt_spin(ts, (unsigned int)rpcc() - idle_start);
+
+      queue = atomic_load_queue(&ts -> queue);
       MB;
 
     if ((long)queue == -1) break;
 
 #ifdef MONITOR
-    main_status[cpu] = MAIN_RECEIVING;
+    MAIN_STATUS(cpu, MAIN_RECEIVING);
 #endif
 
 #ifdef TIMING_DEBUG
@@ -388,7 +576,12 @@ blas_queue_t *tscq;
     if (queue) {
       int (*routine)(blas_arg_t *, void *, void *, void *, void *, BLASLONG) = queue -> routine;
 
-      atomic_store_queue(&thread_status[cpu].queue, (blas_queue_t *)1);
+      atomic_store_queue(&ts -> queue, (blas_queue_t *)1);
+
+#ifdef OS_LINUX
+      if (ts -> cpuset_id != ts -> applied_id) apply_cpuset(ts);
+#endif
+      blas_trace_set_current(ts -> trace);
 
       sa = queue -> sa;
       sb = queue -> sb;
@@ -406,7 +599,7 @@ blas_queue_t *tscq;
 #endif
 
 #ifdef MONITOR
-      main_status[cpu] = MAIN_RUNNING1;
+      MAIN_STATUS(cpu, MAIN_RUNNING1);
 #endif
 
       if (sa == NULL) sa = (void *)((BLASLONG)buffer + GEMM_OFFSET_A);
@@ -446,7 +639,7 @@ blas_queue_t *tscq;
       }
 
 #ifdef MONITOR
-	main_status[cpu] = MAIN_RUNNING2;
+	MAIN_STATUS(cpu, MAIN_RUNNING2);
 #endif
 
       if (queue -> mode & BLAS_LEGACY) {
@@ -463,19 +656,19 @@ blas_queue_t *tscq;
 #endif
 
 #ifdef MONITOR
-      main_status[cpu] = MAIN_FINISH;
+      MAIN_STATUS(cpu, MAIN_FINISH);
 #endif
 
       // arm: make sure all results are written out _before_
       // thread is marked as done and other threads use them
       MB;
-      atomic_store_queue(&thread_status[cpu].queue, (blas_queue_t *)0);
+      atomic_store_queue(&ts -> queue, (blas_queue_t *)0);
 
 
     }
 
 #ifdef MONITOR
-      main_status[cpu] = MAIN_DONE;
+      MAIN_STATUS(cpu, MAIN_DONE);
 #endif
 
 #ifdef TIMING_DEBUG
@@ -495,12 +688,34 @@ blas_queue_t *tscq;
 #endif
 
   blas_memory_free(buffer);
+}
+
+static void* blas_thread_server(void *arg){
+
+  /* Thread identifier */
+  BLASLONG  cpu = (BLASLONG)arg;
+
+#if defined(OS_LINUX) && !defined(NO_AFFINITY)
+  if (!increased_threads)
+    thread_status[cpu].node = gotoblas_set_affinity(cpu + 1);
+  else
+    thread_status[cpu].node = gotoblas_set_affinity(-1);
+#endif
+
+  blas_thread_loop(&thread_status[cpu], cpu);
 
   //pthread_exit(NULL);
 
   return NULL;
 }
 
+static void* blas_pool_server(void *arg){
+
+  blas_thread_loop((thread_status_t *)arg, -1);
+
+  return NULL;
+}
+
 #ifdef MONITOR
 
 static BLASLONG num_suspend = 0;
@@ -588,11 +803,7 @@ int blas_thread_init(void){
 
     for(i = 0; i < blas_num_threads - 1; i++){
 
-      atomic_store_queue(&thread_status[i].queue, (blas_queue_t *)0);
-      thread_status[i].status = THREAD_STATUS_WAKEUP;
-
-      pthread_mutex_init(&thread_status[i].lock, NULL);
-      pthread_cond_init (&thread_status[i].wakeup, NULL);
+      init_thread_status(&thread_status[i]);
 
 #ifdef NEED_STACKATTR
       ret=pthread_create(&blas_threads[i], &attr,
@@ -650,6 +861,12 @@ int exec_blas_async(BLASLONG pos, blas_queue_t *queue){
   BLASLONG i = 0;
   blas_queue_t *current = queue;
   blas_queue_t *tsiq,*tspq;
+  blas_pool_t *pool = blas_pool_current();
+  blas_context_t *ctx = blas_context_current();
+  blas_trace_t *trace = blas_trace_current();
+  thread_status_t *status = thread_status;
+  BLASLONG workers = blas_num_threads - 1;
+  volatile BLASULONG *queue_lock = &exec_queue_lock;
 #if defined(OS_LINUX) && !defined(NO_AFFINITY) && !defined(PARAMTEST)
   int node  = get_node();
   int nodes = get_num_nodes();
@@ -660,7 +877,13 @@ int exec_blas_async(BLASLONG pos, blas_queue_t *queue){
   fprintf(STDERR, "Exec_blas_async is called. Position = %d\n", pos);
 #endif
 
-  blas_lock(&exec_queue_lock);
+  if (pool) {
+    status     = pool -> status;
+    workers    = pool -> nthreads - 1;
+    queue_lock = &pool -> queue_lock;
+  }
+
+  blas_lock(queue_lock);
 
     while (queue) {
       queue -> position  = pos;
@@ -674,16 +897,16 @@ int exec_blas_async(BLASLONG pos, blas_queue_t *queue){
 
       /* Node Mapping Mode */
 
-      if (queue -> mode & BLAS_NODE) {
+      if ((queue -> mode & BLAS_NODE) && !pool) {
 
 	do {
       
-	  while((thread_status[i].node != node || atomic_load_queue(&thread_status[i].queue)) && (i < blas_num_threads - 1)) i ++;
+	  while((status[i].node != node || atomic_load_queue(&status[i].queue)) && (i < workers)) i ++;
 
-	  if (i < blas_num_threads - 1) break;
+	  if (i < workers) break;
 
 	  i ++;
-	  if (i >= blas_num_threads - 1) {
+	  if (i >= workers) {
 	    i = 0;
 	    node ++;
 	    if (node >= nodes) node = 0;
@@ -692,26 +915,31 @@ int exec_blas_async(BLASLONG pos, blas_queue_t *queue){
 	} while (1);
 
       } else {
-	tsiq = atomic_load_queue(&thread_status[i].queue);
+	tsiq = atomic_load_queue(&status[i].queue);
 	while(tsiq) {
 	  i ++;
-	  if (i >= blas_num_threads - 1) i = 0;
-	  tsiq = atomic_load_queue(&thread_status[i].queue);
+	  if (i >= workers) i = 0;
+	  tsiq = atomic_load_queue(&status[i].queue);
 	}
       }
 #else
-      tsiq = atomic_load_queue(&thread_status[i].queue);
+      tsiq = atomic_load_queue(&status[i].queue);
       while(tsiq) {
 	i ++;
-	if (i >= blas_num_threads - 1) i = 0;
-        tsiq = atomic_load_queue(&thread_status[i].queue);
+	if (i >= workers) i = 0;
+        tsiq = atomic_load_queue(&status[i].queue);
       }
 #endif
 
       queue -> assigned = i;
+#ifdef OS_LINUX
+      status[i].cpuset_id = (ctx && ctx -> ncpus) ? ctx -> id : 0;
+      status[i].cpuset    = ctx ? &ctx -> cpuset : NULL;
+#endif
+      status[i].trace = trace;
       MB;
 
-      atomic_store_queue(&thread_status[i].queue, queue);
+      atomic_store_queue(&status[i].queue, queue);
 
       queue = queue -> next;
       pos ++;
@@ -721,35 +949,49 @@ int exec_blas_async(BLASLONG pos, blas_queue_t *queue){
 
     }
 
-    blas_unlock(&exec_queue_lock);
+    blas_unlock(queue_lock);
 
 #ifdef SMP_DEBUG
     fprintf(STDERR, "Done(Number of threads = %2ld).\n", exec_count);
 #endif
 
+    /* Order the queue stores above before reading the sleep state below */
+    __sync_synchronize();
+
     while (current) {
 
       pos = current -> assigned;
 
-      tspq = atomic_load_queue(&thread_status[pos].queue);
+      tspq = atomic_load_queue(&status[pos].queue);
 
+      /* A thread that is still spinning picks its queue up by itself */
       if ((BLASULONG)tspq > 1) {
-	pthread_mutex_lock  (&thread_status[pos].lock);
+#ifdef USE_FUTEX_WAIT
+	if (__atomic_load_n(&status[pos].parked, __ATOMIC_RELAXED) &&
+	    __atomic_exchange_n(&status[pos].parked, 0, __ATOMIC_SEQ_CST)) {
 
-	if (thread_status[pos].status == THREAD_STATUS_SLEEP) {
+#ifdef MONITOR
+	  num_suspend ++;
+#endif
 
+	  my_futex_wake(&status[pos].parked, 1);
+	}
+#else
+	if (status[pos].status == THREAD_STATUS_SLEEP) {
+	  pthread_mutex_lock  (&status[pos].lock);
 
 #ifdef MONITOR
 	  num_suspend ++;
 #endif
 
-	  if (thread_status[pos].status == THREAD_STATUS_SLEEP) {
-	    thread_status[pos].status = THREAD_STATUS_WAKEUP;
-	    pthread_cond_signal(&thread_status[pos].wakeup);
+	  if (status[pos].status == THREAD_STATUS_SLEEP) {
+	    status[pos].status = THREAD_STATUS_WAKEUP;
+	    pthread_cond_signal(&status[pos].wakeup);
 	  }
 
+	  pthread_mutex_unlock(&status[pos].lock);
 	}
-	  pthread_mutex_unlock(&thread_status[pos].lock);
+#endif
       }
 
       current = current -> next;
@@ -760,15 +1002,17 @@ int exec_blas_async(BLASLONG pos, blas_queue_t *queue){
 
 int exec_blas_async_wait(BLASLONG num, blas_queue_t *queue){
   blas_queue_t * tsqq;
+  blas_pool_t *pool = blas_pool_current();
+  thread_status_t *status = pool ? pool -> status : thread_status;
 
     while ((num > 0) && queue) {
 
-      tsqq = atomic_load_queue(&thread_status[queue->assigned].queue);
+      tsqq = atomic_load_queue(&status[queue->assigned].queue);
 
 
       while(tsqq) {
 	YIELDING;
-        tsqq = atomic_load_queue(&thread_status[queue->assigned].queue);
+        tsqq = atomic_load_queue(&status[queue->assigned].queue);
       };
 
       queue = queue -> next;
@@ -887,11 +1131,7 @@ void goto_set_num_threads(int num_threads) {
 
     for(i = blas_num_threads - 1; i < num_threads - 1; i++){
 
-      atomic_store_queue(&thread_status[i].queue, (blas_queue_t *)0);
-      thread_status[i].status = THREAD_STATUS_WAKEUP;
-
-      pthread_mutex_init(&thread_status[i].lock, NULL);
-      pthread_cond_init (&thread_status[i].wakeup, NULL);
+      init_thread_status(&thread_status[i]);
 
 #ifdef NEED_STACKATTR
       pthread_create(&blas_threads[i], &attr,
@@ -977,16 +1217,7 @@ int BLASFUNC(blas_thread_shutdown)(void){
   LOCK_COMMAND(&server_lock);
 
   for (i = 0; i < blas_num_threads - 1; i++) {
-
-
-    pthread_mutex_lock (&thread_status[i].lock);
-
-    atomic_store_queue(&thread_status[i].queue, (blas_queue_t *)-1);
-    thread_status[i].status = THREAD_STATUS_WAKEUP;
-    pthread_cond_signal (&thread_status[i].wakeup);
-
-    pthread_mutex_unlock(&thread_status[i].lock);
-
+    stop_thread(&thread_status[i]);
   }
 
   for(i = 0; i < blas_num_threads - 1; i++){
@@ -1009,5 +1240,127 @@ int BLASFUNC(blas_thread_shutdown)(void){
   return 0;
 }
 
+/* Caller-owned thread pools */
+
+void openblas_threadpool_destroy(blas_pool_t *pool){
+
+  BLASLONG i;
+
+  if (pool == NULL) return;
+
+  if (blas_pool_current() == pool) pthread_setspecific(blas_pool_key, NULL);
+
+  for (i = 0; i < pool -> nthreads - 1; i++) stop_thread(&pool -> status[i]);
+
+  for (i = 0; i < pool -> nthreads - 1; i++) {
+    pthread_join(pool -> threads[i], NULL);
+    pthread_mutex_destroy(&pool -> status[i].lock);
+    pthread_cond_destroy (&pool -> status[i].wakeup);
+  }
+
+  free(pool);
+}
+
+blas_pool_t *openblas_threadpool_create(int num_threads, const int *cpus){
+
+  blas_pool_t *pool;
+  BLASLONG i;
+  int ret;
+
+  if (num_threads < 1) return NULL;
+  if (num_threads > MAX_CPU_NUMBER) num_threads = MAX_CPU_NUMBER;
+
+  pthread_once(&blas_pool_once, blas_pool_key_init);
+
+  if (posix_memalign((void **)&pool, ATTRIBUTE_SIZE, sizeof(blas_pool_t))) return NULL;
+
+  pool -> nthreads   = 1;
+  pool -> queue_lock = 0;
+
+  for (i = 0; i < num_threads - 1; i++) {
+
+    init_thread_status(&pool -> status[i]);
+
+    ret = pthread_create(&pool -> threads[i], NULL, &blas_pool_server, (void *)&pool -> status[i]);
+    if (ret != 0) {
+      fprintf(STDERR, "OpenBLAS openblas_threadpool_create: pthread_create failed for thread %ld of %d: %s\n",
+	      i + 1, num_threads, strerror(ret));
+      pthread_mutex_destroy(&pool -> status[i].lock);
+      pthread_cond_destroy (&pool -> status[i].wakeup);
+      openblas_threadpool_destroy(pool);
+      return NULL;
+    }
+
+#if defined(OS_LINUX) && !defined(NO_AFFINITY)
+    if (cpus) {
+      cpu_set_t cpu_set;
+      CPU_ZERO(&cpu_set);
+      CPU_SET(cpus[i + 1], &cpu_set);
+      pthread_setaffinity_np(pool -> threads[i], sizeof(cpu_set), &cpu_set);
+    }
+#endif
+
+    pool -> nthreads ++;
+  }
+
+  return pool;
+}
+
+int openblas_threadpool_bind(blas_pool_t *pool){
+
+  pthread_once(&blas_pool_once, blas_pool_key_init);
+
+  return pthread_setspecific(blas_pool_key, pool) ? -1 : 0;
+}
+
+/* Per-thread execution context */
+
+int openblas_set_thread_context(int max_threads, const int *cpus, int ncpus, int policy){
+
+  blas_context_t *ctx;
+  int i;
+
+  if (max_threads < 0 || ncpus < 0 || (ncpus > 0 && cpus == NULL)) return -1;
+  if (policy < BLAS_POLICY_DEFAULT || policy > BLAS_POLICY_EAGER) return -1;
+#ifdef OS_LINUX
+  for (i = 0; i < ncpus; i++)
+    if (cpus[i] < 0 || cpus[i] >= CPU_SETSIZE) return -1;
+#endif
+
+  pthread_once(&blas_pool_once, blas_pool_key_init);
+
+  ctx = blas_context_current();
+  if (ctx == NULL) {
+    ctx = (blas_context_t *)calloc(1, sizeof(blas_context_t));
+    if (ctx == NULL) return -1;
+    if (pthread_setspecific(blas_context_key, ctx)) {
+      free(ctx);
+      return -1;
+    }
+  }
+
+  ctx -> nthreads = max_threads;
+  ctx -> policy   = policy;
+  ctx -> ncpus    = ncpus;
+#ifdef OS_LINUX
+  CPU_ZERO(&ctx -> cpuset);
+  for (i = 0; i < ncpus; i++) CPU_SET(cpus[i], &ctx -> cpuset);
+  if (ncpus > 0) ctx -> ncpus = CPU_COUNT(&ctx -> cpuset);
+#endif
+  ctx -> id = ncpus ? __sync_add_and_fetch(&blas_context_ids, 1) : 0;
+
+  return 0;
+}
+
+void openblas_clear_thread_context(void){
+
+  blas_context_t *ctx = blas_context_current();
+
+  if (ctx == NULL) return;
+
+  pthread_setspecific(blas_context_key, NULL);
+  free(ctx);
+}
+
 #endif
 
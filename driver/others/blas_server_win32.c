@@ -533,3 +533,36 @@ void openblas_set_num_threads(int num)
 {
 	goto_set_num_threads(num);
 }
+
+int blas_pool_threads(void)
+{
+	return 0;
+}
+
+/* Caller-owned thread pools are only provided by the pthreads server */
+struct openblas_threadpool *openblas_threadpool_create(int num_threads, const int *cpus){
+  return NULL;
+}
+
+void openblas_threadpool_destroy(struct openblas_threadpool *pool){
+}
+
+int openblas_threadpool_bind(struct openblas_threadpool *pool){
+  return -1;
+}
+
+int blas_context_threads(int nthreads){
+  return nthreads;
+}
+
+int blas_context_policy(void){
+  return BLAS_POLICY_DEFAULT;
+}
+
+/* Per-thread execution contexts are only provided by the pthreads server */
+int openblas_set_thread_context(int max_threads, const int *cpus, int ncpus, int policy){
+  return -1;
+}
+
+void openblas_clear_thread_context(void){
+}
@@ -111,6 +111,103 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #warning BUFFER_SIZE is too small for P, Q, and R of ZGEMM - large calculations may crash !
 #endif
 
+/* NUMA placement of the buffer pool. Every buffer is homed on the node */
+/* of the thread that first maps it: its pages are bound there with     */
+/* mbind and it is preferably handed out again to threads on that node. */
+
+#define MAX_BUFFER_NODES 64
+
+/* Counters that are updated without holding alloc_lock. */
+#if __STDC_VERSION__ >= 201112L
+typedef _Atomic int buffer_count_t;
+#define BUFFER_COUNT_ADD(p, v)	((*(p)) += (v))
+#elif defined(_MSC_VER) && !defined(__clang__)
+typedef volatile LONG buffer_count_t;
+#define BUFFER_COUNT_ADD(p, v)	(InterlockedExchangeAdd((p), (v)) + (v))
+#else
+typedef volatile int buffer_count_t;
+#define BUFFER_COUNT_ADD(p, v)	__sync_add_and_fetch((p), (v))
+#endif
+
+static buffer_count_t buffer_node_mapped[MAX_BUFFER_NODES];
+static buffer_count_t buffer_node_used  [MAX_BUFFER_NODES];
+static int buffer_nodes = 0;
+
+static int buffer_num_nodes(void) {
+
+  int nodes = buffer_nodes;
+
+  if (nodes) return nodes;
+
+  nodes = 1;
+
+#ifdef OS_LINUX
+  {
+    /* List of online nodes, e.g. "0-1" or "0,2-3" */
+    FILE *fp = fopen("/sys/devices/system/node/online", "r");
+    char line[256], *p, *q;
+    long n;
+
+    if (fp) {
+      if (fgets(line, sizeof(line), fp)) {
+	p = line;
+	while (*p) {
+	  n = strtol(p, &q, 10);
+	  if (q == p) { p ++; continue; }
+	  if (n + 1 > nodes) nodes = n + 1;
+	  p = q;
+	}
+      }
+      fclose(fp);
+    }
+  }
+#endif
+
+  if (nodes > MAX_BUFFER_NODES) nodes = MAX_BUFFER_NODES;
+
+  buffer_nodes = nodes;
+
+  return nodes;
+}
+
+static int buffer_node(void) {
+
+  int node = 0;
+
+#ifdef OS_LINUX
+  if (buffer_num_nodes() > 1) node = my_getcpu_node();
+#endif
+
+  if ((node < 0) || (node >= MAX_BUFFER_NODES)) node = 0;
+
+  return node;
+}
+
+static void buffer_bind(void *address, BLASULONG size, int node) {
+
+#ifdef OS_LINUX
+  unsigned long mask;
+
+  if ((address == (void *)-1) || (buffer_num_nodes() <= 1)) return;
+
+  /* Pages already touched by the warmup are migrated along */
+  mask = 1UL << node;
+  my_mbind(address, size, MPOL_PREFERRED, &mask, sizeof(mask) * 8, MPOL_MF_MOVE);
+#endif
+}
+
+int openblas_get_buffer_usage(int node, int *allocated, int *in_use) {
+
+  int nodes = buffer_num_nodes();
+
+  if ((node < 0) || (node >= nodes)) return -1;
+
+  if (allocated) *allocated = buffer_node_mapped[node];
+  if (in_use)    *in_use    = buffer_node_used  [node];
+
+  return nodes;
+}
+
 #if defined(COMPILE_TLS)
 
 #include <errno.h>
@@ -511,10 +608,15 @@ struct alloc_t {
   int attr;
   /* Function that can properly release this memory */
   void (*release_func)(struct alloc_t *);
+  /* NUMA node this allocation is homed on */
+  int node;
   /* Pad to 64-byte alignment */
-  char pad[64 - 2 * sizeof(int) - sizeof(void(*))];
+  char pad[64 - 3 * sizeof(int) - sizeof(void(*))];
 };
 
+/* Fails to compile unless every allocation header is one cache line */
+typedef char alloc_t_is_64_bytes[(sizeof(struct alloc_t) == 64) ? 1 : -1];
+
 /* Convenience macros for storing release funcs */
 #define STORE_RELEASE_FUNC(address, func)                   \
   if (address != (void *)-1) {                              \
@@ -1114,6 +1216,8 @@ static volatile int memory_initialized = 0;
     for (pos = 0; pos < NUM_BUFFERS; pos ++){
       struct alloc_t *alloc_info = table[pos];
       if (alloc_info) {
+        BUFFER_COUNT_ADD(&buffer_node_mapped[alloc_info->node], -1);
+        if (alloc_info->used) BUFFER_COUNT_ADD(&buffer_node_used[alloc_info->node], -1);
         alloc_info->release_func(alloc_info);
         table[pos] = (void *)0;
       }
@@ -1134,7 +1238,7 @@ static void blas_memory_init(){
 
 void *blas_memory_alloc(int procpos){
 
-  int position;
+  int position, fresh, remote, mynode;
 
   void *map_address;
 
@@ -1214,14 +1318,28 @@ UNLOCK_COMMAND(&alloc_lock);
   printf("Alloc Start ...\n");
 #endif
 
+  /* Prefer a free buffer homed on our node, then a fresh slot, then */
+  /* a free buffer left behind on another node before we migrated.   */
+  mynode = buffer_node();
+  fresh  = -1;
+  remote = -1;
+
   position = 0;
   alloc_table = get_memory_table();
   do {
-      if (!alloc_table[position] || !alloc_table[position]->used) goto allocation;
+    if (!alloc_table[position]) {
+      if (fresh < 0) fresh = position;
+    } else if (!alloc_table[position]->used) {
+      if (alloc_table[position]->node == mynode) goto allocation;
+      if (remote < 0) remote = position;
+    }
     position ++;
 
   } while (position < NUM_BUFFERS);
 
+  position = (fresh >= 0) ? fresh : remote;
+  if (position >= 0) goto allocation;
+
   goto error;
 
   allocation :
@@ -1275,7 +1393,11 @@ UNLOCK_COMMAND(&alloc_lock);
 
     } while ((BLASLONG)map_address == -1);
 
+    buffer_bind(map_address, allocation_block_size, mynode);
+
     alloc_table[position] = alloc_info = map_address;
+    alloc_info->node = mynode;
+    BUFFER_COUNT_ADD(&buffer_node_mapped[mynode], 1);
 
 #ifdef DEBUG
     printf("  Mapping Succeeded. %p(%d)\n", (void *)alloc_info, position);
@@ -1287,6 +1409,7 @@ UNLOCK_COMMAND(&alloc_lock);
 #endif
 
   alloc_info->used = 1;
+  BUFFER_COUNT_ADD(&buffer_node_used[alloc_info->node], 1);
 
   return (void *)(((char *)alloc_info) + sizeof(struct alloc_t));
 
@@ -1309,6 +1432,7 @@ void blas_memory_free(void *buffer){
 #endif
 
   alloc_info->used = 0;
+  BUFFER_COUNT_ADD(&buffer_node_used[alloc_info->node], -1);
 
 #ifdef DEBUG
   printf("Unmap Succeeded.\n\n");
@@ -1475,6 +1599,9 @@ static void gotoblas_memory_init(void) {
 
 static int gotoblas_initialized = 0;
 extern void openblas_read_env();
+#ifdef DYNAMIC_ARCH
+extern void gotoblas_tune_init(void);
+#endif
 
 void CONSTRUCTOR gotoblas_init(void) {
 
@@ -1486,12 +1613,15 @@ void CONSTRUCTOR gotoblas_init(void) {
 
   openblas_read_env();
 
+  blas_trace_init();
+
 #ifdef PROFILE
    moncontrol (0);
 #endif
 
 #ifdef DYNAMIC_ARCH
    gotoblas_dynamic_init();
+   gotoblas_tune_init();
 #endif
 
 #if defined(SMP) && defined(OS_LINUX) && !defined(NO_AFFINITY)
@@ -1538,6 +1668,8 @@ void DESTRUCTOR gotoblas_quit(void) {
 
   if (gotoblas_initialized == 0) return;
 
+  blas_trace_quit();
+
   blas_shutdown();
 
 #if defined(SMP)
@@ -2601,31 +2733,47 @@ static BLASULONG base_address      = BASE_ADDRESS;
 #endif
 
 static volatile struct {
-  BLASULONG lock;
   void *addr;
 #if defined(WHEREAMI) && !defined(USE_OPENMP)
   int   pos;
 #endif
   int used;
+  int node;
+  int next;
 #ifndef __64BIT__
   char dummy[48];
 #else
-  char dummy[40];
+  char dummy[44];
 #endif
 
 } memory[NUM_BUFFERS];
 
+/* Free buffers are kept on one list per home node, linked through */
+/* memory[].next; list heads and links store position + 1, so 0    */
+/* marks the end. Entries from memory_slots onwards are unmapped.  */
+static int memory_free_list[MAX_BUFFER_NODES];
+static int memory_slots = 0;
+
 static int memory_initialized = 0;
 
+static __inline int memory_take_free(int node) {
+
+  int position = memory_free_list[node] - 1;
+
+  if (position >= 0) memory_free_list[node] = memory[position].next;
+
+  return position;
+}
+
 /*       Memory allocation routine           */
 /* procpos ... indicates where it comes from */
 /*                0 : Level 3 functions      */
 /*                1 : Level 2 functions      */
 /*                2 : Thread                 */
 
-void *blas_memory_alloc(int procpos){
+static void *memory_table_alloc(int procpos){
 
-  int position;
+  int position, node, mynode;
 #if defined(WHEREAMI) && !defined(USE_OPENMP)
   int mypos = 0;
 #endif
@@ -2672,7 +2820,6 @@ void *blas_memory_alloc(int procpos){
       memory[position].addr   = (void *)0;
       memory[position].pos    = -1;
       memory[position].used   = 0;
-      memory[position].lock   = 0;
     }
 #endif
 
@@ -2735,42 +2882,39 @@ void *blas_memory_alloc(int procpos){
 
 #endif */
 
-  position = 0;
+  mynode = buffer_node();
 
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
+#if defined(SMP) || defined(USE_LOCKING)
   LOCK_COMMAND(&alloc_lock);
 #endif
-  do {
-	  RMB;
-#if defined(USE_OPENMP)	  
-    if (!memory[position].used) { 
-      blas_lock(&memory[position].lock);
-#endif
-      if (!memory[position].used) goto allocation;
-      
-#if defined(USE_OPENMP)
-      blas_unlock(&memory[position].lock);      
-    }
-#endif
-    position ++;
 
-  } while (position < NUM_BUFFERS);
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
-  UNLOCK_COMMAND(&alloc_lock);	
-#endif
-  goto error;
+  /* A free buffer on our own node first, then a fresh one that will */
+  /* be homed here, and only then one that lives on another node.    */
+  position = memory_take_free(mynode);
 
-  allocation :
+  if ((position < 0) && (memory_slots < NUM_BUFFERS)) {
+    position = memory_slots ++;
+    memory[position].node = mynode;
+  }
+
+  for (node = 0; (position < 0) && (node < buffer_num_nodes()); node ++)
+    position = memory_take_free(node);
+
+  if (position < 0) {
+#if defined(SMP) || defined(USE_LOCKING)
+    UNLOCK_COMMAND(&alloc_lock);
+#endif
+    goto error;
+  }
 
 #ifdef DEBUG
   printf("  Position -> %d\n", position);
 #endif
 
   memory[position].used = 1;
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
+  BUFFER_COUNT_ADD(&buffer_node_used[memory[position].node], 1);
+#if defined(SMP) || defined(USE_LOCKING)
   UNLOCK_COMMAND(&alloc_lock);
-#else
-  blas_unlock(&memory[position].lock);	
 #endif
   if (!memory[position].addr) {
     do {
@@ -2816,11 +2960,14 @@ void *blas_memory_alloc(int procpos){
 
     } while ((BLASLONG)map_address == -1);
 
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
+    buffer_bind(map_address, BUFFER_SIZE, memory[position].node);
+
+#if defined(SMP) || defined(USE_LOCKING)
     LOCK_COMMAND(&alloc_lock);
-#endif    
+#endif
     memory[position].addr = map_address;
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
+    BUFFER_COUNT_ADD(&buffer_node_mapped[memory[position].node], 1);
+#if defined(SMP) || defined(USE_LOCKING)
     UNLOCK_COMMAND(&alloc_lock);
 #endif
 
@@ -2867,7 +3014,7 @@ void *blas_memory_alloc(int procpos){
   return NULL;
 }
 
-void blas_memory_free(void *free_area){
+static void memory_table_free(void *free_area){
 
   int position;
 
@@ -2876,13 +3023,13 @@ void blas_memory_free(void *free_area){
 #endif
 
   position = 0;
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
+#if defined(SMP) || defined(USE_LOCKING)
   LOCK_COMMAND(&alloc_lock);
 #endif
-  while ((position < NUM_BUFFERS) && (memory[position].addr != free_area))
+  while ((position < memory_slots) && (memory[position].addr != free_area))
     position++;
 
-  if (memory[position].addr != free_area) goto error;
+  if ((position >= memory_slots) || !memory[position].used) goto error;
 
 #ifdef DEBUG
   printf("  Position : %d\n", position);
@@ -2892,7 +3039,11 @@ void blas_memory_free(void *free_area){
   WMB;
 
   memory[position].used = 0;
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
+  BUFFER_COUNT_ADD(&buffer_node_used[memory[position].node], -1);
+
+  memory[position].next = memory_free_list[memory[position].node];
+  memory_free_list[memory[position].node] = position + 1;
+#if defined(SMP) || defined(USE_LOCKING)
   UNLOCK_COMMAND(&alloc_lock);
 #endif
 
@@ -2907,14 +3058,154 @@ void blas_memory_free(void *free_area){
 
 #ifdef DEBUG
   for (position = 0; position < NUM_BUFFERS; position++)
-    printf("%4ld  %p : %d\n", position, memory[position].addr, memory[position].used);
+    printf("%4ld  %p : %d (node %d)\n", position, memory[position].addr, memory[position].used, memory[position].node);
 #endif
-#if (defined(SMP) || defined(USE_LOCKING)) && !defined(USE_OPENMP)
+#if defined(SMP) || defined(USE_LOCKING)
   UNLOCK_COMMAND(&alloc_lock);
 #endif
   return;
 }
 
+/* Per-thread buffer cache. A thread adopts the first few buffers it  */
+/* gets from the table and keeps them for itself: later allocations */
+/* and frees of those buffers never touch alloc_lock or the table.  */
+/* The table remains the backing store for everything else and     */
+/* takes the buffers back when the thread exits.                    */
+
+#ifndef thread_local
+# if __STDC_VERSION__ >= 201112 && !defined __STDC_NO_THREADS__
+#  define thread_local _Thread_local
+# elif (defined __GNUC__ || \
+       defined __SUNPRO_C || \
+       defined __xlC__) && !defined(__APPLE__)
+#  define thread_local __thread
+# endif
+#endif
+
+#if !(defined(SMP) || defined(USE_LOCKING))
+#define BUFFER_CACHE
+#define buffer_cache_local static
+#elif defined(thread_local) && !defined(OS_WINDOWS)
+#define BUFFER_CACHE
+#define BUFFER_CACHE_KEY
+#define buffer_cache_local static thread_local
+#endif
+
+#ifndef BUFFER_CACHE_SIZE
+#define BUFFER_CACHE_SIZE 4
+#endif
+
+/* Bumped by blas_shutdown, which unmaps everything behind the caches */
+static volatile int memory_generation = 0;
+
+#ifdef BUFFER_CACHE
+
+typedef struct {
+  int   count;
+  int   generation;
+  int   registered;
+  void *buffer[BUFFER_CACHE_SIZE];
+  int   out   [BUFFER_CACHE_SIZE];
+} buffer_cache_t;
+
+buffer_cache_local buffer_cache_t buffer_cache;
+
+/* Buffers adopted by all caches, capped so that the table is never */
+/* drained by threads that have gone idle.                          */
+static buffer_count_t memory_adopted = 0;
+
+#ifdef BUFFER_CACHE_KEY
+static pthread_key_t  buffer_cache_key;
+static pthread_once_t buffer_cache_once = PTHREAD_ONCE_INIT;
+static int buffer_cache_key_created = 0;
+
+static void buffer_cache_release(void *ptr) {
+
+  buffer_cache_t *cache = (buffer_cache_t *)ptr;
+  int i;
+
+  if (cache -> generation == memory_generation) {
+    for (i = 0; i < cache -> count; i ++) {
+      /* Buffers still handed out are left to whoever frees them */
+      if (!cache -> out[i]) memory_table_free(cache -> buffer[i]);
+      BUFFER_COUNT_ADD(&memory_adopted, -1);
+    }
+  }
+
+  cache -> count = 0;
+}
+
+static void buffer_cache_key_init(void) {
+  if (!pthread_key_create(&buffer_cache_key, buffer_cache_release))
+    buffer_cache_key_created = 1;
+}
+#endif
+
+#endif
+
+void *blas_memory_alloc(int procpos){
+
+#ifdef BUFFER_CACHE
+  buffer_cache_t *cache = &buffer_cache;
+  void *buffer;
+  int i;
+
+  if (cache -> generation == memory_generation) {
+    for (i = 0; i < cache -> count; i ++) {
+      if (!cache -> out[i]) {
+	cache -> out[i] = 1;
+	return cache -> buffer[i];
+      }
+    }
+  } else {
+    cache -> count      = 0;
+    cache -> generation = memory_generation;
+  }
+
+  buffer = memory_table_alloc(procpos);
+
+  if (buffer && (cache -> count < BUFFER_CACHE_SIZE)) {
+    if (BUFFER_COUNT_ADD(&memory_adopted, 1) <= NUM_BUFFERS / 2) {
+#ifdef BUFFER_CACHE_KEY
+      if (!cache -> registered) {
+	pthread_once(&buffer_cache_once, buffer_cache_key_init);
+	pthread_setspecific(buffer_cache_key, cache);
+	cache -> registered = 1;
+      }
+#endif
+      cache -> buffer[cache -> count] = buffer;
+      cache -> out   [cache -> count] = 1;
+      cache -> count ++;
+    } else {
+      BUFFER_COUNT_ADD(&memory_adopted, -1);
+    }
+  }
+
+  return buffer;
+#else
+  return memory_table_alloc(procpos);
+#endif
+}
+
+void blas_memory_free(void *free_area){
+
+#ifdef BUFFER_CACHE
+  buffer_cache_t *cache = &buffer_cache;
+  int i;
+
+  if (cache -> generation == memory_generation) {
+    for (i = 0; i < cache -> count; i ++) {
+      if ((cache -> buffer[i] == free_area) && cache -> out[i]) {
+	cache -> out[i] = 0;
+	return;
+      }
+    }
+  }
+#endif
+
+  memory_table_free(free_area);
+}
+
 void *blas_memory_alloc_nolock(int unused) {
   void *map_address;
   map_address = (void *)malloc(BUFFER_SIZE + FIXED_PAGESIZE);
@@ -2951,7 +3242,20 @@ void blas_shutdown(void){
 #if defined(WHEREAMI) && !defined(USE_OPENMP)
     memory[pos].pos    = -1;
 #endif
-    memory[pos].lock   = 0;
+    memory[pos].node   = 0;
+    memory[pos].next   = 0;
+  }
+
+  memory_slots = 0;
+  memory_generation ++;
+#ifdef BUFFER_CACHE
+  memory_adopted = 0;
+#endif
+
+  for (pos = 0; pos < MAX_BUFFER_NODES; pos ++){
+    memory_free_list  [pos] = 0;
+    buffer_node_mapped[pos] = 0;
+    buffer_node_used  [pos] = 0;
   }
 
   UNLOCK_COMMAND(&alloc_lock);
@@ -3070,6 +3374,9 @@ static void gotoblas_memory_init(void) {
 
 static int gotoblas_initialized = 0;
 extern void openblas_read_env();
+#ifdef DYNAMIC_ARCH
+extern void gotoblas_tune_init(void);
+#endif
 
 void CONSTRUCTOR gotoblas_init(void) {
 
@@ -3081,12 +3388,15 @@ void CONSTRUCTOR gotoblas_init(void) {
 
   openblas_read_env();
 
+  blas_trace_init();
+
 #ifdef PROFILE
    moncontrol (0);
 #endif
 
 #ifdef DYNAMIC_ARCH
    gotoblas_dynamic_init();
+   gotoblas_tune_init();
 #endif
 
 #if defined(SMP) && defined(OS_LINUX) && !defined(NO_AFFINITY)
@@ -3133,8 +3443,14 @@ void DESTRUCTOR gotoblas_quit(void) {
 
   if (gotoblas_initialized == 0) return;
 
+  blas_trace_quit();
+
   blas_shutdown();
 
+#ifdef BUFFER_CACHE_KEY
+  if (buffer_cache_key_created) pthread_key_delete(buffer_cache_key);
+#endif
+
 #ifdef PROFILE
    moncontrol (0);
 #endif
@@ -31,6 +31,7 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 *****************************************************************************/
 
+#include <stdio.h>
 #include "common.h"
 
 static int openblas_env_verbose=0;
@@ -39,6 +40,10 @@ static int openblas_env_block_factor=0;
 static int openblas_env_openblas_num_threads=0;
 static int openblas_env_goto_num_threads=0;
 static int openblas_env_omp_num_threads=0;
+static int openblas_env_gemm_dynamic=0;
+static int openblas_env_calibrate=0;
+static int openblas_env_tune_gemm=0;
+static int openblas_env_deterministic=0;
 
 int openblas_verbose() { return openblas_env_verbose;}
 unsigned int openblas_thread_timeout() { return openblas_env_thread_timeout;}
@@ -46,6 +51,11 @@ int openblas_block_factor() { return openblas_env_block_factor;}
 int openblas_num_threads_env() { return openblas_env_openblas_num_threads;}
 int openblas_goto_num_threads_env() { return openblas_env_goto_num_threads;}
 int openblas_omp_num_threads_env() { return openblas_env_omp_num_threads;}
+int openblas_gemm_dynamic() { return openblas_env_gemm_dynamic;}
+int openblas_calibrate() { return openblas_env_calibrate;}
+int openblas_tune_gemm_env() { return openblas_env_tune_gemm;}
+int openblas_get_deterministic() { return openblas_env_deterministic;}
+void openblas_set_deterministic(int on) { openblas_env_deterministic = (on != 0);}
 
 void openblas_read_env() {
   int ret=0;
@@ -79,6 +89,54 @@ void openblas_read_env() {
   if(ret<0) ret=0;
   openblas_env_omp_num_threads=ret;
 
+  ret=0;
+  if (readenv(p,"OPENBLAS_GEMM_DYNAMIC")) ret = atoi(p);
+  if(ret<0) ret=0;
+  openblas_env_gemm_dynamic=ret;
+
+  ret=0;
+  if (readenv(p,"OPENBLAS_CALIBRATE")) ret = atoi(p);
+  if(ret<0) ret=0;
+  openblas_env_calibrate=ret;
+
+  ret=0;
+  if (readenv(p,"OPENBLAS_TUNE_GEMM")) ret = atoi(p);
+  if(ret<0) ret=0;
+  openblas_env_tune_gemm=ret;
+
+  ret=0;
+  if (readenv(p,"OPENBLAS_DETERMINISTIC")) ret = atoi(p);
+  if(ret<0) ret=0;
+  openblas_env_deterministic=(ret != 0);
+
+}
+
+/* Location of a per-user cache file: the file named by the environment
+   variable env if set, otherwise name in the user's cache directory. */
+char *openblas_cache_path(char *path, size_t len, const char *env, const char *name) {
+
+  env_var_t p;
+
+  if (readenv(p, env) && *p) {
+    snprintf(path, len, "%s", p);
+    return path;
+  }
+#ifdef OS_WINDOWS
+  if (readenv(p, "LOCALAPPDATA") && *p) {
+    snprintf(path, len, "%s\\%s", p, name);
+    return path;
+  }
+#else
+  if (readenv(p, "XDG_CACHE_HOME") && *p) {
+    snprintf(path, len, "%s/%s", p, name);
+    return path;
+  }
+  if (readenv(p, "HOME") && *p) {
+    snprintf(path, len, "%s/.cache/%s", p, name);
+    return path;
+  }
+#endif
+  return NULL;
 }
 
 
@@ -0,0 +1,386 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* GEMM blocking sizes (P, Q and R) measured on the running machine.
+   openblas_tune_gemm() sweeps them around the values the core tables
+   chose for the active kernels and keeps the fastest, per precision, in
+   a cache file with one line per core, host signature and precision.
+   gotoblas_init() applies the lines written for this host, and runs the
+   tuner first when OPENBLAS_TUNE_GEMM is set and there are none.
+
+   The blocking sizes only live in the gotoblas table of DYNAMIC_ARCH
+   builds; elsewhere P and Q are compile time constants and there is
+   nothing to tune. */
+
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+
+char *openblas_get_corename(void);
+char *openblas_cache_path(char *path, size_t len, const char *env, const char *name);
+int openblas_tune_gemm_env(void);
+int openblas_tune_gemm(void);
+
+#ifdef DYNAMIC_ARCH
+
+static const char tune_prec[] = "sdcz";
+
+/* Order of the square operands timed for each precision */
+static const BLASLONG tune_size[] = { 1536, 1024, 768, 512 };
+
+/* Candidate values, in quarters of the table value */
+static const int tune_scale[] = { 2, 3, 5, 6, 8 };
+
+/* Blocking sizes in the order they are searched: Q, P, R */
+static const int tune_order[] = { 1, 0, 2 };
+
+/* Q of each precision as the core starts.  Some kernels copy B into a
+   stack buffer sized for it, so a larger Q is neither tried nor loaded. */
+static int tune_qmax[4];
+
+static int tune_busy = 0;
+
+#if   defined(USE_PTHREAD_LOCK)
+static pthread_mutex_t    tune_lock = PTHREAD_MUTEX_INITIALIZER;
+#elif defined(USE_PTHREAD_SPINLOCK)
+static pthread_spinlock_t tune_lock = 0;
+#else
+static BLASULONG  tune_lock = 0UL;
+#endif
+
+static char *tune_path(char *path, size_t len) {
+
+  return openblas_cache_path(path, len, "OPENBLAS_GEMM_TUNE_FILE", "openblas_gemm_blocking");
+}
+
+/* Vendor, family / model / stepping and the cache descriptors of the
+   host, so that a cache file shared between machines with the same core
+   type still keeps their entries apart. */
+static void tune_signature(char *sig, size_t len) {
+
+#if defined(ARCH_X86) || defined(ARCH_X86_64)
+  int eax, ebx, ecx, edx, vendor[4], id, l2 = 0, l3 = 0;
+
+  cpuid(0, &eax, &vendor[0], &vendor[2], &vendor[1]);
+  vendor[3] = 0;
+  cpuid(1, &id, &ebx, &ecx, &edx);
+  cpuid(0x80000000, &eax, &ebx, &ecx, &edx);
+  if ((unsigned int)eax >= 0x80000006U) cpuid(0x80000006, &eax, &ebx, &l2, &l3);
+
+  snprintf(sig, len, "%s-%08x-%08x-%08x", (char *)vendor, id, l2, l3);
+#else
+  snprintf(sig, len, "%s", "generic");
+#endif
+}
+
+static void tune_fields(int prec, int **p, int **q, int **r, int *unroll, int *size) {
+
+  switch (prec) {
+  case 0:
+    *p = &gotoblas->sgemm_p; *q = &gotoblas->sgemm_q; *r = &gotoblas->sgemm_r;
+    *unroll = gotoblas->sgemm_unroll_m; *size = 4;
+    break;
+  case 1:
+    *p = &gotoblas->dgemm_p; *q = &gotoblas->dgemm_q; *r = &gotoblas->dgemm_r;
+    *unroll = gotoblas->dgemm_unroll_m; *size = 8;
+    break;
+  case 2:
+    *p = &gotoblas->cgemm_p; *q = &gotoblas->cgemm_q; *r = &gotoblas->cgemm_r;
+    *unroll = gotoblas->cgemm_unroll_m; *size = 8;
+    break;
+  default:
+    *p = &gotoblas->zgemm_p; *q = &gotoblas->zgemm_q; *r = &gotoblas->zgemm_r;
+    *unroll = gotoblas->zgemm_unroll_m; *size = 16;
+    break;
+  }
+}
+
+/* Largest R the work buffer holds behind a P x Q block of A, computed
+   as blas_set_parameter() does. */
+static BLASLONG tune_rmax(BLASLONG p, BLASLONG q, int size) {
+
+  return (((BUFFER_SIZE - ((p * q * size + GEMM_OFFSET_A + GEMM_ALIGN) & ~GEMM_ALIGN)) / (q * size)) - 15) & ~15;
+}
+
+static int tune_valid(int prec, BLASLONG p, BLASLONG q, BLASLONG r, int unroll, int size) {
+
+  return p >= unroll && p % unroll == 0 && q >= 8 && q <= tune_qmax[prec]
+    && r >= 16 && r <= tune_rmax(p, q, size);
+}
+
+/* Reads the entries written for this core and host into the table. */
+static int tune_load(void) {
+
+  char path[1024], line[256], core[64], sig[64], mysig[64];
+  FILE *fp;
+  int *p, *q, *r, unroll, size, bp, bq, br, found = 0;
+  char prec;
+  const char *c;
+
+  if (tune_path(path, sizeof(path)) == NULL) return 0;
+  if ((fp = fopen(path, "r")) == NULL) return 0;
+
+  tune_signature(mysig, sizeof(mysig));
+
+  while (fgets(line, sizeof(line), fp)) {
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%63s %63s %c %d %d %d", core, sig, &prec, &bp, &bq, &br) != 6) continue;
+    if (strcmp(core, openblas_get_corename()) || strcmp(sig, mysig)) continue;
+    if (prec == '\0' || (c = strchr(tune_prec, prec)) == NULL) continue;
+
+    tune_fields((int)(c - tune_prec), &p, &q, &r, &unroll, &size);
+    if (!tune_valid((int)(c - tune_prec), bp, bq, br, unroll, size)) continue;
+
+    *p = bp;
+    *q = bq;
+    *r = br;
+    found ++;
+  }
+
+  fclose(fp);
+  return found;
+}
+
+/* Rewrites the cache file with the entries of other hosts kept as they
+   were and those of this host replaced. */
+static void tune_save(void) {
+
+  char path[1024], line[256], core[64], sig[64], mysig[64], *keep;
+  size_t used = 0, len, cap = 1 << 16;
+  FILE *fp;
+  int *p, *q, *r, unroll, size, prec;
+
+  if (tune_path(path, sizeof(path)) == NULL) return;
+  if ((keep = (char *)malloc(cap)) == NULL) return;
+
+  tune_signature(mysig, sizeof(mysig));
+
+  if ((fp = fopen(path, "r")) != NULL) {
+    while (fgets(line, sizeof(line), fp)) {
+      if (line[0] == '#') continue;
+      if (sscanf(line, "%63s %63s", core, sig) == 2
+	  && !strcmp(core, openblas_get_corename()) && !strcmp(sig, mysig)) continue;
+      len = strlen(line);
+      if (used + len >= cap) break;
+      memcpy(keep + used, line, len);
+      used += len;
+    }
+    fclose(fp);
+  }
+
+  if ((fp = fopen(path, "w")) != NULL) {
+    fprintf(fp, "# OpenBLAS GEMM blocking: core, host signature, precision, P, Q, R\n");
+    fwrite(keep, 1, used, fp);
+    for (prec = 0; prec < 4; prec++) {
+      tune_fields(prec, &p, &q, &r, &unroll, &size);
+      fprintf(fp, "%s %s %c %d %d %d\n", openblas_get_corename(), mysig, tune_prec[prec], *p, *q, *r);
+    }
+    fclose(fp);
+  }
+
+  free(keep);
+}
+
+/* One single threaded NN product of order n with the current blocking */
+static void tune_run(int prec, BLASLONG n, void *a, void *b, void *c, void *buffer) {
+
+  static float  sone[2] = { ONE, ZERO };
+  static double done[2] = { ONE, ZERO };
+  blas_arg_t args;
+  int *p, *q, *r, unroll, size;
+  void *sa, *sb;
+
+  tune_fields(prec, &p, &q, &r, &unroll, &size);
+
+  args.m = n;
+  args.n = n;
+  args.k = n;
+  args.a = a;
+  args.b = b;
+  args.c = c;
+  args.lda = n;
+  args.ldb = n;
+  args.ldc = n;
+  args.alpha = (prec & 1) ? (void *)done : (void *)sone;
+  args.beta  = args.alpha;
+#ifdef SMP
+  args.common = NULL;
+  args.nthreads = 1;
+#endif
+
+  sa = (void *)((BLASLONG)buffer + GEMM_OFFSET_A);
+  sb = (void *)(((BLASLONG)sa + (((BLASLONG)*p * *q * size + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+  switch (prec) {
+  case 0: SGEMM_NN(&args, NULL, NULL, sa, sb, 0); break;
+  case 1: DGEMM_NN(&args, NULL, NULL, sa, sb, 0); break;
+  case 2: CGEMM_NN(&args, NULL, NULL, sa, sb, 0); break;
+  case 3: ZGEMM_NN(&args, NULL, NULL, sa, sb, 0); break;
+  }
+}
+
+/* Best of three runs, in rpcc ticks */
+static unsigned long long tune_time(int prec, BLASLONG n, void *a, void *b, void *c, void *buffer) {
+
+  unsigned long long start, elapsed, best = 0;
+  int trial;
+
+  for (trial = 0; trial < 3; trial++) {
+    start = rpcc();
+    tune_run(prec, n, a, b, c, buffer);
+    elapsed = rpcc() - start;
+    if (trial == 0 || elapsed < best) best = elapsed;
+  }
+
+  return best;
+}
+
+/* Coordinate search: Q, then P, then R, each over tune_scale times the
+   value the search started from.  A candidate has to be 2% faster to
+   replace the current one. */
+static void tune_precision(int prec, void *a, void *b, void *c, void *buffer) {
+
+  int *field[3], unroll, size, dim, i, j;
+  BLASLONG n = tune_size[prec], base, value, saved;
+  unsigned long long best, t;
+
+  tune_fields(prec, &field[0], &field[1], &field[2], &unroll, &size);
+
+  tune_run(prec, n, a, b, c, buffer);
+  best = tune_time(prec, n, a, b, c, buffer);
+
+  for (j = 0; j < 3; j++) {
+
+    dim  = tune_order[j];
+    base = *field[dim];
+
+    for (i = 0; i < (int)(sizeof(tune_scale) / sizeof(tune_scale[0])); i++) {
+      value = base * tune_scale[i] / 4;
+      switch (dim) {
+      case 0: value = (value + unroll - 1) / unroll * unroll; break;
+      case 1: value = (value + 7) & ~7; break;
+      case 2: value = value & ~15; break;
+      }
+      if (value == *field[dim]) continue;
+
+      saved = *field[dim];
+      *field[dim] = value;
+
+      /* a larger P or Q leaves less room for R */
+      if (dim != 2 && *field[2] > tune_rmax(*field[0], *field[1], size)) {
+	*field[dim] = saved;
+	continue;
+      }
+
+      if (!tune_valid(prec, *field[0], *field[1], *field[2], unroll, size)) {
+	*field[dim] = saved;
+	continue;
+      }
+
+      t = tune_time(prec, n, a, b, c, buffer);
+      if (t < best - best / 50)
+	best = t;
+      else
+	*field[dim] = saved;
+    }
+  }
+}
+
+void gotoblas_tune_init(void) {
+
+  int *p, *q, *r, unroll, size, prec;
+
+  for (prec = 0; prec < 4; prec++) {
+    tune_fields(prec, &p, &q, &r, &unroll, &size);
+    tune_qmax[prec] = *q;
+  }
+
+  if (tune_load() == 0 && openblas_tune_gemm_env()) openblas_tune_gemm();
+}
+
+#endif
+
+int openblas_tune_gemm(void) {
+
+#ifdef DYNAMIC_ARCH
+  BLASLONG n = tune_size[0];
+  void *a, *b, *c, *buffer;
+  int prec;
+
+  LOCK_COMMAND(&tune_lock);
+  if (tune_busy) {
+    UNLOCK_COMMAND(&tune_lock);
+    return -1;
+  }
+  tune_busy = 1;
+  UNLOCK_COMMAND(&tune_lock);
+
+  /* zero operands: the timings do not depend on the values */
+  a = calloc(1, n * n * sizeof(float));
+  b = calloc(1, n * n * sizeof(float));
+  c = calloc(1, n * n * sizeof(float));
+  buffer = blas_memory_alloc(1);
+
+  if (a && b && c && buffer) {
+    for (prec = 0; prec < 4; prec++)
+      tune_precision(prec, a, b, c, buffer);
+
+    tune_save();
+  }
+
+  if (buffer) blas_memory_free(buffer);
+  free(a);
+  free(b);
+  free(c);
+
+  LOCK_COMMAND(&tune_lock);
+  tune_busy = 0;
+  UNLOCK_COMMAND(&tune_lock);
+
+  return (a && b && c && buffer) ? 0 : -1;
+#else
+  return -1;
+#endif
+}
+
+int openblas_get_gemm_blocking(char precision, int *p, int *q, int *r) {
+
+  switch (precision) {
+  case 's': *p = SGEMM_P; *q = SGEMM_Q; *r = SGEMM_R; break;
+  case 'd': *p = DGEMM_P; *q = DGEMM_Q; *r = DGEMM_R; break;
+  case 'c': *p = CGEMM_P; *q = CGEMM_Q; *r = CGEMM_R; break;
+  case 'z': *p = ZGEMM_P; *q = ZGEMM_Q; *r = ZGEMM_R; break;
+  default: return -1;
+  }
+
+  return 0;
+}
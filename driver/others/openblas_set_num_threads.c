@@ -49,5 +49,23 @@ void openblas_set_num_threads(int num_threads) {
 
 void openblas_set_num_threads_(int* num_threads){
 
+}
+
+struct openblas_threadpool *openblas_threadpool_create(int num_threads, const int *cpus){
+  return NULL;
+}
+
+void openblas_threadpool_destroy(struct openblas_threadpool *pool){
+}
+
+int openblas_threadpool_bind(struct openblas_threadpool *pool){
+  return -1;
+}
+
+int openblas_set_thread_context(int max_threads, const int *cpus, int ncpus, int policy){
+  return -1;
+}
+
+void openblas_clear_thread_context(void){
 }
 #endif
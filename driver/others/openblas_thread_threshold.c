@@ -0,0 +1,423 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Problem sizes from which the interface routines use more than one
+   thread.  The table starts out with the built-in heuristics and can be
+   replaced by crossover points measured on the running machine, either
+   through openblas_calibrate_threading() or on first use when
+   OPENBLAS_CALIBRATE is set.  Measured values are kept in a cache file
+   together with the core name and thread count they were taken with. */
+
+#include <stdio.h>
+#include <string.h>
+#include "common.h"
+#ifndef OS_WINDOWS
+#include <time.h>
+#endif
+
+static const char *threshold_name[] = { "axpy", "gemv", "trsm", "trsv" };
+static const char threshold_prec[] = "sdcz";
+
+static int threshold_lookup(const char *name, int *routine, int *prec) {
+
+  const char *p;
+  int i;
+
+  if (name == NULL || name[0] == '\0' || (p = strchr(threshold_prec, name[0])) == NULL) return -1;
+
+  for (i = 0; i < (int)(sizeof(threshold_name) / sizeof(threshold_name[0])); i++)
+    if (!strcmp(name + 1, threshold_name[i])) {
+      *routine = i;
+      *prec = (int)(p - threshold_prec);
+      return 0;
+    }
+
+  return -1;
+}
+
+#ifdef SMP
+
+#if defined(Z13)
+#define AXPY_DEFAULT	200001
+#else
+#define AXPY_DEFAULT	10001
+#endif
+
+#define GEMV_DEFAULT	(2304L * GEMM_MULTITHREAD_THRESHOLD)
+#define ZGEMV_DEFAULT	(1024L * GEMM_MULTITHREAD_THRESHOLD)
+#define TRSM_DEFAULT	(256L * GEMM_MULTITHREAD_THRESHOLD)
+#define ZTRSM_DEFAULT	(128L * GEMM_MULTITHREAD_THRESHOLD)
+#define TRSV_DEFAULT	(2048L * 2048L)
+#define ZTRSV_DEFAULT	(1024L * 1024L)
+
+static BLASLONG thread_threshold[BLAS_THRESHOLD_ROUTINES][4] = {
+  { AXPY_DEFAULT, AXPY_DEFAULT, AXPY_DEFAULT,  AXPY_DEFAULT  },
+  { GEMV_DEFAULT, GEMV_DEFAULT, ZGEMV_DEFAULT, ZGEMV_DEFAULT },
+  { TRSM_DEFAULT, TRSM_DEFAULT, ZTRSM_DEFAULT, ZTRSM_DEFAULT },
+  { TRSV_DEFAULT, TRSV_DEFAULT, ZTRSV_DEFAULT, ZTRSV_DEFAULT },
+};
+
+static volatile int threshold_ready = 0;
+static int threshold_busy = 0;
+
+#if   defined(USE_PTHREAD_LOCK)
+static pthread_mutex_t    threshold_lock = PTHREAD_MUTEX_INITIALIZER;
+#elif defined(USE_PTHREAD_SPINLOCK)
+static pthread_spinlock_t threshold_lock = 0;
+#else
+static BLASULONG  threshold_lock = 0UL;
+#endif
+
+int openblas_calibrate();
+char *openblas_get_corename(void);
+char *openblas_cache_path(char *path, size_t len, const char *env, const char *name);
+int openblas_calibrate_threading(void);
+
+/* Operand sizes tried for each routine: the vector length for axpy, the
+   order of the square matrix for gemv, trsm and trsv. */
+static const BLASLONG threshold_first[] = { 1024, 32, 16, 64 };
+static const BLASLONG threshold_last[]  = { 1L << 20, 1024, 512, 1024 };
+
+static char *threshold_path(char *path, size_t len) {
+
+  return openblas_cache_path(path, len, "OPENBLAS_THRESHOLD_FILE", "openblas_thresholds");
+}
+
+/* Reads a cache file written for this core and thread count into table. */
+static int threshold_load(BLASLONG table[][4]) {
+
+  char path[1024], line[256], core[64], name[16];
+  FILE *fp;
+  int threads, routine, prec, found = 0;
+  long value;
+
+  if (threshold_path(path, sizeof(path)) == NULL) return 0;
+  if ((fp = fopen(path, "r")) == NULL) return 0;
+
+  while (fgets(line, sizeof(line), fp)) {
+    if (line[0] == '#') continue;
+    if (sscanf(line, "%63s %d", core, &threads) != 2) break;
+    if (strcmp(core, openblas_get_corename()) || threads != blas_cpu_number) break;
+
+    while (fgets(line, sizeof(line), fp))
+      if (sscanf(line, "%15s %ld", name, &value) == 2 && value > 0
+	  && !threshold_lookup(name, &routine, &prec)) {
+	table[routine][prec] = value;
+	found ++;
+      }
+    break;
+  }
+
+  fclose(fp);
+  return found;
+}
+
+static void threshold_save(BLASLONG table[][4]) {
+
+  char path[1024];
+  FILE *fp;
+  int routine, prec;
+
+  if (threshold_path(path, sizeof(path)) == NULL) return;
+  if ((fp = fopen(path, "w")) == NULL) return;
+
+  fprintf(fp, "# OpenBLAS thread thresholds: core, threads, then size per routine\n");
+  fprintf(fp, "%s %d\n", openblas_get_corename(), blas_cpu_number);
+  for (routine = 0; routine < BLAS_THRESHOLD_ROUTINES; routine++)
+    for (prec = 0; prec < 4; prec++)
+      fprintf(fp, "%c%s %ld\n", threshold_prec[prec], threshold_name[routine],
+	      (long)table[routine][prec]);
+
+  fclose(fp);
+}
+
+static double threshold_clock(void) {
+#ifdef OS_WINDOWS
+  LARGE_INTEGER count, freq;
+
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&freq);
+  return (double)count.QuadPart / (double)freq.QuadPart;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (double)ts.tv_sec + 1.e-9 * (double)ts.tv_nsec;
+#endif
+}
+
+/* One call of the single threaded (nthreads == 1) or threaded code path
+   the interface would take, on square or vector operands of order n. */
+static void threshold_run(int routine, int prec, BLASLONG n, int nthreads,
+			  void *a, void *x, void *y, void *buffer) {
+
+  static float  sone[2] = { ONE, ZERO };
+  static double done[2] = { ONE, ZERO };
+  blas_arg_t args;
+  BLASLONG p = 0, q = 0, size = (prec & 1) ? sizeof(double) : sizeof(float);
+  int mode = ((prec & 1) ? BLAS_DOUBLE : BLAS_SINGLE) | ((prec & 2) ? BLAS_COMPLEX : BLAS_REAL);
+  int (*trsm)(blas_arg_t *, BLASLONG *, BLASLONG *, void *, void *, BLASLONG) = NULL;
+  void *sa, *sb;
+
+  switch (routine) {
+
+  case BLAS_THRESHOLD_AXPY:
+    if (nthreads == 1) {
+      switch (prec) {
+      case 0: SAXPYU_K(n, 0, 0, ONE,       x, 1, y, 1, NULL, 0); break;
+      case 1: DAXPYU_K(n, 0, 0, ONE,       x, 1, y, 1, NULL, 0); break;
+      case 2: CAXPYU_K(n, 0, 0, ONE, ZERO, x, 1, y, 1, NULL, 0); break;
+      case 3: ZAXPYU_K(n, 0, 0, ONE, ZERO, x, 1, y, 1, NULL, 0); break;
+      }
+    } else {
+      switch (prec) {
+      case 0: blas_level1_thread(mode, n, 0, 0, sone, x, 1, y, 1, NULL, 0, (void *)SAXPYU_K, nthreads); break;
+      case 1: blas_level1_thread(mode, n, 0, 0, done, x, 1, y, 1, NULL, 0, (void *)DAXPYU_K, nthreads); break;
+      case 2: blas_level1_thread(mode, n, 0, 0, sone, x, 1, y, 1, NULL, 0, (void *)CAXPYU_K, nthreads); break;
+      case 3: blas_level1_thread(mode, n, 0, 0, done, x, 1, y, 1, NULL, 0, (void *)ZAXPYU_K, nthreads); break;
+      }
+    }
+    break;
+
+  case BLAS_THRESHOLD_GEMV:
+    if (nthreads == 1) {
+      switch (prec) {
+      case 0: SGEMV_N(n, n, 0, ONE,       a, n, x, 1, y, 1, buffer); break;
+      case 1: DGEMV_N(n, n, 0, ONE,       a, n, x, 1, y, 1, buffer); break;
+      case 2: CGEMV_N(n, n, 0, ONE, ZERO, a, n, x, 1, y, 1, buffer); break;
+      case 3: ZGEMV_N(n, n, 0, ONE, ZERO, a, n, x, 1, y, 1, buffer); break;
+      }
+    } else {
+      switch (prec) {
+      case 0: sgemv_thread_n(n, n, ONE,  a, n, x, 1, y, 1, buffer, nthreads); break;
+      case 1: dgemv_thread_n(n, n, ONE,  a, n, x, 1, y, 1, buffer, nthreads); break;
+      case 2: cgemv_thread_n(n, n, sone, a, n, x, 1, y, 1, buffer, nthreads); break;
+      case 3: zgemv_thread_n(n, n, done, a, n, x, 1, y, 1, buffer, nthreads); break;
+      }
+    }
+    break;
+
+  case BLAS_THRESHOLD_TRSM:
+    switch (prec) {
+    case 0: trsm = (void *)strsm_LNLU; p = SGEMM_P; q = SGEMM_Q; break;
+    case 1: trsm = (void *)dtrsm_LNLU; p = DGEMM_P; q = DGEMM_Q; break;
+    case 2: trsm = (void *)ctrsm_LNLU; p = CGEMM_P; q = CGEMM_Q; break;
+    case 3: trsm = (void *)ztrsm_LNLU; p = ZGEMM_P; q = ZGEMM_Q; break;
+    }
+
+    args.m = n;
+    args.n = n;
+    args.a = a;
+    args.b = y;
+    args.lda = n;
+    args.ldb = n;
+    args.beta = (prec & 1) ? (void *)done : (void *)sone;
+    args.nthreads = nthreads;
+
+    sa = (void *)((BLASLONG)buffer + GEMM_OFFSET_A);
+    sb = (void *)(((BLASLONG)sa + ((p * q * ((prec & 2) ? 2 : 1) * size + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+    if (nthreads == 1)
+      trsm(&args, NULL, NULL, sa, sb, 0);
+    else
+      gemm_thread_n(mode, &args, NULL, NULL, (void *)trsm, sa, sb, nthreads);
+    break;
+
+  case BLAS_THRESHOLD_TRSV:
+    /* unit diagonal, so the zero operands stay finite */
+    if (nthreads == 1) {
+      switch (prec) {
+      case 0: strsv_NLU(n, a, n, x, 1, buffer); break;
+      case 1: dtrsv_NLU(n, a, n, x, 1, buffer); break;
+      case 2: ctrsv_NLU(n, a, n, x, 1, buffer); break;
+      case 3: ztrsv_NLU(n, a, n, x, 1, buffer); break;
+      }
+    } else {
+      switch (prec) {
+      case 0: strsv_thread_NLU(n, a, n, x, 1, buffer, nthreads); break;
+      case 1: dtrsv_thread_NLU(n, a, n, x, 1, buffer, nthreads); break;
+      case 2: ctrsv_thread_NLU(n, a, n, x, 1, buffer, nthreads); break;
+      case 3: ztrsv_thread_NLU(n, a, n, x, 1, buffer, nthreads); break;
+      }
+    }
+    break;
+  }
+}
+
+/* Seconds per call, the better of two runs of at least a millisecond. */
+static double threshold_time(int routine, int prec, BLASLONG n, int nthreads,
+			     void *a, void *x, void *y, void *buffer) {
+
+  double start, elapsed, best = 0.;
+  BLASLONG reps, i;
+  int trial;
+
+  threshold_run(routine, prec, n, nthreads, a, x, y, buffer);
+
+  for (trial = 0; trial < 2; trial++) {
+    reps = 1;
+    do {
+      start = threshold_clock();
+      for (i = 0; i < reps; i++)
+	threshold_run(routine, prec, n, nthreads, a, x, y, buffer);
+      elapsed = threshold_clock() - start;
+      reps *= 2;
+    } while (elapsed < 1.e-3);
+
+    elapsed /= (double)(reps / 2);
+    if (trial == 0 || elapsed < best) best = elapsed;
+  }
+
+  return best;
+}
+
+/* Doubles the operand size until the threaded path wins by 10% twice in a
+   row and returns the problem size where that started, in the units the
+   interface compares against: the vector length for axpy and m * n for
+   gemv, trsm and trsv. */
+static BLASLONG threshold_measure(int routine, int prec, int nthreads,
+				  void *a, void *x, void *y, void *buffer) {
+
+  BLASLONG n, start = 0;
+  int wins = 0;
+
+  for (n = threshold_first[routine]; n <= threshold_last[routine]; n *= 2) {
+    if (threshold_time(routine, prec, n, nthreads, a, x, y, buffer) <
+	0.9 * threshold_time(routine, prec, n, 1, a, x, y, buffer)) {
+      if (wins++ == 0) start = n;
+      if (wins == 2) break;
+    } else {
+      wins = 0;
+    }
+  }
+
+  /* never faster: only thread problems past the ones tried */
+  if (wins == 0) start = 2 * threshold_last[routine];
+
+  return (routine == BLAS_THRESHOLD_AXPY) ? start : start * start;
+}
+
+static void threshold_init(void) {
+
+  BLASLONG table[BLAS_THRESHOLD_ROUTINES][4];
+  int calibrate = 0;
+
+  LOCK_COMMAND(&threshold_lock);
+  if (!threshold_ready) {
+    memcpy(table, thread_threshold, sizeof(table));
+    if (threshold_load(table) > 0)
+      memcpy(thread_threshold, table, sizeof(table));
+    else
+      calibrate = openblas_calibrate();
+    WMB;
+    threshold_ready = 1;
+  }
+  UNLOCK_COMMAND(&threshold_lock);
+
+  /* callers keep using the defaults while this runs */
+  if (calibrate) openblas_calibrate_threading();
+}
+
+BLASLONG blas_thread_threshold(int routine, int prec) {
+
+  if (blas_context_policy() == BLAS_POLICY_EAGER) return 0;
+
+  if (!threshold_ready) threshold_init();
+
+  return thread_threshold[routine][prec];
+}
+
+#endif
+
+int openblas_calibrate_threading(void) {
+
+#ifdef SMP
+  BLASLONG table[BLAS_THRESHOLD_ROUTINES][4];
+  BLASLONG n, len;
+  void *a, *x, *y, *buffer;
+  int routine, prec, nthreads;
+
+  nthreads = num_cpu_avail(1);
+  if (nthreads <= 1) return -1;
+
+  if (!threshold_ready) threshold_init();
+
+  LOCK_COMMAND(&threshold_lock);
+  if (threshold_busy) {
+    UNLOCK_COMMAND(&threshold_lock);
+    return -1;
+  }
+  threshold_busy = 1;
+  UNLOCK_COMMAND(&threshold_lock);
+
+  /* zero operands: the timings do not depend on the values */
+  n = threshold_last[BLAS_THRESHOLD_GEMV];
+  len = MAX(threshold_last[BLAS_THRESHOLD_AXPY], n * n) * 2 * sizeof(double);
+  a = calloc(1, len);
+  x = calloc(1, len);
+  y = calloc(1, len);
+  buffer = blas_memory_alloc(1);
+
+  if (a && x && y) {
+    for (routine = 0; routine < BLAS_THRESHOLD_ROUTINES; routine++)
+      for (prec = 0; prec < 4; prec++)
+	table[routine][prec] = threshold_measure(routine, prec, nthreads, a, x, y, buffer);
+
+    LOCK_COMMAND(&threshold_lock);
+    memcpy(thread_threshold, table, sizeof(table));
+    UNLOCK_COMMAND(&threshold_lock);
+
+    threshold_save(table);
+  }
+
+  blas_memory_free(buffer);
+  free(a);
+  free(x);
+  free(y);
+
+  LOCK_COMMAND(&threshold_lock);
+  threshold_busy = 0;
+  UNLOCK_COMMAND(&threshold_lock);
+
+  return (a && x && y) ? 0 : -1;
+#else
+  return -1;
+#endif
+}
+
+double openblas_get_thread_threshold(const char *name) {
+
+  int routine, prec;
+
+  if (threshold_lookup(name, &routine, &prec)) return -1.;
+
+#ifdef SMP
+  return (double)blas_thread_threshold(routine, prec);
+#else
+  return -1.;
+#endif
+}
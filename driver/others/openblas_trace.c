@@ -0,0 +1,434 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Per-call trace records.  A traced interface routine brackets its work
+   with TRACE_START() / TRACE_END(), the level 3 drivers add the cycles
+   they spend packing and in the kernels, and the finished record goes to
+   the callback and/or the trace stream.
+
+   Records are appended to a ring owned by the calling thread, so the
+   call itself never takes a lock.  A ring is drained, in one write per
+   chunk, when it fills up, on openblas_trace_flush() and at exit; the
+   thread draining it takes the ring's drain flag, and a record that
+   finds its ring full while someone else drains it is dropped and
+   counted rather than waited for.
+
+   Helper threads of the pthreads server charge their packing and kernel
+   time to the call they work for; with the OpenMP and Windows servers
+   only the calling thread's share is counted. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "common.h"
+#include "cblas.h"
+#ifdef OS_WINDOWS
+#include <io.h>
+#include <fcntl.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#endif
+
+#ifndef thread_local
+# if __STDC_VERSION__ >= 201112 && !defined __STDC_NO_THREADS__
+#  define thread_local _Thread_local
+# elif (defined __GNUC__ || \
+       defined __SUNPRO_C || \
+       defined __xlC__) && !defined(__APPLE__)
+#  define thread_local __thread
+# endif
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TRACE_CAS(p, o, n)	(InterlockedCompareExchangePointer((PVOID volatile *)(p), (n), (o)) == (o))
+#define TRACE_ADD(p, v)		InterlockedExchangeAdd64((LONG64 volatile *)(p), (LONG64)(v))
+#define TRACE_XCHG(p, v)	InterlockedExchange64((LONG64 volatile *)(p), (LONG64)(v))
+#define TRACE_TRYLOCK(p)	(InterlockedExchange((LONG volatile *)(p), 1) == 0)
+#else
+#define TRACE_CAS(p, o, n)	__sync_bool_compare_and_swap(p, o, n)
+#define TRACE_ADD(p, v)		__sync_fetch_and_add(p, v)
+#define TRACE_XCHG(p, v)	__atomic_exchange_n(p, v, __ATOMIC_SEQ_CST)
+#define TRACE_TRYLOCK(p)	(__sync_lock_test_and_set(p, 1) == 0)
+#endif
+
+#ifndef TRACE_RING
+#define TRACE_RING	256
+#endif
+
+/* Records per write when draining to a JSON-lines stream */
+#define TRACE_CHUNK	32
+#define TRACE_LINE	256
+
+int blas_trace_enabled = 0;
+
+static int trace_format = OPENBLAS_TRACE_OFF;
+static int trace_fd = -1;
+static openblas_trace_callback trace_callback = NULL;
+static void *trace_callback_data = NULL;
+static volatile unsigned long long trace_dropped = 0;
+
+typedef struct trace_ring {
+  openblas_trace_record record[TRACE_RING];
+  /* head only moves in the owning thread, tail only under drain */
+  volatile BLASULONG head;
+  volatile BLASULONG tail;
+  volatile int drain;
+  volatile int owned;
+  struct trace_ring *next;
+} trace_ring_t;
+
+static trace_ring_t * volatile trace_rings = NULL;
+
+#ifdef thread_local
+static thread_local trace_ring_t *trace_ring_local = NULL;
+static thread_local blas_trace_t *trace_current = NULL;
+#endif
+
+static unsigned long long trace_clock(int realtime) {
+
+#ifdef OS_WINDOWS
+  LARGE_INTEGER count, freq;
+
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&freq);
+  return (unsigned long long)((double)count.QuadPart * 1.e9 / (double)freq.QuadPart);
+#else
+  struct timespec ts;
+
+  clock_gettime(realtime ? CLOCK_REALTIME : CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000000ULL + (unsigned long long)ts.tv_nsec;
+#endif
+}
+
+static void trace_write(const void *data, size_t len) {
+
+  const char *p = (const char *)data;
+  long done;
+
+  while (len > 0 && trace_fd >= 0) {
+#ifdef OS_WINDOWS
+    done = _write(trace_fd, p, (unsigned int)len);
+#else
+    done = (long)write(trace_fd, p, len);
+#endif
+    if (done <= 0) return;
+    p   += done;
+    len -= done;
+  }
+}
+
+static int trace_json(char *line, const openblas_trace_record *r) {
+
+  return snprintf(line, TRACE_LINE,
+		  "{\"routine\":\"%s\",\"options\":\"%s\",\"m\":%lld,\"n\":%lld,\"k\":%lld,"
+		  "\"threads\":%d,\"start_ns\":%llu,\"wall_ns\":%llu,\"pack_ns\":%llu,\"kernel_ns\":%llu}\n",
+		  r -> routine, r -> options, r -> m, r -> n, r -> k, r -> threads,
+		  r -> start_ns, r -> wall_ns, r -> pack_ns, r -> kernel_ns);
+}
+
+/* Write out everything queued in ring; returns 0 if someone else is at it */
+static int trace_drain(trace_ring_t *ring) {
+
+  char buffer[TRACE_CHUNK * TRACE_LINE];
+  unsigned long long dropped;
+  BLASULONG tail, head;
+  int len, count;
+
+  if (!TRACE_TRYLOCK(&ring -> drain)) return 0;
+
+  tail = ring -> tail;
+  head = ring -> head;
+  RMB;
+
+  if (trace_format == OPENBLAS_TRACE_JSON) {
+
+    if (trace_dropped && (dropped = TRACE_XCHG(&trace_dropped, 0ULL)) > 0) {
+      len = snprintf(buffer, TRACE_LINE, "{\"dropped\":%llu}\n", dropped);
+      trace_write(buffer, len);
+    }
+
+    while (tail != head) {
+      len = 0;
+      for (count = 0; count < TRACE_CHUNK && tail != head; count++, tail++)
+	len += trace_json(buffer + len, &ring -> record[tail % TRACE_RING]);
+      trace_write(buffer, len);
+    }
+
+  } else if (trace_format == OPENBLAS_TRACE_BINARY) {
+
+    while (tail != head) {
+      count = (int)MIN(head - tail, TRACE_RING - tail % TRACE_RING);
+      trace_write(&ring -> record[tail % TRACE_RING], count * sizeof(openblas_trace_record));
+      tail += count;
+    }
+  }
+
+  MB;
+  ring -> tail = head;
+  WMB;
+  ring -> drain = 0;
+
+  return 1;
+}
+
+#ifdef thread_local
+
+#if !defined(OS_WINDOWS)
+#include <pthread.h>
+
+static pthread_key_t  trace_key;
+static pthread_once_t trace_once = PTHREAD_ONCE_INIT;
+
+/* A thread that goes away hands its ring over to the next new thread */
+static void trace_release(void *ring) {
+
+  trace_drain((trace_ring_t *)ring);
+  WMB;
+  ((trace_ring_t *)ring) -> owned = 0;
+}
+
+static void trace_key_init(void) {
+  pthread_key_create(&trace_key, trace_release);
+}
+#endif
+
+static trace_ring_t *trace_ring_get(void) {
+
+  trace_ring_t *ring, *first;
+
+  for (ring = trace_rings; ring; ring = ring -> next)
+    if (!ring -> owned && TRACE_TRYLOCK(&ring -> owned)) break;
+
+  if (ring == NULL) {
+    ring = (trace_ring_t *)calloc(1, sizeof(trace_ring_t));
+    if (ring == NULL) return NULL;
+    ring -> owned = 1;
+
+    do {
+      first = trace_rings;
+      ring -> next = first;
+    } while (!TRACE_CAS(&trace_rings, first, ring));
+  }
+
+#if !defined(OS_WINDOWS)
+  pthread_once(&trace_once, trace_key_init);
+  pthread_setspecific(trace_key, ring);
+#endif
+
+  trace_ring_local = ring;
+  return ring;
+}
+
+static void trace_push(const openblas_trace_record *r) {
+
+  trace_ring_t *ring = trace_ring_local;
+
+  if (ring == NULL && (ring = trace_ring_get()) == NULL) return;
+
+  if (ring -> head - ring -> tail >= TRACE_RING && !trace_drain(ring)) {
+    TRACE_ADD(&trace_dropped, 1ULL);
+    return;
+  }
+
+  ring -> record[ring -> head % TRACE_RING] = *r;
+  WMB;
+  ring -> head ++;
+}
+
+#else
+
+/* Without thread local storage every record is written out directly */
+static void trace_push(const openblas_trace_record *r) {
+
+  char line[TRACE_LINE];
+
+  if (trace_format == OPENBLAS_TRACE_JSON)
+    trace_write(line, trace_json(line, r));
+  else
+    trace_write(r, sizeof(openblas_trace_record));
+}
+
+#endif
+
+blas_trace_t *blas_trace_current(void) {
+#ifdef thread_local
+  return trace_current;
+#else
+  return NULL;
+#endif
+}
+
+void blas_trace_set_current(blas_trace_t *trace) {
+#ifdef thread_local
+  trace_current = trace;
+#endif
+}
+
+void blas_trace_cost(blas_trace_t *trace, unsigned long long pack, unsigned long long kernel) {
+  if (pack)   TRACE_ADD(&trace -> pack,   pack);
+  if (kernel) TRACE_ADD(&trace -> kernel, kernel);
+}
+
+void blas_trace_begin(blas_trace_t *trace) {
+
+  trace -> start_ns     = trace_clock(1);
+  trace -> start_mono   = trace_clock(0);
+  trace -> pack         = 0;
+  trace -> kernel       = 0;
+  trace -> outer        = blas_trace_current();
+  blas_trace_set_current(trace);
+  trace -> start_cycles = rpcc();
+}
+
+void blas_trace_end(blas_trace_t *trace, const char *name, const char *options,
+		    BLASLONG m, BLASLONG n, BLASLONG k, int threads) {
+
+  openblas_trace_record r;
+  openblas_trace_callback callback = trace_callback;
+  unsigned long long cycles = rpcc() - trace -> start_cycles;
+  double scale;
+
+  blas_trace_set_current(trace -> outer);
+
+  memset(&r, 0, sizeof(r));
+  if (!strncmp(name, "cblas_", 6)) name += 6;
+  strncpy(r.routine, name, sizeof(r.routine) - 1);
+  if (options) strncpy(r.options, options, sizeof(r.options) - 1);
+  r.m = m;
+  r.n = n;
+  r.k = k;
+  r.threads  = threads;
+  r.start_ns = trace -> start_ns;
+  r.wall_ns  = trace_clock(0) - trace -> start_mono;
+
+  /* the drivers count cycles, convert them at this call's rate */
+  if (cycles > 0 && (trace -> pack || trace -> kernel)) {
+    scale = (double)r.wall_ns / (double)cycles;
+    r.pack_ns   = (unsigned long long)(scale * (double)trace -> pack);
+    r.kernel_ns = (unsigned long long)(scale * (double)trace -> kernel);
+  }
+
+  if (callback) callback(&r, trace_callback_data);
+  if (trace_format != OPENBLAS_TRACE_OFF) trace_push(&r);
+}
+
+void openblas_trace_flush(void) {
+
+#ifdef thread_local
+  trace_ring_t *ring;
+
+  for (ring = trace_rings; ring; ring = ring -> next) trace_drain(ring);
+#endif
+}
+
+static void trace_close(void) {
+
+  openblas_trace_flush();
+
+  trace_format = OPENBLAS_TRACE_OFF;
+  MB;
+
+  if (trace_fd > 2) {
+#ifdef OS_WINDOWS
+    _close(trace_fd);
+#else
+    close(trace_fd);
+#endif
+  }
+  trace_fd = -1;
+}
+
+int openblas_set_trace(int format, const char *path) {
+
+  static const char magic[16] = "OBTRACE1";
+  int fd = 2;
+  unsigned int size = sizeof(openblas_trace_record);
+
+  if (format < OPENBLAS_TRACE_OFF || format > OPENBLAS_TRACE_BINARY) return -1;
+  if (format == OPENBLAS_TRACE_BINARY && (path == NULL || !strcmp(path, "-"))) return -1;
+
+  if (format != OPENBLAS_TRACE_OFF && path && strcmp(path, "-")) {
+#ifdef OS_WINDOWS
+    fd = _open(path, _O_WRONLY | _O_CREAT | _O_TRUNC | _O_APPEND | _O_BINARY, 0644);
+#else
+    fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+#endif
+    if (fd < 0) return -1;
+  }
+
+  blas_trace_enabled = (trace_callback != NULL);
+  MB;
+  trace_close();
+
+  if (format == OPENBLAS_TRACE_OFF) return 0;
+
+  trace_fd = fd;
+
+  /* binary streams start with the magic and the record size */
+  if (format == OPENBLAS_TRACE_BINARY) {
+    char header[sizeof(magic) + sizeof(size)];
+    memcpy(header, magic, sizeof(magic));
+    memcpy(header + sizeof(magic), &size, sizeof(size));
+    trace_write(header, sizeof(header));
+  }
+
+  trace_format = format;
+  WMB;
+  blas_trace_enabled = 1;
+
+  return 0;
+}
+
+void openblas_set_trace_callback(openblas_trace_callback callback, void *data) {
+
+  trace_callback = NULL;
+  WMB;
+  trace_callback_data = data;
+  WMB;
+  trace_callback = callback;
+  blas_trace_enabled = (callback != NULL) || (trace_format != OPENBLAS_TRACE_OFF);
+}
+
+/* OPENBLAS_TRACE=json|binary selects the stream, OPENBLAS_TRACE_FILE where
+   it goes (default: stderr, which only takes JSON lines) */
+void blas_trace_init(void) {
+
+  char *p = getenv("OPENBLAS_TRACE");
+
+  if (p == NULL || *p == '\0') return;
+
+  if (!strcmp(p, "json") || !strcmp(p, "1"))
+    openblas_set_trace(OPENBLAS_TRACE_JSON, getenv("OPENBLAS_TRACE_FILE"));
+  else if (!strcmp(p, "binary"))
+    openblas_set_trace(OPENBLAS_TRACE_BINARY, getenv("OPENBLAS_TRACE_FILE"));
+}
+
+void blas_trace_quit(void) {
+  if (trace_format != OPENBLAS_TRACE_OFF) trace_close();
+}
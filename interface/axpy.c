@@ -41,11 +41,6 @@
 #ifdef FUNCTION_PROFILE
 #include "functable.h"
 #endif
-#if  defined(Z13)
-#define MULTI_THREAD_MINIMAL  200000
-#else
-#define MULTI_THREAD_MINIMAL  10000
-#endif
 #ifndef CBLAS
 
 void NAME(blasint *N, FLOAT *ALPHA, FLOAT *x, blasint *INCX, FLOAT *y, blasint *INCY){
@@ -82,6 +77,8 @@ void CNAME(blasint n, FLOAT alpha, FLOAT *x, blasint incx, FLOAT *y, blasint inc
     
   IDEBUG_START;
 
+  TRACE_START();
+
   FUNCTION_PROFILE_START();
 
   if (incx < 0) x -= (n - 1) * incx;
@@ -93,7 +90,7 @@ void CNAME(blasint n, FLOAT alpha, FLOAT *x, blasint incx, FLOAT *y, blasint inc
   //
   //Temporarily work-around the low performance issue with small input size &
   //multithreads.
-  if (incx == 0 || incy == 0 || n <= MULTI_THREAD_MINIMAL)
+  if (incx == 0 || incy == 0 || n < blas_thread_threshold(BLAS_THRESHOLD_AXPY, BLAS_THRESHOLD_PREC))
 	  nthreads = 1;
   else
 	  nthreads = num_cpu_avail(1);
@@ -122,6 +119,8 @@ void CNAME(blasint n, FLOAT alpha, FLOAT *x, blasint incx, FLOAT *y, blasint inc
 
   FUNCTION_PROFILE_END(1, 2 * n, 2 * n);
 
+  TRACE_END(NULL, n, 0, 0, TRACE_THREADS(nthreads));
+
   IDEBUG_END;
 
   return;
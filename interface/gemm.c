@@ -103,6 +103,46 @@ static int (*gemm[])(blas_arg_t *, BLASLONG *, BLASLONG *, IFLOAT *, IFLOAT *, B
 #endif
 };
 
+#if defined(SMALL_MATRIX_OPT) && !defined(GEMM3M) && !defined(XDOUBLE) && !defined(HALF)
+#define USE_SMALL_MATRIX_OPT
+
+/* Unpacked kernels for small problems, indexed like gemm[] above. With
+   DYNAMIC_ARCH the entries are offsets into gotoblas_t, since the kernels
+   of the selected core are only known at runtime. */
+
+#ifdef DYNAMIC_ARCH
+#define SMALL_KERNEL_ADDR(table, idx) (*(void **)((char *)gotoblas + (size_t)(table[idx])))
+#else
+#define SMALL_KERNEL_ADDR(table, idx) ((void *)(table[idx]))
+#endif
+
+#ifndef COMPLEX
+static void *gemm_small_kernel[] = {
+  (void *)GEMM_SMALL_KERNEL_NN, (void *)GEMM_SMALL_KERNEL_TN, NULL, NULL,
+  (void *)GEMM_SMALL_KERNEL_NT, (void *)GEMM_SMALL_KERNEL_TT, NULL, NULL,
+};
+
+static void *gemm_small_kernel_b0[] = {
+  (void *)GEMM_SMALL_KERNEL_B0_NN, (void *)GEMM_SMALL_KERNEL_B0_TN, NULL, NULL,
+  (void *)GEMM_SMALL_KERNEL_B0_NT, (void *)GEMM_SMALL_KERNEL_B0_TT, NULL, NULL,
+};
+#else
+static void *gemm_small_kernel[] = {
+  (void *)GEMM_SMALL_KERNEL_NN, (void *)GEMM_SMALL_KERNEL_TN, (void *)GEMM_SMALL_KERNEL_RN, (void *)GEMM_SMALL_KERNEL_CN,
+  (void *)GEMM_SMALL_KERNEL_NT, (void *)GEMM_SMALL_KERNEL_TT, (void *)GEMM_SMALL_KERNEL_RT, (void *)GEMM_SMALL_KERNEL_CT,
+  (void *)GEMM_SMALL_KERNEL_NR, (void *)GEMM_SMALL_KERNEL_TR, (void *)GEMM_SMALL_KERNEL_RR, (void *)GEMM_SMALL_KERNEL_CR,
+  (void *)GEMM_SMALL_KERNEL_NC, (void *)GEMM_SMALL_KERNEL_TC, (void *)GEMM_SMALL_KERNEL_RC, (void *)GEMM_SMALL_KERNEL_CC,
+};
+
+static void *gemm_small_kernel_b0[] = {
+  (void *)GEMM_SMALL_KERNEL_B0_NN, (void *)GEMM_SMALL_KERNEL_B0_TN, (void *)GEMM_SMALL_KERNEL_B0_RN, (void *)GEMM_SMALL_KERNEL_B0_CN,
+  (void *)GEMM_SMALL_KERNEL_B0_NT, (void *)GEMM_SMALL_KERNEL_B0_TT, (void *)GEMM_SMALL_KERNEL_B0_RT, (void *)GEMM_SMALL_KERNEL_B0_CT,
+  (void *)GEMM_SMALL_KERNEL_B0_NR, (void *)GEMM_SMALL_KERNEL_B0_TR, (void *)GEMM_SMALL_KERNEL_B0_RR, (void *)GEMM_SMALL_KERNEL_B0_CR,
+  (void *)GEMM_SMALL_KERNEL_B0_NC, (void *)GEMM_SMALL_KERNEL_B0_TC, (void *)GEMM_SMALL_KERNEL_B0_RC, (void *)GEMM_SMALL_KERNEL_B0_CC,
+};
+#endif
+#endif
+
 #ifndef CBLAS
 
 void NAME(char *TRANSA, char *TRANSB,
@@ -220,8 +260,8 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANS
 	   blasint m, blasint n, blasint k,
 #ifndef COMPLEX
 	   FLOAT alpha,
-	   FLOAT *a, blasint lda,
-	   FLOAT *b, blasint ldb,
+	   IFLOAT *a, blasint lda,
+	   IFLOAT *b, blasint ldb,
 	   FLOAT beta,
 	   FLOAT *c, blasint ldc) {
 #else
@@ -271,7 +311,7 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANS
 
   PRINT_DEBUG_CNAME;
 
-#if !defined(COMPLEX) && !defined(DOUBLE) && defined(USE_SGEMM_KERNEL_DIRECT)
+#if !defined(COMPLEX) && !defined(DOUBLE) && !defined(HALF) && defined(USE_SGEMM_KERNEL_DIRECT)
 #ifdef DYNAMIC_ARCH
  if (support_avx512() )
 #endif  
@@ -402,6 +442,49 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANS
 
   if ((args.m == 0) || (args.n == 0)) return;
 
+  TRACE_START();
+
+#ifdef USE_SMALL_MATRIX_OPT
+#ifndef COMPLEX
+  if (*(FLOAT *)args.alpha != ZERO &&
+      GEMM_SMALL_MATRIX_PERMIT(transa, transb, args.m, args.n, args.k, *(FLOAT *)args.alpha, *(FLOAT *)args.beta)) {
+    FLOAT alpha0 = *(FLOAT *)args.alpha, beta0 = *(FLOAT *)args.beta;
+
+    if (beta0 == ZERO) {
+      int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT *, BLASLONG, FLOAT *, BLASLONG)
+	= SMALL_KERNEL_ADDR(gemm_small_kernel_b0, (transb << 2) | transa);
+      kernel(args.m, args.n, args.k, args.a, args.lda, alpha0, args.b, args.ldb, args.c, args.ldc);
+    } else {
+      int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT *, BLASLONG, FLOAT, FLOAT *, BLASLONG)
+	= SMALL_KERNEL_ADDR(gemm_small_kernel, (transb << 2) | transa);
+      kernel(args.m, args.n, args.k, args.a, args.lda, alpha0, args.b, args.ldb, beta0, args.c, args.ldc);
+    }
+    TRACE_END(((char[]){"NTRC"[transa], "NTRC"[transb], 0}), args.m, args.n, args.k, 1);
+    return;
+  }
+#else
+  if ((((FLOAT *)args.alpha)[0] != ZERO || ((FLOAT *)args.alpha)[1] != ZERO) &&
+      GEMM_SMALL_MATRIX_PERMIT(transa, transb, args.m, args.n, args.k,
+			       ((FLOAT *)args.alpha)[0], ((FLOAT *)args.alpha)[1],
+			       ((FLOAT *)args.beta)[0], ((FLOAT *)args.beta)[1])) {
+    FLOAT alpha0 = ((FLOAT *)args.alpha)[0], alpha1 = ((FLOAT *)args.alpha)[1];
+    FLOAT beta0 = ((FLOAT *)args.beta)[0], beta1 = ((FLOAT *)args.beta)[1];
+
+    if (beta0 == ZERO && beta1 == ZERO) {
+      int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT, FLOAT *, BLASLONG, FLOAT *, BLASLONG)
+	= SMALL_KERNEL_ADDR(gemm_small_kernel_b0, (transb << 2) | transa);
+      kernel(args.m, args.n, args.k, args.a, args.lda, alpha0, alpha1, args.b, args.ldb, args.c, args.ldc);
+    } else {
+      int (*kernel)(BLASLONG, BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT, FLOAT, FLOAT *, BLASLONG, FLOAT, FLOAT, FLOAT *, BLASLONG)
+	= SMALL_KERNEL_ADDR(gemm_small_kernel, (transb << 2) | transa);
+      kernel(args.m, args.n, args.k, args.a, args.lda, alpha0, alpha1, args.b, args.ldb, beta0, beta1, args.c, args.ldc);
+    }
+    TRACE_END(((char[]){"NTRC"[transa], "NTRC"[transb], 0}), args.m, args.n, args.k, 1);
+    return;
+  }
+#endif
+#endif
+
 #if 0
   fprintf(stderr, "m = %4d  n = %d  k = %d  lda = %4d  ldb = %4d  ldc = %4d\n",
 	 args.m, args.n, args.k, args.lda, args.ldb, args.ldc);
@@ -436,6 +519,12 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANS
 
   } else {
 
+    if (openblas_gemm_dynamic() || openblas_get_deterministic()) {
+
+      gemm_thread_dynamic(mode, &args, NULL, NULL, gemm[(transb << 2) | transa], sa, sb, args.nthreads);
+
+    } else {
+
 #ifndef USE_SIMPLE_THREADED_LEVEL3
 
 #ifndef NO_AFFINITY
@@ -464,6 +553,8 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANS
 #endif
 #endif
 
+    }
+
 #endif
 
 #ifdef SMP
@@ -474,6 +565,8 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANS
 
   FUNCTION_PROFILE_END(COMPSIZE * COMPSIZE, args.m * args.k + args.k * args.n + args.m * args.n, 2 * args.m * args.n * args.k);
 
+  TRACE_END(((char[]){"NTRC"[transa], "NTRC"[transb], 0}), args.m, args.n, args.k, TRACE_THREADS(args.nthreads));
+
   IDEBUG_END;
 
   return;
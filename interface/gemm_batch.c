@@ -0,0 +1,326 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+/*
+ * cblas_?gemm_batch          : group_count groups, every group holding
+ *                              group_size[g] GEMMs that share the
+ *                              parameters of the group.
+ * cblas_?gemm_batch_strided  : batch_size GEMMs with identical parameters
+ *                              whose operands are stride? elements apart.
+ *
+ * Each entry is checked exactly like cblas_?gemm; the whole batch is then
+ * handed to the batch driver, which distributes entries over the threads.
+ */
+
+#ifndef COMPLEX
+#ifdef DOUBLE
+#define ERROR_NAME "DGEMM_BATCH "
+#else
+#define ERROR_NAME "SGEMM_BATCH "
+#endif
+#else
+#ifdef DOUBLE
+#define ERROR_NAME "ZGEMM_BATCH "
+#else
+#define ERROR_NAME "CGEMM_BATCH "
+#endif
+#endif
+
+static int trans_index(enum CBLAS_TRANSPOSE Trans){
+
+  if (Trans == CblasNoTrans)     return 0;
+  if (Trans == CblasTrans)       return 1;
+#ifndef COMPLEX
+  if (Trans == CblasConjNoTrans) return 0;
+  if (Trans == CblasConjTrans)   return 1;
+#else
+  if (Trans == CblasConjNoTrans) return 2;
+  if (Trans == CblasConjTrans)   return 3;
+#endif
+  return -1;
+}
+
+/* Fill one batch entry; returns the cblas_?gemm info code or -1 */
+static blasint set_entry(blas_arg_t *args, enum CBLAS_ORDER order,
+			 enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANSPOSE TransB,
+			 blasint m, blasint n, blasint k, FLOAT *alpha,
+			 FLOAT *a, blasint lda, FLOAT *b, blasint ldb,
+			 FLOAT *beta, FLOAT *c, blasint ldc){
+
+  int transa = -1, transb = -1;
+  blasint nrowa, nrowb, info;
+
+  info = 0;
+
+  args -> alpha = (void *)alpha;
+  args -> beta  = (void *)beta;
+  args -> k     = k;
+  args -> c     = (void *)c;
+  args -> ldc   = ldc;
+
+  if (order == CblasColMajor) {
+    args -> m = m;
+    args -> n = n;
+
+    args -> a = (void *)a;
+    args -> b = (void *)b;
+
+    args -> lda = lda;
+    args -> ldb = ldb;
+
+    transa = trans_index(TransA);
+    transb = trans_index(TransB);
+
+    info = -1;
+  }
+
+  if (order == CblasRowMajor) {
+    args -> m = n;
+    args -> n = m;
+
+    args -> a = (void *)b;
+    args -> b = (void *)a;
+
+    args -> lda = ldb;
+    args -> ldb = lda;
+
+    transa = trans_index(TransB);
+    transb = trans_index(TransA);
+
+    info = -1;
+  }
+
+  if (info < 0) {
+    nrowa = args -> m;
+    if (transa & 1) nrowa = args -> k;
+    nrowb = args -> k;
+    if (transb & 1) nrowb = args -> n;
+
+    if (args -> ldc < args -> m) info = 13;
+    if (args -> ldb < nrowb)     info = 10;
+    if (args -> lda < nrowa)     info =  8;
+    if (args -> k < 0)           info =  5;
+    if (args -> n < 0)           info =  4;
+    if (args -> m < 0)           info =  3;
+    if (transb < 0)              info =  2;
+    if (transa < 0)              info =  1;
+  }
+
+  args -> routine      = NULL;
+  args -> routine_mode = (transb << 2) | transa;
+#ifdef SMP
+  args -> nthreads     = 1;
+  args -> common       = NULL;
+#endif
+
+  return info;
+}
+
+static void run_batch(blas_arg_t *args, BLASLONG count){
+
+#ifdef FUNCTION_PROFILE
+  double size = 0., flops = 0.;
+  BLASLONG i;
+
+  for (i = 0; i < count; i++) {
+    size  += (double)(args[i].m * args[i].k + args[i].k * args[i].n + args[i].m * args[i].n);
+    flops += 2. * (double)args[i].m * (double)args[i].n * (double)args[i].k;
+  }
+#endif
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  GEMM_BATCH_THREAD(args, count);
+
+  FUNCTION_PROFILE_END(COMPSIZE * COMPSIZE, size, flops);
+
+  IDEBUG_END;
+}
+
+#ifndef STRIDED
+
+void CNAME(enum CBLAS_ORDER order,
+	   enum CBLAS_TRANSPOSE *TransA_array, enum CBLAS_TRANSPOSE *TransB_array,
+	   blasint *m_array, blasint *n_array, blasint *k_array,
+#ifndef COMPLEX
+	   FLOAT *alpha_array,
+	   FLOAT **a_array, blasint *lda_array,
+	   FLOAT **b_array, blasint *ldb_array,
+	   FLOAT *beta_array,
+	   FLOAT **c_array, blasint *ldc_array,
+#else
+	   void *valpha_array,
+	   void **va_array, blasint *lda_array,
+	   void **vb_array, blasint *ldb_array,
+	   void *vbeta_array,
+	   void **vc_array, blasint *ldc_array,
+#endif
+	   blasint group_count, blasint *group_size) {
+
+#ifndef COMPLEX
+  FLOAT **a = a_array, **b = b_array, **c = c_array;
+#else
+  FLOAT *alpha_array = (FLOAT *)valpha_array;
+  FLOAT *beta_array  = (FLOAT *)vbeta_array;
+  FLOAT **a = (FLOAT **)va_array, **b = (FLOAT **)vb_array, **c = (FLOAT **)vc_array;
+#endif
+
+  blas_arg_t *args;
+  BLASLONG g, i, total, count, pos;
+  blasint info;
+
+  PRINT_DEBUG_CNAME;
+
+  info = 0;
+  if (group_count < 0) info = 15;
+
+  total = 0;
+  for (g = 0; g < group_count && info == 0; g++) {
+    if (group_size[g] < 0) info = 16;
+    total += group_size[g];
+  }
+
+  if (info) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+    return;
+  }
+
+  if (total == 0) return;
+
+  args = (blas_arg_t *)malloc(total * sizeof(blas_arg_t));
+  if (args == NULL) {
+    fprintf(stderr, "OpenBLAS : " ERROR_NAME "failed to allocate %ld batch entries\n", (long)total);
+    return;
+  }
+
+  count = 0;
+  pos   = 0;
+
+  for (g = 0; g < group_count; g++) {
+    for (i = 0; i < group_size[g]; i++, pos++) {
+
+      info = set_entry(&args[count], order, TransA_array[g], TransB_array[g],
+		       m_array[g], n_array[g], k_array[g], alpha_array + g * COMPSIZE,
+		       a[pos], lda_array[g], b[pos], ldb_array[g],
+		       beta_array + g * COMPSIZE, c[pos], ldc_array[g]);
+
+      if (info >= 0) {
+	BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+	free(args);
+	return;
+      }
+
+      if (args[count].m == 0 || args[count].n == 0) continue;
+
+      count ++;
+    }
+  }
+
+  if (count > 0) run_batch(args, count);
+
+  free(args);
+}
+
+#else
+
+void CNAME(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANSPOSE TransB,
+	   blasint m, blasint n, blasint k,
+#ifndef COMPLEX
+	   FLOAT alpha,
+	   FLOAT *a, blasint lda, blasint stridea,
+	   FLOAT *b, blasint ldb, blasint strideb,
+	   FLOAT beta,
+	   FLOAT *c, blasint ldc, blasint stridec,
+#else
+	   void *valpha,
+	   void *va, blasint lda, blasint stridea,
+	   void *vb, blasint ldb, blasint strideb,
+	   void *vbeta,
+	   void *vc, blasint ldc, blasint stridec,
+#endif
+	   blasint batch_size) {
+
+#ifndef COMPLEX
+  FLOAT *palpha = &alpha, *pbeta = &beta;
+#else
+  FLOAT *palpha = (FLOAT *)valpha;
+  FLOAT *pbeta  = (FLOAT *)vbeta;
+  FLOAT *a = (FLOAT *)va;
+  FLOAT *b = (FLOAT *)vb;
+  FLOAT *c = (FLOAT *)vc;
+#endif
+
+  blas_arg_t *args;
+  BLASLONG i;
+  blasint info;
+
+  PRINT_DEBUG_CNAME;
+
+  info = 0;
+  if (batch_size < 0) info = 19;
+
+  if (info) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+    return;
+  }
+
+  if (batch_size == 0) return;
+
+  args = (blas_arg_t *)malloc(batch_size * sizeof(blas_arg_t));
+  if (args == NULL) {
+    fprintf(stderr, "OpenBLAS : " ERROR_NAME "failed to allocate %ld batch entries\n", (long)batch_size);
+    return;
+  }
+
+  for (i = 0; i < batch_size; i++) {
+    info = set_entry(&args[i], order, TransA, TransB, m, n, k, palpha,
+		     a + i * stridea * COMPSIZE, lda,
+		     b + i * strideb * COMPSIZE, ldb,
+		     pbeta, c + i * stridec * COMPSIZE, ldc);
+
+    if (info >= 0) {
+      BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+      free(args);
+      return;
+    }
+  }
+
+  if (args[0].m > 0 && args[0].n > 0) run_batch(args, batch_size);
+
+  free(args);
+}
+
+#endif
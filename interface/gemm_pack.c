@@ -0,0 +1,302 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+/*
+ * cblas_?gemm_pack_get_size : bytes needed for a packed A (m x k) or B (k x n)
+ * cblas_?gemm_pack          : pack alpha * op(A) or alpha * op(B) once
+ * cblas_?gemm_compute       : C := op(A) * op(B) + beta * C, where A and / or
+ *                             B is CblasPacked and comes from ?gemm_pack
+ *
+ * The packed buffer is opaque and only valid for the core it was packed
+ * on; it holds the panels the level3 driver would build in sa / sb, so
+ * the kernel reads it directly instead of repacking the operand on every
+ * call.  Row major is handled as in ?gemm by swapping A and B, so a
+ * packed A of a row major problem is stored as the B operand.
+ */
+
+#ifdef DOUBLE
+#define ERROR_NAME "DGEMM_PACK "
+#define COMPUTE_ERROR_NAME "DGEMM_COMPUTE "
+#else
+#define ERROR_NAME "SGEMM_PACK "
+#define COMPUTE_ERROR_NAME "SGEMM_COMPUTE "
+#endif
+
+#ifndef GEMM_MULTITHREAD_THRESHOLD
+#define GEMM_MULTITHREAD_THRESHOLD 4
+#endif
+
+#define SMP_THRESHOLD_MIN 65536.0
+
+#if defined(GET_SIZE)
+
+size_t CNAME(enum CBLAS_IDENTIFIER identifier, blasint m, blasint n, blasint k){
+
+  BLASLONG dim;
+
+  PRINT_DEBUG_CNAME;
+
+  if (identifier == CblasAMatrix) dim = m;
+  else if (identifier == CblasBMatrix) dim = n;
+  else return 0;
+
+  if (dim < 0 || k < 0) return 0;
+
+  return sizeof(gemm_pack_t) + GEMM_PACK_ALIGN + (size_t)dim * (size_t)k * sizeof(FLOAT);
+}
+
+#elif !defined(COMPUTE)
+
+static int (*pack[])(blas_arg_t *) = {
+  GEMM_PACK_AN, GEMM_PACK_AT, GEMM_PACK_BN, GEMM_PACK_BT,
+};
+
+void CNAME(enum CBLAS_ORDER order, enum CBLAS_IDENTIFIER identifier, enum CBLAS_TRANSPOSE Trans,
+	   blasint m, blasint n, blasint k, FLOAT alpha, FLOAT *src, blasint ld, FLOAT *dest){
+
+  blas_arg_t args;
+  int role, trans;
+  blasint dim, nrow, info;
+
+  PRINT_DEBUG_CNAME;
+
+  role  = -1;
+  trans = -1;
+  info  =  0;
+
+  if (identifier == CblasAMatrix) role = 0;
+  if (identifier == CblasBMatrix) role = 1;
+
+  /* row major: op(A) is the B operand of the transposed problem */
+  if (order == CblasRowMajor && role >= 0) role ^= 1;
+
+  if (Trans == CblasNoTrans)     trans = 0;
+  if (Trans == CblasTrans)       trans = 1;
+  if (Trans == CblasConjNoTrans) trans = 0;
+  if (Trans == CblasConjTrans)   trans = 1;
+
+  dim = (identifier == CblasAMatrix) ? m : n;
+
+  /* rows of the stored matrix seen column major */
+  nrow = ((role == 0) ^ (trans == 1)) ? dim : k;
+
+  if (ld < MAX(nrow, 1))  info = 9;
+  if (k < 0)              info = 6;
+  if (n < 0)              info = 5;
+  if (m < 0)              info = 4;
+  if (trans < 0)          info = 3;
+  if (role  < 0)          info = 2;
+  if (order != CblasColMajor && order != CblasRowMajor) info = 1;
+
+  if (info) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+    return;
+  }
+
+  args.a     = (void *)src;
+  args.lda   = ld;
+  args.m     = dim;
+  args.n     = dim;
+  args.k     = k;
+  args.alpha = (void *)&alpha;
+  args.c     = (void *)dest;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  (pack[(role << 1) | trans])(&args);
+
+  FUNCTION_PROFILE_END(1, dim * k, 0);
+
+  IDEBUG_END;
+}
+
+#else
+
+static int (*compute[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
+  NULL,           NULL,           GEMM_COMPUTE_NP,
+  NULL,           NULL,           GEMM_COMPUTE_TP,
+  GEMM_COMPUTE_PN, GEMM_COMPUTE_PT, GEMM_COMPUTE_PP,
+};
+
+static int packed_mode(blasint Trans){
+
+  if (Trans == CblasPacked)      return 2;
+  if (Trans == CblasNoTrans)     return 0;
+  if (Trans == CblasTrans)       return 1;
+  if (Trans == CblasConjNoTrans) return 0;
+  if (Trans == CblasConjTrans)   return 1;
+  return -1;
+}
+
+/* a packed operand must match its role, its shape and the active core */
+static int packed_valid(void *handle, BLASLONG identifier, BLASLONG dim, BLASLONG k){
+
+  gemm_pack_t *pack = (gemm_pack_t *)handle;
+
+  return pack != NULL && pack -> identifier == identifier &&
+    pack -> dim == dim && pack -> k == k && pack -> q == GEMM_Q &&
+    pack -> unroll_m == GEMM_UNROLL_M && pack -> unroll_n == GEMM_UNROLL_N;
+}
+
+void CNAME(enum CBLAS_ORDER order, blasint TransA, blasint TransB,
+	   blasint m, blasint n, blasint k,
+	   FLOAT *a, blasint lda, FLOAT *b, blasint ldb,
+	   FLOAT beta, FLOAT *c, blasint ldc){
+
+  blas_arg_t args;
+  int transa, transb;
+  blasint nrowa, nrowb, info;
+  FLOAT alpha = ONE;
+
+  XFLOAT *buffer;
+  XFLOAT *sa, *sb;
+
+  PRINT_DEBUG_CNAME;
+
+  transa = -1;
+  transb = -1;
+  info   =  0;
+
+  args.k = k;
+  args.c = (void *)c;
+  args.ldc = ldc;
+
+  if (order == CblasColMajor) {
+    args.m = m;
+    args.n = n;
+
+    args.a = (void *)a;
+    args.b = (void *)b;
+
+    args.lda = lda;
+    args.ldb = ldb;
+
+    transa = packed_mode(TransA);
+    transb = packed_mode(TransB);
+
+    info = -1;
+  }
+
+  if (order == CblasRowMajor) {
+    args.m = n;
+    args.n = m;
+
+    args.a = (void *)b;
+    args.b = (void *)a;
+
+    args.lda = ldb;
+    args.ldb = lda;
+
+    transa = packed_mode(TransB);
+    transb = packed_mode(TransA);
+
+    info = -1;
+  }
+
+  if (info < 0) {
+    nrowa = args.m;
+    if (transa == 1) nrowa = args.k;
+    nrowb = args.k;
+    if (transb == 1) nrowb = args.n;
+
+    if (args.ldc < MAX(args.m, 1)) info = 13;
+
+    if (transb == 2) {
+      if (!packed_valid(args.b, 1, args.n, args.k)) info = 10;
+    } else
+      if (args.ldb < MAX(nrowb, 1)) info = 10;
+
+    if (transa == 2) {
+      if (!packed_valid(args.a, 0, args.m, args.k)) info =  8;
+    } else
+      if (args.lda < MAX(nrowa, 1)) info =  8;
+
+    if (args.k < 0)        info =  5;
+    if (args.n < 0)        info =  4;
+    if (args.m < 0)        info =  3;
+    if (transb < 0)        info =  2;
+    if (transa < 0)        info =  1;
+  }
+
+  if (info >= 0) {
+    BLASFUNC(xerbla)(COMPUTE_ERROR_NAME, &info, sizeof(COMPUTE_ERROR_NAME));
+    return;
+  }
+
+  if (args.m == 0 || args.n == 0) return;
+
+  /* nothing packed: this is a plain gemm */
+  if (transa != 2 && transb != 2) {
+#ifdef DOUBLE
+    cblas_dgemm(CblasColMajor, transa ? CblasTrans : CblasNoTrans, transb ? CblasTrans : CblasNoTrans,
+		args.m, args.n, args.k, alpha, args.a, args.lda, args.b, args.ldb, beta, args.c, args.ldc);
+#else
+    cblas_sgemm(CblasColMajor, transa ? CblasTrans : CblasNoTrans, transb ? CblasTrans : CblasNoTrans,
+		args.m, args.n, args.k, alpha, args.a, args.lda, args.b, args.ldb, beta, args.c, args.ldc);
+#endif
+    return;
+  }
+
+  args.alpha = (void *)&alpha;
+  args.beta  = (void *)&beta;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  buffer = (XFLOAT *)blas_memory_alloc(0);
+
+  sa = (XFLOAT *)((BLASLONG)buffer + GEMM_OFFSET_A);
+  sb = (XFLOAT *)(((BLASLONG)sa + ((GEMM_P * GEMM_Q * SIZE + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+#ifdef SMP
+  args.common = NULL;
+
+  if ((double)args.m * (double)args.n * (double)args.k <= SMP_THRESHOLD_MIN * GEMM_MULTITHREAD_THRESHOLD)
+    args.nthreads = 1;
+  else
+    args.nthreads = num_cpu_avail(3);
+#endif
+
+  (compute[transa * 3 + transb])(&args, NULL, NULL, sa, sb, 0);
+
+  blas_memory_free(buffer);
+
+  FUNCTION_PROFILE_END(1, args.m * args.k + args.k * args.n + args.m * args.n, 2 * args.m * args.n * args.k);
+
+  IDEBUG_END;
+}
+
+#endif
@@ -0,0 +1,332 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include <ctype.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+#ifndef COMPLEX
+#ifdef DOUBLE
+#define ERROR_NAME "DGEMMT "
+#else
+#define ERROR_NAME "SGEMMT "
+#endif
+#else
+#ifdef DOUBLE
+#define ERROR_NAME "ZGEMMT "
+#else
+#define ERROR_NAME "CGEMMT "
+#endif
+#endif
+
+/* index: uplo, then op(A), then op(B); N, T (and C for complex) */
+#ifndef COMPLEX
+#define NTRANS 2
+static int (*gemmt[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
+  GEMMT_UNN, GEMMT_UNT, GEMMT_UTN, GEMMT_UTT,
+  GEMMT_LNN, GEMMT_LNT, GEMMT_LTN, GEMMT_LTT,
+};
+#else
+#define NTRANS 3
+static int (*gemmt[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
+  GEMMT_UNN, GEMMT_UNT, GEMMT_UNC, GEMMT_UTN, GEMMT_UTT, GEMMT_UTC, GEMMT_UCN, GEMMT_UCT, GEMMT_UCC,
+  GEMMT_LNN, GEMMT_LNT, GEMMT_LNC, GEMMT_LTN, GEMMT_LTT, GEMMT_LTC, GEMMT_LCN, GEMMT_LCT, GEMMT_LCC,
+};
+#endif
+
+#ifndef CBLAS
+
+void NAME(char *UPLO, char *TRANSA, char *TRANSB,
+	  blasint *N, blasint *K,
+	  FLOAT *alpha, FLOAT *a, blasint *ldA,
+	  FLOAT *b, blasint *ldB,
+	  FLOAT *beta,  FLOAT *c, blasint *ldC){
+
+  char uplo_arg   = *UPLO;
+  char transa_arg = *TRANSA;
+  char transb_arg = *TRANSB;
+
+  blas_arg_t args;
+
+  FLOAT *buffer;
+  FLOAT *sa, *sb;
+
+#ifdef SMP
+#ifndef COMPLEX
+#ifdef DOUBLE
+  int mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#else
+#ifdef DOUBLE
+  int mode  =  BLAS_DOUBLE  | BLAS_COMPLEX;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_COMPLEX;
+#endif
+#endif
+#endif
+
+  blasint info;
+  int uplo, transa, transb;
+  blasint nrowa, nrowb;
+
+  PRINT_DEBUG_NAME;
+
+  args.n = *N;
+  args.k = *K;
+
+  args.a = (void *)a;
+  args.b = (void *)b;
+  args.c = (void *)c;
+
+  args.lda = *ldA;
+  args.ldb = *ldB;
+  args.ldc = *ldC;
+
+  args.alpha = (void *)alpha;
+  args.beta  = (void *)beta;
+
+  TOUPPER(uplo_arg);
+  TOUPPER(transa_arg);
+  TOUPPER(transb_arg);
+
+  uplo   = -1;
+  transa = -1;
+  transb = -1;
+
+  if (uplo_arg  == 'U') uplo  = 0;
+  if (uplo_arg  == 'L') uplo  = 1;
+
+  if (transa_arg == 'N') transa = 0;
+  if (transa_arg == 'T') transa = 1;
+  if (transb_arg == 'N') transb = 0;
+  if (transb_arg == 'T') transb = 1;
+#ifndef COMPLEX
+  if (transa_arg == 'C') transa = 1;
+  if (transb_arg == 'C') transb = 1;
+#else
+  if (transa_arg == 'C') transa = 2;
+  if (transb_arg == 'C') transb = 2;
+#endif
+
+  nrowa = args.n;
+  if (transa > 0) nrowa = args.k;
+  nrowb = args.k;
+  if (transb > 0) nrowb = args.n;
+
+  info = 0;
+
+  if (args.ldc < MAX(1,args.n)) info = 13;
+  if (args.ldb < MAX(1,nrowb))  info = 10;
+  if (args.lda < MAX(1,nrowa))  info =  8;
+  if (args.k < 0)               info =  5;
+  if (args.n < 0)               info =  4;
+  if (transb < 0)               info =  3;
+  if (transa < 0)               info =  2;
+  if (uplo  < 0)                info =  1;
+
+  if (info != 0) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+    return;
+  }
+
+#else
+
+void CNAME(enum CBLAS_ORDER order, enum CBLAS_UPLO Uplo,
+	   enum CBLAS_TRANSPOSE TransA, enum CBLAS_TRANSPOSE TransB,
+	   blasint n, blasint k,
+#ifndef COMPLEX
+	   FLOAT alpha,
+	   FLOAT *a, blasint lda,
+	   FLOAT *b, blasint ldb,
+	   FLOAT beta,
+	   FLOAT *c, blasint ldc) {
+#else
+	   void *valpha,
+	   void *va, blasint lda,
+	   void *vb, blasint ldb,
+	   void *vbeta,
+	   void *vc, blasint ldc) {
+  FLOAT *alpha = (FLOAT *) valpha;
+  FLOAT *beta  = (FLOAT *) vbeta;
+  FLOAT *a = (FLOAT *) va;
+  FLOAT *b = (FLOAT *) vb;
+  FLOAT *c = (FLOAT *) vc;
+#endif
+
+  blas_arg_t args;
+  int uplo, transa, transb, ta, tb;
+  blasint info, nrowa, nrowb;
+
+  FLOAT *buffer;
+  FLOAT *sa, *sb;
+
+#ifdef SMP
+#ifndef COMPLEX
+#ifdef DOUBLE
+  int mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#else
+#ifdef DOUBLE
+  int mode  =  BLAS_DOUBLE  | BLAS_COMPLEX;
+#else
+  int mode  =  BLAS_SINGLE  | BLAS_COMPLEX;
+#endif
+#endif
+#endif
+
+  PRINT_DEBUG_CNAME;
+
+  args.n = n;
+  args.k = k;
+  args.c = (void *)c;
+  args.ldc = ldc;
+
+#ifndef COMPLEX
+  args.alpha = (void *)&alpha;
+  args.beta  = (void *)&beta;
+#else
+  args.alpha = (void *)alpha;
+  args.beta  = (void *)beta;
+#endif
+
+  uplo   = -1;
+  ta     = -1;
+  tb     = -1;
+  info   =  0;
+
+  if (TransA == CblasNoTrans)     ta = 0;
+  if (TransA == CblasTrans)       ta = 1;
+  if (TransB == CblasNoTrans)     tb = 0;
+  if (TransB == CblasTrans)       tb = 1;
+#ifndef COMPLEX
+  if (TransA == CblasConjTrans)   ta = 1;
+  if (TransB == CblasConjTrans)   tb = 1;
+#else
+  if (TransA == CblasConjTrans)   ta = 2;
+  if (TransB == CblasConjTrans)   tb = 2;
+#endif
+
+  /* row major is the transposed problem: swap the operands and the triangle */
+  transa = ta;
+  transb = tb;
+
+  if (order == CblasColMajor) {
+    if (Uplo == CblasUpper) uplo  = 0;
+    if (Uplo == CblasLower) uplo  = 1;
+
+    args.a = (void *)a;
+    args.b = (void *)b;
+    args.lda = lda;
+    args.ldb = ldb;
+
+    info = -1;
+  }
+
+  if (order == CblasRowMajor) {
+    if (Uplo == CblasUpper) uplo  = 1;
+    if (Uplo == CblasLower) uplo  = 0;
+
+    args.a = (void *)b;
+    args.b = (void *)a;
+    args.lda = ldb;
+    args.ldb = lda;
+
+    transa = tb;
+    transb = ta;
+
+    info = -1;
+  }
+
+  if (info < 0) {
+    nrowa = args.n;
+    if (transa > 0) nrowa = args.k;
+    nrowb = args.k;
+    if (transb > 0) nrowb = args.n;
+
+    if (args.ldc < MAX(1,args.n)) info = 13;
+    if (args.ldb < MAX(1,nrowb))  info = 10;
+    if (args.lda < MAX(1,nrowa))  info =  8;
+    if (args.k < 0)               info =  5;
+    if (args.n < 0)               info =  4;
+    if (transb < 0)               info =  3;
+    if (transa < 0)               info =  2;
+    if (uplo  < 0)                info =  1;
+  }
+
+  if (info >= 0) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+    return;
+  }
+
+#endif
+
+  if (args.n == 0) return;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  buffer = (FLOAT *)blas_memory_alloc(0);
+
+  sa = (FLOAT *)((BLASLONG)buffer + GEMM_OFFSET_A);
+  sb = (FLOAT *)(((BLASLONG)sa + ((GEMM_P * GEMM_Q * COMPSIZE * SIZE + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+#ifdef SMP
+  mode |= (uplo << BLAS_UPLO_SHIFT);
+
+  args.common = NULL;
+  args.nthreads = num_cpu_avail(3);
+
+  if (args.nthreads == 1) {
+#endif
+
+    (gemmt[(uplo * NTRANS + transa) * NTRANS + transb])(&args, NULL, NULL, sa, sb, 0);
+
+#ifdef SMP
+
+  } else {
+
+    syrk_thread(mode, &args, NULL, NULL, gemmt[(uplo * NTRANS + transa) * NTRANS + transb], sa, sb, args.nthreads);
+
+  }
+#endif
+
+  blas_memory_free(buffer);
+
+  FUNCTION_PROFILE_END(COMPSIZE * COMPSIZE, 2 * args.n * args.k + args.n * args.n / 2, args.n * args.n * args.k);
+
+  IDEBUG_END;
+
+  return;
+}
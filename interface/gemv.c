@@ -205,6 +205,8 @@ void CNAME(enum CBLAS_ORDER order,
 
   IDEBUG_START;
 
+  TRACE_START();
+
   FUNCTION_PROFILE_START();
 
   if (incx < 0) x -= (lenx - 1) * incx;
@@ -220,7 +222,7 @@ void CNAME(enum CBLAS_ORDER order,
 
 #ifdef SMP
 
-  if ( 1L * m * n < 2304L * GEMM_MULTITHREAD_THRESHOLD )
+  if ( 1L * m * n < blas_thread_threshold(BLAS_THRESHOLD_GEMV, BLAS_THRESHOLD_PREC) )
     nthreads = 1;
   else
     nthreads = num_cpu_avail(2);
@@ -241,6 +243,8 @@ void CNAME(enum CBLAS_ORDER order,
   STACK_FREE(buffer);
   FUNCTION_PROFILE_END(1, m * n + m + n,  2 * m * n);
 
+  TRACE_END(((char[]){"NT"[(int)trans], 0}), m, n, 0, TRACE_THREADS(nthreads));
+
   IDEBUG_END;
 
   return;
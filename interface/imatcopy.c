@@ -32,6 +32,7 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "common.h"
 #ifdef FUNCTION_PROFILE
 #include "functable.h"
@@ -54,6 +55,79 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 /* Enables the New IMATCOPY code with inplace operation if lda == ldb   */
 #define NEW_IMATCOPY
 
+/* The remaining shapes are done in place on the column major view of
+   a, an m x n matrix: its columns are packed to leading dimension m,
+   moved into place and spread out again to ldb. */
+
+static void imatcopy_n(BLASLONG m, BLASLONG n, FLOAT alpha, FLOAT *a, BLASLONG lda, BLASLONG ldb)
+{
+	BLASLONG j;
+
+	/* a column is never moved over one that is still to be read */
+	if ( ldb < lda )
+	{
+		for ( j=1; j<n; j++ )
+			memmove(a + j * ldb, a + j * lda, m * sizeof(FLOAT));
+	}
+	else if ( ldb > lda )
+	{
+		for ( j=n-1; j>0; j-- )
+			memmove(a + j * ldb, a + j * lda, m * sizeof(FLOAT));
+	}
+
+	IMATCOPY_K_CN(m, n, alpha, a, ldb);
+}
+
+static void imatcopy_t(BLASLONG m, BLASLONG n, FLOAT alpha, FLOAT *a, BLASLONG lda, BLASLONG ldb)
+{
+	BLASLONG i, j, k, next, start, size = m * n;
+	unsigned char *done;
+	FLOAT t;
+
+	/* one bit per element instead of a full copy of the matrix */
+	done = calloc((size + 7) / 8, 1);
+	if ( done == NULL )
+	{
+		printf("Memory alloc failed\n");
+		exit(1);
+	}
+
+	if ( lda > m )
+	{
+		for ( j=1; j<n; j++ )
+			memmove(a + j * m, a + j * lda, m * sizeof(FLOAT));
+	}
+
+	/* element k = j + i * n of the transpose comes from i + j * m, follow
+	   each cycle of that permutation once; 0 and size - 1 stay in place */
+	for ( start=1; start<size-1; start++ )
+	{
+		if ( done[start >> 3] & (1 << (start & 7)) ) continue;
+
+		t = a[start];
+		k = start;
+		while ( 1 )
+		{
+			done[k >> 3] |= 1 << (k & 7);
+			next = (k % n) * m + k / n;
+			if ( next == start ) break;
+			a[k] = a[next];
+			k = next;
+		}
+		a[k] = t;
+	}
+
+	free(done);
+
+	if ( ldb > n )
+	{
+		for ( i=m-1; i>0; i-- )
+			memmove(a + i * ldb, a + i * n, n * sizeof(FLOAT));
+	}
+
+	IMATCOPY_K_CN(n, m, alpha, a, ldb);
+}
+
 #ifndef CBLAS
 void NAME( char* ORDER, char* TRANS, blasint *rows, blasint *cols, FLOAT *alpha, FLOAT *a, blasint *lda, blasint *ldb)
 {
@@ -61,8 +135,6 @@ void NAME( char* ORDER, char* TRANS, blasint *rows, blasint *cols, FLOAT *alpha,
 	char Order, Trans;
 	int order=-1,trans=-1;
 	blasint info = -1;
-	FLOAT *b;
-	size_t msize;
 
 	Order = *ORDER;
 	Trans = *TRANS;
@@ -81,8 +153,6 @@ void CNAME( enum CBLAS_ORDER CORDER, enum CBLAS_TRANSPOSE CTRANS, blasint crows,
 {
 	int order=-1,trans=-1;
 	blasint info = -1;
-	FLOAT *b;
-	size_t msize;
 	blasint *lda, *ldb, *rows, *cols; 
 	FLOAT *alpha; 
 
@@ -149,46 +219,21 @@ void CNAME( enum CBLAS_ORDER CORDER, enum CBLAS_TRANSPOSE CTRANS, blasint crows,
 
 #endif
 
-	if ( *lda >  *ldb )
-		msize = (*lda) * (*ldb)  * sizeof(FLOAT);
-	else
-		msize = (*ldb) * (*ldb)  * sizeof(FLOAT);
-
-	b = malloc(msize);
-	if ( b == NULL )
-	{
-		printf("Memory alloc failed\n");
-		exit(1);
-	}
-
 	if ( order == BlasColMajor )
 	{
 		if ( trans == BlasNoTrans )
-		{
-			OMATCOPY_K_CN(*rows, *cols, *alpha, a, *lda, b, *ldb );
-			OMATCOPY_K_CN(*rows, *cols, (FLOAT) 1.0 , b, *ldb, a, *ldb );
-		}
+			imatcopy_n(*rows, *cols, *alpha, a, *lda, *ldb);
 		else
-		{
-			OMATCOPY_K_CT(*rows, *cols, *alpha, a, *lda, b, *ldb );
-			OMATCOPY_K_CN(*cols, *rows, (FLOAT) 1.0, b, *ldb, a, *ldb );
-		}
+			imatcopy_t(*rows, *cols, *alpha, a, *lda, *ldb);
 	}
 	else
 	{
 		if ( trans == BlasNoTrans )
-		{
-			OMATCOPY_K_RN(*rows, *cols, *alpha, a, *lda, b, *ldb );
-			OMATCOPY_K_RN(*rows, *cols, (FLOAT) 1.0, b, *ldb, a, *ldb );
-		}
+			imatcopy_n(*cols, *rows, *alpha, a, *lda, *ldb);
 		else
-		{
-			OMATCOPY_K_RT(*rows, *cols, *alpha, a, *lda, b, *ldb );
-			OMATCOPY_K_RN(*cols, *rows, (FLOAT) 1.0, b, *ldb, a, *ldb );
-		}
+			imatcopy_t(*cols, *rows, *alpha, a, *lda, *ldb);
 	}
 
-	free(b);
 	return;
 
 }
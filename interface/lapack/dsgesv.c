@@ -0,0 +1,356 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+/* Mixed precision solvers with iterative refinement (DSGESV, DSPOSV).
+
+   A is factored in single precision through sgetrf / spotrf, which
+   take the optimized getrf / potrf drivers, and the solution is then
+   refined with residuals computed in double precision.  When the
+   matrix does not fit in single precision, the single factorization
+   breaks down, or the refinement does not converge in ITERMAX steps,
+   the system is solved in double precision instead; ITER reports
+   which case was taken, as in LAPACK.
+
+   Compiled with POSV this is DSPOSV.  With BF16_UPDATE (BUILD_HALF
+   only) it is DSHGESV, which additionally runs the trailing updates of
+   the single precision LU through shgemm, on operands rounded to
+   bfloat16. */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <float.h>
+#include <math.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+#ifdef POSV
+#define ERROR_NAME "DSPOSV"
+#elif defined(BF16_UPDATE)
+#define ERROR_NAME "DSHGESV"
+#else
+#define ERROR_NAME "DSGESV"
+#endif
+
+#define ITERMAX 30
+
+/* Rounds the lower (uplo == 1), upper (uplo == 0) or full (uplo < 0)
+   part of a to single precision; non-zero if an entry overflows */
+static int narrow(BLASLONG m, BLASLONG n, int uplo, double *a, BLASLONG lda, float *sa, BLASLONG ldsa)
+{
+  BLASLONG i, j, is, ie;
+
+  for (j = 0; j < n; j++) {
+    is = (uplo == 1) ? j : 0;
+    ie = (uplo == 0) ? j + 1 : m;
+    for (i = is; i < ie; i++) {
+      if (fabs(a[i + j * lda]) > FLT_MAX) return 1;
+      sa[i + j * ldsa] = (float)a[i + j * lda];
+    }
+  }
+
+  return 0;
+}
+
+/* r = b - A * x */
+static void residual(blasint n, blasint nrhs, int uplo, double *a, blasint lda,
+                     double *b, blasint ldb, double *x, blasint ldx, double *r)
+{
+  double one = ONE, mone = -ONE;
+#ifdef POSV
+  char side = 'L', up = uplo ? 'L' : 'U';
+#else
+  char trans = 'N';
+#endif
+  BLASLONG i, j;
+
+  for (j = 0; j < nrhs; j++)
+    for (i = 0; i < n; i++) r[i + j * n] = b[i + j * ldb];
+
+#ifdef POSV
+  BLASFUNC(dsymm)(&side, &up, &n, &nrhs, &mone, a, &lda, x, &ldx, &one, r, &n);
+#else
+  (void)uplo;
+  BLASFUNC(dgemm)(&trans, &trans, &n, &nrhs, &n, &mone, a, &lda, x, &ldx, &one, r, &n);
+#endif
+}
+
+/* Every column of r within cte of the corresponding column of x */
+static int converged(blasint n, blasint nrhs, double *x, blasint ldx, double *r, double cte)
+{
+  BLASLONG j;
+
+  for (j = 0; j < nrhs; j++)
+    if (AMAX_K(n, r + j * n, 1) > AMAX_K(n, x + j * ldx, 1) * cte) return 0;
+
+  return 1;
+}
+
+#ifdef BF16_UPDATE
+/* Right-looking LU of the single precision copy.  Panels are factored
+   by sgetrf; the update of the trailing matrix behind each panel goes
+   through shgemm, which accumulates in single precision. */
+static blasint factor_bf16(blasint n, float *a, blasint lda, blasint *ipiv)
+{
+  blasint nb = SGEMM_Q, j, jb, i, m2, n2, k1, k2, iinfo, one = 1;
+  float sone = ONE, smone = -ONE;
+  char side = 'L', lower = 'L', trans = 'N', unit = 'U';
+  bfloat16 *l, *u;
+
+  if (nb > n) nb = n;
+
+  l = (bfloat16 *)malloc(sizeof(bfloat16) * n * nb);
+  u = (bfloat16 *)malloc(sizeof(bfloat16) * n * nb);
+
+  if (l == NULL || u == NULL) {
+    free(l);
+    free(u);
+    BLASFUNC(sgetrf)(&n, &n, a, &lda, ipiv, &iinfo);
+    return iinfo;
+  }
+
+  for (j = 0; j < n; j += nb) {
+    jb = MIN(nb, n - j);
+    m2 = n - j;
+
+    BLASFUNC(sgetrf)(&m2, &jb, a + j + j * lda, &lda, ipiv + j, &iinfo);
+    if (iinfo > 0) {
+      iinfo += j;
+      break;
+    }
+
+    for (i = j; i < j + jb; i++) ipiv[i] += j;
+
+    k1 = j + 1;
+    k2 = j + jb;
+    if (j > 0) BLASFUNC(slaswp)(&j, a, &lda, &k1, &k2, ipiv, &one);
+
+    n2 = n - j - jb;
+    if (n2 > 0) {
+      BLASFUNC(slaswp)(&n2, a + (j + jb) * lda, &lda, &k1, &k2, ipiv, &one);
+      BLASFUNC(strsm)(&side, &lower, &trans, &unit, &jb, &n2, &sone,
+                      a + j + j * lda, &lda, a + j + (j + jb) * lda, &lda);
+
+      m2 = n2;
+      for (i = 0; i < jb; i++)
+        BLASFUNC(shstobf16)(&m2, a + j + jb + (j + i) * lda, &one, l + i * m2, &one);
+      for (i = 0; i < n2; i++)
+        BLASFUNC(shstobf16)(&jb, a + j + (j + jb + i) * lda, &one, u + i * jb, &one);
+
+      BLASFUNC(shgemm)(&trans, &trans, &m2, &n2, &jb, &smone, l, &m2, u, &jb,
+                       &sone, a + j + jb + (j + jb) * lda, &lda);
+    }
+  }
+
+  free(l);
+  free(u);
+
+  return iinfo;
+}
+#endif
+
+#ifndef POSV
+int NAME(blasint *N, blasint *NRHS, double *a, blasint *ldA, blasint *ipiv,
+         double *b, blasint *ldB, double *x, blasint *ldX, double *work,
+         float *swork, blasint *Iter, blasint *Info){
+#else
+int NAME(char *UPLO, blasint *N, blasint *NRHS, double *a, blasint *ldA,
+         double *b, blasint *ldB, double *x, blasint *ldX, double *work,
+         float *swork, blasint *Iter, blasint *Info){
+#endif
+
+  blasint n    = *N;
+  blasint nrhs = *NRHS;
+  blasint lda  = *ldA;
+  blasint ldb  = *ldB;
+  blasint ldx  = *ldX;
+  blasint info, iiter;
+  int uplo = -1;
+  double anrm, cte;
+  float *sa, *sx;
+  BLASLONG i, j;
+#ifdef POSV
+  char uplo_arg = *UPLO;
+  char up;
+#else
+  char trans = 'N';
+#endif
+
+  PRINT_DEBUG_NAME;
+
+  info = 0;
+
+#ifndef POSV
+  if (ldx  < MAX(1, n)) info = 9;
+  if (ldb  < MAX(1, n)) info = 7;
+  if (lda  < MAX(1, n)) info = 4;
+  if (nrhs < 0)         info = 2;
+  if (n    < 0)         info = 1;
+#else
+  TOUPPER(uplo_arg);
+
+  if (uplo_arg == 'U') uplo = 0;
+  if (uplo_arg == 'L') uplo = 1;
+  up = uplo_arg;
+
+  if (ldx  < MAX(1, n)) info = 9;
+  if (ldb  < MAX(1, n)) info = 7;
+  if (lda  < MAX(1, n)) info = 5;
+  if (nrhs < 0)         info = 3;
+  if (n    < 0)         info = 2;
+  if (uplo < 0)         info = 1;
+#endif
+
+  if (info) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME) - 1);
+    *Iter = 0;
+    *Info = - info;
+    return 0;
+  }
+
+  *Iter = 0;
+  *Info = 0;
+
+  if (n == 0 || nrhs == 0) return 0;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  /* Infinity norm of A, accumulated in the first column of work */
+  for (i = 0; i < n; i++) work[i] = ZERO;
+  for (j = 0; j < n; j++) {
+#ifndef POSV
+    for (i = 0; i < n; i++) work[i] += fabs(a[i + j * lda]);
+#else
+    for (i = (uplo ? j : 0); i < (uplo ? n : j + 1); i++) {
+      work[i] += fabs(a[i + j * lda]);
+      if (i != j) work[j] += fabs(a[i + j * lda]);
+    }
+#endif
+  }
+  anrm = ZERO;
+  for (i = 0; i < n; i++) if (work[i] > anrm || work[i] != work[i]) anrm = work[i];
+
+  cte = anrm * DBL_EPSILON * 0.5 * sqrt((double)n);
+
+  sa = swork;
+  sx = swork + (BLASLONG)n * n;
+
+  if (narrow(n, nrhs, -1, b, ldb, sx, n)) {
+    *Iter = -2;
+    goto fallback;
+  }
+
+  if (narrow(n, n, uplo, a, lda, sa, n)) {
+    *Iter = -2;
+    goto fallback;
+  }
+
+#ifndef POSV
+#ifdef BF16_UPDATE
+  info = factor_bf16(n, sa, n, ipiv);
+#else
+  BLASFUNC(sgetrf)(&n, &n, sa, &n, ipiv, &info);
+#endif
+#else
+  BLASFUNC(spotrf)(&up, &n, sa, &n, &info);
+#endif
+
+  if (info) {
+    *Iter = -3;
+    goto fallback;
+  }
+
+#ifndef POSV
+  BLASFUNC(sgetrs)(&trans, &n, &nrhs, sa, &n, ipiv, sx, &n, &info);
+#else
+  BLASFUNC(spotrs)(&up, &n, &nrhs, sa, &n, sx, &n, &info);
+#endif
+
+  for (j = 0; j < nrhs; j++)
+    for (i = 0; i < n; i++) x[i + j * ldx] = (double)sx[i + j * n];
+
+  residual(n, nrhs, uplo, a, lda, b, ldb, x, ldx, work);
+
+  if (converged(n, nrhs, x, ldx, work, cte)) goto done;
+
+  for (iiter = 1; iiter <= ITERMAX; iiter++) {
+
+    if (narrow(n, nrhs, -1, work, n, sx, n)) {
+      *Iter = -2;
+      goto fallback;
+    }
+
+#ifndef POSV
+    BLASFUNC(sgetrs)(&trans, &n, &nrhs, sa, &n, ipiv, sx, &n, &info);
+#else
+    BLASFUNC(spotrs)(&up, &n, &nrhs, sa, &n, sx, &n, &info);
+#endif
+
+    for (j = 0; j < nrhs; j++)
+      for (i = 0; i < n; i++) x[i + j * ldx] += (double)sx[i + j * n];
+
+    residual(n, nrhs, uplo, a, lda, b, ldb, x, ldx, work);
+
+    if (converged(n, nrhs, x, ldx, work, cte)) {
+      *Iter = iiter;
+      goto done;
+    }
+  }
+
+  *Iter = -ITERMAX - 1;
+
+ fallback:
+  /* Solve in double precision, overwriting A with its factors */
+  for (j = 0; j < nrhs; j++)
+    for (i = 0; i < n; i++) x[i + j * ldx] = b[i + j * ldb];
+
+#ifndef POSV
+  BLASFUNC(dgetrf)(&n, &n, a, &lda, ipiv, &info);
+  if (info == 0) BLASFUNC(dgetrs)(&trans, &n, &nrhs, a, &lda, ipiv, x, &ldx, &info);
+#else
+  BLASFUNC(dpotrf)(&up, &n, a, &lda, &info);
+  if (info == 0) BLASFUNC(dpotrs)(&up, &n, &nrhs, a, &lda, x, &ldx, &info);
+#endif
+
+  *Info = info;
+
+ done:
+  FUNCTION_PROFILE_END(1, n * n, 2. / 3. * n * n * n + n * n);
+
+  IDEBUG_END;
+
+  return 0;
+}
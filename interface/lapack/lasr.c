@@ -0,0 +1,188 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+/* ?LASR: applies the sequence of plane rotations P(z-1) ... P(1) (or
+   P(1) ... P(z-1)) from the left or the right to the m by n matrix A.
+   Rotation j acts on the rows (SIDE = 'L') or columns (SIDE = 'R')
+
+     j, j+1    for PIVOT = 'V',
+     1, j+1    for PIVOT = 'T',
+     j, z      for PIVOT = 'B',
+
+   with z = m or n, in the order given by DIRECT.  For SIDE = 'R' and
+   PIVOT = 'V', which dsteqr, dbdsqr and friends use to accumulate
+   their eigen- and singular vectors, the whole wave goes through the
+   ROTSEQ kernel in about one pass over A; the other right-side forms
+   are column rotations through ROT_K, and the left-side forms are
+   applied one column of A at a time.  The complex versions apply the
+   same real rotations to the real and imaginary parts. */
+
+#include <stdio.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+#ifndef COMPLEX
+#ifdef DOUBLE
+#define ERROR_NAME "DLASR"
+#else
+#define ERROR_NAME "SLASR"
+#endif
+#else
+#ifdef DOUBLE
+#define ERROR_NAME "ZLASR"
+#else
+#define ERROR_NAME "CLASR"
+#endif
+#endif
+
+#ifdef DOUBLE
+#define LASR_ROTSEQ	DROTSEQ_K
+#else
+#define LASR_ROTSEQ	SROTSEQ_K
+#endif
+
+/* rows or columns p and q of rotation j, for z rows or columns */
+static inline void lasr_pair(int pivot, BLASLONG j, BLASLONG z, BLASLONG *p, BLASLONG *q)
+{
+  if (pivot == 0) {
+    *p = j;
+    *q = j + 1;
+  } else if (pivot == 1) {
+    *p = 0;
+    *q = j + 1;
+  } else {
+    *p = j;
+    *q = z - 1;
+  }
+}
+
+int NAME(char *SIDE, char *PIVOT, char *DIRECT, blasint *M, blasint *N,
+	 FLOAT *c, FLOAT *s, FLOAT *a, blasint *ldA){
+
+  char side_arg   = *SIDE;
+  char pivot_arg  = *PIVOT;
+  char direct_arg = *DIRECT;
+
+  BLASLONG m   = *M;
+  BLASLONG n   = *N;
+  BLASLONG lda = *ldA;
+
+  blasint info;
+  int side, pivot, backward;
+  BLASLONG z, i, jj, j, p, q, r;
+  FLOAT cj, sj, t, *col;
+
+  PRINT_DEBUG_NAME;
+
+  TOUPPER(side_arg);
+  TOUPPER(pivot_arg);
+  TOUPPER(direct_arg);
+
+  side = -1;
+  if (side_arg == 'L') side = 0;
+  if (side_arg == 'R') side = 1;
+
+  pivot = -1;
+  if (pivot_arg == 'V') pivot = 0;
+  if (pivot_arg == 'T') pivot = 1;
+  if (pivot_arg == 'B') pivot = 2;
+
+  backward = -1;
+  if (direct_arg == 'F') backward = 0;
+  if (direct_arg == 'B') backward = 1;
+
+  info = 0;
+  if (lda      < MAX(1, m)) info = 9;
+  if (n        < 0) info = 5;
+  if (m        < 0) info = 4;
+  if (backward < 0) info = 3;
+  if (pivot    < 0) info = 2;
+  if (side     < 0) info = 1;
+
+  if (info != 0) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME) - 1);
+    return 0;
+  }
+
+  if (m == 0 || n == 0) return 0;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  z = side ? n : m;
+
+  if (side == 1 && pivot == 0) {
+
+    LASR_ROTSEQ(m * COMPSIZE, n - 1, a, lda * COMPSIZE, c, s, backward);
+
+  } else if (side == 1) {
+
+    for (jj = 0; jj < z - 1; jj++) {
+      j = backward ? z - 2 - jj : jj;
+      if (c[j] == ONE && s[j] == ZERO) continue;
+
+      lasr_pair(pivot, j, z, &p, &q);
+      ROT_K(m, a + p * lda * COMPSIZE, 1, a + q * lda * COMPSIZE, 1, c[j], s[j]);
+    }
+
+  } else {
+
+    for (i = 0; i < n; i++) {
+      col = a + i * lda * COMPSIZE;
+
+      for (jj = 0; jj < z - 1; jj++) {
+	j = backward ? z - 2 - jj : jj;
+	cj = c[j];
+	sj = s[j];
+	if (cj == ONE && sj == ZERO) continue;
+
+	lasr_pair(pivot, j, z, &p, &q);
+	for (r = 0; r < COMPSIZE; r++) {
+	  t = col[q * COMPSIZE + r];
+	  col[q * COMPSIZE + r] = cj * t - sj * col[p * COMPSIZE + r];
+	  col[p * COMPSIZE + r] = sj * t + cj * col[p * COMPSIZE + r];
+	}
+      }
+    }
+
+  }
+
+  FUNCTION_PROFILE_END(COMPSIZE, m * n, 6 * m * n);
+
+  IDEBUG_END;
+
+  return 0;
+}
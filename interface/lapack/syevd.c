@@ -0,0 +1,301 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+#ifdef DOUBLE
+#define ERROR_NAME "DSYEVD"
+#define STEDC	BLASFUNC(dstedc)
+#define STERF	BLASFUNC(dsterf)
+#define SMLNUM	(DBL_MIN / DBL_EPSILON)
+#else
+#define ERROR_NAME "SSYEVD"
+#define STEDC	BLASFUNC(sstedc)
+#define STERF	BLASFUNC(ssterf)
+#define SMLNUM	(FLT_MIN / FLT_EPSILON)
+#endif
+
+/* Native two-stage eigensolver, see lapack/syevd.  The lower triangle
+   is reduced to a band by sy2sb and the band to tridiagonal form by
+   sb2st; ?STEDC (?STERF without vectors) solves the tridiagonal problem
+   and the eigenvectors are transformed back by sb2st_back and ormqr.
+   The upper triangle is transposed into the lower one first, in place
+   if A is overwritten by the eigenvectors anyway.  WORK is used if it
+   holds the whole workspace, which a workspace query returns; the
+   minimum LWORK and LIWORK are those of the reference ?SYEVD and any
+   shortfall is allocated here. */
+
+int NAME(char *JOBZ, char *UPLO, blasint *N, FLOAT *a, blasint *ldA, FLOAT *w,
+	 FLOAT *work, blasint *lWork, blasint *iwork, blasint *liWork, blasint *Info){
+
+  blas_arg_t args;
+
+  char jobz_arg = *JOBZ;
+  char uplo_arg = *UPLO;
+  blasint info, n, ldz, lwork, liwork;
+  BLASLONG nb, k0, ng, nv2, nq, lwmin, liwmin, lwkopt, wsize, lda, ldl, i, j;
+  int wantz, lower, lquery;
+  FLOAT *ws, *tau1, *e, *tau2, *v2, *z, *s, *al;
+  FLOAT anrm, sigma, rmin, rmax, temp;
+  FLOAT *buffer, *sa, *sb;
+
+  PRINT_DEBUG_NAME;
+
+  TOUPPER(jobz_arg);
+  TOUPPER(uplo_arg);
+
+  wantz  = (jobz_arg == 'V');
+  lower  = (uplo_arg == 'L');
+  lquery = (*lWork == -1 || *liWork == -1);
+  n      = *N;
+  lda    = *ldA;
+
+  nb = (n >= 4 * SYEVD_BAND) ? SYEVD_BAND : 1;
+  nq = QR_BLOCKING;
+  k0 = 0;
+  nv2 = 0;
+  if (n > 2) {
+    k0 = (n - 3) / nb + 1;
+    ng = (n - 2 + nb - 1) / nb;
+    if (wantz && nb > 1) nv2 = nb * nb * (ng * k0 - ng * (ng - 1) / 2);
+  }
+
+  wsize = MAX(3 * nb * nb + 2 * (BLASLONG)n * nb, (2 * nb + 1) * (BLASLONG)n);
+  if (wantz) {
+    wsize = MAX(wsize, 1 + 4 * (BLASLONG)n + (BLASLONG)n * n);
+    wsize = MAX(wsize, 3 * nb * nb * k0 + nb * (BLASLONG)n);
+    wsize = MAX(wsize, nq * (nq + (BLASLONG)n));
+  }
+  lwkopt = 2 * (BLASLONG)n + nv2 + nv2 / nb + wsize;
+  if (wantz || !lower) lwkopt += (BLASLONG)n * n;
+
+  if (n <= 1) {
+    lwmin  = 1;
+    liwmin = 1;
+  } else if (wantz) {
+    lwmin  = 1 + 6 * (BLASLONG)n + 2 * (BLASLONG)n * n;
+    liwmin = 3 + 5 * (BLASLONG)n;
+  } else {
+    lwmin  = 2 * (BLASLONG)n + 1;
+    liwmin = 1;
+  }
+  if (n <= 1) lwkopt = 1;
+  lwkopt = MAX(lwkopt, lwmin);
+
+  info = 0;
+  if (!lquery) {
+    if (*liWork < liwmin) info = 10;
+    if (*lWork  < lwmin)  info =  8;
+  }
+  if (lda < MAX(1, n))                info = 5;
+  if (n < 0)                          info = 3;
+  if (!lower && uplo_arg != 'U')      info = 2;
+  if (!wantz && jobz_arg != 'N')      info = 1;
+  if (info) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME) - 1);
+    *Info = - info;
+    return 0;
+  }
+
+  work[0]  = (FLOAT)lwkopt;
+  iwork[0] = liwmin;
+
+  *Info = 0;
+  if (lquery) return 0;
+  if (n == 0) return 0;
+
+  if (n == 1) {
+    w[0] = a[0];
+    if (wantz) a[0] = ONE;
+    return 0;
+  }
+
+  ws = work;
+  if (*lWork < lwkopt) {
+    ws = (FLOAT *)malloc(sizeof(FLOAT) * lwkopt);
+    if (ws == NULL) {
+      info = 8;
+      BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME) - 1);
+      *Info = - info;
+      return 0;
+    }
+  }
+
+  tau1 = ws;
+  e    = tau1 + n;
+  tau2 = e    + n;
+  v2   = tau2 + nv2 / nb;
+  z    = v2   + nv2;
+  s    = z    + ((wantz || !lower) ? (BLASLONG)n * n : 0);
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  /* scale the matrix to the range of ?SYEVD */
+  anrm = ZERO;
+  for (j = 0; j < n; j++) {
+    for (i = lower ? j : 0; i < (lower ? n : j + 1); i++) {
+      temp = fabs(a[i + j * lda]);
+      if (temp > anrm || temp != temp) anrm = temp;
+    }
+  }
+
+  rmin  = sqrt(SMLNUM);
+  rmax  = sqrt(ONE / SMLNUM);
+  sigma = ONE;
+  if (anrm > ZERO && anrm < rmin) sigma = rmin / anrm;
+  if (anrm > rmax)                sigma = rmax / anrm;
+
+  if (sigma != ONE) {
+    for (j = 0; j < n; j++) {
+      if (lower) SCAL_K(n - j, 0, 0, sigma, a + j + j * lda, 1, NULL, 0, NULL, 0);
+      else       SCAL_K(j + 1, 0, 0, sigma, a     + j * lda, 1, NULL, 0, NULL, 0);
+    }
+  }
+
+  al  = a;
+  ldl = lda;
+  if (!lower) {
+    if (wantz) {
+      for (j = 0; j < n; j++)
+	for (i = 0; i < j; i++) a[j + i * ldl] = a[i + j * ldl];
+    } else {
+      al  = z;
+      ldl = n;
+      for (j = 0; j < n; j++)
+	for (i = j; i < n; i++) z[i + j * n] = a[j + i * lda];
+    }
+  }
+
+  buffer = (FLOAT *)blas_memory_alloc(1);
+
+  sa = (FLOAT *)((BLASLONG)buffer + GEMM_OFFSET_A);
+  sb = (FLOAT *)(((BLASLONG)sa + ((GEMM_P * GEMM_Q * COMPSIZE * SIZE + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+#ifdef SMP
+  args.common = NULL;
+  args.nthreads = num_cpu_avail(4);
+  if (nb == 1) args.nthreads = 1;
+#endif
+
+  /* A = Q1 B Q1' */
+  args.n   = n;
+  args.k   = nb;
+  args.a   = (void *)al;
+  args.lda = ldl;
+  args.b   = (void *)tau1;
+  args.c   = (void *)s;
+  SY2SB(&args, NULL, NULL, sa, sb, 0);
+
+  /* B = Q2 T Q2' */
+  if (nb > 1) {
+    for (i = 0; i < (2 * nb + 1) * (BLASLONG)n; i++) s[i] = ZERO;
+    for (j = 0; j < n; j++)
+      for (i = j; i <= MIN(j + nb, n - 1); i++) s[i + j * 2 * nb] = al[i + j * ldl];
+
+    args.n   = n;
+    args.k   = nb;
+    args.a   = (void *)s;
+    args.lda = 2 * nb;
+    args.b   = wantz ? (void *)v2 : NULL;
+    args.c   = (void *)tau2;
+    SB2ST(&args, NULL, NULL, sa, sb, 0);
+
+    for (j = 0; j < n; j++) w[j] = s[j + j * 2 * nb];
+    for (j = 0; j < n - 1; j++) e[j] = s[j + 1 + j * 2 * nb];
+  } else {
+    for (j = 0; j < n; j++) w[j] = al[j + j * ldl];
+    for (j = 0; j < n - 1; j++) e[j] = al[j + 1 + j * ldl];
+  }
+
+  if (!wantz) {
+    STERF(&n, w, e, &info);
+  } else {
+    ldz    = n;
+    lwork  = 1 + 4 * n + n * n;
+    liwork = *liWork;
+    STEDC("I", &n, w, e, z, &ldz, s, &lwork, iwork, &liwork, &info);
+
+    if (!info) {
+      /* Z = Q1 Q2 Z */
+      args.m   = n;
+      args.n   = n;
+      args.k   = nb;
+      args.a   = (void *)v2;
+      args.b   = (void *)tau2;
+      args.c   = (void *)z;
+      args.ldc = n;
+      args.d   = (void *)s;
+      SB2ST_BACK(&args, NULL, NULL, sa, sb, 0);
+
+      if (n - nb - 1 > 0) {
+	args.m   = n - nb;
+	args.n   = n;
+	args.k   = n - nb - 1;
+	args.a   = (void *)(al + nb);
+	args.lda = ldl;
+	args.b   = (void *)tau1;
+	args.c   = (void *)(z + nb);
+	args.ldc = n;
+	args.d   = (void *)s;
+	ORMQR_LN(&args, NULL, NULL, sa, sb, 0);
+      }
+
+      for (j = 0; j < n; j++) COPY_K(n, z + j * n, 1, a + j * lda, 1);
+    }
+  }
+
+  if (sigma != ONE) SCAL_K(n, 0, 0, ONE / sigma, w, 1, NULL, 0, NULL, 0);
+
+  blas_memory_free(buffer);
+
+  if (ws != work) free(ws);
+  work[0]  = (FLOAT)lwkopt;
+  iwork[0] = liwmin;
+
+  *Info = info;
+
+  FUNCTION_PROFILE_END(1, n * n, 4. / 3. * n * n * n + (wantz ? 4. * n * n * n : 0.));
+
+  IDEBUG_END;
+
+  return 0;
+}
@@ -0,0 +1,152 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include <stdio.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+#ifdef DOUBLE
+#define ERROR_NAME "DSYTRF"
+#else
+#define ERROR_NAME "SSYTRF"
+#endif
+
+/* Native Bunch-Kaufman factorization, see lapack/sytrf.  The pivots are
+   in the ?SYTRF format, so ?SYTRS and the other reference routines
+   taking them can use the factors.  WORK is used if it holds the whole
+   workspace, which a workspace query returns; otherwise the workspace
+   is allocated here. */
+
+static blasint (*sytrf_single[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
+  SYTRF_U_SINGLE, SYTRF_L_SINGLE,
+};
+
+#ifdef SMP
+static blasint (*sytrf_parallel[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
+  SYTRF_U_PARALLEL, SYTRF_L_PARALLEL,
+};
+#endif
+
+int NAME(char *UPLO, blasint *N, FLOAT *a, blasint *ldA, blasint *ipiv,
+	 FLOAT *work, blasint *lWork, blasint *Info){
+
+  blas_arg_t args;
+
+  blasint uplo_arg = *UPLO;
+  blasint uplo;
+  blasint info;
+  BLASLONG lwkopt;
+  FLOAT *buffer, *sa, *sb, *ws;
+
+  PRINT_DEBUG_NAME;
+
+  args.n    = *N;
+  args.a    = (void *)a;
+  args.lda  = *ldA;
+  args.c    = (void *)ipiv;
+
+  TOUPPER(uplo_arg);
+
+  uplo = -1;
+  if (uplo_arg == 'U') uplo = 0;
+  if (uplo_arg == 'L') uplo = 1;
+
+  /* the look-ahead driver keeps two panels of W */
+  lwkopt = MAX(1, 2 * args.n * SYTRF_BLOCKING);
+  work[0] = (FLOAT)lwkopt;
+
+  info  = 0;
+  if (*lWork < 1 && *lWork != -1) info = 7;
+  if (args.lda < MAX(1,args.n)) info = 4;
+  if (args.n   < 0)             info = 2;
+  if (uplo     < 0)             info = 1;
+  if (info) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME) - 1);
+    *Info = - info;
+    return 0;
+  }
+
+  *Info = 0;
+  if (*lWork == -1) return 0;
+  if (args.n == 0) return 0;
+
+  ws = work;
+  if (*lWork < lwkopt) {
+    ws = (FLOAT *)malloc(sizeof(FLOAT) * lwkopt);
+    if (ws == NULL) {
+      info = 7;
+      BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME) - 1);
+      *Info = - info;
+      return 0;
+    }
+  }
+  args.b = (void *)ws;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  buffer = (FLOAT *)blas_memory_alloc(1);
+
+  sa = (FLOAT *)((BLASLONG)buffer + GEMM_OFFSET_A);
+  sb = (FLOAT *)(((BLASLONG)sa + ((GEMM_P * GEMM_Q * COMPSIZE * SIZE + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+#ifdef SMP
+  args.common = NULL;
+  args.nthreads = num_cpu_avail(4);
+
+  if (args.nthreads == 1) {
+#endif
+
+    *Info = (sytrf_single[uplo])(&args, NULL, NULL, sa, sb, 0);
+
+#ifdef SMP
+  } else {
+    *Info = (sytrf_parallel[uplo])(&args, NULL, NULL, sa, sb, 0);
+  }
+#endif
+
+  blas_memory_free(buffer);
+
+  if (ws != work) free(ws);
+  work[0] = (FLOAT)lwkopt;
+
+  FUNCTION_PROFILE_END(1, .5 * args.n * args.n, 1. / 3. * args.n * args.n * args.n);
+
+  IDEBUG_END;
+
+  return 0;
+}
@@ -0,0 +1,154 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include <stdio.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+#ifdef DOUBLE
+#define ERROR_NAME "DSYTRS"
+#else
+#define ERROR_NAME "SSYTRS"
+#endif
+
+/* Solves with the factors of ?SYTRF, see lapack/sytrs.  The blocked
+   solve needs n (SYTRF_BLOCKING + 1) elements of workspace per thread,
+   which ?SYTRS does not take, so it is allocated here.  Without it the
+   right hand sides are solved one at a time. */
+
+static blasint (*sytrs_single[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
+  SYTRS_U_SINGLE, SYTRS_L_SINGLE,
+};
+
+#ifdef SMP
+static blasint (*sytrs_parallel[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
+  SYTRS_U_PARALLEL, SYTRS_L_PARALLEL,
+};
+#endif
+
+int NAME(char *UPLO, blasint *N, blasint *NRHS, FLOAT *a, blasint *ldA,
+	 blasint *ipiv, FLOAT *b, blasint *ldB, blasint *Info){
+
+  blas_arg_t args;
+
+  blasint uplo_arg = *UPLO;
+  blasint uplo;
+  blasint info;
+  BLASLONG nthreads;
+  FLOAT *buffer, *sa, *sb, *ws;
+
+  PRINT_DEBUG_NAME;
+
+  args.m    = *N;
+  args.n    = *NRHS;
+  args.a    = (void *)a;
+  args.lda  = *ldA;
+  args.b    = (void *)b;
+  args.ldb  = *ldB;
+  args.c    = (void *)ipiv;
+
+  TOUPPER(uplo_arg);
+
+  uplo = -1;
+  if (uplo_arg == 'U') uplo = 0;
+  if (uplo_arg == 'L') uplo = 1;
+
+  info = 0;
+  if (args.ldb  < MAX(1, args.m)) info = 8;
+  if (args.lda  < MAX(1, args.m)) info = 5;
+  if (args.n    < 0) info = 3;
+  if (args.m    < 0) info = 2;
+  if (uplo      < 0) info = 1;
+  if (info) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME) - 1);
+    *Info = - info;
+    return 0;
+  }
+
+  *Info = 0;
+
+  if (args.m == 0 || args.n == 0) return 0;
+
+  nthreads = 1;
+#ifdef SMP
+  args.common = NULL;
+  args.nthreads = num_cpu_avail(4);
+  /* sytrs_parallel gives each thread two right hand sides at least */
+  if (args.nthreads > args.n / 2) args.nthreads = MAX(args.n / 2, 1);
+  nthreads = args.nthreads;
+#endif
+
+  /* A single right hand side is solved in place */
+  ws = NULL;
+  if (args.n > 1) {
+    ws = (FLOAT *)malloc(sizeof(FLOAT) * nthreads * args.m * (SYTRF_BLOCKING + 1));
+#ifdef SMP
+    if (ws == NULL) args.nthreads = 1;
+#endif
+  }
+  args.d = (void *)ws;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  buffer = (FLOAT *)blas_memory_alloc(1);
+
+  sa = (FLOAT *)((BLASLONG)buffer + GEMM_OFFSET_A);
+  sb = (FLOAT *)(((BLASLONG)sa + ((GEMM_P * GEMM_Q * COMPSIZE * SIZE + GEMM_ALIGN) & ~GEMM_ALIGN)) + GEMM_OFFSET_B);
+
+#ifdef SMP
+  if (args.nthreads == 1) {
+#endif
+
+    (sytrs_single[uplo])(&args, NULL, NULL, sa, sb, 0);
+
+#ifdef SMP
+  } else {
+    (sytrs_parallel[uplo])(&args, NULL, NULL, sa, sb, 0);
+  }
+#endif
+
+  blas_memory_free(buffer);
+
+  free(ws);
+
+  FUNCTION_PROFILE_END(1, args.m * args.n, 2. * args.m * args.m * args.n);
+
+  IDEBUG_END;
+
+  return 0;
+}
@@ -47,6 +47,31 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define BlasNoTrans  0
 #define BlasTrans    1
 
+#ifdef SMP
+/* The threads split the outer dimension of a, the columns of a column
+   major and the rows of a row major matrix, so m is the width of the
+   slice and n the full inner dimension */
+static int omatcopy_cn_thread(BLASLONG m, BLASLONG n, BLASLONG dummy1, FLOAT alpha, FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT *dummy2, BLASLONG dummy3)
+{
+	return OMATCOPY_K_CN(n, m, alpha, a, lda, b, ldb);
+}
+
+static int omatcopy_ct_thread(BLASLONG m, BLASLONG n, BLASLONG dummy1, FLOAT alpha, FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT *dummy2, BLASLONG dummy3)
+{
+	return OMATCOPY_K_CT(n, m, alpha, a, lda, b, ldb);
+}
+
+static int omatcopy_rn_thread(BLASLONG m, BLASLONG n, BLASLONG dummy1, FLOAT alpha, FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT *dummy2, BLASLONG dummy3)
+{
+	return OMATCOPY_K_RN(m, n, alpha, a, lda, b, ldb);
+}
+
+static int omatcopy_rt_thread(BLASLONG m, BLASLONG n, BLASLONG dummy1, FLOAT alpha, FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT *dummy2, BLASLONG dummy3)
+{
+	return OMATCOPY_K_RT(m, n, alpha, a, lda, b, ldb);
+}
+#endif
+
 #ifndef CBLAS 
 void NAME( char* ORDER, char* TRANS, blasint *rows, blasint *cols, FLOAT *alpha, FLOAT *a, blasint *lda, FLOAT *b, blasint *ldb)
 {
@@ -54,6 +79,10 @@ void NAME( char* ORDER, char* TRANS, blasint *rows, blasint *cols, FLOAT *alpha,
 	char Order, Trans;
 	int order=-1,trans=-1;
 	blasint info = -1;
+#ifdef SMP
+	int mode, nthreads;
+	int (*function)();
+#endif
 
 	Order = *ORDER;
 	Trans = *TRANS;
@@ -74,6 +103,10 @@ void CNAME(enum CBLAS_ORDER CORDER, enum CBLAS_TRANSPOSE CTRANS, blasint crows,
 	FLOAT   *alpha; 
 	int order=-1,trans=-1;
 	blasint info = -1;
+#ifdef SMP
+	int mode, nthreads;
+	int (*function)();
+#endif
 
 	if ( CORDER == CblasColMajor ) order = BlasColMajor; 
 	if ( CORDER == CblasRowMajor ) order = BlasRowMajor; 
@@ -111,6 +144,34 @@ void CNAME(enum CBLAS_ORDER CORDER, enum CBLAS_TRANSPOSE CTRANS, blasint crows,
     		return;
   	}
 
+#ifdef SMP
+	if ( (double)*rows * (double)*cols <= 262144.0 )
+		nthreads = 1;
+	else
+		nthreads = num_cpu_avail(1);
+
+	if ( nthreads > 1 )
+	{
+#ifdef DOUBLE
+		mode = BLAS_DOUBLE | BLAS_REAL;
+#else
+		mode = BLAS_SINGLE | BLAS_REAL;
+#endif
+		/* a transposed slice lands in consecutive elements of b */
+		if ( trans == BlasTrans ) mode |= BLAS_TRANSB_T;
+
+		if ( order == BlasColMajor )
+			function = (trans == BlasNoTrans) ? (int (*)())omatcopy_cn_thread : (int (*)())omatcopy_ct_thread;
+		else
+			function = (trans == BlasNoTrans) ? (int (*)())omatcopy_rn_thread : (int (*)())omatcopy_rt_thread;
+
+		blas_level1_thread(mode, (order == BlasColMajor) ? *cols : *rows,
+				   (order == BlasColMajor) ? *rows : *cols, 0,
+				   alpha, a, *lda, b, *ldb, NULL, 0, function, nthreads);
+		return;
+	}
+#endif
+
 	if ( order == BlasColMajor )
 	{
 		if ( trans == BlasNoTrans )
@@ -0,0 +1,71 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+/* Widen bfloat16 values to single precision; the conversion is exact. */
+
+#ifndef CBLAS
+
+void NAME(blasint *N, bfloat16 *in, blasint *INCIN, float *out, blasint *INCOUT){
+
+  BLASLONG n       = *N;
+  BLASLONG inc_in  = *INCIN;
+  BLASLONG inc_out = *INCOUT;
+
+  PRINT_DEBUG_NAME;
+
+#else
+
+void CNAME(blasint n, bfloat16 *in, blasint inc_in, float *out, blasint inc_out){
+
+  PRINT_DEBUG_CNAME;
+
+#endif
+
+  if (n <= 0) return;
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+  if (inc_in  < 0) in  -= (n - 1) * inc_in;
+  if (inc_out < 0) out -= (n - 1) * inc_out;
+
+  SHBF16TOS_K(n, in, inc_in, out, inc_out);
+
+  FUNCTION_PROFILE_END(1, n, 0);
+
+  IDEBUG_END;
+
+  return;
+
+}
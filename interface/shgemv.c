@@ -0,0 +1,294 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include <stdio.h>
+#include "common.h"
+#ifdef FUNCTION_PROFILE
+#include "functable.h"
+#endif
+
+#define ERROR_NAME "SHGEMV "
+
+/* y = alpha * op(A) * x + beta * y with A and x in bfloat16 and alpha,
+   beta and y in single precision.  The kernels apply beta themselves so
+   y is only streamed once. */
+
+#ifdef SMP
+static int gemv_kernel(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *dummy1, FLOAT *dummy2, BLASLONG pos){
+
+  bfloat16 *a = (bfloat16 *)args -> a;
+  bfloat16 *x = (bfloat16 *)args -> b;
+  float    *y = (float    *)args -> c;
+  BLASLONG lda  = args -> lda;
+  BLASLONG incx = args -> ldb;
+  BLASLONG incy = args -> ldc;
+  BLASLONG m = args -> m;
+  BLASLONG n = args -> n;
+
+  if (range_m) {
+    /* non-transposed: each thread owns a block of rows of A and y */
+    a += range_m[0];
+    y += range_m[0] * incy;
+    m  = range_m[1] - range_m[0];
+    SHGEMV_N(m, n, *(float *)args -> alpha, a, lda, x, incx, *(float *)args -> beta, y, incy);
+  } else {
+    /* transposed: each thread owns a block of columns of A and of y */
+    a += range_n[0] * lda;
+    y += range_n[0] * incy;
+    n  = range_n[1] - range_n[0];
+    SHGEMV_T(m, n, *(float *)args -> alpha, a, lda, x, incx, *(float *)args -> beta, y, incy);
+  }
+
+  return 0;
+}
+
+static void gemv_thread(int trans, BLASLONG m, BLASLONG n, float alpha, bfloat16 *a, BLASLONG lda,
+			bfloat16 *x, BLASLONG incx, float beta, float *y, BLASLONG incy, int nthreads){
+
+  blas_arg_t args;
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  BLASLONG range[MAX_CPU_NUMBER + 1];
+  BLASLONG width, i, num_cpu;
+
+  args.m = m;
+  args.n = n;
+  args.a = (void *)a;
+  args.b = (void *)x;
+  args.c = (void *)y;
+  args.lda = lda;
+  args.ldb = incx;
+  args.ldc = incy;
+  args.alpha = (void *)&alpha;
+  args.beta  = (void *)&beta;
+
+  num_cpu  = 0;
+  range[0] = 0;
+  i        = trans ? n : m;
+
+  while (i > 0){
+
+    width = blas_quickdivide(i + nthreads - num_cpu - 1, nthreads - num_cpu);
+    /* keep row blocks on whole cache lines of y */
+    if (!trans) width = (width + 15) & ~15;
+    if (width < 4) width = 4;
+    if (i < width) width = i;
+
+    range[num_cpu + 1] = range[num_cpu] + width;
+
+    queue[num_cpu].mode    = BLAS_SINGLE | BLAS_REAL;
+    queue[num_cpu].routine = gemv_kernel;
+    queue[num_cpu].args    = &args;
+    queue[num_cpu].range_m = trans ? NULL : &range[num_cpu];
+    queue[num_cpu].range_n = trans ? &range[num_cpu] : NULL;
+    queue[num_cpu].sa      = NULL;
+    queue[num_cpu].sb      = NULL;
+    queue[num_cpu].next    = &queue[num_cpu + 1];
+
+    num_cpu ++;
+    i -= width;
+  }
+
+  queue[0].sa = NULL;
+  queue[0].sb = NULL;
+  queue[num_cpu - 1].next = NULL;
+
+  exec_blas(num_cpu, queue);
+}
+#endif
+
+#ifndef CBLAS
+
+void NAME(char *TRANS, blasint *M, blasint *N,
+	   float *ALPHA, bfloat16 *a, blasint *LDA,
+	   bfloat16 *x, blasint *INCX,
+	   float *BETA, float *y, blasint *INCY){
+
+  char trans = *TRANS;
+  blasint m = *M;
+  blasint n = *N;
+  blasint lda = *LDA;
+  blasint incx = *INCX;
+  blasint incy = *INCY;
+  float alpha = *ALPHA;
+  float beta  = *BETA;
+
+  blasint info;
+  blasint lenx, leny;
+  blasint i;
+#ifdef SMP
+  int nthreads;
+#endif
+
+  PRINT_DEBUG_NAME;
+
+  TOUPPER(trans);
+
+  info = 0;
+
+  i = -1;
+
+  if (trans == 'N') i = 0;
+  if (trans == 'T') i = 1;
+  if (trans == 'R') i = 0;
+  if (trans == 'C') i = 1;
+
+  if (incy == 0)	info = 11;
+  if (incx == 0)	info = 8;
+  if (lda < MAX(1, m))	info = 6;
+  if (n < 0)		info = 3;
+  if (m < 0)		info = 2;
+  if (i < 0)          info = 1;
+
+  trans = i;
+
+  if (info != 0){
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+    return;
+  }
+
+#else
+
+void CNAME(enum CBLAS_ORDER order,
+	   enum CBLAS_TRANSPOSE TransA,
+	   blasint m, blasint n,
+	   float alpha,
+	   bfloat16 *a, blasint lda,
+	   bfloat16 *x, blasint incx,
+	   float beta,
+	   float *y, blasint incy){
+
+  blasint lenx, leny;
+  int trans;
+  blasint info, t;
+#ifdef SMP
+  int nthreads;
+#endif
+
+  PRINT_DEBUG_CNAME;
+
+  trans = -1;
+  info  =  0;
+
+  if (order == CblasColMajor) {
+    if (TransA == CblasNoTrans)     trans = 0;
+    if (TransA == CblasTrans)       trans = 1;
+    if (TransA == CblasConjNoTrans) trans = 0;
+    if (TransA == CblasConjTrans)   trans = 1;
+
+    info = -1;
+
+    if (incy == 0)	  info = 11;
+    if (incx == 0)	  info = 8;
+    if (lda < MAX(1, m))  info = 6;
+    if (n < 0)		  info = 3;
+    if (m < 0)		  info = 2;
+    if (trans < 0)        info = 1;
+
+  }
+
+  if (order == CblasRowMajor) {
+    if (TransA == CblasNoTrans)     trans = 1;
+    if (TransA == CblasTrans)       trans = 0;
+    if (TransA == CblasConjNoTrans) trans = 1;
+    if (TransA == CblasConjTrans)   trans = 0;
+
+    info = -1;
+
+    t = n;
+    n = m;
+    m = t;
+
+    if (incy == 0)	  info = 11;
+    if (incx == 0)	  info = 8;
+    if (lda < MAX(1, m))  info = 6;
+    if (n < 0)		  info = 3;
+    if (m < 0)		  info = 2;
+    if (trans < 0)        info = 1;
+
+  }
+
+  if (info >= 0) {
+    BLASFUNC(xerbla)(ERROR_NAME, &info, sizeof(ERROR_NAME));
+    return;
+  }
+
+#endif
+
+  if ((m==0) || (n==0)) return;
+
+  lenx = n;
+  leny = m;
+  if (trans) lenx = m;
+  if (trans) leny = n;
+
+  if (incx < 0) x -= (lenx - 1) * incx;
+  if (incy < 0) y -= (leny - 1) * incy;
+
+  if (alpha == ZERO) {
+    /* A and x are not referenced */
+    BLASLONG iy;
+    for (iy = 0; iy < leny; iy++) {
+      if (beta == ZERO) y[iy * incy] = ZERO;
+      else y[iy * incy] *= beta;
+    }
+    return;
+  }
+
+  IDEBUG_START;
+
+  FUNCTION_PROFILE_START();
+
+#ifdef SMP
+
+  if ( 1L * m * n < 2304L * GEMM_MULTITHREAD_THRESHOLD )
+    nthreads = 1;
+  else
+    nthreads = num_cpu_avail(2);
+
+  if (nthreads == 1) {
+#endif
+
+    if (trans)
+      SHGEMV_T(m, n, alpha, a, lda, x, incx, beta, y, incy);
+    else
+      SHGEMV_N(m, n, alpha, a, lda, x, incx, beta, y, incy);
+
+#ifdef SMP
+  } else {
+
+    gemv_thread(trans, m, n, alpha, a, lda, x, incx, beta, y, incy, nthreads);
+
+  }
+#endif
+
+  FUNCTION_PROFILE_END(1, m * n + m + n,  2 * m * n);
+
+  IDEBUG_END;
+
+  return;
+
+}
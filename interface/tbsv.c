@@ -64,6 +64,21 @@ static int (*tbsv[])(BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT *, BLASLONG, v
 #endif
 };
 
+#ifdef SMP
+static int (*tbsv_thread[])(BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT *, BLASLONG, FLOAT *, int) = {
+#ifdef XDOUBLE
+  qtbsv_thread_NUU, qtbsv_thread_NUN, qtbsv_thread_NLU, qtbsv_thread_NLN,
+  qtbsv_thread_TUU, qtbsv_thread_TUN, qtbsv_thread_TLU, qtbsv_thread_TLN,
+#elif defined(DOUBLE)
+  dtbsv_thread_NUU, dtbsv_thread_NUN, dtbsv_thread_NLU, dtbsv_thread_NLN,
+  dtbsv_thread_TUU, dtbsv_thread_TUN, dtbsv_thread_TLU, dtbsv_thread_TLN,
+#else
+  stbsv_thread_NUU, stbsv_thread_NUN, stbsv_thread_NLU, stbsv_thread_NLN,
+  stbsv_thread_TUU, stbsv_thread_TUN, stbsv_thread_TLU, stbsv_thread_TLN,
+#endif
+};
+#endif
+
 #ifndef CBLAS
 
 void NAME(char *UPLO, char *TRANS, char *DIAG,
@@ -84,6 +99,9 @@ void NAME(char *UPLO, char *TRANS, char *DIAG,
   int unit;
   int trans;
   FLOAT *buffer;
+#ifdef SMP
+  int nthreads;
+#endif
 
   PRINT_DEBUG_NAME;
 
@@ -130,6 +148,9 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_UPLO Uplo,
   int trans, uplo, unit;
   blasint info;
   FLOAT *buffer;
+#ifdef SMP
+  int nthreads;
+#endif
 
   PRINT_DEBUG_CNAME;
 
@@ -201,8 +222,25 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_UPLO Uplo,
 
   buffer = (FLOAT *)blas_memory_alloc(1);
 
+#ifdef SMP
+  if (k < DTB_ENTRIES || 1L * n * k < blas_thread_threshold(BLAS_THRESHOLD_TRSV, BLAS_THRESHOLD_PREC))
+    nthreads = 1;
+  else
+    nthreads = num_cpu_avail(2);
+
+  if (nthreads == 1) {
+#endif
+
   (tbsv[(trans<<2) | (uplo<<1) | unit])(n, k, a, lda, x, incx, buffer);
 
+#ifdef SMP
+  } else {
+
+    (tbsv_thread[(trans<<2) | (uplo<<1) | unit])(n, k, a, lda, x, incx, buffer, nthreads);
+
+  }
+#endif
+
   blas_memory_free(buffer);
 
   FUNCTION_PROFILE_END(1, n * k / 2 + n, n * k);
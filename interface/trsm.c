@@ -81,12 +81,6 @@
 #endif
 #endif
 
-#ifndef COMPLEX
-#define SMP_FACTOR 256
-#else
-#define SMP_FACTOR 128
-#endif
-
 static int (*trsm[])(blas_arg_t *, BLASLONG *, BLASLONG *, FLOAT *, FLOAT *, BLASLONG) = {
 #ifndef TRMM
   TRSM_LNUU, TRSM_LNUN, TRSM_LNLU, TRSM_LNLN,
@@ -361,6 +355,8 @@ void CNAME(enum CBLAS_ORDER order,
 
   IDEBUG_START;
 
+  TRACE_START();
+
   FUNCTION_PROFILE_START();
 
   buffer = (FLOAT *)blas_memory_alloc(0);
@@ -379,7 +375,7 @@ void CNAME(enum CBLAS_ORDER order,
 	if ( args.n < 2 * GEMM_MULTITHREAD_THRESHOLD )
 		args.nthreads = 1;
 */
-  if ( args.m * args.n < SMP_FACTOR * GEMM_MULTITHREAD_THRESHOLD)
+  if ( args.m * args.n < blas_thread_threshold(BLAS_THRESHOLD_TRSM, BLAS_THRESHOLD_PREC))
 	args.nthreads = 1;
   else
 	args.nthreads = num_cpu_avail(3);
@@ -406,6 +402,9 @@ void CNAME(enum CBLAS_ORDER order,
 		       (!side) ? args.m * (args.m + args.n) : args.n * (args.m + args.n),
 		       (!side) ? args.m * args.m * args.n : args.m * args.n * args.n);
 
+  TRACE_END(((char[]){"LR"[side], "UL"[uplo], "NTRC"[trans], "UN"[unit], 0}),
+	    args.m, args.n, 0, TRACE_THREADS(args.nthreads));
+
   IDEBUG_END;
 
   return;
@@ -231,6 +231,8 @@ void CNAME(enum CBLAS_ORDER order,
 
   IDEBUG_START;
 
+  TRACE_START();
+
   FUNCTION_PROFILE_START();
 
   if (incx < 0) x -= (lenx - 1) * incx * 2;
@@ -252,7 +254,7 @@ void CNAME(enum CBLAS_ORDER order,
 
 #ifdef SMP
 
-  if ( 1L * m * n < 1024L * GEMM_MULTITHREAD_THRESHOLD )
+  if ( 1L * m * n < blas_thread_threshold(BLAS_THRESHOLD_GEMV, BLAS_THRESHOLD_PREC) )
     nthreads = 1;
   else
     nthreads = num_cpu_avail(2);
@@ -275,6 +277,8 @@ void CNAME(enum CBLAS_ORDER order,
 
   FUNCTION_PROFILE_END(4, m * n + m + n,  2 * m * n);
 
+  TRACE_END(((char[]){"NTRCOUSD"[(int)trans], 0}), m, n, 0, TRACE_THREADS(nthreads));
+
   IDEBUG_END;
 
   return;
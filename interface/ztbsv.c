@@ -70,6 +70,27 @@ static int (*tbsv[])(BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT *, BLASLONG, v
 #endif
 };
 
+#ifdef SMP
+static int (*tbsv_thread[])(BLASLONG, BLASLONG, FLOAT *, BLASLONG, FLOAT *, BLASLONG, FLOAT *, int) = {
+#ifdef XDOUBLE
+  xtbsv_thread_NUU, xtbsv_thread_NUN, xtbsv_thread_NLU, xtbsv_thread_NLN,
+  xtbsv_thread_TUU, xtbsv_thread_TUN, xtbsv_thread_TLU, xtbsv_thread_TLN,
+  xtbsv_thread_RUU, xtbsv_thread_RUN, xtbsv_thread_RLU, xtbsv_thread_RLN,
+  xtbsv_thread_CUU, xtbsv_thread_CUN, xtbsv_thread_CLU, xtbsv_thread_CLN,
+#elif defined(DOUBLE)
+  ztbsv_thread_NUU, ztbsv_thread_NUN, ztbsv_thread_NLU, ztbsv_thread_NLN,
+  ztbsv_thread_TUU, ztbsv_thread_TUN, ztbsv_thread_TLU, ztbsv_thread_TLN,
+  ztbsv_thread_RUU, ztbsv_thread_RUN, ztbsv_thread_RLU, ztbsv_thread_RLN,
+  ztbsv_thread_CUU, ztbsv_thread_CUN, ztbsv_thread_CLU, ztbsv_thread_CLN,
+#else
+  ctbsv_thread_NUU, ctbsv_thread_NUN, ctbsv_thread_NLU, ctbsv_thread_NLN,
+  ctbsv_thread_TUU, ctbsv_thread_TUN, ctbsv_thread_TLU, ctbsv_thread_TLN,
+  ctbsv_thread_RUU, ctbsv_thread_RUN, ctbsv_thread_RLU, ctbsv_thread_RLN,
+  ctbsv_thread_CUU, ctbsv_thread_CUN, ctbsv_thread_CLU, ctbsv_thread_CLN,
+#endif
+};
+#endif
+
 #ifndef CBLAS
 
 void NAME(char *UPLO, char *TRANS, char *DIAG,
@@ -90,6 +111,9 @@ void NAME(char *UPLO, char *TRANS, char *DIAG,
   int unit;
   int trans;
   FLOAT *buffer;
+#ifdef SMP
+  int nthreads;
+#endif
 
   PRINT_DEBUG_NAME;
 
@@ -139,6 +163,9 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_UPLO Uplo,
   int trans, uplo, unit;
   blasint info;
   FLOAT *buffer;
+#ifdef SMP
+  int nthreads;
+#endif
 
   PRINT_DEBUG_CNAME;
 
@@ -210,8 +237,25 @@ void CNAME(enum CBLAS_ORDER order, enum CBLAS_UPLO Uplo,
 
   buffer = (FLOAT *)blas_memory_alloc(1);
 
+#ifdef SMP
+  if (k < DTB_ENTRIES || 1L * n * k < blas_thread_threshold(BLAS_THRESHOLD_TRSV, BLAS_THRESHOLD_PREC))
+    nthreads = 1;
+  else
+    nthreads = num_cpu_avail(2);
+
+  if (nthreads == 1) {
+#endif
+
   (tbsv[(trans<<2) | (uplo<<1) | unit])(n, k, a, lda, x, incx, buffer);
 
+#ifdef SMP
+  } else {
+
+    (tbsv_thread[(trans<<2) | (uplo<<1) | unit])(n, k, a, lda, x, incx, buffer, nthreads);
+
+  }
+#endif
+
   blas_memory_free(buffer);
 
   FUNCTION_PROFILE_END(4, n * k / 2 + n, n * k);
@@ -217,12 +217,21 @@ static int dasum_thread_function(BLASLONG n, BLASLONG dummy0,
 
 	return 0;
 }
+
+static int dasum_leaf_function(BLASLONG n, FLOAT *x, BLASLONG inc_x,
+	FLOAT *y, BLASLONG inc_y, double *partial)
+{
+	partial[0] = dasum_compute(n, x, inc_x);
+	partial[1] = 0.0;
+
+	return 0;
+}
 #endif
 
 FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x)
 {
 #if defined(SMP)
-	int nthreads;
+	int nthreads, mode;
 	FLOAT dummy_alpha;
 #endif
 	FLOAT asum = 0.0;
@@ -233,15 +242,21 @@ FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x)
 	else
 		nthreads = num_cpu_avail(1);
 
-	if (nthreads == 1) {
+	mode = BLAS_DOUBLE;
+
+	if (openblas_get_deterministic()) {
+		double sum[4];
+
+		blas_level1_thread_reduce(mode, n, x, inc_x, NULL, 0, sum,
+				   (void *)dasum_leaf_function, nthreads);
+		asum = sum[0];
+	} else if (nthreads == 1) {
 		asum = dasum_compute(n, x, inc_x);
 	} else {
-		int mode, i;
+		int i;
 		char result[MAX_CPU_NUMBER * sizeof(double) * 2];
 		FLOAT *ptr;
 
-		mode = BLAS_DOUBLE;
-
 		blas_level1_thread_with_return_value(mode, n, 0, 0, &dummy_alpha,
 				   x, inc_x, NULL, 0, result, 0,
 				   ( void *)dasum_thread_function, nthreads);
@@ -373,12 +373,21 @@ static int dot_thread_function(BLASLONG n, BLASLONG dummy0,
 
 	return 0;
 }
+
+static int dot_leaf_function(BLASLONG n, FLOAT *x, BLASLONG inc_x,
+	FLOAT *y, BLASLONG inc_y, double *partial)
+{
+	partial[0] = dot_compute(n, x, inc_x, y, inc_y);
+	partial[1] = 0.0;
+
+	return 0;
+}
 #endif
 
 RETURN_TYPE CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y)
 {
 #if defined(SMP)
-	int nthreads;
+	int nthreads, mode;
 	FLOAT dummy_alpha;
 #endif
 	RETURN_TYPE dot = 0.0;
@@ -389,19 +398,25 @@ RETURN_TYPE CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y
 	else
 		nthreads = num_cpu_avail(1);
 
-	if (nthreads == 1) {
+#if !defined(DOUBLE)
+	mode = BLAS_SINGLE  | BLAS_REAL;
+#else
+	mode = BLAS_DOUBLE  | BLAS_REAL;
+#endif
+
+	if (openblas_get_deterministic()) {
+		double sum[4];
+
+		blas_level1_thread_reduce(mode, n, x, inc_x, y, inc_y, sum,
+				   (void *)dot_leaf_function, nthreads);
+		dot = sum[0];
+	} else if (nthreads == 1) {
 		dot = dot_compute(n, x, inc_x, y, inc_y);
 	} else {
-		int mode, i;
+		int i;
 		char result[MAX_CPU_NUMBER * sizeof(double) * 2];
 		RETURN_TYPE *ptr;
 
-#if !defined(DOUBLE)
-		mode = BLAS_SINGLE  | BLAS_REAL;
-#else
-		mode = BLAS_DOUBLE  | BLAS_REAL;
-#endif
-
 		blas_level1_thread_with_return_value(mode, n, 0, 0, &dummy_alpha,
 				   x, inc_x, y, inc_y, result, 0,
 				   ( void *)dot_thread_function, nthreads);
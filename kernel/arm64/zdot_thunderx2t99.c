@@ -304,12 +304,24 @@ static int zdot_thread_function(BLASLONG n, BLASLONG dummy0,
 
 	return 0;
 }
+
+static int zdot_leaf_function(BLASLONG n, FLOAT *x, BLASLONG inc_x,
+	FLOAT *y, BLASLONG inc_y, double *partial)
+{
+	OPENBLAS_COMPLEX_FLOAT res;
+
+	zdot_compute(n, x, inc_x, y, inc_y, &res);
+	partial[0] = CREAL(res);
+	partial[1] = CIMAG(res);
+
+	return 0;
+}
 #endif
 
 OPENBLAS_COMPLEX_FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y)
 {
 #if defined(SMP)
-	int nthreads;
+	int nthreads, mode;
 	FLOAT dummy_alpha;
 #endif
 	OPENBLAS_COMPLEX_FLOAT zdot;
@@ -322,19 +334,26 @@ OPENBLAS_COMPLEX_FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLA
 	else
 		nthreads = num_cpu_avail(1);
 
-	if (nthreads == 1) {
+#if !defined(DOUBLE)
+	mode = BLAS_SINGLE  | BLAS_COMPLEX;
+#else
+	mode = BLAS_DOUBLE  | BLAS_COMPLEX;
+#endif
+
+	if (openblas_get_deterministic()) {
+		double sum[4];
+
+		blas_level1_thread_reduce(mode, n, x, inc_x, y, inc_y, sum,
+				   (void *)zdot_leaf_function, nthreads);
+		CREAL(zdot) = sum[0];
+		CIMAG(zdot) = sum[1];
+	} else if (nthreads == 1) {
 		zdot_compute(n, x, inc_x, y, inc_y, &zdot);
 	} else {
-		int mode, i;
+		int i;
 		char result[MAX_CPU_NUMBER * sizeof(double) * 2];
 		OPENBLAS_COMPLEX_FLOAT *ptr;
 
-#if !defined(DOUBLE)
-		mode = BLAS_SINGLE  | BLAS_COMPLEX;
-#else
-		mode = BLAS_DOUBLE  | BLAS_COMPLEX;
-#endif
-
 		blas_level1_thread_with_return_value(mode, n, 0, 0, &dummy_alpha,
 				   x, inc_x, y, inc_y, result, 0,
 				   ( void *)zdot_thread_function, nthreads);
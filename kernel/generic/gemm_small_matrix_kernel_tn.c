@@ -0,0 +1,58 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+/* C = alpha * A**T * B + beta * C without packing, for small matrices.
+   Column major; compiled with -DB0 for the beta == 0 variant. */
+
+#ifdef B0
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT *C, BLASLONG ldc)
+#else
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT beta, FLOAT *C, BLASLONG ldc)
+#endif
+{
+	BLASLONG i, j, l;
+	FLOAT *a, *b, result;
+
+	for (j = 0; j < N; j++) {
+		b = B + j * ldb;
+		for (i = 0; i < M; i++) {
+			a = A + i * lda;
+			result = ZERO;
+			for (l = 0; l < K; l++)
+				result += a[l] * b[l];
+#ifdef B0
+			C[i + j * ldc] = alpha * result;
+#else
+			C[i + j * ldc] = alpha * result + beta * C[i + j * ldc];
+#endif
+		}
+	}
+
+	return 0;
+}
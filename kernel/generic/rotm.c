@@ -0,0 +1,68 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+/* Modified Givens transformation, as in the reference ?ROTM:
+
+     flag = -1:  H = (h11 h12; h21 h22)
+     flag =  0:  H = (1 h12; h21 1)
+     flag =  1:  H = (h11 1; -1 h22)
+     flag = -2:  H is the identity
+
+   param holds flag, h11, h21, h12, h22.  The unit entries are applied
+   as multiplications by one, which change nothing. */
+
+int CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y, FLOAT *param)
+{
+	BLASLONG i;
+	FLOAT h11, h12, h21, h22, w, z;
+
+	if (n <= 0 || param[0] == -2.0) return 0;
+
+	if (param[0] < 0.0) {
+		h11 = param[1];  h21 = param[2];
+		h12 = param[3];  h22 = param[4];
+	} else if (param[0] == 0.0) {
+		h11 = 1.0;       h21 = param[2];
+		h12 = param[3];  h22 = 1.0;
+	} else {
+		h11 = param[1];  h21 = -1.0;
+		h12 = 1.0;       h22 = param[4];
+	}
+
+	for (i = 0; i < n; i++) {
+		w = *x;
+		z = *y;
+		*x = h11 * w + h12 * z;
+		*y = h21 * w + h22 * z;
+		x += inc_x;
+		y += inc_y;
+	}
+
+	return 0;
+}
@@ -0,0 +1,70 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+/* Applies the plane rotations (c[j], s[j]), j = 0 .. k-1, to the column
+   pairs (j, j+1) of the m by k+1 matrix a, first to last or, when
+   backward is set, last to first; this is LAPACK's ?LASR with SIDE = 'R'
+   and PIVOT = 'V':
+
+     a(:,j)   = c[j] * a(:,j) + s[j] * a(:,j+1)
+     a(:,j+1) = c[j] * a(:,j+1) - s[j] * a(:,j)
+
+   Rotations with c = 1 and s = 0 are skipped, as there.  The rows are
+   taken in blocks, so that the column a rotation leaves behind is still
+   in cache when the next one picks it up and a whole wave of rotations
+   costs about one pass over the matrix instead of k. */
+
+#define ROTSEQ_ROWS	256
+
+int CNAME(BLASLONG m, BLASLONG k, FLOAT *a, BLASLONG lda, FLOAT *c, FLOAT *s, BLASLONG backward)
+{
+	BLASLONG is, min_i, i, jj, j;
+	FLOAT cj, sj, t, *x, *y;
+
+	for (is = 0; is < m; is += ROTSEQ_ROWS) {
+		min_i = MIN(m - is, ROTSEQ_ROWS);
+
+		for (jj = 0; jj < k; jj++) {
+			j = backward ? k - 1 - jj : jj;
+			cj = c[j];
+			sj = s[j];
+			if (cj == 1.0 && sj == 0.0) continue;
+
+			x = a + is + j * lda;
+			y = x + lda;
+			for (i = 0; i < min_i; i++) {
+				t = y[i];
+				y[i] = cj * t - sj * x[i];
+				x[i] = sj * t + cj * x[i];
+			}
+		}
+	}
+
+	return 0;
+}
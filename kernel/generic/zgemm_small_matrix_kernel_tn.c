@@ -0,0 +1,85 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+/* C = alpha * op(A) * op(B) + beta * C without packing, for small matrices,
+   with op(A) = A**T or A**H and op(B) = B or conj(B).  Compiled with -DNN, -DCN,
+   -DNC or -DCC to select conjugation of A and/or B (as in the zgemm kernels),
+   and with -DB0 for the beta == 0 variant. */
+
+#if defined(NN)
+#define MADD(re, im, ar, ai, br, bi) { re += ar * br - ai * bi; im += ar * bi + ai * br; }
+#elif defined(CN)
+#define MADD(re, im, ar, ai, br, bi) { re += ar * br + ai * bi; im += ar * bi - ai * br; }
+#elif defined(NC)
+#define MADD(re, im, ar, ai, br, bi) { re += ar * br + ai * bi; im += ai * br - ar * bi; }
+#else
+#define MADD(re, im, ar, ai, br, bi) { re += ar * br - ai * bi; im -= ar * bi + ai * br; }
+#endif
+
+#ifdef B0
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha0, FLOAT alpha1, FLOAT *B, BLASLONG ldb, FLOAT *C, BLASLONG ldc)
+#else
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha0, FLOAT alpha1, FLOAT *B, BLASLONG ldb, FLOAT beta0, FLOAT beta1, FLOAT *C, BLASLONG ldc)
+#endif
+{
+	BLASLONG i, j, l;
+	FLOAT ar, ai, br, bi, real, imag;
+	FLOAT *c;
+#ifndef B0
+	FLOAT cr, ci;
+#endif
+
+	for (j = 0; j < N; j++) {
+		for (i = 0; i < M; i++) {
+			real = ZERO;
+			imag = ZERO;
+
+			for (l = 0; l < K; l++) {
+				ar = A[2 * (l + i * lda) + 0];
+				ai = A[2 * (l + i * lda) + 1];
+				br = B[2 * (l + j * ldb) + 0];
+				bi = B[2 * (l + j * ldb) + 1];
+				MADD(real, imag, ar, ai, br, bi);
+			}
+
+			c = C + 2 * (i + j * ldc);
+#ifdef B0
+			c[0] = alpha0 * real - alpha1 * imag;
+			c[1] = alpha0 * imag + alpha1 * real;
+#else
+			cr = c[0];
+			ci = c[1];
+			c[0] = alpha0 * real - alpha1 * imag + beta0 * cr - beta1 * ci;
+			c[1] = alpha0 * imag + alpha1 * real + beta0 * ci + beta1 * cr;
+#endif
+		}
+	}
+
+	return 0;
+}
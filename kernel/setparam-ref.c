@@ -67,7 +67,8 @@ gotoblas_t TABLE_NAME = {
   snrm2_kTS,  sasum_kTS, ssum_kTS, scopy_kTS, sdot_kTS,
   dsdot_kTS,
   srot_kTS,   saxpy_kTS,  sscal_kTS, sswap_kTS,
-  sgemv_nTS,  sgemv_tTS, sger_kTS,
+  shstobf16_kTS, shbf16tos_kTS,
+  shgemv_nTS,  shgemv_tTS, sger_kTS,
   ssymv_LTS, ssymv_UTS,
 
   shgemm_kernelTS, shgemm_betaTS,
@@ -131,7 +132,8 @@ gotoblas_t TABLE_NAME = {
   isamax_kTS, isamin_kTS, ismax_kTS, ismin_kTS,
   snrm2_kTS,  sasum_kTS, ssum_kTS, scopy_kTS, sdot_kTS,
   dsdot_kTS,
-  srot_kTS,   saxpy_kTS,  sscal_kTS, sswap_kTS,
+  srot_kTS,   srotm_kTS,  srotseq_kTS,
+  saxpy_kTS,  sscal_kTS, sswap_kTS,
   sgemv_nTS,  sgemv_tTS, sger_kTS,
   ssymv_LTS, ssymv_UTS,
 
@@ -186,7 +188,8 @@ gotoblas_t TABLE_NAME = {
   damax_kTS,  damin_kTS,  dmax_kTS,  dmin_kTS,
   idamax_kTS, idamin_kTS, idmax_kTS, idmin_kTS,
   dnrm2_kTS,  dasum_kTS,  dsum_kTS, dcopy_kTS, ddot_kTS,
-  drot_kTS,   daxpy_kTS,  dscal_kTS, dswap_kTS,
+  drot_kTS,   drotm_kTS,  drotseq_kTS,
+  daxpy_kTS,  dscal_kTS, dswap_kTS,
   dgemv_nTS,  dgemv_tTS,  dger_kTS,
   dsymv_LTS,  dsymv_UTS,
 
@@ -238,7 +241,8 @@ gotoblas_t TABLE_NAME = {
   qamax_kTS,  qamin_kTS,  qmax_kTS,  qmin_kTS,
   iqamax_kTS, iqamin_kTS, iqmax_kTS, iqmin_kTS,
   qnrm2_kTS,  qasum_kTS,  qsum_kTS, qcopy_kTS, qdot_kTS,
-  qrot_kTS,   qaxpy_kTS,  qscal_kTS, qswap_kTS,
+  qrot_kTS,   qrotm_kTS,
+  qaxpy_kTS,  qscal_kTS, qswap_kTS,
   qgemv_nTS,  qgemv_tTS,  qger_kTS,
   qsymv_LTS,  qsymv_UTS,
 
@@ -701,7 +705,34 @@ gotoblas_t TABLE_NAME = {
   zimatcopy_k_cnTS, zimatcopy_k_ctTS, zimatcopy_k_rnTS, zimatcopy_k_rtTS,
   zimatcopy_k_cncTS, zimatcopy_k_ctcTS, zimatcopy_k_rncTS, zimatcopy_k_rtcTS,
 
-  sgeadd_kTS, dgeadd_kTS, cgeadd_kTS, zgeadd_kTS
+  sgeadd_kTS, dgeadd_kTS, cgeadd_kTS, zgeadd_kTS,
+
+#ifdef SMALL_MATRIX_OPT
+  sgemm_small_matrix_permitTS,
+  sgemm_small_kernel_nnTS, sgemm_small_kernel_tnTS, sgemm_small_kernel_ntTS, sgemm_small_kernel_ttTS,
+  sgemm_small_kernel_b0_nnTS, sgemm_small_kernel_b0_tnTS, sgemm_small_kernel_b0_ntTS, sgemm_small_kernel_b0_ttTS,
+  dgemm_small_matrix_permitTS,
+  dgemm_small_kernel_nnTS, dgemm_small_kernel_tnTS, dgemm_small_kernel_ntTS, dgemm_small_kernel_ttTS,
+  dgemm_small_kernel_b0_nnTS, dgemm_small_kernel_b0_tnTS, dgemm_small_kernel_b0_ntTS, dgemm_small_kernel_b0_ttTS,
+  cgemm_small_matrix_permitTS,
+  cgemm_small_kernel_nnTS, cgemm_small_kernel_tnTS, cgemm_small_kernel_rnTS, cgemm_small_kernel_cnTS,
+  cgemm_small_kernel_ntTS, cgemm_small_kernel_ttTS, cgemm_small_kernel_rtTS, cgemm_small_kernel_ctTS,
+  cgemm_small_kernel_nrTS, cgemm_small_kernel_trTS, cgemm_small_kernel_rrTS, cgemm_small_kernel_crTS,
+  cgemm_small_kernel_ncTS, cgemm_small_kernel_tcTS, cgemm_small_kernel_rcTS, cgemm_small_kernel_ccTS,
+  cgemm_small_kernel_b0_nnTS, cgemm_small_kernel_b0_tnTS, cgemm_small_kernel_b0_rnTS, cgemm_small_kernel_b0_cnTS,
+  cgemm_small_kernel_b0_ntTS, cgemm_small_kernel_b0_ttTS, cgemm_small_kernel_b0_rtTS, cgemm_small_kernel_b0_ctTS,
+  cgemm_small_kernel_b0_nrTS, cgemm_small_kernel_b0_trTS, cgemm_small_kernel_b0_rrTS, cgemm_small_kernel_b0_crTS,
+  cgemm_small_kernel_b0_ncTS, cgemm_small_kernel_b0_tcTS, cgemm_small_kernel_b0_rcTS, cgemm_small_kernel_b0_ccTS,
+  zgemm_small_matrix_permitTS,
+  zgemm_small_kernel_nnTS, zgemm_small_kernel_tnTS, zgemm_small_kernel_rnTS, zgemm_small_kernel_cnTS,
+  zgemm_small_kernel_ntTS, zgemm_small_kernel_ttTS, zgemm_small_kernel_rtTS, zgemm_small_kernel_ctTS,
+  zgemm_small_kernel_nrTS, zgemm_small_kernel_trTS, zgemm_small_kernel_rrTS, zgemm_small_kernel_crTS,
+  zgemm_small_kernel_ncTS, zgemm_small_kernel_tcTS, zgemm_small_kernel_rcTS, zgemm_small_kernel_ccTS,
+  zgemm_small_kernel_b0_nnTS, zgemm_small_kernel_b0_tnTS, zgemm_small_kernel_b0_rnTS, zgemm_small_kernel_b0_cnTS,
+  zgemm_small_kernel_b0_ntTS, zgemm_small_kernel_b0_ttTS, zgemm_small_kernel_b0_rtTS, zgemm_small_kernel_b0_ctTS,
+  zgemm_small_kernel_b0_nrTS, zgemm_small_kernel_b0_trTS, zgemm_small_kernel_b0_rrTS, zgemm_small_kernel_b0_crTS,
+  zgemm_small_kernel_b0_ncTS, zgemm_small_kernel_b0_tcTS, zgemm_small_kernel_b0_rcTS, zgemm_small_kernel_b0_ccTS
+#endif
 
 };
 
@@ -0,0 +1,121 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Helpers shared by the bfloat16 (sh*) kernels for SkylakeX and newer.
+ *
+ * A bfloat16 is the upper half of an IEEE single, so widening to float is
+ * a 16 bit shift.  The GEMM and GEMV kernels keep operands as pairs of
+ * bfloat16 in one 32 bit lane, which is the layout vdpbf16ps consumes:
+ * lane i of the result gets a[2i]*b[2i] + a[2i+1]*b[2i+1].  When the
+ * compiler targets AVX512-BF16 the instruction is used unconditionally;
+ * with a compiler that knows the instruction but a baseline of plain
+ * AVX512 the kernels check cpuid once and fall back to two FMAs on
+ * SkylakeX / Cascade Lake. */
+
+#ifndef BF16_COMMON_SKYLAKEX_H
+#define BF16_COMMON_SKYLAKEX_H
+
+#include <string.h>
+#include <immintrin.h>
+
+#if defined(__AVX512BF16__)
+#define BF16_DPBF16_ALWAYS
+#elif (defined(__clang__) && __clang_major__ >= 9) || \
+      (!defined(__clang__) && defined(__GNUC__) && __GNUC__ >= 10)
+#define BF16_DPBF16_RUNTIME
+#endif
+
+#if defined(BF16_DPBF16_ALWAYS) || defined(BF16_DPBF16_RUNTIME)
+#define BF16_HAVE_DPBF16
+#define BF16_TARGET_DPBF16	__attribute__((target("avx512bf16")))
+#define BF16_DPBF16(acc, a, b)	_mm512_dpbf16_ps(acc, (__m512bh)(a), (__m512bh)(b))
+#endif
+
+static inline int bf16_cpu_has_dpbf16(void) {
+#if defined(BF16_DPBF16_ALWAYS)
+  return 1;
+#elif defined(BF16_DPBF16_RUNTIME)
+  static int has_dpbf16 = -1;
+  unsigned int eax, ebx, ecx, edx;
+
+  if (has_dpbf16 < 0) {
+    /* AVX512_BF16 is CPUID.(EAX=7,ECX=1):EAX[bit 5] */
+    __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "0"(7), "2"(0));
+    if (eax >= 1) {
+      __asm__ __volatile__("cpuid" : "=a"(eax), "=b"(ebx), "=c"(ecx), "=d"(edx) : "0"(7), "2"(1));
+      has_dpbf16 = (eax >> 5) & 1;
+    } else {
+      has_dpbf16 = 0;
+    }
+  }
+  return has_dpbf16;
+#else
+  return 0;
+#endif
+}
+
+/* one pair of bfloat16, possibly at an odd element offset */
+static inline int bf16_load_pair(const bfloat16 *p) {
+  int v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline float bf16_to_float(bfloat16 x) {
+  unsigned int u = (unsigned int)x << 16;
+  float f;
+  memcpy(&f, &u, sizeof(f));
+  return f;
+}
+
+/* widen 16 bfloat16 values to single precision */
+static inline __m512 bf16_cvt_ps(__m256i v) {
+  return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_cvtepu16_epi32(v), 16));
+}
+
+/* emulation of vdpbf16ps: the even element of each pair sits in the low
+   half of the lane, the odd element in the high half */
+static inline __m512 bf16_dot2_ps(__m512 acc, __m512i a, __m512i b) {
+  __m512i hi = _mm512_set1_epi32((int)0xffff0000);
+  acc = _mm512_fmadd_ps(_mm512_castsi512_ps(_mm512_slli_epi32(a, 16)),
+                        _mm512_castsi512_ps(_mm512_slli_epi32(b, 16)), acc);
+  return _mm512_fmadd_ps(_mm512_castsi512_ps(_mm512_and_si512(a, hi)),
+                         _mm512_castsi512_ps(_mm512_and_si512(b, hi)), acc);
+}
+
+/* float -> bfloat16 with round to nearest even; NaNs stay (quiet) NaNs */
+static inline __m256i bf16_from_ps(__m512 x) {
+  __m512i u   = _mm512_castps_si512(x);
+  __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(u, 16), _mm512_set1_epi32(1));
+  __m512i r   = _mm512_add_epi32(u, _mm512_add_epi32(lsb, _mm512_set1_epi32(0x7fff)));
+  __mmask16 nan = _mm512_cmp_ps_mask(x, x, _CMP_UNORD_Q);
+
+  r = _mm512_mask_or_epi32(r, nan, u, _mm512_set1_epi32(0x00400000));
+  return _mm512_cvtepi32_epi16(_mm512_srli_epi32(r, 16));
+}
+
+#endif
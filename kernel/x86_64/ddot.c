@@ -157,6 +157,15 @@ static int dot_thread_function(BLASLONG n, BLASLONG dummy0,
         return 0;
 }
 
+static int dot_leaf_function(BLASLONG n, FLOAT *x, BLASLONG inc_x,
+        FLOAT *y, BLASLONG inc_y, double *partial)
+{
+        partial[0] = dot_compute(n, x, inc_x, y, inc_y);
+        partial[1] = 0.0;
+
+        return 0;
+}
+
 extern int blas_level1_thread_with_return_value(int mode, BLASLONG m, BLASLONG n,
         BLASLONG k, void *alpha, void *a, BLASLONG lda, void *b, BLASLONG ldb,
         void *c, BLASLONG ldc, int (*function)(), int nthreads);
@@ -165,7 +174,7 @@ extern int blas_level1_thread_with_return_value(int mode, BLASLONG m, BLASLONG n
 FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y)
 {
 #if defined(SMP)
-	int nthreads;
+	int nthreads, mode;
 	FLOAT dummy_alpha;
 #endif
 	FLOAT dot = 0.0;
@@ -176,18 +185,25 @@ FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y)
 	else
 		nthreads = num_cpu_avail(1);
 
-	if (nthreads == 1) {
+#if !defined(DOUBLE)
+	mode = BLAS_SINGLE  | BLAS_REAL;
+#else
+	mode = BLAS_DOUBLE  | BLAS_REAL;
+#endif
+
+	if (openblas_get_deterministic()) {
+		double sum[4];
+
+		blas_level1_thread_reduce(mode, n, x, inc_x, y, inc_y, sum,
+				   (void *)dot_leaf_function, nthreads);
+		dot = sum[0];
+	} else if (nthreads == 1) {
 		dot = dot_compute(n, x, inc_x, y, inc_y);
 	} else {
-		int mode, i;
+		int i;
 		char result[MAX_CPU_NUMBER * sizeof(double) * 2];
 		RETURN_TYPE *ptr;
 
-#if !defined(DOUBLE)
-		mode = BLAS_SINGLE  | BLAS_REAL;
-#else
-		mode = BLAS_DOUBLE  | BLAS_REAL;
-#endif
 		blas_level1_thread_with_return_value(mode, n, 0, 0, &dummy_alpha,
 				   x, inc_x, y, inc_y, result, 0,
 				   ( void *)dot_thread_function, nthreads);
@@ -0,0 +1,175 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Double and double complex nrm2 with Blue's scaled sums, as in
+   LAPACK 3.10: squares of magnitudes between NRM2_TSML and NRM2_TBIG
+   are summed as they are, larger ones after scaling by NRM2_SBIG and
+   smaller ones after scaling by NRM2_SSML, so that no square overflows
+   or underflows.  The three sums only meet at the end. */
+
+#include "common.h"
+#include <math.h>
+
+#define NRM2_TSML	0x1p-511
+#define NRM2_TBIG	0x1p+486
+#define NRM2_SSML	0x1p+537
+#define NRM2_SBIG	0x1p-538
+
+#if defined(SKYLAKEX)
+#include "dznrm2_microk_skylakex-2.c"
+#elif defined(HASWELL) || defined(ZEN)
+#include "dznrm2_microk_haswell-2.c"
+#endif
+
+static void nrm2_tail(BLASLONG n, FLOAT *x, BLASLONG inc_x, double *acc)
+{
+	BLASLONG i;
+	double ax;
+
+	for (i = 0; i < n; i++) {
+		ax = fabs(x[i * inc_x]);
+		if (ax > NRM2_TBIG) {
+			ax *= NRM2_SBIG;
+			acc[0] += ax * ax;
+		} else if (ax < NRM2_TSML) {
+			ax *= NRM2_SSML;
+			acc[2] += ax * ax;
+		} else {
+			acc[1] += ax * ax;
+		}
+	}
+}
+
+/* big, medium and small sums of n elements */
+static void nrm2_compute(BLASLONG n, FLOAT *x, BLASLONG inc_x, double *acc)
+{
+	BLASLONG n1 = 0;
+
+	acc[0] = acc[1] = acc[2] = 0.0;
+
+#if defined(COMPLEX)
+	if (inc_x != 1) {
+		nrm2_tail(n, x,     inc_x * 2, acc);
+		nrm2_tail(n, x + 1, inc_x * 2, acc);
+		return;
+	}
+	n *= 2;
+#else
+	if (inc_x != 1) {
+		nrm2_tail(n, x, inc_x, acc);
+		return;
+	}
+#endif
+
+#if defined(HAVE_KERNEL_16)
+	n1 = n & -16;
+	if (n1 > 0) nrm2_kernel_16(n1, x, acc);
+#endif
+
+	nrm2_tail(n - n1, x + n1, 1, acc);
+}
+
+static FLOAT nrm2_finish(double *acc)
+{
+	double abig = acc[0], amed = acc[1], asml = acc[2];
+	double ymin, ymax, scl, sumsq;
+
+	if (abig > 0.0) {
+		/* medium values only matter when they are not dwarfed,
+		   and a NaN has to come through */
+		if (amed > 0.0 || amed != amed) abig += (amed * NRM2_SBIG) * NRM2_SBIG;
+		scl   = 1.0 / NRM2_SBIG;
+		sumsq = abig;
+	} else if (asml > 0.0) {
+		if (amed > 0.0 || amed != amed) {
+			amed = sqrt(amed);
+			asml = sqrt(asml) / NRM2_SSML;
+			if (asml > amed) {
+				ymin = amed;
+				ymax = asml;
+			} else {
+				ymin = asml;
+				ymax = amed;
+			}
+			scl   = 1.0;
+			sumsq = ymax * ymax * (1.0 + (ymin / ymax) * (ymin / ymax));
+		} else {
+			scl   = 1.0 / NRM2_SSML;
+			sumsq = asml;
+		}
+	} else {
+		scl   = 1.0;
+		sumsq = amed;
+	}
+
+	return scl * sqrt(sumsq);
+}
+
+#if defined(SMP)
+static int nrm2_leaf_function(BLASLONG n, FLOAT *x, BLASLONG inc_x,
+	FLOAT *y, BLASLONG inc_y, double *partial)
+{
+	nrm2_compute(n, x, inc_x, partial);
+
+	return 0;
+}
+#endif
+
+FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x)
+{
+	double acc[4];
+#if defined(SMP)
+	int nthreads, mode;
+#endif
+
+	if (n <= 0 || inc_x <= 0) return 0.0;
+
+#if defined(SMP)
+	if (n <= 10000)
+		nthreads = 1;
+	else
+		nthreads = num_cpu_avail(1);
+
+#if defined(COMPLEX)
+	mode = BLAS_DOUBLE  | BLAS_COMPLEX;
+#else
+	mode = BLAS_DOUBLE  | BLAS_REAL;
+#endif
+
+	/* long vectors are always summed over fixed chunks, so the result
+	   does not depend on how many threads share them */
+	if (n > 10000 || openblas_get_deterministic())
+		blas_level1_thread_reduce(mode, n, x, inc_x, NULL, 0, acc,
+				   (void *)nrm2_leaf_function, nthreads);
+	else
+		nrm2_compute(n, x, inc_x, acc);
+#else
+	nrm2_compute(n, x, inc_x, acc);
+#endif
+
+	return nrm2_finish(acc);
+}
@@ -0,0 +1,97 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#if (( defined(__GNUC__)  && __GNUC__   > 6 && defined(__AVX2__)) || (defined(__clang__) && __clang_major__ >= 6 && defined(__AVX2__)))
+
+#define HAVE_KERNEL_16 1
+
+#include <immintrin.h>
+
+/* Adds the squares of one vector to the big, medium and small sums,
+   each lane to the sum its magnitude belongs to. */
+#define NRM2_SPLIT(v, big, med, sml) {						\
+	__m256d isbig = _mm256_cmp_pd(v, tbig, _CMP_GT_OQ);			\
+	__m256d issml = _mm256_cmp_pd(v, tsml, _CMP_LT_OQ);			\
+	__m256d b = _mm256_mul_pd(v, sbig), s = _mm256_mul_pd(v, ssml);		\
+	big = _mm256_add_pd(big, _mm256_and_pd(isbig, _mm256_mul_pd(b, b)));	\
+	sml = _mm256_add_pd(sml, _mm256_and_pd(issml, _mm256_mul_pd(s, s)));	\
+	med = _mm256_add_pd(med, _mm256_andnot_pd(_mm256_or_pd(isbig, issml),	\
+						  _mm256_mul_pd(v, v)));	\
+}
+
+static double nrm2_hsum(__m256d v)
+{
+	__m128d h = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+
+	return _mm_cvtsd_f64(_mm_add_sd(h, _mm_unpackhi_pd(h, h)));
+}
+
+/* n a multiple of 16 */
+static void nrm2_kernel_16(BLASLONG n, FLOAT *x, double *acc)
+{
+	BLASLONG i;
+	__m256d sign = _mm256_set1_pd(-0.0);
+	__m256d tsml = _mm256_set1_pd(NRM2_TSML), tbig = _mm256_set1_pd(NRM2_TBIG);
+	__m256d ssml = _mm256_set1_pd(NRM2_SSML), sbig = _mm256_set1_pd(NRM2_SBIG);
+	__m256d big = _mm256_setzero_pd(), sml = _mm256_setzero_pd();
+	__m256d med0 = _mm256_setzero_pd(), med1 = _mm256_setzero_pd();
+	__m256d med2 = _mm256_setzero_pd(), med3 = _mm256_setzero_pd();
+
+	for (i = 0; i < n; i += 16) {
+		__m256d x0 = _mm256_andnot_pd(sign, _mm256_loadu_pd(x + i +  0));
+		__m256d x1 = _mm256_andnot_pd(sign, _mm256_loadu_pd(x + i +  4));
+		__m256d x2 = _mm256_andnot_pd(sign, _mm256_loadu_pd(x + i +  8));
+		__m256d x3 = _mm256_andnot_pd(sign, _mm256_loadu_pd(x + i + 12));
+		__m256d hi = _mm256_max_pd(_mm256_max_pd(x0, x1), _mm256_max_pd(x2, x3));
+		__m256d lo = _mm256_min_pd(_mm256_min_pd(x0, x1), _mm256_min_pd(x2, x3));
+
+		/* NaNs may slip past this test, but they end up in med
+		   either way */
+		if (_mm256_movemask_pd(_mm256_or_pd(_mm256_cmp_pd(hi, tbig, _CMP_GT_OQ),
+						    _mm256_cmp_pd(lo, tsml, _CMP_LT_OQ))) == 0) {
+			med0 = _mm256_add_pd(med0, _mm256_mul_pd(x0, x0));
+			med1 = _mm256_add_pd(med1, _mm256_mul_pd(x1, x1));
+			med2 = _mm256_add_pd(med2, _mm256_mul_pd(x2, x2));
+			med3 = _mm256_add_pd(med3, _mm256_mul_pd(x3, x3));
+		} else {
+			NRM2_SPLIT(x0, big, med0, sml);
+			NRM2_SPLIT(x1, big, med1, sml);
+			NRM2_SPLIT(x2, big, med2, sml);
+			NRM2_SPLIT(x3, big, med3, sml);
+		}
+	}
+
+	med0 = _mm256_add_pd(_mm256_add_pd(med0, med1), _mm256_add_pd(med2, med3));
+
+	acc[0] += nrm2_hsum(big);
+	acc[1] += nrm2_hsum(med0);
+	acc[2] += nrm2_hsum(sml);
+}
+
+#undef NRM2_SPLIT
+
+#endif
@@ -0,0 +1,79 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* need a new enough GCC for avx512 support */
+#if (( defined(__GNUC__)  && __GNUC__   > 6 && defined(__AVX512CD__)) || (defined(__clang__) && __clang_major__ >= 9 && defined(__AVX512CD__)))
+
+#define HAVE_KERNEL_16 1
+
+#include <immintrin.h>
+
+#define NRM2_SPLIT(v, big, med, sml) {						\
+	__mmask8 isbig = _mm512_cmp_pd_mask(v, tbig, _CMP_GT_OQ);		\
+	__mmask8 issml = _mm512_cmp_pd_mask(v, tsml, _CMP_LT_OQ);		\
+	__m512d b = _mm512_mul_pd(v, sbig), s = _mm512_mul_pd(v, ssml);		\
+	big = _mm512_mask_add_pd(big, isbig, big, _mm512_mul_pd(b, b));		\
+	sml = _mm512_mask_add_pd(sml, issml, sml, _mm512_mul_pd(s, s));		\
+	med = _mm512_mask_add_pd(med, (__mmask8)~(isbig | issml), med,		\
+				 _mm512_mul_pd(v, v));				\
+}
+
+/* n a multiple of 16 */
+static void nrm2_kernel_16(BLASLONG n, FLOAT *x, double *acc)
+{
+	BLASLONG i;
+	__m512d tsml = _mm512_set1_pd(NRM2_TSML), tbig = _mm512_set1_pd(NRM2_TBIG);
+	__m512d ssml = _mm512_set1_pd(NRM2_SSML), sbig = _mm512_set1_pd(NRM2_SBIG);
+	__m512d big = _mm512_setzero_pd(), sml = _mm512_setzero_pd();
+	__m512d med0 = _mm512_setzero_pd(), med1 = _mm512_setzero_pd();
+
+	for (i = 0; i < n; i += 16) {
+		__m512d x0 = _mm512_abs_pd(_mm512_loadu_pd(x + i + 0));
+		__m512d x1 = _mm512_abs_pd(_mm512_loadu_pd(x + i + 8));
+
+		/* NaNs may slip past this test, but they end up in med
+		   either way */
+		if ((_mm512_cmp_pd_mask(_mm512_max_pd(x0, x1), tbig, _CMP_GT_OQ)
+		     | _mm512_cmp_pd_mask(_mm512_min_pd(x0, x1), tsml, _CMP_LT_OQ)) == 0) {
+			med0 = _mm512_fmadd_pd(x0, x0, med0);
+			med1 = _mm512_fmadd_pd(x1, x1, med1);
+		} else {
+			NRM2_SPLIT(x0, big, med0, sml);
+			NRM2_SPLIT(x1, big, med1, sml);
+		}
+	}
+
+	acc[0] += _mm512_reduce_add_pd(big);
+	acc[1] += _mm512_reduce_add_pd(_mm512_add_pd(med0, med1));
+	acc[2] += _mm512_reduce_add_pd(sml);
+}
+
+#undef NRM2_SPLIT
+
+#else
+#include "dznrm2_microk_haswell-2.c"
+#endif
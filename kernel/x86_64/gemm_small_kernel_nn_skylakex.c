@@ -0,0 +1,161 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+/* need a new enough GCC for avx512 support */
+#if defined(__AVX2__) && (( defined(__GNUC__) && __GNUC__ > 6) || (defined(__clang__) && __clang_major__ >= 6))
+
+#include "gemm_small_kernel_skylakex.h"
+
+/*
+ * Unpacked small matrix kernel for C = alpha * A * op(B) + beta * C, with
+ * op(B) = B, or B**T when B_TRANS is defined (gemm_small_kernel_nt_skylakex.c).
+ * Columns of A are contiguous, so C is computed in blocks of 2 vectors by
+ * 4 columns with broadcast elements of B; row tails are handled with masked
+ * loads and stores instead of a scalar loop.
+ */
+
+#ifndef B_TRANS
+#define B_ELEM(l, j)	B[(l) + (j) * ldb]
+#else
+#define B_ELEM(l, j)	B[(j) + (l) * ldb]
+#endif
+
+#define A_LOAD(v)	V_LOAD(&A[i + (v) * VLEN + l * lda], m##v)
+
+#ifdef B0
+#define C_STORE(acc, v, jj)	V_STORE(&C[i + (v) * VLEN + (jj) * ldc], m##v, valpha * acc)
+#else
+#define C_STORE(acc, v, jj)	V_STORE(&C[i + (v) * VLEN + (jj) * ldc], m##v, \
+				valpha * acc + vbeta * V_LOAD(&C[i + (v) * VLEN + (jj) * ldc], m##v))
+#endif
+
+#ifdef B0
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT *C, BLASLONG ldc)
+#else
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT beta, FLOAT *C, BLASLONG ldc)
+#endif
+{
+	BLASLONG i, j, l;
+	v_float valpha = V_SET1(alpha);
+#ifndef B0
+	v_float vbeta = V_SET1(beta);
+#endif
+	v_float a0, a1, b;
+	v_mask m0, m1;
+
+	for (i = 0; i + VLEN < M; i += 2 * VLEN) {
+		m0 = V_MASK(VLEN);
+		m1 = V_MASK(V_COUNT(M, i + VLEN));
+
+		for (j = 0; j + 4 <= N; j += 4) {
+			v_float c00 = V_ZERO(), c01 = V_ZERO(), c02 = V_ZERO(), c03 = V_ZERO();
+			v_float c10 = V_ZERO(), c11 = V_ZERO(), c12 = V_ZERO(), c13 = V_ZERO();
+
+			for (l = 0; l < K; l++) {
+				a0 = A_LOAD(0);
+				a1 = A_LOAD(1);
+				b = V_SET1(B_ELEM(l, j + 0));
+				c00 += a0 * b;
+				c10 += a1 * b;
+				b = V_SET1(B_ELEM(l, j + 1));
+				c01 += a0 * b;
+				c11 += a1 * b;
+				b = V_SET1(B_ELEM(l, j + 2));
+				c02 += a0 * b;
+				c12 += a1 * b;
+				b = V_SET1(B_ELEM(l, j + 3));
+				c03 += a0 * b;
+				c13 += a1 * b;
+			}
+
+			C_STORE(c00, 0, j + 0);
+			C_STORE(c01, 0, j + 1);
+			C_STORE(c02, 0, j + 2);
+			C_STORE(c03, 0, j + 3);
+			C_STORE(c10, 1, j + 0);
+			C_STORE(c11, 1, j + 1);
+			C_STORE(c12, 1, j + 2);
+			C_STORE(c13, 1, j + 3);
+		}
+
+		for (; j < N; j++) {
+			v_float c00 = V_ZERO(), c10 = V_ZERO();
+
+			for (l = 0; l < K; l++) {
+				b = V_SET1(B_ELEM(l, j));
+				c00 += A_LOAD(0) * b;
+				c10 += A_LOAD(1) * b;
+			}
+
+			C_STORE(c00, 0, j);
+			C_STORE(c10, 1, j);
+		}
+	}
+
+	/* at most one (possibly partial) vector of rows left */
+	if (i < M) {
+		m0 = V_MASK(V_COUNT(M, i));
+
+		for (j = 0; j + 4 <= N; j += 4) {
+			v_float c00 = V_ZERO(), c01 = V_ZERO(), c02 = V_ZERO(), c03 = V_ZERO();
+
+			for (l = 0; l < K; l++) {
+				a0 = A_LOAD(0);
+				c00 += a0 * V_SET1(B_ELEM(l, j + 0));
+				c01 += a0 * V_SET1(B_ELEM(l, j + 1));
+				c02 += a0 * V_SET1(B_ELEM(l, j + 2));
+				c03 += a0 * V_SET1(B_ELEM(l, j + 3));
+			}
+
+			C_STORE(c00, 0, j + 0);
+			C_STORE(c01, 0, j + 1);
+			C_STORE(c02, 0, j + 2);
+			C_STORE(c03, 0, j + 3);
+		}
+
+		for (; j < N; j++) {
+			v_float c00 = V_ZERO();
+
+			for (l = 0; l < K; l++)
+				c00 += A_LOAD(0) * V_SET1(B_ELEM(l, j));
+
+			C_STORE(c00, 0, j);
+		}
+	}
+
+	return 0;
+}
+
+#else
+#ifndef B_TRANS
+#include "../generic/gemm_small_matrix_kernel_nn.c"
+#else
+#include "../generic/gemm_small_matrix_kernel_nt.c"
+#endif
+#endif
@@ -0,0 +1,101 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Vector helpers shared by the gemm_small_kernel_*_skylakex.c kernels.
+   Builds with AVX512 support use 512 bit registers and mask registers,
+   plain AVX2 builds (Haswell, Zen) fall back to 256 bit maskload/maskstore. */
+
+#include <immintrin.h>
+
+#ifdef __AVX512CD__
+
+#ifdef DOUBLE
+#define VLEN 8
+typedef __m512d v_float;
+typedef __mmask8 v_mask;
+#define V_ZERO()		_mm512_setzero_pd()
+#define V_SET1(x)		_mm512_set1_pd(x)
+#define V_MASK(n)		((__mmask8)((1U << (n)) - 1))
+#define V_LOAD(p, m)		_mm512_maskz_loadu_pd(m, p)
+#define V_STORE(p, m, v)	_mm512_mask_storeu_pd(p, m, v)
+#define V_REDUCE(v)		_mm512_reduce_add_pd(v)
+#else
+#define VLEN 16
+typedef __m512 v_float;
+typedef __mmask16 v_mask;
+#define V_ZERO()		_mm512_setzero_ps()
+#define V_SET1(x)		_mm512_set1_ps(x)
+#define V_MASK(n)		((__mmask16)((1U << (n)) - 1))
+#define V_LOAD(p, m)		_mm512_maskz_loadu_ps(m, p)
+#define V_STORE(p, m, v)	_mm512_mask_storeu_ps(p, m, v)
+#define V_REDUCE(v)		_mm512_reduce_add_ps(v)
+#endif
+
+#else
+
+#ifdef DOUBLE
+#define VLEN 4
+typedef __m256d v_float;
+typedef __m256i v_mask;
+#define V_ZERO()		_mm256_setzero_pd()
+#define V_SET1(x)		_mm256_set1_pd(x)
+#define V_MASK(n)		_mm256_cmpgt_epi64(_mm256_set1_epi64x(n), _mm256_set_epi64x(3, 2, 1, 0))
+#define V_LOAD(p, m)		_mm256_maskload_pd(p, m)
+#define V_STORE(p, m, v)	_mm256_maskstore_pd(p, m, v)
+#define V_REDUCE(v)		gemm_small_reduce(v)
+
+static inline double gemm_small_reduce(__m256d v)
+{
+	__m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+	s = _mm_add_sd(s, _mm_unpackhi_pd(s, s));
+	return _mm_cvtsd_f64(s);
+}
+#else
+#define VLEN 8
+typedef __m256 v_float;
+typedef __m256i v_mask;
+#define V_ZERO()		_mm256_setzero_ps()
+#define V_SET1(x)		_mm256_set1_ps(x)
+#define V_MASK(n)		_mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_set_epi32(7, 6, 5, 4, 3, 2, 1, 0))
+#define V_LOAD(p, m)		_mm256_maskload_ps(p, m)
+#define V_STORE(p, m, v)	_mm256_maskstore_ps(p, m, v)
+#define V_REDUCE(v)		gemm_small_reduce(v)
+
+static inline float gemm_small_reduce(__m256 v)
+{
+	__m128 s = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+	s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+	s = _mm_add_ss(s, _mm_movehdup_ps(s));
+	return _mm_cvtss_f32(s);
+}
+#endif
+
+#endif
+
+/* number of valid lanes in the vector starting at offset "off" of a
+   dimension of length "len", clamped to [0, VLEN] */
+#define V_COUNT(len, off)	((len) - (off) >= VLEN ? VLEN : ((len) - (off) > 0 ? (len) - (off) : 0))
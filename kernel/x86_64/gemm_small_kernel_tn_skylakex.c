@@ -0,0 +1,146 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+/* need a new enough GCC for avx512 support */
+#if defined(__AVX2__) && (( defined(__GNUC__) && __GNUC__ > 6) || (defined(__clang__) && __clang_major__ >= 6))
+
+#include "gemm_small_kernel_skylakex.h"
+
+/*
+ * Unpacked small matrix kernel for C = alpha * A**T * B + beta * C.
+ * Both operands are contiguous along K, so every element of C is a dot
+ * product; 4 rows by 2 columns of C are accumulated at once so that each
+ * vector of A and B is reused, and the K tail is loaded with a mask.
+ */
+
+#define A_LOAD(ii)	V_LOAD(&A[l + (i + (ii)) * lda], m)
+#define B_LOAD(jj)	V_LOAD(&B[l + (j + (jj)) * ldb], m)
+
+#ifdef B0
+#define C_STORE(acc, ii, jj)	C[(i + (ii)) + (j + (jj)) * ldc] = alpha * V_REDUCE(acc)
+#else
+#define C_STORE(acc, ii, jj)	C[(i + (ii)) + (j + (jj)) * ldc] = alpha * V_REDUCE(acc) + \
+					beta * C[(i + (ii)) + (j + (jj)) * ldc]
+#endif
+
+#ifdef B0
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT *C, BLASLONG ldc)
+#else
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT beta, FLOAT *C, BLASLONG ldc)
+#endif
+{
+	BLASLONG i, j, l;
+	v_float a0, a1, a2, a3, b0, b1;
+	v_mask m;
+
+	for (j = 0; j + 2 <= N; j += 2) {
+		for (i = 0; i + 4 <= M; i += 4) {
+			v_float c00 = V_ZERO(), c10 = V_ZERO(), c20 = V_ZERO(), c30 = V_ZERO();
+			v_float c01 = V_ZERO(), c11 = V_ZERO(), c21 = V_ZERO(), c31 = V_ZERO();
+
+			for (l = 0; l < K; l += VLEN) {
+				m = V_MASK(V_COUNT(K, l));
+				a0 = A_LOAD(0);
+				a1 = A_LOAD(1);
+				a2 = A_LOAD(2);
+				a3 = A_LOAD(3);
+				b0 = B_LOAD(0);
+				b1 = B_LOAD(1);
+				c00 += a0 * b0;
+				c10 += a1 * b0;
+				c20 += a2 * b0;
+				c30 += a3 * b0;
+				c01 += a0 * b1;
+				c11 += a1 * b1;
+				c21 += a2 * b1;
+				c31 += a3 * b1;
+			}
+
+			C_STORE(c00, 0, 0);
+			C_STORE(c10, 1, 0);
+			C_STORE(c20, 2, 0);
+			C_STORE(c30, 3, 0);
+			C_STORE(c01, 0, 1);
+			C_STORE(c11, 1, 1);
+			C_STORE(c21, 2, 1);
+			C_STORE(c31, 3, 1);
+		}
+
+		for (; i < M; i++) {
+			v_float c00 = V_ZERO(), c01 = V_ZERO();
+
+			for (l = 0; l < K; l += VLEN) {
+				m = V_MASK(V_COUNT(K, l));
+				a0 = A_LOAD(0);
+				c00 += a0 * B_LOAD(0);
+				c01 += a0 * B_LOAD(1);
+			}
+
+			C_STORE(c00, 0, 0);
+			C_STORE(c01, 0, 1);
+		}
+	}
+
+	for (; j < N; j++) {
+		for (i = 0; i + 4 <= M; i += 4) {
+			v_float c00 = V_ZERO(), c10 = V_ZERO(), c20 = V_ZERO(), c30 = V_ZERO();
+
+			for (l = 0; l < K; l += VLEN) {
+				m = V_MASK(V_COUNT(K, l));
+				b0 = B_LOAD(0);
+				c00 += A_LOAD(0) * b0;
+				c10 += A_LOAD(1) * b0;
+				c20 += A_LOAD(2) * b0;
+				c30 += A_LOAD(3) * b0;
+			}
+
+			C_STORE(c00, 0, 0);
+			C_STORE(c10, 1, 0);
+			C_STORE(c20, 2, 0);
+			C_STORE(c30, 3, 0);
+		}
+
+		for (; i < M; i++) {
+			v_float c00 = V_ZERO();
+
+			for (l = 0; l < K; l += VLEN) {
+				m = V_MASK(V_COUNT(K, l));
+				c00 += A_LOAD(0) * B_LOAD(0);
+			}
+
+			C_STORE(c00, 0, 0);
+		}
+	}
+
+	return 0;
+}
+
+#else
+#include "../generic/gemm_small_matrix_kernel_tn.c"
+#endif
@@ -0,0 +1,126 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+/* need a new enough GCC for avx512 support */
+#if defined(__AVX2__) && (( defined(__GNUC__) && __GNUC__ > 6) || (defined(__clang__) && __clang_major__ >= 6))
+
+#include "gemm_small_kernel_skylakex.h"
+
+/*
+ * Unpacked small matrix kernel for C = alpha * A**T * B**T + beta * C.
+ * Rows of B**T are contiguous, so rows of C are computed in blocks of
+ * 4 rows by 2 vectors with broadcast elements of A. Rows of C are strided
+ * by ldc, so each result vector goes through a small buffer and is
+ * written back element by element.
+ */
+
+#define B_LOAD(v)	V_LOAD(&B[j + (v) * VLEN + l * ldb], m##v)
+#define A_ELEM(ii)	V_SET1(A[l + (i + (ii)) * lda])
+
+#ifdef B0
+#define C_UPDATE(ii, jj)	C[(i + (ii)) + (j + (jj)) * ldc] = buf[jj]
+#else
+#define C_UPDATE(ii, jj)	C[(i + (ii)) + (j + (jj)) * ldc] = buf[jj] + beta * C[(i + (ii)) + (j + (jj)) * ldc]
+#endif
+
+#define C_STORE(acc, ii, v) { \
+	V_STORE(buf + (v) * VLEN, m##v, valpha * acc); \
+	for (jj = (v) * VLEN; jj < (v) * VLEN + n##v; jj++) \
+		C_UPDATE(ii, jj); \
+}
+
+#ifdef B0
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT *C, BLASLONG ldc)
+#else
+int CNAME(BLASLONG M, BLASLONG N, BLASLONG K, FLOAT *A, BLASLONG lda, FLOAT alpha, FLOAT *B, BLASLONG ldb, FLOAT beta, FLOAT *C, BLASLONG ldc)
+#endif
+{
+	BLASLONG i, j, l, jj, n0, n1;
+	FLOAT buf[2 * VLEN];
+	v_float valpha = V_SET1(alpha);
+	v_float b0, b1, a;
+	v_mask m0, m1;
+
+	for (j = 0; j < N; j += 2 * VLEN) {
+		n0 = V_COUNT(N, j);
+		n1 = V_COUNT(N, j + VLEN);
+		m0 = V_MASK(n0);
+		m1 = V_MASK(n1);
+
+		for (i = 0; i + 4 <= M; i += 4) {
+			v_float c00 = V_ZERO(), c10 = V_ZERO(), c20 = V_ZERO(), c30 = V_ZERO();
+			v_float c01 = V_ZERO(), c11 = V_ZERO(), c21 = V_ZERO(), c31 = V_ZERO();
+
+			for (l = 0; l < K; l++) {
+				b0 = B_LOAD(0);
+				b1 = B_LOAD(1);
+				a = A_ELEM(0);
+				c00 += a * b0;
+				c01 += a * b1;
+				a = A_ELEM(1);
+				c10 += a * b0;
+				c11 += a * b1;
+				a = A_ELEM(2);
+				c20 += a * b0;
+				c21 += a * b1;
+				a = A_ELEM(3);
+				c30 += a * b0;
+				c31 += a * b1;
+			}
+
+			C_STORE(c00, 0, 0);
+			C_STORE(c01, 0, 1);
+			C_STORE(c10, 1, 0);
+			C_STORE(c11, 1, 1);
+			C_STORE(c20, 2, 0);
+			C_STORE(c21, 2, 1);
+			C_STORE(c30, 3, 0);
+			C_STORE(c31, 3, 1);
+		}
+
+		for (; i < M; i++) {
+			v_float c00 = V_ZERO(), c01 = V_ZERO();
+
+			for (l = 0; l < K; l++) {
+				a = A_ELEM(0);
+				c00 += a * B_LOAD(0);
+				c01 += a * B_LOAD(1);
+			}
+
+			C_STORE(c00, 0, 0);
+			C_STORE(c01, 0, 1);
+		}
+	}
+
+	return 0;
+}
+
+#else
+#include "../generic/gemm_small_matrix_kernel_tt.c"
+#endif
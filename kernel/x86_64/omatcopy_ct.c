@@ -0,0 +1,119 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+#if defined(SKYLAKEX)
+#include "omatcopy_microk_skylakex-2.c"
+#elif defined(HASWELL) || defined(ZEN)
+#include "omatcopy_microk_haswell-2.c"
+#endif
+
+/*****************************************************
+ * Order ColMajor, Trans: b = alpha * a^T
+ * Built with ROWM this is the RowMajor Trans kernel,
+ * which is the same operation on the swapped shape.
+ *
+ * Both dimensions are halved recursively until a block
+ * of source and destination fits in L1, the blocks are
+ * then transposed in TILE x TILE register tiles.
+******************************************************/
+
+#ifndef HAVE_KERNEL_TILE
+#define TILE 1
+
+static void omatcopy_kernel_tile(FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT alpha)
+{
+	*b = alpha * *a;
+}
+#endif
+
+#define BLOCK (256 / (BLASLONG)sizeof(FLOAT))
+
+static void transpose_tail(BLASLONG rows, BLASLONG cols, FLOAT alpha, FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb)
+{
+	BLASLONG i, j;
+
+	for (j = 0; j < cols; j++)
+		for (i = 0; i < rows; i++)
+			b[j + i * ldb] = alpha * a[i + j * lda];
+}
+
+static void transpose_block(BLASLONG rows, BLASLONG cols, FLOAT alpha, FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb)
+{
+	BLASLONG i, j, h;
+
+	if (rows > BLOCK && rows >= cols) {
+		h = (rows / 2 + TILE - 1) & ~(TILE - 1);
+		transpose_block(h, cols, alpha, a, lda, b, ldb);
+		transpose_block(rows - h, cols, alpha, a + h, lda, b + h * ldb, ldb);
+		return;
+	}
+
+	if (cols > BLOCK) {
+		h = (cols / 2 + TILE - 1) & ~(TILE - 1);
+		transpose_block(rows, h, alpha, a, lda, b, ldb);
+		transpose_block(rows, cols - h, alpha, a + h * lda, lda, b + h, ldb);
+		return;
+	}
+
+	for (j = 0; j + TILE <= cols; j += TILE) {
+		for (i = 0; i + TILE <= rows; i += TILE)
+			omatcopy_kernel_tile(a + i + j * lda, lda, b + j + i * ldb, ldb, alpha);
+		if (i < rows)
+			transpose_tail(rows - i, TILE, alpha, a + i + j * lda, lda, b + j + i * ldb, ldb);
+	}
+
+	if (j < cols)
+		transpose_tail(rows, cols - j, alpha, a + j * lda, lda, b + j, ldb);
+}
+
+int CNAME(BLASLONG rows, BLASLONG cols, FLOAT alpha, FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb)
+{
+	BLASLONG i, j;
+
+#ifdef ROWM
+	BLASLONG t = rows;
+	rows = cols;
+	cols = t;
+#endif
+
+	if ( rows <= 0     )  return(0);
+	if ( cols <= 0     )  return(0);
+
+	if ( alpha == 0.0 )
+	{
+		for ( i=0; i<rows ; i++ )
+			for ( j=0; j<cols ; j++ )
+				b[j + i * ldb] = 0.0;
+		return(0);
+	}
+
+	transpose_block(rows, cols, alpha, a, lda, b, ldb);
+
+	return(0);
+}
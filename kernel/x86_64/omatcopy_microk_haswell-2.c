@@ -0,0 +1,95 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#if (( defined(__GNUC__)  && __GNUC__   > 6 && defined(__AVX2__)) || (defined(__clang__) && __clang_major__ >= 6))
+
+#include <immintrin.h>
+
+#define HAVE_KERNEL_TILE 1
+
+/* b[k * ldb + c] = alpha * a[k + c * lda] for one TILE x TILE block,
+   the columns of a are loaded as vectors and transposed in registers */
+
+#ifdef DOUBLE
+
+#define TILE 4
+
+static void omatcopy_kernel_tile(FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT alpha)
+{
+	__m256d va = _mm256_set1_pd(alpha);
+	__m256d r0, r1, r2, r3, t0, t1, t2, t3;
+
+	r0 = _mm256_loadu_pd(a          );
+	r1 = _mm256_loadu_pd(a +     lda);
+	r2 = _mm256_loadu_pd(a + 2 * lda);
+	r3 = _mm256_loadu_pd(a + 3 * lda);
+
+	t0 = _mm256_unpacklo_pd(r0, r1);
+	t1 = _mm256_unpackhi_pd(r0, r1);
+	t2 = _mm256_unpacklo_pd(r2, r3);
+	t3 = _mm256_unpackhi_pd(r2, r3);
+
+	_mm256_storeu_pd(b          , _mm256_mul_pd(va, _mm256_permute2f128_pd(t0, t2, 0x20)));
+	_mm256_storeu_pd(b +     ldb, _mm256_mul_pd(va, _mm256_permute2f128_pd(t1, t3, 0x20)));
+	_mm256_storeu_pd(b + 2 * ldb, _mm256_mul_pd(va, _mm256_permute2f128_pd(t0, t2, 0x31)));
+	_mm256_storeu_pd(b + 3 * ldb, _mm256_mul_pd(va, _mm256_permute2f128_pd(t1, t3, 0x31)));
+}
+
+#else
+
+#define TILE 8
+
+static void omatcopy_kernel_tile(FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT alpha)
+{
+	__m256 va = _mm256_set1_ps(alpha);
+	__m256 r[8], t[8], s[8];
+	int i;
+
+	for (i = 0; i < 8; i++)
+		r[i] = _mm256_loadu_ps(a + i * lda);
+
+	for (i = 0; i < 8; i += 2) {
+		t[i    ] = _mm256_unpacklo_ps(r[i], r[i + 1]);
+		t[i + 1] = _mm256_unpackhi_ps(r[i], r[i + 1]);
+	}
+
+	for (i = 0; i < 8; i += 4) {
+		s[i    ] = _mm256_shuffle_ps(t[i    ], t[i + 2], 0x44);
+		s[i + 1] = _mm256_shuffle_ps(t[i    ], t[i + 2], 0xee);
+		s[i + 2] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+		s[i + 3] = _mm256_shuffle_ps(t[i + 1], t[i + 3], 0xee);
+	}
+
+	for (i = 0; i < 4; i++) {
+		_mm256_storeu_ps(b +  i      * ldb, _mm256_mul_ps(va, _mm256_permute2f128_ps(s[i], s[i + 4], 0x20)));
+		_mm256_storeu_ps(b + (i + 4) * ldb, _mm256_mul_ps(va, _mm256_permute2f128_ps(s[i], s[i + 4], 0x31)));
+	}
+}
+
+#endif
+
+#endif
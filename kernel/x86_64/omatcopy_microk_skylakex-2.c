@@ -0,0 +1,117 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* need a new enough GCC for avx512 support */
+#if (( defined(__GNUC__)  && __GNUC__   > 6 && defined(__AVX512CD__)) || (defined(__clang__) && __clang_major__ >= 9))
+
+#include <immintrin.h>
+
+#define HAVE_KERNEL_TILE 1
+
+/* b[k * ldb + c] = alpha * a[k + c * lda] for one TILE x TILE block,
+   the columns of a are loaded as vectors and transposed in registers */
+
+#ifdef DOUBLE
+
+#define TILE 8
+
+static void omatcopy_kernel_tile(FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT alpha)
+{
+	__m512d va = _mm512_set1_pd(alpha);
+	__m512d r[8], t[8], u[8];
+	int i;
+
+	for (i = 0; i < 8; i++)
+		r[i] = _mm512_loadu_pd(a + i * lda);
+
+	for (i = 0; i < 8; i += 2) {
+		t[i    ] = _mm512_unpacklo_pd(r[i], r[i + 1]);
+		t[i + 1] = _mm512_unpackhi_pd(r[i], r[i + 1]);
+	}
+
+	/* u[q] holds columns q and q + 4 of rows 0 .. 3, u[q + 4] those of rows 4 .. 7 */
+	for (i = 0; i < 8; i += 4) {
+		u[i    ] = _mm512_shuffle_f64x2(t[i    ], t[i + 2], 0x88);
+		u[i + 1] = _mm512_shuffle_f64x2(t[i + 1], t[i + 3], 0x88);
+		u[i + 2] = _mm512_shuffle_f64x2(t[i    ], t[i + 2], 0xdd);
+		u[i + 3] = _mm512_shuffle_f64x2(t[i + 1], t[i + 3], 0xdd);
+	}
+
+	for (i = 0; i < 4; i++) {
+		_mm512_storeu_pd(b +  i      * ldb, _mm512_mul_pd(va, _mm512_shuffle_f64x2(u[i], u[i + 4], 0x88)));
+		_mm512_storeu_pd(b + (i + 4) * ldb, _mm512_mul_pd(va, _mm512_shuffle_f64x2(u[i], u[i + 4], 0xdd)));
+	}
+}
+
+#else
+
+#define TILE 16
+
+static void omatcopy_kernel_tile(FLOAT *a, BLASLONG lda, FLOAT *b, BLASLONG ldb, FLOAT alpha)
+{
+	__m512 va = _mm512_set1_ps(alpha);
+	__m512 r[16], t[16];
+	int i;
+
+	for (i = 0; i < 16; i++)
+		r[i] = _mm512_loadu_ps(a + i * lda);
+
+	for (i = 0; i < 16; i += 2) {
+		t[i    ] = _mm512_unpacklo_ps(r[i], r[i + 1]);
+		t[i + 1] = _mm512_unpackhi_ps(r[i], r[i + 1]);
+	}
+
+	/* r[4 * g + q] holds columns q, q + 4, q + 8, q + 12 of rows 4g .. 4g + 3 */
+	for (i = 0; i < 16; i += 4) {
+		r[i    ] = _mm512_shuffle_ps(t[i    ], t[i + 2], 0x44);
+		r[i + 1] = _mm512_shuffle_ps(t[i    ], t[i + 2], 0xee);
+		r[i + 2] = _mm512_shuffle_ps(t[i + 1], t[i + 3], 0x44);
+		r[i + 3] = _mm512_shuffle_ps(t[i + 1], t[i + 3], 0xee);
+	}
+
+	for (i = 0; i < 4; i++) {
+		t[i     ] = _mm512_shuffle_f32x4(r[i    ], r[i +  4], 0x88);
+		t[i +  4] = _mm512_shuffle_f32x4(r[i    ], r[i +  4], 0xdd);
+		t[i +  8] = _mm512_shuffle_f32x4(r[i + 8], r[i + 12], 0x88);
+		t[i + 12] = _mm512_shuffle_f32x4(r[i + 8], r[i + 12], 0xdd);
+	}
+
+	for (i = 0; i < 4; i++) {
+		_mm512_storeu_ps(b + (i     ) * ldb, _mm512_mul_ps(va, _mm512_shuffle_f32x4(t[i    ], t[i +  8], 0x88)));
+		_mm512_storeu_ps(b + (i +  8) * ldb, _mm512_mul_ps(va, _mm512_shuffle_f32x4(t[i    ], t[i +  8], 0xdd)));
+		_mm512_storeu_ps(b + (i +  4) * ldb, _mm512_mul_ps(va, _mm512_shuffle_f32x4(t[i + 4], t[i + 12], 0x88)));
+		_mm512_storeu_ps(b + (i + 12) * ldb, _mm512_mul_ps(va, _mm512_shuffle_f32x4(t[i + 4], t[i + 12], 0xdd)));
+	}
+}
+
+#endif
+
+#else
+
+#include "omatcopy_microk_haswell-2.c"
+
+#endif
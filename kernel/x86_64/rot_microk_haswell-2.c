@@ -0,0 +1,164 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* x = h[0] * x + h[1] * y and y = h[2] * x + h[3] * y, n a multiple of 16 */
+#define HAVE_KERNEL_16 1
+static void rot_kernel_16( BLASLONG n, FLOAT *x, FLOAT *y, FLOAT *h) __attribute__ ((noinline));
+
+#if defined(DOUBLE)
+
+static void rot_kernel_16( BLASLONG n, FLOAT *x, FLOAT *y, FLOAT *h)
+{
+
+	BLASLONG register i = 0;
+
+	__asm__  __volatile__
+	(
+	"vbroadcastsd		  (%4), %%ymm0		    \n\t"  // h11
+	"vbroadcastsd		 8(%4), %%ymm1		    \n\t"  // h12
+	"vbroadcastsd		16(%4), %%ymm2		    \n\t"  // h21
+	"vbroadcastsd		24(%4), %%ymm3		    \n\t"  // h22
+
+	".p2align 4				            \n\t"
+	"1:				            \n\t"
+
+	"vmovups                  (%2,%0,8), %%ymm4          \n\t"  // 4 * x
+	"vmovups                32(%2,%0,8), %%ymm5          \n\t"  // 4 * x
+	"vmovups                64(%2,%0,8), %%ymm6          \n\t"  // 4 * x
+	"vmovups                96(%2,%0,8), %%ymm7          \n\t"  // 4 * x
+	"vmovups                  (%3,%0,8), %%ymm8          \n\t"  // 4 * y
+	"vmovups                32(%3,%0,8), %%ymm9          \n\t"  // 4 * y
+	"vmovups                64(%3,%0,8), %%ymm10         \n\t"  // 4 * y
+	"vmovups                96(%3,%0,8), %%ymm11         \n\t"  // 4 * y
+
+	"vmulpd		%%ymm1 , %%ymm8 , %%ymm12	     \n\t"   // h12 * y
+	"vmulpd		%%ymm1 , %%ymm9 , %%ymm13	     \n\t"
+	"vmulpd		%%ymm1 , %%ymm10, %%ymm14	     \n\t"
+	"vmulpd		%%ymm1 , %%ymm11, %%ymm15	     \n\t"
+	"vmulpd		%%ymm3 , %%ymm8 , %%ymm8 	     \n\t"   // h22 * y
+	"vmulpd		%%ymm3 , %%ymm9 , %%ymm9 	     \n\t"
+	"vmulpd		%%ymm3 , %%ymm10, %%ymm10	     \n\t"
+	"vmulpd		%%ymm3 , %%ymm11, %%ymm11	     \n\t"
+	"vfmadd231pd	%%ymm0 , %%ymm4 , %%ymm12	     \n\t"   // += h11 * x
+	"vfmadd231pd	%%ymm0 , %%ymm5 , %%ymm13	     \n\t"
+	"vfmadd231pd	%%ymm0 , %%ymm6 , %%ymm14	     \n\t"
+	"vfmadd231pd	%%ymm0 , %%ymm7 , %%ymm15	     \n\t"
+	"vfmadd231pd	%%ymm2 , %%ymm4 , %%ymm8 	     \n\t"   // += h21 * x
+	"vfmadd231pd	%%ymm2 , %%ymm5 , %%ymm9 	     \n\t"
+	"vfmadd231pd	%%ymm2 , %%ymm6 , %%ymm10	     \n\t"
+	"vfmadd231pd	%%ymm2 , %%ymm7 , %%ymm11	     \n\t"
+
+	"vmovups	%%ymm12,   (%2,%0,8)		     \n\t"
+	"vmovups	%%ymm13, 32(%2,%0,8)		     \n\t"
+	"vmovups	%%ymm14, 64(%2,%0,8)		     \n\t"
+	"vmovups	%%ymm15, 96(%2,%0,8)		     \n\t"
+	"vmovups	%%ymm8 ,   (%3,%0,8)		     \n\t"
+	"vmovups	%%ymm9 , 32(%3,%0,8)		     \n\t"
+	"vmovups	%%ymm10, 64(%3,%0,8)		     \n\t"
+	"vmovups	%%ymm11, 96(%3,%0,8)		     \n\t"
+
+	"addq		$16, %0	  	 	             \n\t"
+	"subq	        $16, %1			             \n\t"
+	"jnz		1b		             \n\t"
+	"vzeroupper				     \n\t"
+
+	:
+	  "+r" (i),	// 0
+	  "+r" (n)  	// 1
+	:
+	  "r" (x),      // 2
+	  "r" (y),      // 3
+	  "r" (h)       // 4
+	: "cc",
+	  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+	  "%xmm4", "%xmm5", "%xmm6", "%xmm7",
+	  "%xmm8", "%xmm9", "%xmm10", "%xmm11",
+	  "%xmm12", "%xmm13", "%xmm14", "%xmm15",
+	  "memory"
+	);
+
+}
+
+#else
+
+static void rot_kernel_16( BLASLONG n, FLOAT *x, FLOAT *y, FLOAT *h)
+{
+
+	BLASLONG register i = 0;
+
+	__asm__  __volatile__
+	(
+	"vbroadcastss		  (%4), %%ymm0		    \n\t"  // h11
+	"vbroadcastss		 4(%4), %%ymm1		    \n\t"  // h12
+	"vbroadcastss		 8(%4), %%ymm2		    \n\t"  // h21
+	"vbroadcastss		12(%4), %%ymm3		    \n\t"  // h22
+
+	".p2align 4				            \n\t"
+	"1:				            \n\t"
+
+	"vmovups                  (%2,%0,4), %%ymm4          \n\t"  // 8 * x
+	"vmovups                32(%2,%0,4), %%ymm5          \n\t"  // 8 * x
+	"vmovups                  (%3,%0,4), %%ymm8          \n\t"  // 8 * y
+	"vmovups                32(%3,%0,4), %%ymm9          \n\t"  // 8 * y
+
+	"vmulps		%%ymm1 , %%ymm8 , %%ymm12	     \n\t"   // h12 * y
+	"vmulps		%%ymm1 , %%ymm9 , %%ymm13	     \n\t"
+	"vmulps		%%ymm3 , %%ymm8 , %%ymm8 	     \n\t"   // h22 * y
+	"vmulps		%%ymm3 , %%ymm9 , %%ymm9 	     \n\t"
+	"vfmadd231ps	%%ymm0 , %%ymm4 , %%ymm12	     \n\t"   // += h11 * x
+	"vfmadd231ps	%%ymm0 , %%ymm5 , %%ymm13	     \n\t"
+	"vfmadd231ps	%%ymm2 , %%ymm4 , %%ymm8 	     \n\t"   // += h21 * x
+	"vfmadd231ps	%%ymm2 , %%ymm5 , %%ymm9 	     \n\t"
+
+	"vmovups	%%ymm12,   (%2,%0,4)		     \n\t"
+	"vmovups	%%ymm13, 32(%2,%0,4)		     \n\t"
+	"vmovups	%%ymm8 ,   (%3,%0,4)		     \n\t"
+	"vmovups	%%ymm9 , 32(%3,%0,4)		     \n\t"
+
+	"addq		$16, %0	  	 	             \n\t"
+	"subq	        $16, %1			             \n\t"
+	"jnz		1b		             \n\t"
+	"vzeroupper				     \n\t"
+
+	:
+	  "+r" (i),	// 0
+	  "+r" (n)  	// 1
+	:
+	  "r" (x),      // 2
+	  "r" (y),      // 3
+	  "r" (h)       // 4
+	: "cc",
+	  "%xmm0", "%xmm1", "%xmm2", "%xmm3",
+	  "%xmm4", "%xmm5",
+	  "%xmm8", "%xmm9",
+	  "%xmm12", "%xmm13",
+	  "memory"
+	);
+
+}
+
+#endif
@@ -0,0 +1,78 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* need a new enough GCC for avx512 support */
+#if (( defined(__GNUC__)  && __GNUC__   > 6 && defined(__AVX512CD__)) || (defined(__clang__) && __clang_major__ >= 9 && defined(__AVX512CD__)))
+
+#define HAVE_KERNEL_16 1
+
+#include <immintrin.h>
+
+/* x = h[0] * x + h[1] * y and y = h[2] * x + h[3] * y, n a multiple of 16 */
+#if defined(DOUBLE)
+
+static void rot_kernel_16(BLASLONG n, FLOAT *x, FLOAT *y, FLOAT *h)
+{
+	BLASLONG i, j;
+	__m512d h11 = _mm512_set1_pd(h[0]), h12 = _mm512_set1_pd(h[1]);
+	__m512d h21 = _mm512_set1_pd(h[2]), h22 = _mm512_set1_pd(h[3]);
+	__m512d vx[2], vy[2];
+
+	for (i = 0; i < n; i += 16) {
+		for (j = 0; j < 2; j++) {
+			vx[j] = _mm512_loadu_pd(x + i + 8 * j);
+			vy[j] = _mm512_loadu_pd(y + i + 8 * j);
+		}
+		for (j = 0; j < 2; j++) {
+			_mm512_storeu_pd(x + i + 8 * j, _mm512_fmadd_pd(h11, vx[j], _mm512_mul_pd(h12, vy[j])));
+			_mm512_storeu_pd(y + i + 8 * j, _mm512_fmadd_pd(h21, vx[j], _mm512_mul_pd(h22, vy[j])));
+		}
+	}
+}
+
+#else
+
+static void rot_kernel_16(BLASLONG n, FLOAT *x, FLOAT *y, FLOAT *h)
+{
+	BLASLONG i;
+	__m512 h11 = _mm512_set1_ps(h[0]), h12 = _mm512_set1_ps(h[1]);
+	__m512 h21 = _mm512_set1_ps(h[2]), h22 = _mm512_set1_ps(h[3]);
+	__m512 vx, vy;
+
+	for (i = 0; i < n; i += 16) {
+		vx = _mm512_loadu_ps(x + i);
+		vy = _mm512_loadu_ps(y + i);
+		_mm512_storeu_ps(x + i, _mm512_fmadd_ps(h11, vx, _mm512_mul_ps(h12, vy)));
+		_mm512_storeu_ps(y + i, _mm512_fmadd_ps(h21, vx, _mm512_mul_ps(h22, vy)));
+	}
+}
+
+#endif
+
+#else
+#include "rot_microk_haswell-2.c"
+#endif
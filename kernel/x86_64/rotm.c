@@ -0,0 +1,84 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+#if defined(SKYLAKEX)
+#include "rot_microk_skylakex-2.c"
+#elif defined(HASWELL) || defined(ZEN)
+#include "rot_microk_haswell-2.c"
+#endif
+
+static void rot_compute(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y, FLOAT *h)
+{
+	BLASLONG i;
+	FLOAT w, z;
+
+	for (i = 0; i < n; i++) {
+		w = *x;
+		z = *y;
+		*x = h[0] * w + h[1] * z;
+		*y = h[2] * w + h[3] * z;
+		x += inc_x;
+		y += inc_y;
+	}
+}
+
+/* Modified Givens transformation; param holds flag, h11, h21, h12 and
+   h22 as for the reference ?ROTM.  The three flags that carry a matrix
+   are all applied as a full 2 by 2 one, their unit entries being exact
+   multiplications by one. */
+
+int CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y, FLOAT *param)
+{
+	BLASLONG n1 = 0;
+	FLOAT h[4];
+
+	if (n <= 0 || param[0] == -2.0) return 0;
+
+	if (param[0] < 0.0) {
+		h[0] = param[1];  h[1] = param[3];
+		h[2] = param[2];  h[3] = param[4];
+	} else if (param[0] == 0.0) {
+		h[0] = 1.0;       h[1] = param[3];
+		h[2] = param[2];  h[3] = 1.0;
+	} else {
+		h[0] = param[1];  h[1] = 1.0;
+		h[2] = -1.0;      h[3] = param[4];
+	}
+
+#if defined(HAVE_KERNEL_16)
+	if (inc_x == 1 && inc_y == 1) {
+		n1 = n & -16;
+		if (n1 > 0) rot_kernel_16(n1, x, y, h);
+	}
+#endif
+
+	rot_compute(n - n1, x + n1 * inc_x, inc_x, y + n1 * inc_y, inc_y, h);
+
+	return 0;
+}
@@ -0,0 +1,71 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+
+#if defined(SKYLAKEX)
+#include "rotseq_microk_skylakex-2.c"
+#elif defined(HASWELL) || defined(ZEN)
+#include "rotseq_microk_haswell-2.c"
+#endif
+
+/* Applies the rotations (c[j], s[j]) to the column pairs (j, j+1) of the
+   m by k+1 matrix a, as ?LASR with SIDE = 'R' and PIVOT = 'V', see
+   kernel/generic/rotseq.c.  Full strips of rows go through the vector
+   kernel, the rows left over through the scalar loop below. */
+
+int CNAME(BLASLONG m, BLASLONG k, FLOAT *a, BLASLONG lda, FLOAT *c, FLOAT *s, BLASLONG backward)
+{
+	BLASLONG m1 = 0, i, jj, j;
+	FLOAT cj, sj, t, *x, *y;
+
+	if (m <= 0 || k <= 0) return 0;
+
+#if defined(ROTSEQ_UNROLL)
+	m1 = m & -ROTSEQ_UNROLL;
+	if (m1 > 0) rotseq_kernel(m1, k, a, lda, c, s, backward);
+#endif
+
+	if (m1 == m) return 0;
+
+	for (jj = 0; jj < k; jj++) {
+		j = backward ? k - 1 - jj : jj;
+		cj = c[j];
+		sj = s[j];
+		if (cj == 1.0 && sj == 0.0) continue;
+
+		x = a + j * lda;
+		y = x + lda;
+		for (i = m1; i < m; i++) {
+			t = y[i];
+			y[i] = cj * t - sj * x[i];
+			x[i] = sj * t + cj * x[i];
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,144 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#if (( defined(__GNUC__)  && __GNUC__   > 6 && defined(__AVX2__)) || (defined(__clang__) && __clang_major__ >= 6 && defined(__AVX2__)))
+
+#include <immintrin.h>
+
+/* A strip of 16 (double) or 32 (single) rows goes through the whole
+   wave in registers: the column a rotation leaves behind is carried into
+   the next rotation, so each element is loaded and stored once. */
+
+#if defined(DOUBLE)
+
+#define ROTSEQ_UNROLL	16
+#define ROTSEQ_WIDTH	4
+#define VFLOAT		__m256d
+#define VLOAD		_mm256_loadu_pd
+#define VSTORE		_mm256_storeu_pd
+#define VSET1		_mm256_set1_pd
+#define VMUL		_mm256_mul_pd
+#define VADD		_mm256_add_pd
+#define VSUB		_mm256_sub_pd
+
+#else
+
+#define ROTSEQ_UNROLL	32
+#define ROTSEQ_WIDTH	8
+#define VFLOAT		__m256
+#define VLOAD		_mm256_loadu_ps
+#define VSTORE		_mm256_storeu_ps
+#define VSET1		_mm256_set1_ps
+#define VMUL		_mm256_mul_ps
+#define VADD		_mm256_add_ps
+#define VSUB		_mm256_sub_ps
+
+#endif
+
+#define LOAD4(v, p)	v##0 = VLOAD(p); v##1 = VLOAD(p + ROTSEQ_WIDTH); \
+			v##2 = VLOAD(p + 2 * ROTSEQ_WIDTH); v##3 = VLOAD(p + 3 * ROTSEQ_WIDTH)
+#define STORE4(p, v)	VSTORE(p, v##0); VSTORE(p + ROTSEQ_WIDTH, v##1); \
+			VSTORE(p + 2 * ROTSEQ_WIDTH, v##2); VSTORE(p + 3 * ROTSEQ_WIDTH, v##3)
+
+/* Each strip touches k+1 columns, too many streams for the hardware
+   prefetcher on tall matrices, so the next column is fetched a few
+   strips ahead of use. */
+#define ROTSEQ_PREFETCH	(4 * ROTSEQ_UNROLL)
+
+/* m a multiple of ROTSEQ_UNROLL */
+static void rotseq_kernel(BLASLONG m, BLASLONG k, FLOAT *a, BLASLONG lda, FLOAT *c, FLOAT *s, BLASLONG backward)
+{
+	BLASLONG i, jj, j;
+	VFLOAT vc, vs, carry0, carry1, carry2, carry3, next0, next1, next2, next3;
+	FLOAT *col;
+
+	for (i = 0; i < m; i += ROTSEQ_UNROLL) {
+		col = a + i + (backward ? k * lda : 0);
+		_mm_prefetch((char *)(col + ROTSEQ_PREFETCH), _MM_HINT_T0);
+		_mm_prefetch((char *)(col + ROTSEQ_PREFETCH + ROTSEQ_UNROLL / 2), _MM_HINT_T0);
+		LOAD4(carry, col);
+
+		for (jj = 0; jj < k; jj++) {
+			j = backward ? k - 1 - jj : jj;
+			col = a + i + (backward ? j : j + 1) * lda;
+			_mm_prefetch((char *)(col + ROTSEQ_PREFETCH), _MM_HINT_T0);
+			_mm_prefetch((char *)(col + ROTSEQ_PREFETCH + ROTSEQ_UNROLL / 2), _MM_HINT_T0);
+			LOAD4(next, col);
+
+			if (c[j] == 1.0 && s[j] == 0.0) {
+				/* identity: the carried column is final as it is */
+				col = a + i + (backward ? j + 1 : j) * lda;
+				STORE4(col, carry);
+				carry0 = next0; carry1 = next1; carry2 = next2; carry3 = next3;
+				continue;
+			}
+
+			vc = VSET1(c[j]);
+			vs = VSET1(s[j]);
+			if (!backward) {
+				/* carry is column j, next is column j+1 */
+				col = a + i + j * lda;
+				VSTORE(col,                    VADD(VMUL(vs, next0), VMUL(vc, carry0)));
+				VSTORE(col + ROTSEQ_WIDTH,     VADD(VMUL(vs, next1), VMUL(vc, carry1)));
+				VSTORE(col + 2 * ROTSEQ_WIDTH, VADD(VMUL(vs, next2), VMUL(vc, carry2)));
+				VSTORE(col + 3 * ROTSEQ_WIDTH, VADD(VMUL(vs, next3), VMUL(vc, carry3)));
+				carry0 = VSUB(VMUL(vc, next0), VMUL(vs, carry0));
+				carry1 = VSUB(VMUL(vc, next1), VMUL(vs, carry1));
+				carry2 = VSUB(VMUL(vc, next2), VMUL(vs, carry2));
+				carry3 = VSUB(VMUL(vc, next3), VMUL(vs, carry3));
+			} else {
+				/* carry is column j+1, next is column j */
+				col = a + i + (j + 1) * lda;
+				VSTORE(col,                    VSUB(VMUL(vc, carry0), VMUL(vs, next0)));
+				VSTORE(col + ROTSEQ_WIDTH,     VSUB(VMUL(vc, carry1), VMUL(vs, next1)));
+				VSTORE(col + 2 * ROTSEQ_WIDTH, VSUB(VMUL(vc, carry2), VMUL(vs, next2)));
+				VSTORE(col + 3 * ROTSEQ_WIDTH, VSUB(VMUL(vc, carry3), VMUL(vs, next3)));
+				carry0 = VADD(VMUL(vs, carry0), VMUL(vc, next0));
+				carry1 = VADD(VMUL(vs, carry1), VMUL(vc, next1));
+				carry2 = VADD(VMUL(vs, carry2), VMUL(vc, next2));
+				carry3 = VADD(VMUL(vs, carry3), VMUL(vc, next3));
+			}
+		}
+
+		col = a + i + (backward ? 0 : k * lda);
+		STORE4(col, carry);
+	}
+}
+
+#undef ROTSEQ_WIDTH
+#undef ROTSEQ_PREFETCH
+#undef LOAD4
+#undef STORE4
+#undef VFLOAT
+#undef VLOAD
+#undef VSTORE
+#undef VSET1
+#undef VMUL
+#undef VADD
+#undef VSUB
+
+#endif
@@ -0,0 +1,55 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+#include "bf16_common_skylakex.h"
+
+/* bfloat16 to single precision; exact, the bits are the upper half. */
+
+int CNAME(BLASLONG n, bfloat16 *in, BLASLONG inc_in, float *out, BLASLONG inc_out) {
+
+  BLASLONG i;
+  __mmask16 mask;
+
+  if (n <= 0) return 0;
+
+  if (inc_in == 1 && inc_out == 1) {
+    for (i = 0; i + 32 <= n; i += 32) {
+      _mm512_storeu_ps(out + i,      bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(in + i))));
+      _mm512_storeu_ps(out + i + 16, bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(in + i + 16))));
+    }
+    for (; i < n; i += 16) {
+      mask = (__mmask16)((n - i >= 16) ? 0xffffU : ((1U << (n - i)) - 1));
+      _mm512_mask_storeu_ps(out + i, mask, bf16_cvt_ps(_mm256_maskz_loadu_epi16(mask, in + i)));
+    }
+    return 0;
+  }
+
+  for (i = 0; i < n; i++) out[i * inc_out] = bf16_to_float(in[i * inc_in]);
+
+  return 0;
+}
@@ -0,0 +1,180 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Packing routines for the bfloat16 GEMM kernel (shgemm_kernel_32x8_skylakex.c).
+ *
+ * A block of m (= k of the product) by n (= rows of A or columns of B) is
+ * cut into panels of unroll, then 16 when unroll is 32, then whatever is
+ * left.  Inside a panel of width w, k is stored in pairs: 2*w elements with
+ * the k and k+1 values of each row next to each other, followed by w
+ * plain elements when m is odd.
+ *
+ * ncopy reads element (k, p) at a[k + p * lda], tcopy at a[p + k * lda]. */
+
+#ifndef SHGEMM_COPY_SKYLAKEX_H
+#define SHGEMM_COPY_SKYLAKEX_H
+
+#include "bf16_common_skylakex.h"
+
+static inline BLASLONG shgemm_panel_width(BLASLONG unroll, BLASLONG left) {
+  if (left >= unroll) return unroll;
+  if (unroll == 32 && left >= 16) return 16;
+  return left;
+}
+
+/* Eight columns holding eight k pairs each become eight k pairs of eight
+   columns; a k pair is one 32 bit word, so this is a dword transpose. */
+static inline void shgemm_transpose_8x8(bfloat16 *src, BLASLONG lda, bfloat16 *dst, BLASLONG w) {
+
+  __m256i r0, r1, r2, r3, r4, r5, r6, r7;
+  __m256i t0, t1, t2, t3, t4, t5, t6, t7;
+
+  r0 = _mm256_loadu_si256((__m256i *)(src + 0 * lda));
+  r1 = _mm256_loadu_si256((__m256i *)(src + 1 * lda));
+  r2 = _mm256_loadu_si256((__m256i *)(src + 2 * lda));
+  r3 = _mm256_loadu_si256((__m256i *)(src + 3 * lda));
+  r4 = _mm256_loadu_si256((__m256i *)(src + 4 * lda));
+  r5 = _mm256_loadu_si256((__m256i *)(src + 5 * lda));
+  r6 = _mm256_loadu_si256((__m256i *)(src + 6 * lda));
+  r7 = _mm256_loadu_si256((__m256i *)(src + 7 * lda));
+
+  t0 = _mm256_unpacklo_epi32(r0, r1);
+  t1 = _mm256_unpackhi_epi32(r0, r1);
+  t2 = _mm256_unpacklo_epi32(r2, r3);
+  t3 = _mm256_unpackhi_epi32(r2, r3);
+  t4 = _mm256_unpacklo_epi32(r4, r5);
+  t5 = _mm256_unpackhi_epi32(r4, r5);
+  t6 = _mm256_unpacklo_epi32(r6, r7);
+  t7 = _mm256_unpackhi_epi32(r6, r7);
+
+  r0 = _mm256_unpacklo_epi64(t0, t2);
+  r1 = _mm256_unpackhi_epi64(t0, t2);
+  r2 = _mm256_unpacklo_epi64(t1, t3);
+  r3 = _mm256_unpackhi_epi64(t1, t3);
+  r4 = _mm256_unpacklo_epi64(t4, t6);
+  r5 = _mm256_unpackhi_epi64(t4, t6);
+  r6 = _mm256_unpacklo_epi64(t5, t7);
+  r7 = _mm256_unpackhi_epi64(t5, t7);
+
+  _mm256_storeu_si256((__m256i *)(dst + 0 * 2 * w), _mm256_permute2x128_si256(r0, r4, 0x20));
+  _mm256_storeu_si256((__m256i *)(dst + 1 * 2 * w), _mm256_permute2x128_si256(r1, r5, 0x20));
+  _mm256_storeu_si256((__m256i *)(dst + 2 * 2 * w), _mm256_permute2x128_si256(r2, r6, 0x20));
+  _mm256_storeu_si256((__m256i *)(dst + 3 * 2 * w), _mm256_permute2x128_si256(r3, r7, 0x20));
+  _mm256_storeu_si256((__m256i *)(dst + 4 * 2 * w), _mm256_permute2x128_si256(r0, r4, 0x31));
+  _mm256_storeu_si256((__m256i *)(dst + 5 * 2 * w), _mm256_permute2x128_si256(r1, r5, 0x31));
+  _mm256_storeu_si256((__m256i *)(dst + 6 * 2 * w), _mm256_permute2x128_si256(r2, r6, 0x31));
+  _mm256_storeu_si256((__m256i *)(dst + 7 * 2 * w), _mm256_permute2x128_si256(r3, r7, 0x31));
+}
+
+static inline void shgemm_ncopy_panels(BLASLONG unroll, BLASLONG m, BLASLONG n,
+                                bfloat16 *a, BLASLONG lda, bfloat16 *b) {
+
+  BLASLONG i, g, p, kp, np, w;
+  bfloat16 *ao;
+
+  np = m >> 1;
+
+  for (p = 0; p < n; p += w) {
+    w = shgemm_panel_width(unroll, n - p);
+    ao = a + p * lda;
+
+    kp = 0;
+    if ((w & 7) == 0) {
+      for (; kp + 8 <= np; kp += 8)
+        for (g = 0; g < w; g += 8)
+          shgemm_transpose_8x8(ao + 2 * kp + g * lda, lda, b + 2 * (kp * w + g), w);
+    }
+
+    for (; kp < np; kp++) {
+      for (i = 0; i < w; i++) {
+        b[2 * (kp * w + i) + 0] = ao[2 * kp + 0 + i * lda];
+        b[2 * (kp * w + i) + 1] = ao[2 * kp + 1 + i * lda];
+      }
+    }
+    b += 2 * np * w;
+
+    if (m & 1) {
+      for (i = 0; i < w; i++) b[i] = ao[m - 1 + i * lda];
+      b += w;
+    }
+  }
+}
+
+static inline void shgemm_tcopy_panels(BLASLONG unroll, BLASLONG m, BLASLONG n,
+                                bfloat16 *a, BLASLONG lda, bfloat16 *b) {
+
+  static const short idx_lo[32] = { 0, 32,  1, 33,  2, 34,  3, 35,  4, 36,  5, 37,  6, 38,  7, 39,
+                                    8, 40,  9, 41, 10, 42, 11, 43, 12, 44, 13, 45, 14, 46, 15, 47 };
+  static const short idx_hi[32] = {16, 48, 17, 49, 18, 50, 19, 51, 20, 52, 21, 53, 22, 54, 23, 55,
+                                   24, 56, 25, 57, 26, 58, 27, 59, 28, 60, 29, 61, 30, 62, 31, 63 };
+  __m512i vlo = _mm512_loadu_si512(idx_lo);
+  __m512i vhi = _mm512_loadu_si512(idx_hi);
+  __m512i v0, v1;
+  __m128i x0, x1;
+  BLASLONG i, k, p, w;
+  bfloat16 *ao, *r0, *r1;
+
+  for (p = 0; p < n; p += w) {
+    w = shgemm_panel_width(unroll, n - p);
+    ao = a + p;
+
+    for (k = 0; k + 1 < m; k += 2) {
+      r0 = ao + k * lda;
+      r1 = r0 + lda;
+
+      if (w == 32) {
+        v0 = _mm512_loadu_si512(r0);
+        v1 = _mm512_loadu_si512(r1);
+        _mm512_storeu_si512(b,      _mm512_permutex2var_epi16(v0, vlo, v1));
+        _mm512_storeu_si512(b + 32, _mm512_permutex2var_epi16(v0, vhi, v1));
+      } else if (w == 16) {
+        v0 = _mm512_castsi256_si512(_mm256_loadu_si256((__m256i *)r0));
+        v1 = _mm512_castsi256_si512(_mm256_loadu_si256((__m256i *)r1));
+        _mm512_storeu_si512(b, _mm512_permutex2var_epi16(v0, vlo, v1));
+      } else if (w == 8) {
+        x0 = _mm_loadu_si128((__m128i *)r0);
+        x1 = _mm_loadu_si128((__m128i *)r1);
+        _mm_storeu_si128((__m128i *)b,       _mm_unpacklo_epi16(x0, x1));
+        _mm_storeu_si128((__m128i *)(b + 8), _mm_unpackhi_epi16(x0, x1));
+      } else {
+        for (i = 0; i < w; i++) {
+          b[2 * i + 0] = r0[i];
+          b[2 * i + 1] = r1[i];
+        }
+      }
+      b += 2 * w;
+    }
+
+    if (m & 1) {
+      r0 = ao + (m - 1) * lda;
+      for (i = 0; i < w; i++) b[i] = r0[i];
+      b += w;
+    }
+  }
+}
+
+#endif
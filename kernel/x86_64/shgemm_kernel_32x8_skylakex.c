@@ -0,0 +1,66 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+#include "bf16_common_skylakex.h"
+
+/* bfloat16 GEMM kernel, C(float) += alpha * A * B on 32x8 tiles.  The
+ * packing routines (shgemm_{n,t}copy_*_skylakex.c) store k in pairs so that
+ * one 32 bit broadcast of B and one load of A feed vdpbf16ps directly. */
+
+#define MICROK(name)	shgemm_##name##_fma
+#define MICROK_ATTR
+#define DOT2(acc, a, b)	bf16_dot2_ps(acc, a, b)
+#include "shgemm_microk_32x8_skylakex.c"
+#undef MICROK
+#undef MICROK_ATTR
+#undef DOT2
+
+#ifdef BF16_HAVE_DPBF16
+#define MICROK(name)	shgemm_##name##_dpbf16
+#define MICROK_ATTR	BF16_TARGET_DPBF16
+#define DOT2(acc, a, b)	BF16_DPBF16(acc, a, b)
+#include "shgemm_microk_32x8_skylakex.c"
+#undef MICROK
+#undef MICROK_ATTR
+#undef DOT2
+#endif
+
+int CNAME(BLASLONG bm, BLASLONG bn, BLASLONG bk, FLOAT alpha, IFLOAT *ba, IFLOAT *bb, FLOAT *C, BLASLONG ldc) {
+
+  if (bm <= 0 || bn <= 0 || bk <= 0) return 0;
+
+#ifdef BF16_HAVE_DPBF16
+  if (bf16_cpu_has_dpbf16()) {
+    shgemm_kernel_dpbf16(bm, bn, bk, alpha, ba, bb, C, ldc);
+    return 0;
+  }
+#endif
+
+  shgemm_kernel_fma(bm, bn, bk, alpha, ba, bb, C, ldc);
+  return 0;
+}
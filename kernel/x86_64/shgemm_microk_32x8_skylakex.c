@@ -0,0 +1,146 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Body of shgemm_kernel_32x8_skylakex.c.  It is included once per flavour
+ * of the pair dot product, with MICROK(name) giving the function names,
+ * MICROK_ATTR their target attribute and DOT2(acc, a, b) the vdpbf16ps
+ * operation or its emulation.
+ *
+ * Packed panels hold pairs of k for every row (A) or column (B): for a
+ * panel of width w, each k pair takes 2*w elements with the two values of
+ * a row adjacent, and an odd last k takes w plain elements. */
+
+#define STEP(j) \
+  if (NR > j) { \
+    bj = _mm512_set1_epi32(bf16_load_pair(b + 2 * j)); \
+    c0_##j = DOT2(c0_##j, a0, bj); \
+    if (FULL) c1_##j = DOT2(c1_##j, a1, bj); \
+  }
+
+#define TAIL(j) \
+  if (NR > j) { \
+    fb = _mm512_set1_ps(bf16_to_float(b[j])); \
+    c0_##j = _mm512_fmadd_ps(f0, fb, c0_##j); \
+    if (FULL) c1_##j = _mm512_fmadd_ps(f1, fb, c1_##j); \
+  }
+
+#define SAVE(j) \
+  if (NR > j) { \
+    float *cj = c + j * ldc; \
+    if (FULL) { \
+      _mm512_storeu_ps(cj,      _mm512_fmadd_ps(c0_##j, va, _mm512_loadu_ps(cj))); \
+      _mm512_storeu_ps(cj + 16, _mm512_fmadd_ps(c1_##j, va, _mm512_loadu_ps(cj + 16))); \
+    } else { \
+      _mm512_mask_storeu_ps(cj, sm, _mm512_fmadd_ps(c0_##j, va, _mm512_maskz_loadu_ps(sm, cj))); \
+    } \
+  }
+
+/* C(w x NR) += alpha * A * B for one pair of panels; w is 32 when FULL is
+   set and at most 16 otherwise */
+static inline __attribute__((always_inline)) MICROK_ATTR
+void MICROK(tile)(const int NR, const int FULL, BLASLONG w, BLASLONG k, float alpha,
+                  bfloat16 *a, bfloat16 *b, float *c, BLASLONG ldc) {
+
+  __m512 c0_0 = _mm512_setzero_ps(), c1_0 = _mm512_setzero_ps();
+  __m512 c0_1 = _mm512_setzero_ps(), c1_1 = _mm512_setzero_ps();
+  __m512 c0_2 = _mm512_setzero_ps(), c1_2 = _mm512_setzero_ps();
+  __m512 c0_3 = _mm512_setzero_ps(), c1_3 = _mm512_setzero_ps();
+  __m512 c0_4 = _mm512_setzero_ps(), c1_4 = _mm512_setzero_ps();
+  __m512 c0_5 = _mm512_setzero_ps(), c1_5 = _mm512_setzero_ps();
+  __m512 c0_6 = _mm512_setzero_ps(), c1_6 = _mm512_setzero_ps();
+  __m512 c0_7 = _mm512_setzero_ps(), c1_7 = _mm512_setzero_ps();
+  __m512i a0, a1 = _mm512_setzero_si512(), bj;
+  __m512 f0, f1 = _mm512_setzero_ps(), fb, va;
+  __mmask32 lm = (__mmask32)((w >= 16) ? 0xffffffffU : ((1U << (2 * w)) - 1));
+  __mmask16 sm = (__mmask16)((w >= 16) ? 0xffffU : ((1U << w) - 1));
+  BLASLONG l;
+
+  for (l = 0; l < (k >> 1); l++) {
+    if (FULL) {
+      a0 = _mm512_loadu_si512(a);
+      a1 = _mm512_loadu_si512(a + 32);
+      a += 64;
+    } else {
+      a0 = _mm512_maskz_loadu_epi16(lm, a);
+      a += 2 * w;
+    }
+    STEP(0) STEP(1) STEP(2) STEP(3) STEP(4) STEP(5) STEP(6) STEP(7)
+    b += 2 * NR;
+  }
+
+  if (k & 1) {
+    if (FULL) {
+      f0 = bf16_cvt_ps(_mm256_loadu_si256((__m256i *)a));
+      f1 = bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(a + 16)));
+    } else {
+      f0 = bf16_cvt_ps(_mm256_maskz_loadu_epi16(sm, a));
+    }
+    TAIL(0) TAIL(1) TAIL(2) TAIL(3) TAIL(4) TAIL(5) TAIL(6) TAIL(7)
+  }
+
+  va = _mm512_set1_ps(alpha);
+  SAVE(0) SAVE(1) SAVE(2) SAVE(3) SAVE(4) SAVE(5) SAVE(6) SAVE(7)
+}
+
+#define TILE_CASE(NR) \
+  case NR: \
+    if (mr == 32) MICROK(tile)(NR, 1, 32, k, alpha, ap, b, c + i, ldc); \
+    else          MICROK(tile)(NR, 0, mr, k, alpha, ap, b, c + i, ldc); \
+    break;
+
+static MICROK_ATTR void MICROK(kernel)(BLASLONG m, BLASLONG n, BLASLONG k, float alpha,
+                                       bfloat16 *a, bfloat16 *b, float *c, BLASLONG ldc) {
+
+  BLASLONG i, j, mr, nr;
+  bfloat16 *ap;
+
+  for (j = 0; j < n; j += nr) {
+    nr = n - j;
+    if (nr > 8) nr = 8;
+
+    ap = a;
+    for (i = 0; i < m; i += mr) {
+      mr = m - i;
+      if (mr >= 32) mr = 32;
+      else if (mr > 16) mr = 16;
+
+      switch (nr) {
+        TILE_CASE(1) TILE_CASE(2) TILE_CASE(3) TILE_CASE(4)
+        TILE_CASE(5) TILE_CASE(6) TILE_CASE(7) TILE_CASE(8)
+      }
+      ap += mr * k;
+    }
+
+    b += nr * k;
+    c += nr * ldc;
+  }
+}
+
+#undef STEP
+#undef TAIL
+#undef SAVE
+#undef TILE_CASE
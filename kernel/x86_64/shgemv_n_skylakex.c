@@ -0,0 +1,107 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+#include "bf16_common_skylakex.h"
+
+/* y = alpha * A * x + beta * y with A and x in bfloat16, y in single
+ * precision.  Rows are taken in blocks of 128 so that each column of A
+ * feeds eight independent accumulators; the bfloat16 inputs are widened
+ * with a shift, so only half the bytes of an SGEMV are read from A. */
+
+static inline void shgemv_n_update(float *y, BLASLONG incy, __m512 acc, float beta, BLASLONG len) {
+
+  __mmask16 mask = (__mmask16)((len >= 16) ? 0xffffU : ((1U << len) - 1));
+  float t[16];
+  BLASLONG l;
+
+  if (incy == 1) {
+    if (beta != ZERO)
+      acc = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(mask, y), _mm512_set1_ps(beta), acc);
+    _mm512_mask_storeu_ps(y, mask, acc);
+  } else {
+    _mm512_storeu_ps(t, acc);
+    if (len > 16) len = 16;
+    for (l = 0; l < len; l++) {
+      if (beta == ZERO) y[l * incy] = t[l];
+      else y[l * incy] = t[l] + beta * y[l * incy];
+    }
+  }
+}
+
+int CNAME(BLASLONG m, BLASLONG n, float alpha, bfloat16 *a, BLASLONG lda,
+          bfloat16 *x, BLASLONG incx, float beta, float *y, BLASLONG incy) {
+
+  BLASLONG i, j, l, len;
+  bfloat16 *ap;
+  __m512 xj, acc0, acc1, acc2, acc3, acc4, acc5, acc6, acc7;
+  __mmask16 mask;
+
+  if (m <= 0) return 0;
+
+  for (i = 0; i + 128 <= m; i += 128) {
+    acc0 = acc1 = acc2 = acc3 = _mm512_setzero_ps();
+    acc4 = acc5 = acc6 = acc7 = _mm512_setzero_ps();
+
+    for (j = 0; j < n; j++) {
+      xj = _mm512_set1_ps(alpha * bf16_to_float(x[j * incx]));
+      ap = a + i + j * lda;
+      acc0 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap +   0))), xj, acc0);
+      acc1 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap +  16))), xj, acc1);
+      acc2 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap +  32))), xj, acc2);
+      acc3 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap +  48))), xj, acc3);
+      acc4 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap +  64))), xj, acc4);
+      acc5 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap +  80))), xj, acc5);
+      acc6 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap +  96))), xj, acc6);
+      acc7 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_loadu_si256((__m256i *)(ap + 112))), xj, acc7);
+    }
+
+    shgemv_n_update(y + (i +   0) * incy, incy, acc0, beta, 16);
+    shgemv_n_update(y + (i +  16) * incy, incy, acc1, beta, 16);
+    shgemv_n_update(y + (i +  32) * incy, incy, acc2, beta, 16);
+    shgemv_n_update(y + (i +  48) * incy, incy, acc3, beta, 16);
+    shgemv_n_update(y + (i +  64) * incy, incy, acc4, beta, 16);
+    shgemv_n_update(y + (i +  80) * incy, incy, acc5, beta, 16);
+    shgemv_n_update(y + (i +  96) * incy, incy, acc6, beta, 16);
+    shgemv_n_update(y + (i + 112) * incy, incy, acc7, beta, 16);
+  }
+
+  for (l = i; l < m; l += 16) {
+    len = m - l;
+    mask = (__mmask16)((len >= 16) ? 0xffffU : ((1U << len) - 1));
+    acc0 = _mm512_setzero_ps();
+
+    for (j = 0; j < n; j++) {
+      xj = _mm512_set1_ps(alpha * bf16_to_float(x[j * incx]));
+      acc0 = _mm512_fmadd_ps(bf16_cvt_ps(_mm256_maskz_loadu_epi16(mask, a + l + j * lda)), xj, acc0);
+    }
+
+    shgemv_n_update(y + l * incy, incy, acc0, beta, len);
+  }
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Body of shgemv_t_skylakex.c, included once per flavour of the pair dot
+ * product (see shgemm_microk_32x8_skylakex.c).  x must be contiguous.
+ * Pairs of rows are multiplied with pairs of x, four columns at a time
+ * with two accumulators per column. */
+
+static MICROK_ATTR void MICROK(kernel)(BLASLONG m, BLASLONG n, float alpha, bfloat16 *a, BLASLONG lda,
+                                       bfloat16 *x, float beta, float *y, BLASLONG incy) {
+
+  BLASLONG i, j;
+  bfloat16 *a0, *a1, *a2, *a3;
+  __m512i x0, x1;
+  __m512 s0, s1, s2, s3, t0, t1, t2, t3;
+  __mmask32 mask;
+  float r0, r1, r2, r3;
+
+  for (j = 0; j + 4 <= n; j += 4) {
+    a0 = a + j * lda;
+    a1 = a0 + lda;
+    a2 = a1 + lda;
+    a3 = a2 + lda;
+    s0 = s1 = s2 = s3 = _mm512_setzero_ps();
+    t0 = t1 = t2 = t3 = _mm512_setzero_ps();
+
+    for (i = 0; i + 64 <= m; i += 64) {
+      x0 = _mm512_loadu_si512(x + i);
+      x1 = _mm512_loadu_si512(x + i + 32);
+      s0 = DOT2(s0, _mm512_loadu_si512(a0 + i), x0);
+      s1 = DOT2(s1, _mm512_loadu_si512(a1 + i), x0);
+      s2 = DOT2(s2, _mm512_loadu_si512(a2 + i), x0);
+      s3 = DOT2(s3, _mm512_loadu_si512(a3 + i), x0);
+      t0 = DOT2(t0, _mm512_loadu_si512(a0 + i + 32), x1);
+      t1 = DOT2(t1, _mm512_loadu_si512(a1 + i + 32), x1);
+      t2 = DOT2(t2, _mm512_loadu_si512(a2 + i + 32), x1);
+      t3 = DOT2(t3, _mm512_loadu_si512(a3 + i + 32), x1);
+    }
+    for (; i < m; i += 32) {
+      mask = (__mmask32)((m - i >= 32) ? 0xffffffffU : ((1U << (m - i)) - 1));
+      x0 = _mm512_maskz_loadu_epi16(mask, x + i);
+      s0 = DOT2(s0, _mm512_maskz_loadu_epi16(mask, a0 + i), x0);
+      s1 = DOT2(s1, _mm512_maskz_loadu_epi16(mask, a1 + i), x0);
+      s2 = DOT2(s2, _mm512_maskz_loadu_epi16(mask, a2 + i), x0);
+      s3 = DOT2(s3, _mm512_maskz_loadu_epi16(mask, a3 + i), x0);
+    }
+
+    r0 = alpha * _mm512_reduce_add_ps(_mm512_add_ps(s0, t0));
+    r1 = alpha * _mm512_reduce_add_ps(_mm512_add_ps(s1, t1));
+    r2 = alpha * _mm512_reduce_add_ps(_mm512_add_ps(s2, t2));
+    r3 = alpha * _mm512_reduce_add_ps(_mm512_add_ps(s3, t3));
+
+    if (beta == ZERO) {
+      y[(j + 0) * incy] = r0;
+      y[(j + 1) * incy] = r1;
+      y[(j + 2) * incy] = r2;
+      y[(j + 3) * incy] = r3;
+    } else {
+      y[(j + 0) * incy] = r0 + beta * y[(j + 0) * incy];
+      y[(j + 1) * incy] = r1 + beta * y[(j + 1) * incy];
+      y[(j + 2) * incy] = r2 + beta * y[(j + 2) * incy];
+      y[(j + 3) * incy] = r3 + beta * y[(j + 3) * incy];
+    }
+  }
+
+  for (; j < n; j++) {
+    a0 = a + j * lda;
+    s0 = t0 = _mm512_setzero_ps();
+
+    for (i = 0; i + 64 <= m; i += 64) {
+      s0 = DOT2(s0, _mm512_loadu_si512(a0 + i), _mm512_loadu_si512(x + i));
+      t0 = DOT2(t0, _mm512_loadu_si512(a0 + i + 32), _mm512_loadu_si512(x + i + 32));
+    }
+    for (; i < m; i += 32) {
+      mask = (__mmask32)((m - i >= 32) ? 0xffffffffU : ((1U << (m - i)) - 1));
+      s0 = DOT2(s0, _mm512_maskz_loadu_epi16(mask, a0 + i), _mm512_maskz_loadu_epi16(mask, x + i));
+    }
+
+    r0 = alpha * _mm512_reduce_add_ps(_mm512_add_ps(s0, t0));
+    if (beta == ZERO) y[j * incy] = r0;
+    else y[j * incy] = r0 + beta * y[j * incy];
+  }
+}
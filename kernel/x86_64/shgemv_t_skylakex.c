@@ -0,0 +1,79 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+#include "bf16_common_skylakex.h"
+
+/* y = alpha * A**T * x + beta * y with A and x in bfloat16, y in single
+ * precision.  Each column is a dot product of bfloat16 pairs, computed
+ * with vdpbf16ps where the CPU has it. */
+
+#define MICROK(name)	shgemv_t_##name##_fma
+#define MICROK_ATTR
+#define DOT2(acc, a, b)	bf16_dot2_ps(acc, a, b)
+#include "shgemv_t_microk_skylakex.c"
+#undef MICROK
+#undef MICROK_ATTR
+#undef DOT2
+
+#ifdef BF16_HAVE_DPBF16
+#define MICROK(name)	shgemv_t_##name##_dpbf16
+#define MICROK_ATTR	BF16_TARGET_DPBF16
+#define DOT2(acc, a, b)	BF16_DPBF16(acc, a, b)
+#include "shgemv_t_microk_skylakex.c"
+#undef MICROK
+#undef MICROK_ATTR
+#undef DOT2
+#endif
+
+int CNAME(BLASLONG m, BLASLONG n, float alpha, bfloat16 *a, BLASLONG lda,
+          bfloat16 *x, BLASLONG incx, float beta, float *y, BLASLONG incy) {
+
+  BLASLONG i, j;
+  float temp;
+
+  if (incx != 1) {
+    for (j = 0; j < n; j++) {
+      temp = ZERO;
+      for (i = 0; i < m; i++)
+        temp += bf16_to_float(a[i + j * lda]) * bf16_to_float(x[i * incx]);
+      if (beta == ZERO) y[j * incy] = alpha * temp;
+      else y[j * incy] = alpha * temp + beta * y[j * incy];
+    }
+    return 0;
+  }
+
+#ifdef BF16_HAVE_DPBF16
+  if (bf16_cpu_has_dpbf16()) {
+    shgemv_t_kernel_dpbf16(m, n, alpha, a, lda, x, beta, y, incy);
+    return 0;
+  }
+#endif
+
+  shgemv_t_kernel_fma(m, n, alpha, a, lda, x, beta, y, incy);
+  return 0;
+}
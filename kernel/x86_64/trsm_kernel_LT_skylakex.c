@@ -0,0 +1,211 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+#include "trsm_kernel_skylakex_common.h"
+
+static FLOAT dm1 = -1.;
+
+#define GEMM_KERNEL   GEMM_KERNEL_N
+
+/* Forward substitution down the rows of an m x n block; the inverted
+   diagonal of row i is a[i * m + i], the entries below it follow. */
+static inline __attribute__((always_inline)) void solve(BLASLONG m, BLASLONG n, FLOAT *a, FLOAT *b, FLOAT *c, BLASLONG ldc) {
+
+  vec_t x[TRSM_UNROLL_N][NV], aa, bb;
+  __m512i idx = row_index(n);
+  BLASLONG i, j, v;
+
+  SOLVE_UNROLL
+  for (j = 0; j < n; j ++)
+    SOLVE_UNROLL
+    for (v = 0; v < NV; v ++)
+      x[j][v] = VLOAD(row_mask(v, 0, m), c + j * ldc + v * VL);
+
+  SOLVE_UNROLL
+  for (i = 0; i < m; i ++) {
+
+    aa = VSET1(*(a + i));
+
+    SOLVE_UNROLL
+    for (j = 0; j < n; j ++) {
+      bb = VMUL(VLANE(x[j][i / VL], i % VL), aa);
+      x[j][i / VL] = VBLEND(x[j][i / VL], (vmask_t)(1U << (i % VL)), bb);
+
+      SOLVE_UNROLL
+      for (v = i / VL; v < NV; v ++)
+	x[j][v] = VFNMADD(x[j][v], row_mask(v, i + 1, m), bb,
+			  VLOAD(row_mask(v, i + 1, m), a + v * VL));
+    }
+    a += m;
+  }
+
+  SOLVE_UNROLL
+  for (j = 0; j < n; j ++)
+    SOLVE_UNROLL
+    for (v = 0; v < NV; v ++) {
+      VSTORE(c + j * ldc + v * VL, row_mask(v, 0, m), x[j][v]);
+      VSCATTER(b + v * VL * n + j, row_mask(v, 0, m), idx, x[j][v]);
+    }
+}
+
+int CNAME(BLASLONG m, BLASLONG n, BLASLONG k, FLOAT dummy1,
+	   FLOAT *a, FLOAT *b, FLOAT *c, BLASLONG ldc, BLASLONG offset){
+
+  FLOAT *aa, *cc;
+  BLASLONG  kk;
+  BLASLONG i, j, jj;
+
+#if 0
+  fprintf(stderr, "TRSM KERNEL LT : m = %3ld  n = %3ld  k = %3ld offset = %3ld\n",
+	  m, n, k, offset);
+#endif
+
+  /* the tile of solve() is TRSM_UNROLL_M x TRSM_UNROLL_N */
+  if (GEMM_UNROLL_M != TRSM_UNROLL_M || GEMM_UNROLL_N != TRSM_UNROLL_N) return -1;
+
+  jj = 0;
+
+  j = (n >> GEMM_UNROLL_N_SHIFT);
+
+  while (j > 0) {
+
+    kk = offset;
+    aa = a;
+    cc = c;
+
+    i = (m >> GEMM_UNROLL_M_SHIFT);
+
+    while (i > 0) {
+
+	if (kk > 0) {
+	  GEMM_KERNEL(TRSM_UNROLL_M, TRSM_UNROLL_N, kk, dm1,
+		      aa, b, cc, ldc);
+	}
+
+	solve(TRSM_UNROLL_M, TRSM_UNROLL_N,
+	      aa + kk * TRSM_UNROLL_M,
+	      b  + kk * TRSM_UNROLL_N,
+	      cc, ldc);
+
+      aa += TRSM_UNROLL_M * k;
+      cc += TRSM_UNROLL_M    ;
+      kk += TRSM_UNROLL_M;
+      i --;
+    }
+
+    if (m & (TRSM_UNROLL_M - 1)) {
+      i = (TRSM_UNROLL_M >> 1);
+      while (i > 0) {
+	if (m & i) {
+	    if (kk > 0) {
+	      GEMM_KERNEL(i, TRSM_UNROLL_N, kk, dm1,
+			  aa, b, cc, ldc);
+	    }
+	  solve(i, TRSM_UNROLL_N,
+		aa + kk * i            ,
+		b  + kk * TRSM_UNROLL_N,
+		cc, ldc);
+
+	  aa += i * k;
+	  cc += i    ;
+	  kk += i;
+	}
+	i >>= 1;
+      }
+    }
+
+    b += TRSM_UNROLL_N * k  ;
+    c += TRSM_UNROLL_N * ldc;
+    j --;
+    jj += TRSM_UNROLL_M;
+  }
+
+  if (n & (TRSM_UNROLL_N - 1)) {
+
+    j = (TRSM_UNROLL_N >> 1);
+    while (j > 0) {
+      if (n & j) {
+
+	kk = offset;
+	aa = a;
+	cc = c;
+
+	i = (m >> GEMM_UNROLL_M_SHIFT);
+
+	while (i > 0) {
+	  if (kk > 0) {
+	    GEMM_KERNEL(TRSM_UNROLL_M, j, kk, dm1,
+			aa,
+			b,
+			cc,
+			ldc);
+	  }
+
+	  solve(TRSM_UNROLL_M, j,
+		aa + kk * TRSM_UNROLL_M,
+		b  + kk * j            , cc, ldc);
+
+	  aa += TRSM_UNROLL_M * k;
+	  cc += TRSM_UNROLL_M    ;
+	  kk += TRSM_UNROLL_M;
+	  i --;
+	}
+
+	if (m & (TRSM_UNROLL_M - 1)) {
+	  i = (TRSM_UNROLL_M >> 1);
+	  while (i > 0) {
+	    if (m & i) {
+	      if (kk > 0) {
+		GEMM_KERNEL(i, j, kk, dm1,
+			    aa,
+			    b,
+			    cc,
+			    ldc);
+	      }
+
+	      solve(i, j,
+		    aa + kk * i,
+		    b  + kk * j, cc, ldc);
+
+	      aa += i * k;
+	      cc += i    ;
+	      kk += i;
+	      }
+	    i >>= 1;
+	  }
+	}
+
+	b += j * k  ;
+	c += j * ldc;
+      }
+      j >>= 1;
+    }
+  }
+
+  return 0;
+}
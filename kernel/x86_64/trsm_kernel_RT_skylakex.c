@@ -0,0 +1,225 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+#include "common.h"
+#include "trsm_kernel_skylakex_common.h"
+
+static FLOAT dm1 = -1.;
+
+#define GEMM_KERNEL   GEMM_KERNEL_N
+
+/* Backward substitution along the columns of an m x n block, the
+   mirror image of the RN solve. */
+static inline __attribute__((always_inline)) void solve(BLASLONG m, BLASLONG n, FLOAT *a, FLOAT *b, FLOAT *c, BLASLONG ldc) {
+
+  vec_t x[TRSM_UNROLL_N][NV], bb;
+  BLASLONG i, k, v;
+
+  SOLVE_UNROLL
+  for (i = 0; i < n; i ++)
+    SOLVE_UNROLL
+    for (v = 0; v < NV; v ++)
+      x[i][v] = VLOAD(row_mask(v, 0, m), c + i * ldc + v * VL);
+
+  b += (n - 1) * n;
+
+  SOLVE_UNROLL
+  for (i = n - 1; i >= 0; i--) {
+
+    bb = VSET1(*(b + i));
+
+    SOLVE_UNROLL
+    for (v = 0; v < NV; v ++)
+      x[i][v] = VMUL(x[i][v], bb);
+
+    SOLVE_UNROLL
+    for (k = 0; k < i; k ++) {
+      bb = VSET1(*(b + k));
+      SOLVE_UNROLL
+      for (v = 0; v < NV; v ++)
+	x[k][v] = VFNMADD(x[k][v], row_mask(v, 0, m), x[i][v], bb);
+    }
+    b -= n;
+  }
+
+  SOLVE_UNROLL
+  for (i = 0; i < n; i ++)
+    SOLVE_UNROLL
+    for (v = 0; v < NV; v ++) {
+      VSTORE(c + i * ldc + v * VL, row_mask(v, 0, m), x[i][v]);
+      VSTORE(a + i * m   + v * VL, row_mask(v, 0, m), x[i][v]);
+    }
+}
+
+int CNAME(BLASLONG m, BLASLONG n, BLASLONG k,  FLOAT dummy1,
+	   FLOAT *a, FLOAT *b, FLOAT *c, BLASLONG ldc, BLASLONG offset){
+
+  BLASLONG i, j;
+  FLOAT *aa, *cc;
+  BLASLONG  kk;
+
+#if 0
+  fprintf(stderr, "TRSM RT KERNEL m = %3ld  n = %3ld  k = %3ld offset = %3ld\n",
+	  m, n, k, offset);
+#endif
+
+  /* the tile of solve() is TRSM_UNROLL_M x TRSM_UNROLL_N */
+  if (GEMM_UNROLL_M != TRSM_UNROLL_M || GEMM_UNROLL_N != TRSM_UNROLL_N) return -1;
+
+  kk = n - offset;
+  c += n * ldc;
+  b += n * k;
+
+  if (n & (TRSM_UNROLL_N - 1)) {
+
+    j = 1;
+    while (j < TRSM_UNROLL_N) {
+      if (n & j) {
+
+	aa  = a;
+	b -= j * k;
+	c -= j * ldc;
+	cc  = c;
+
+	i = (m >> GEMM_UNROLL_M_SHIFT);
+	if (i > 0) {
+
+	  do {
+	    if (k - kk > 0) {
+	      GEMM_KERNEL(TRSM_UNROLL_M, j, k - kk, dm1,
+			  aa + TRSM_UNROLL_M * kk,
+			  b  +  j            * kk,
+			  cc,
+			  ldc);
+	    }
+
+	    solve(TRSM_UNROLL_M, j,
+		  aa + (kk - j) * TRSM_UNROLL_M,
+		  b  + (kk - j) * j,
+		  cc, ldc);
+
+	    aa += TRSM_UNROLL_M * k;
+	    cc += TRSM_UNROLL_M;
+	    i --;
+	  } while (i > 0);
+	}
+
+	if (m & (TRSM_UNROLL_M - 1)) {
+	  i = (TRSM_UNROLL_M >> 1);
+	  do {
+	    if (m & i) {
+
+	      if (k - kk > 0) {
+		GEMM_KERNEL(i, j, k - kk, dm1,
+			    aa + i * kk,
+			    b  + j * kk,
+			    cc, ldc);
+	      }
+
+	      solve(i, j,
+		    aa + (kk - j) * i,
+		    b  + (kk - j) * j,
+		    cc, ldc);
+
+	      aa += i * k;
+	      cc += i;
+
+	    }
+	    i >>= 1;
+	  } while (i > 0);
+	}
+	kk -= j;
+      }
+      j <<= 1;
+    }
+  }
+
+  j = (n >> GEMM_UNROLL_N_SHIFT);
+
+  if (j > 0) {
+
+    do {
+      aa  = a;
+      b -= TRSM_UNROLL_N * k;
+      c -= TRSM_UNROLL_N * ldc;
+      cc  = c;
+
+      i = (m >> GEMM_UNROLL_M_SHIFT);
+      if (i > 0) {
+	do {
+	  if (k - kk > 0) {
+	    GEMM_KERNEL(TRSM_UNROLL_M, TRSM_UNROLL_N, k - kk, dm1,
+			aa + TRSM_UNROLL_M * kk,
+			b  + TRSM_UNROLL_N * kk,
+			cc,
+			ldc);
+	  }
+
+	  solve(TRSM_UNROLL_M, TRSM_UNROLL_N,
+		aa + (kk - TRSM_UNROLL_N) * TRSM_UNROLL_M,
+		b  + (kk - TRSM_UNROLL_N) * TRSM_UNROLL_N,
+		cc, ldc);
+
+	  aa += TRSM_UNROLL_M * k;
+	  cc += TRSM_UNROLL_M;
+	  i --;
+	} while (i > 0);
+      }
+
+      if (m & (TRSM_UNROLL_M - 1)) {
+	i = (TRSM_UNROLL_M >> 1);
+	do {
+	  if (m & i) {
+	    if (k - kk > 0) {
+	      GEMM_KERNEL(i, TRSM_UNROLL_N, k - kk, dm1,
+			  aa + i             * kk,
+			  b  + TRSM_UNROLL_N * kk,
+			  cc,
+			  ldc);
+	    }
+
+	    solve(i, TRSM_UNROLL_N,
+		  aa + (kk - TRSM_UNROLL_N) * i,
+		  b  + (kk - TRSM_UNROLL_N) * TRSM_UNROLL_N,
+		  cc, ldc);
+
+	    aa += i * k;
+	    cc += i;
+	  }
+	  i >>= 1;
+	} while (i > 0);
+      }
+
+      kk -= TRSM_UNROLL_N;
+      j --;
+    } while (j > 0);
+  }
+
+  return 0;
+}
+
+
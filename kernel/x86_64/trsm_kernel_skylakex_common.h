@@ -0,0 +1,137 @@
+/***************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+1. Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+2. Redistributions in binary form must reproduce the above copyright
+notice, this list of conditions and the following disclaimer in
+the documentation and/or other materials provided with the
+distribution.
+3. Neither the name of the OpenBLAS project nor the names of
+its contributors may be used to endorse or promote products
+derived from this software without specific prior written permission.
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE OPENBLAS PROJECT OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*****************************************************************************/
+
+/* Shared pieces of the AVX-512 TRSM kernels. A packed panel of up to
+   16 rows is held as NV zmm registers per column; rows outside the
+   triangle being eliminated are switched off with lane masks, so the
+   unwritten half of the packed diagonal block is never used. */
+
+#include <immintrin.h>
+
+#if GEMM_DEFAULT_UNROLL_M == 1
+#define GEMM_UNROLL_M_SHIFT 0
+#endif
+
+#if GEMM_DEFAULT_UNROLL_M == 2
+#define GEMM_UNROLL_M_SHIFT 1
+#endif
+
+#if GEMM_DEFAULT_UNROLL_M == 4
+#define GEMM_UNROLL_M_SHIFT 2
+#endif
+
+#if GEMM_DEFAULT_UNROLL_M == 8
+#define GEMM_UNROLL_M_SHIFT 3
+#endif
+
+#if GEMM_DEFAULT_UNROLL_M == 16
+#define GEMM_UNROLL_M_SHIFT 4
+#endif
+
+#if GEMM_DEFAULT_UNROLL_N == 1
+#define GEMM_UNROLL_N_SHIFT 0
+#endif
+
+#if GEMM_DEFAULT_UNROLL_N == 2
+#define GEMM_UNROLL_N_SHIFT 1
+#endif
+
+#if GEMM_DEFAULT_UNROLL_N == 4
+#define GEMM_UNROLL_N_SHIFT 2
+#endif
+
+#if GEMM_DEFAULT_UNROLL_N == 8
+#define GEMM_UNROLL_N_SHIFT 3
+#endif
+
+#if GEMM_DEFAULT_UNROLL_N == 16
+#define GEMM_UNROLL_N_SHIFT 4
+#endif
+
+#if GEMM_DEFAULT_UNROLL_M > 16 || GEMM_DEFAULT_UNROLL_N > 16
+#error "AVX-512 TRSM kernels support unroll factors up to 16"
+#endif
+
+#ifdef DOUBLE
+#define VL			8
+typedef __m512d			vec_t;
+typedef __mmask8		vmask_t;
+#define VLOAD(m, p)		_mm512_maskz_loadu_pd(m, p)
+#define VSTORE(p, m, v)		_mm512_mask_storeu_pd(p, m, v)
+#define VSCATTER(p, m, i, v)	_mm512_mask_i32scatter_pd(p, m, _mm512_castsi512_si256(i), v, 8)
+#define VSET1(x)		_mm512_set1_pd(x)
+#define VMUL(a, b)		_mm512_mul_pd(a, b)
+#define VFNMADD(v, m, a, b)	_mm512_mask3_fnmadd_pd(a, b, v, m)
+#define VBLEND(v, m, a)		_mm512_mask_mov_pd(v, m, a)
+#define VLANE(v, l)		_mm512_permutexvar_pd(_mm512_set1_epi64(l), v)
+#else
+#define VL			16
+typedef __m512			vec_t;
+typedef __mmask16		vmask_t;
+#define VLOAD(m, p)		_mm512_maskz_loadu_ps(m, p)
+#define VSTORE(p, m, v)		_mm512_mask_storeu_ps(p, m, v)
+#define VSCATTER(p, m, i, v)	_mm512_mask_i32scatter_ps(p, m, i, v, 4)
+#define VSET1(x)		_mm512_set1_ps(x)
+#define VMUL(a, b)		_mm512_mul_ps(a, b)
+#define VFNMADD(v, m, a, b)	_mm512_mask3_fnmadd_ps(a, b, v, m)
+#define VBLEND(v, m, a)		_mm512_mask_mov_ps(v, m, a)
+#define VLANE(v, l)		_mm512_permutexvar_ps(_mm512_set1_epi32(l), v)
+#endif
+
+/* The solves keep the whole tile in registers, which only happens when
+   every loop over rows, columns and registers is unrolled completely. */
+#define SOLVE_UNROLL		_Pragma("GCC unroll 16")
+
+/* Shape of the register tile.  With DYNAMIC_ARCH GEMM_UNROLL_M/N are
+   read from the core's table at run time, so the kernels work with the
+   compile-time unroll and check once that the table agrees. */
+#define TRSM_UNROLL_M GEMM_DEFAULT_UNROLL_M
+#define TRSM_UNROLL_N GEMM_DEFAULT_UNROLL_N
+
+/* zmm registers per column of a TRSM_UNROLL_M panel */
+#define NV ((TRSM_UNROLL_M + VL - 1) / VL)
+
+/* Lanes of register v that hold rows lo .. hi - 1 */
+static inline vmask_t row_mask(BLASLONG v, BLASLONG lo, BLASLONG hi) {
+
+  lo -= v * VL;
+  hi -= v * VL;
+
+  if (lo < 0)  lo = 0;
+  if (hi > VL) hi = VL;
+  if (hi <= lo) return 0;
+
+  return (vmask_t)(((1U << hi) - 1) & ~((1U << lo) - 1));
+}
+
+/* Offsets 0, stride, 2 * stride, ... of the first VL rows, for
+   writing a solved column into a row-major packed panel. */
+static inline __m512i row_index(BLASLONG stride) {
+  return _mm512_mullo_epi32(_mm512_set_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+					     7, 6, 5, 4, 3, 2, 1, 0),
+			    _mm512_set1_epi32((int)stride));
+}
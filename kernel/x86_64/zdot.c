@@ -174,12 +174,23 @@ BLASLONG inc_y, FLOAT *result, BLASLONG dummy3)
         zdot_compute(n, x, inc_x, y, inc_y, (void *)result);
         return 0;
 }
+
+static int zdot_leaf_function(BLASLONG n, FLOAT *x, BLASLONG inc_x,
+FLOAT *y, BLASLONG inc_y, double *partial)
+{
+        OPENBLAS_COMPLEX_FLOAT res;
+
+        zdot_compute(n, x, inc_x, y, inc_y, &res);
+        partial[0] = CREAL(res);
+        partial[1] = CIMAG(res);
+        return 0;
+}
 #endif
 
 OPENBLAS_COMPLEX_FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLASLONG inc_y)
 {
 #if defined(SMP)
-	int nthreads;
+	int nthreads, mode;
 	FLOAT dummy_alpha;
 #if defined(C_PGI) || defined(C_SUN)	
 	FLOAT zdotr=0., zdoti=0.;
@@ -200,19 +211,25 @@ OPENBLAS_COMPLEX_FLOAT CNAME(BLASLONG n, FLOAT *x, BLASLONG inc_x, FLOAT *y, BLA
 	else
 		nthreads = num_cpu_avail(1);
 
-	if (nthreads == 1) {
+#if !defined(DOUBLE)
+	mode = BLAS_SINGLE  | BLAS_COMPLEX;
+#else
+	mode = BLAS_DOUBLE  | BLAS_COMPLEX;
+#endif
+
+	if (openblas_get_deterministic()) {
+		double sum[4];
+
+		blas_level1_thread_reduce(mode, n, x, inc_x, y, inc_y, sum,
+				   (void *)zdot_leaf_function, nthreads);
+		zdot = OPENBLAS_MAKE_COMPLEX_FLOAT(sum[0], sum[1]);
+	} else if (nthreads == 1) {
 		zdot_compute(n, x, inc_x, y, inc_y, &zdot);
 	} else {
-		int mode, i;
+		int i;
 		char result[MAX_CPU_NUMBER * sizeof(double) * 2];
 		OPENBLAS_COMPLEX_FLOAT *ptr;
 
-#if !defined(DOUBLE)
-		mode = BLAS_SINGLE  | BLAS_COMPLEX;
-#else
-		mode = BLAS_DOUBLE  | BLAS_COMPLEX;
-#endif
-
 		blas_level1_thread_with_return_value(mode, n, 0, 0, &dummy_alpha,
 				   x, inc_x, y, inc_y, result, 0,
 				   ( void *)zdot_thread_function, nthreads);
@@ -0,0 +1,218 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* QR factorization of an m by n panel (m >= n) that also returns the
+   triangular factor T of its block reflector, as ?GEQRT3.  The panel is
+   split in halves: the left half is factored, its reflector applied to
+   the right half with LARFB, the rest of the right half factored and
+   the two T factors coupled by LARFT_K.  Narrow panels are done a column
+   at a time with GEMV and GER.  args -> d is a workspace of at least
+   n by n. */
+
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include "common.h"
+
+#ifndef GEQRF_PANEL_MIN
+#define GEQRF_PANEL_MIN 8
+#endif
+
+#ifdef DOUBLE
+#define SAFMIN (DBL_MIN / (DBL_EPSILON * 0.5))
+#define BIG    DBL_MAX
+#else
+#define SAFMIN (FLT_MIN / (FLT_EPSILON * 0.5))
+#define BIG    FLT_MAX
+#endif
+
+static FLOAT dp1 =  1.;
+
+static FLOAT lapy2(FLOAT x, FLOAT y) {
+
+  FLOAT w, z;
+
+  if (x != x) return x;
+  if (y != y) return y;
+
+  x = fabs(x);
+  y = fabs(y);
+  w = MAX(x, y);
+  z = MIN(x, y);
+
+  if (z == ZERO || w > BIG) return w;
+
+  return w * sqrt(ONE + (z / w) * (z / w));
+}
+
+/* ?LARFG: H (alpha; x) = (beta; 0) with H = I - tau (1; v) (1; v)' */
+static FLOAT larfg(BLASLONG n, FLOAT *alpha, FLOAT *x) {
+
+  FLOAT xnorm, beta, tau;
+  BLASLONG knt, j;
+
+  if (n <= 1) return ZERO;
+
+  xnorm = NRM2_K(n - 1, x, 1);
+  if (xnorm == ZERO) return ZERO;
+
+  beta = -copysign(lapy2(*alpha, xnorm), *alpha);
+  knt  = 0;
+
+  if (fabs(beta) < SAFMIN) {
+    /* xnorm and beta may be inaccurate, scale x and recompute them */
+    do {
+      knt ++;
+      SCAL_K(n - 1, 0, 0, ONE / SAFMIN, x, 1, NULL, 0, NULL, 0);
+      beta   *= ONE / SAFMIN;
+      *alpha *= ONE / SAFMIN;
+    } while (fabs(beta) < SAFMIN && knt < 20);
+
+    xnorm = NRM2_K(n - 1, x, 1);
+    beta  = -copysign(lapy2(*alpha, xnorm), *alpha);
+  }
+
+  tau = (beta - *alpha) / beta;
+  SCAL_K(n - 1, 0, 0, ONE / (*alpha - beta), x, 1, NULL, 0, NULL, 0);
+
+  for (j = 0; j < knt; j++) beta *= SAFMIN;
+  *alpha = beta;
+
+  return tau;
+}
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG m, n, n1, n2, lda, ldc, ldd, i, j;
+  FLOAT *a, *tau, *t, *w, aii;
+  blas_arg_t newarg;
+
+  m   = args -> m;
+  n   = args -> n;
+  a   = (FLOAT *)args -> a;
+  tau = (FLOAT *)args -> b;
+  t   = (FLOAT *)args -> c;
+  w   = (FLOAT *)args -> d;
+  lda = args -> lda;
+  ldc = args -> ldc;
+  ldd = args -> ldd;
+
+  if (n <= 0) return 0;
+
+  newarg.alpha = NULL;
+  newarg.beta  = NULL;
+#ifdef SMP
+  newarg.nthreads = 1;
+#endif
+
+  if (n <= GEQRF_PANEL_MIN) {
+    for (j = 0; j < n; j++) {
+      tau[j] = larfg(m - j, a + j + j * lda, a + j + 1 + j * lda);
+
+      if (j + 1 < n && tau[j] != ZERO) {
+	/* A(j:m, j+1:n) -= tau v (v' A(j:m, j+1:n)) */
+	aii = a[j + j * lda];
+	a[j + j * lda] = ONE;
+
+	for (i = 0; i < n - j - 1; i++) w[i] = ZERO;
+	GEMV_T(m - j, n - j - 1, 0, dp1, a + j + (j + 1) * lda, lda, a + j + j * lda, 1, w, 1, sb);
+	GERU_K(m - j, n - j - 1, 0, -tau[j], a + j + j * lda, 1, w, 1, a + j + (j + 1) * lda, lda, sb);
+
+	a[j + j * lda] = aii;
+      }
+    }
+
+    newarg.k   = 0;
+    newarg.m   = m;
+    newarg.n   = n;
+    newarg.a   = a;
+    newarg.b   = tau;
+    newarg.c   = t;
+    newarg.lda = lda;
+    newarg.ldc = ldc;
+    LARFT_K(&newarg, NULL, NULL, sa, sb, 0);
+    return 0;
+  }
+
+  n1 = n / 2;
+  n2 = n - n1;
+
+  newarg.m   = m;
+  newarg.n   = n1;
+  newarg.a   = a;
+  newarg.b   = tau;
+  newarg.c   = t;
+  newarg.d   = w;
+  newarg.lda = lda;
+  newarg.ldc = ldc;
+  newarg.ldd = ldd;
+  CNAME(&newarg, NULL, NULL, sa, sb, 0);
+
+  /* A(:, n1:n) = H1' A(:, n1:n) */
+  newarg.m   = m;
+  newarg.n   = n2;
+  newarg.k   = n1;
+  newarg.a   = a;
+  newarg.b   = t;
+  newarg.c   = a + n1 * lda;
+  newarg.d   = w;
+  newarg.lda = lda;
+  newarg.ldb = ldc;
+  newarg.ldc = lda;
+  newarg.ldd = ldd;
+  LARFB_LT(&newarg, NULL, NULL, sa, sb, 0);
+
+  newarg.m   = m - n1;
+  newarg.n   = n2;
+  newarg.a   = a   + n1 + n1 * lda;
+  newarg.b   = tau + n1;
+  newarg.c   = t   + n1 + n1 * ldc;
+  newarg.d   = w;
+  newarg.lda = lda;
+  newarg.ldc = ldc;
+  newarg.ldd = ldd;
+  CNAME(&newarg, NULL, NULL, sa, sb, 0);
+
+  newarg.m   = m;
+  newarg.n   = n;
+  newarg.k   = n1;
+  newarg.a   = a;
+  newarg.b   = tau;
+  newarg.c   = t;
+  newarg.lda = lda;
+  newarg.ldc = ldc;
+  LARFT_K(&newarg, NULL, NULL, sa, sb, 0);
+
+  return 0;
+}
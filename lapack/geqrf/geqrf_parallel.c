@@ -0,0 +1,221 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Threaded blocked QR with look-ahead.  While the other threads apply
+   the reflector of panel j to their slices of the trailing matrix, the
+   first thread updates the columns of panel j+1, factors it and then
+   takes a smaller slice of the trailing update, so the panel
+   factorization is off the critical path as in getrf_parallel.  The
+   slices are whole columns, each with its own part of the update
+   workspace, so the result does not depend on the number of threads.
+   Workspace as in geqrf_single. */
+
+#include <stdio.h>
+#include "common.h"
+
+typedef struct {
+  FLOAT *a, *tau, *t, *wp;
+  BLASLONG m, lda, nb, j, jb, nb2, from, to;
+} lookahead_t;
+
+/* First thread: update and factor the next panel, then its slice of the rest */
+static int lookahead_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG mypos) {
+
+  lookahead_t *look = (lookahead_t *)args -> common;
+  blas_arg_t newarg;
+  BLASLONG range[2];
+  BLASLONG j  = look -> j + look -> jb;
+  BLASLONG lda = look -> lda;
+
+  range[0] = 0;
+  range[1] = look -> nb2;
+  LARFB_LT(args, NULL, range, sa, sb, 0);
+
+  newarg.m   = look -> m - j;
+  newarg.n   = look -> nb2;
+  newarg.a   = look -> a + j + j * lda;
+  newarg.b   = look -> tau + j;
+  newarg.c   = look -> t;
+  newarg.d   = look -> wp;
+  newarg.lda = lda;
+  newarg.ldc = look -> nb;
+  newarg.ldd = look -> nb;
+  newarg.nthreads = 1;
+  GEQRF_PANEL(&newarg, NULL, NULL, sa, sb, 0);
+
+  if (look -> to > look -> from) {
+    range[0] = look -> from;
+    range[1] = look -> to;
+    LARFB_LT(args, NULL, range, sa, sb, 0);
+  }
+
+  return 0;
+}
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG m, n, k, lda, nb, j, jb, nb2, rest, width, share, i, num_cpu;
+  FLOAT *a, *tau, *t, *tnext, *wp, *w, *tmp;
+  blas_arg_t newarg;
+  lookahead_t look;
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  BLASLONG range[MAX_CPU_NUMBER + 1];
+  int mode;
+
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+
+  m   = args -> m;
+  n   = args -> n;
+  a   = (FLOAT *)args -> a;
+  tau = (FLOAT *)args -> b;
+  lda = args -> lda;
+
+  k  = MIN(m, n);
+  nb = QR_BLOCKING;
+
+  if (args -> nthreads == 1 || n < 4 * nb || k < 2 * nb)
+    return GEQRF_SINGLE(args, NULL, NULL, sa, sb, 0);
+
+  t     = (FLOAT *)args -> c;
+  tnext = t  + nb * nb;
+  wp    = tnext + nb * nb;
+  w     = wp + nb * nb;
+
+  newarg.nthreads = 1;
+  newarg.m   = m;
+  newarg.n   = MIN(nb, k);
+  newarg.a   = a;
+  newarg.b   = tau;
+  newarg.c   = t;
+  newarg.d   = wp;
+  newarg.lda = lda;
+  newarg.ldc = nb;
+  newarg.ldd = nb;
+  GEQRF_PANEL(&newarg, NULL, NULL, sa, sb, 0);
+
+  look.a   = a;
+  look.tau = tau;
+  look.wp  = wp;
+  look.m   = m;
+  look.lda = lda;
+  look.nb  = nb;
+
+  for (j = 0; j < k; j += nb) {
+    jb = MIN(nb, k - j);
+    if (j + jb >= n) break;
+
+    nb2  = MIN(nb, MAX(k - j - jb, 0));
+    rest = n - j - jb - nb2;
+
+    /* panel j is factored; its reflector goes to columns j+jb:n */
+    newarg.m   = m - j;
+    newarg.n   = n - j - jb;
+    newarg.k   = jb;
+    newarg.a   = a + j + j * lda;
+    newarg.b   = t;
+    newarg.c   = a + j + (j + jb) * lda;
+    newarg.d   = w;
+    newarg.lda = lda;
+    newarg.ldb = nb;
+    newarg.ldc = lda;
+    newarg.ldd = nb;
+    newarg.nthreads = 1;
+    newarg.common = (void *)&look;
+
+    if (nb2 == 0) {
+      /* m < n and no panel left: plain update of the last columns */
+      gemm_thread_n(mode, &newarg, NULL, NULL, (int (*)(void))LARFB_LT, sa, sb, args -> nthreads);
+      break;
+    }
+
+    look.j   = j;
+    look.jb  = jb;
+    look.nb2 = nb2;
+    look.t   = tnext;
+
+    /* The first thread's panel counts as about two block columns of update */
+    num_cpu = MIN(args -> nthreads, 1 + (rest + GEMM_UNROLL_N - 1) / GEMM_UNROLL_N);
+    width   = rest + 2 * nb2;
+    share   = MAX((width / num_cpu) - 2 * nb2, 0);
+    share   = (share / GEMM_UNROLL_N) * GEMM_UNROLL_N;
+
+    look.from = nb2;
+    look.to   = nb2 + share;
+
+    range[1] = nb2 + share;
+    for (i = 1; i < num_cpu; i++) {
+      width = (n - j - jb - range[i]) / (num_cpu - i);
+      width = ((width + GEMM_UNROLL_N - 1) / GEMM_UNROLL_N) * GEMM_UNROLL_N;
+      range[i + 1] = MIN(range[i] + width, n - j - jb);
+    }
+
+    queue[0].mode    = mode;
+    queue[0].routine = lookahead_thread;
+    queue[0].args    = &newarg;
+    queue[0].range_m = NULL;
+    queue[0].range_n = NULL;
+    queue[0].sa      = sa;
+    queue[0].sb      = sb;
+    queue[0].next    = &queue[1];
+
+    for (i = 1; i < num_cpu; i++) {
+      queue[i].mode    = mode;
+      queue[i].routine = LARFB_LT;
+      queue[i].args    = &newarg;
+      queue[i].range_m = NULL;
+      queue[i].range_n = &range[i];
+      queue[i].sa      = NULL;
+      queue[i].sb      = NULL;
+      queue[i].next    = &queue[i + 1];
+    }
+
+    queue[num_cpu - 1].next = NULL;
+
+    WMB;
+
+    exec_blas(num_cpu, queue);
+
+    tmp = t;
+    t = tnext;
+    tnext = tmp;
+  }
+
+  return 0;
+}
@@ -0,0 +1,100 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Blocked Householder QR, as ?GEQRF.  Each block column of width
+   QR_BLOCKING is factored by geqrf_panel, which also returns the
+   triangular factor T of its reflectors, and the trailing matrix gets
+   the compact WY update A = (I - V T' V') A through the level 3
+   drivers.  args -> b is tau; args -> c is the workspace, QR_WORKSPACE
+   elements: two nb by nb triangles, the nb by nb panel workspace and
+   the nb by n update workspace. */
+
+#include <stdio.h>
+#include "common.h"
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG m, n, k, lda, nb, j, jb;
+  FLOAT *a, *tau, *t, *wp, *w;
+  blas_arg_t newarg;
+
+  m   = args -> m;
+  n   = args -> n;
+  a   = (FLOAT *)args -> a;
+  tau = (FLOAT *)args -> b;
+  lda = args -> lda;
+
+  k  = MIN(m, n);
+  nb = QR_BLOCKING;
+
+  t  = (FLOAT *)args -> c;
+  wp = t  + 2 * nb * nb;
+  w  = wp + nb * nb;
+
+#ifdef SMP
+  newarg.nthreads = 1;
+#endif
+
+  for (j = 0; j < k; j += nb) {
+    jb = MIN(nb, k - j);
+
+    newarg.m   = m - j;
+    newarg.n   = jb;
+    newarg.a   = a + j + j * lda;
+    newarg.b   = tau + j;
+    newarg.c   = t;
+    newarg.d   = wp;
+    newarg.lda = lda;
+    newarg.ldc = nb;
+    newarg.ldd = nb;
+    GEQRF_PANEL(&newarg, NULL, NULL, sa, sb, 0);
+
+    if (j + jb < n) {
+      newarg.m   = m - j;
+      newarg.n   = n - j - jb;
+      newarg.k   = jb;
+      newarg.a   = a + j + j * lda;
+      newarg.b   = t;
+      newarg.c   = a + j + (j + jb) * lda;
+      newarg.d   = w;
+      newarg.lda = lda;
+      newarg.ldb = nb;
+      newarg.ldc = lda;
+      newarg.ldd = nb;
+      LARFB_LT(&newarg, NULL, NULL, sa, sb, 0);
+    }
+  }
+
+  return 0;
+}
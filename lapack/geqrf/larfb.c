@@ -0,0 +1,226 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Applies the block reflector H = I - V T V' of k Householder vectors,
+   or its transpose (TRANSA), to the m by n matrix C from the left (LEFT)
+   or the right.  V is unit lower trapezoidal with the leading k by k
+   triangle implicit, as left behind in A by geqrf; T is the k by k upper
+   triangular factor from larft_k.  W is a k by n (left) or m by k
+   (right) workspace.
+
+   The columns (left) or rows (right) of C are independent, so range_n
+   or range_m picks a slice and the routine can be run through
+   gemm_thread_n / gemm_thread_m; each slice only touches its own part
+   of W. */
+
+#include <stdio.h>
+#include "common.h"
+
+static FLOAT dp1 =  1.;
+static FLOAT dm1 = -1.;
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG m, n, k, lda, ldb, ldc, ldd, j;
+  FLOAT *v, *t, *c, *w;
+  blas_arg_t newarg;
+
+  m   = args -> m;
+  n   = args -> n;
+  k   = args -> k;
+  v   = (FLOAT *)args -> a;
+  t   = (FLOAT *)args -> b;
+  c   = (FLOAT *)args -> c;
+  w   = (FLOAT *)args -> d;
+  lda = args -> lda;
+  ldb = args -> ldb;
+  ldc = args -> ldc;
+  ldd = args -> ldd;
+
+#ifdef LEFT
+  if (range_n) {
+    n  = range_n[1] - range_n[0];
+    c += range_n[0] * ldc;
+    w += range_n[0] * ldd;
+  }
+#else
+  if (range_m) {
+    m  = range_m[1] - range_m[0];
+    c += range_m[0];
+    w += range_m[0];
+  }
+#endif
+
+  if (m <= 0 || n <= 0 || k <= 0) return 0;
+
+  newarg.alpha = NULL;
+  newarg.beta  = NULL;
+#ifdef SMP
+  newarg.nthreads = 1;
+#endif
+
+#ifdef LEFT
+
+  /* W = V1' C1 + V2' C2 */
+  for (j = 0; j < n; j++) COPY_K(k, c + j * ldc, 1, w + j * ldd, 1);
+
+  newarg.m = k;
+  newarg.n = n;
+  newarg.a = v;
+  newarg.b = w;
+  newarg.lda = lda;
+  newarg.ldb = ldd;
+  TRMM_LTLU(&newarg, NULL, NULL, sa, sb, 0);
+
+  if (m > k) {
+    newarg.m = k;
+    newarg.n = n;
+    newarg.k = m - k;
+    newarg.a = v + k;
+    newarg.b = c + k;
+    newarg.c = w;
+    newarg.lda = lda;
+    newarg.ldb = ldc;
+    newarg.ldc = ldd;
+    newarg.alpha = &dp1;
+    GEMM_TN(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  /* W = T' W or T W */
+  newarg.m = k;
+  newarg.n = n;
+  newarg.a = t;
+  newarg.b = w;
+  newarg.lda = ldb;
+  newarg.ldb = ldd;
+#ifdef TRANSA
+  TRMM_LTUN(&newarg, NULL, NULL, sa, sb, 0);
+#else
+  TRMM_LNUN(&newarg, NULL, NULL, sa, sb, 0);
+#endif
+
+  /* C2 -= V2 W, C1 -= V1 W */
+  if (m > k) {
+    newarg.m = m - k;
+    newarg.n = n;
+    newarg.k = k;
+    newarg.a = v + k;
+    newarg.b = w;
+    newarg.c = c + k;
+    newarg.lda = lda;
+    newarg.ldb = ldd;
+    newarg.ldc = ldc;
+    newarg.alpha = &dm1;
+    GEMM_NN(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  newarg.m = k;
+  newarg.n = n;
+  newarg.a = v;
+  newarg.b = w;
+  newarg.lda = lda;
+  newarg.ldb = ldd;
+  TRMM_LNLU(&newarg, NULL, NULL, sa, sb, 0);
+
+  for (j = 0; j < n; j++) AXPYU_K(k, 0, 0, dm1, w + j * ldd, 1, c + j * ldc, 1, NULL, 0);
+
+#else
+
+  /* W = C1 V1 + C2 V2 */
+  for (j = 0; j < k; j++) COPY_K(m, c + j * ldc, 1, w + j * ldd, 1);
+
+  newarg.m = m;
+  newarg.n = k;
+  newarg.a = v;
+  newarg.b = w;
+  newarg.lda = lda;
+  newarg.ldb = ldd;
+  TRMM_RNLU(&newarg, NULL, NULL, sa, sb, 0);
+
+  if (n > k) {
+    newarg.m = m;
+    newarg.n = k;
+    newarg.k = n - k;
+    newarg.a = c + k * ldc;
+    newarg.b = v + k;
+    newarg.c = w;
+    newarg.lda = ldc;
+    newarg.ldb = lda;
+    newarg.ldc = ldd;
+    newarg.alpha = &dp1;
+    GEMM_NN(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  /* W = W T or W T' */
+  newarg.m = m;
+  newarg.n = k;
+  newarg.a = t;
+  newarg.b = w;
+  newarg.lda = ldb;
+  newarg.ldb = ldd;
+#ifdef TRANSA
+  TRMM_RTUN(&newarg, NULL, NULL, sa, sb, 0);
+#else
+  TRMM_RNUN(&newarg, NULL, NULL, sa, sb, 0);
+#endif
+
+  /* C2 -= W V2', C1 -= W V1' */
+  if (n > k) {
+    newarg.m = m;
+    newarg.n = n - k;
+    newarg.k = k;
+    newarg.a = w;
+    newarg.b = v + k;
+    newarg.c = c + k * ldc;
+    newarg.lda = ldd;
+    newarg.ldb = lda;
+    newarg.ldc = ldc;
+    newarg.alpha = &dm1;
+    GEMM_NT(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  newarg.m = m;
+  newarg.n = k;
+  newarg.a = v;
+  newarg.b = w;
+  newarg.lda = lda;
+  newarg.ldb = ldd;
+  TRMM_RTLU(&newarg, NULL, NULL, sa, sb, 0);
+
+  for (j = 0; j < k; j++) AXPYU_K(m, 0, 0, dm1, w + j * ldd, 1, c + j * ldc, 1, NULL, 0);
+
+#endif
+
+  return 0;
+}
@@ -0,0 +1,169 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Forms the upper triangular factor T of the block reflector
+   H = H(1) H(2) ... H(k) = I - V T V' from the m by k unit lower
+   trapezoidal V and tau, as ?LARFT with DIRECT = 'F', STOREV = 'C'.
+   Narrow blocks are done a column at a time with GEMV; wider ones are
+   split in halves, T11 and T22 formed recursively and coupled by
+
+     T12 = -T11 (V1' V2) T22
+
+   through the level 3 drivers.  If args -> k is set, T11 (k by k) and
+   T22 are already in place, as geqrf_panel leaves them, and only T12
+   is formed. */
+
+#include <stdio.h>
+#include "common.h"
+
+#ifndef LARFT_MIN
+#define LARFT_MIN 8
+#endif
+
+static FLOAT dp1 =  1.;
+static FLOAT dm1 = -1.;
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG m, n, n1, n2, lda, ldc, i, j, l;
+  FLOAT *v, *tau, *t, *x, temp;
+  blas_arg_t newarg;
+
+  m   = args -> m;
+  n   = args -> n;
+  v   = (FLOAT *)args -> a;
+  tau = (FLOAT *)args -> b;
+  t   = (FLOAT *)args -> c;
+  lda = args -> lda;
+  ldc = args -> ldc;
+
+  if (n <= 0) return 0;
+
+  if (n <= LARFT_MIN && !args -> k) {
+    for (i = 0; i < n; i++) {
+      x = t + i * ldc;
+      x[i] = tau[i];
+      if (i == 0) continue;
+
+      if (tau[i] == ZERO) {
+	for (j = 0; j < i; j++) x[j] = ZERO;
+	continue;
+      }
+
+      /* x = V(i:m, 0:i)' v(i) with v(i) = 1 */
+      for (j = 0; j < i; j++) x[j] = v[i + j * lda];
+      if (m > i + 1)
+	GEMV_T(m - i - 1, i, 0, dp1, v + i + 1, lda, v + i + 1 + i * lda, 1, x, 1, sb);
+
+      /* x = -tau T(0:i, 0:i) x */
+      for (j = 0; j < i; j++) {
+	temp = ZERO;
+	for (l = j; l < i; l++) temp += t[j + l * ldc] * x[l];
+	x[j] = -tau[i] * temp;
+      }
+    }
+    return 0;
+  }
+
+  n1 = args -> k ? args -> k : n / 2;
+  n2 = n - n1;
+
+  newarg.alpha = NULL;
+  newarg.beta  = NULL;
+#ifdef SMP
+  newarg.nthreads = 1;
+#endif
+
+  if (!args -> k) {
+    newarg.k   = 0;
+    newarg.m   = m;
+    newarg.n   = n1;
+    newarg.a   = v;
+    newarg.b   = tau;
+    newarg.c   = t;
+    newarg.lda = lda;
+    newarg.ldc = ldc;
+    CNAME(&newarg, NULL, NULL, sa, sb, 0);
+
+    newarg.m   = m - n1;
+    newarg.n   = n2;
+    newarg.a   = v   + n1 + n1 * lda;
+    newarg.b   = tau + n1;
+    newarg.c   = t   + n1 + n1 * ldc;
+    CNAME(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  /* T12 = V1(n1:n, :)' V2(n1:n, :) + V1(n:m, :)' V2(n:m, :) */
+  x = t + n1 * ldc;
+  for (j = 0; j < n2; j++)
+    for (i = 0; i < n1; i++) x[i + j * ldc] = v[n1 + j + i * lda];
+
+  newarg.m   = n1;
+  newarg.n   = n2;
+  newarg.a   = v + n1 + n1 * lda;
+  newarg.b   = x;
+  newarg.lda = lda;
+  newarg.ldb = ldc;
+  TRMM_RNLU(&newarg, NULL, NULL, sa, sb, 0);
+
+  if (m > n) {
+    newarg.m   = n1;
+    newarg.n   = n2;
+    newarg.k   = m - n;
+    newarg.a   = v + n;
+    newarg.b   = v + n + n1 * lda;
+    newarg.c   = x;
+    newarg.lda = lda;
+    newarg.ldb = lda;
+    newarg.ldc = ldc;
+    newarg.alpha = &dp1;
+    GEMM_TN(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  /* T12 = -T11 T12 T22 */
+  newarg.m   = n1;
+  newarg.n   = n2;
+  newarg.a   = t;
+  newarg.b   = x;
+  newarg.lda = ldc;
+  newarg.ldb = ldc;
+  newarg.beta = &dm1;
+  TRMM_LNUN(&newarg, NULL, NULL, sa, sb, 0);
+
+  newarg.a   = t + n1 + n1 * ldc;
+  newarg.beta = NULL;
+  TRMM_RNUN(&newarg, NULL, NULL, sa, sb, 0);
+
+  return 0;
+}
@@ -0,0 +1,159 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Applies Q = H(1) H(2) ... H(k) from geqrf, or Q' (TRANSA), to the m
+   by n matrix C from the left (LEFT) or the right, as ?ORMQR.  The
+   reflectors are taken QR_BLOCKING at a time: LARFT_K forms the block
+   factor T and LARFB applies it to C, threaded over the columns (left)
+   or rows (right) of C.  args -> a and args -> b are A and tau from
+   geqrf, args -> c is C and args -> d the workspace of QR_BLOCKING by
+   QR_BLOCKING + max(m, n) elements. */
+
+#include <stdio.h>
+#include "common.h"
+
+#ifdef LEFT
+#ifdef TRANSA
+#define LARFB	LARFB_LT
+#else
+#define LARFB	LARFB_LN
+#endif
+#else
+#ifdef TRANSA
+#define LARFB	LARFB_RT
+#else
+#define LARFB	LARFB_RN
+#endif
+#endif
+
+/* H(1) first for Q' C and C Q, H(k) first for Q C and C Q' */
+#if (defined(LEFT) && defined(TRANSA)) || (!defined(LEFT) && !defined(TRANSA))
+#define FORWARD
+#endif
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG m, n, k, nq, lda, ldc, nb, i, ib, step;
+  FLOAT *a, *tau, *c, *t, *w;
+  blas_arg_t newarg;
+#ifdef SMP
+  int mode;
+
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#endif
+
+  m   = args -> m;
+  n   = args -> n;
+  k   = args -> k;
+  a   = (FLOAT *)args -> a;
+  tau = (FLOAT *)args -> b;
+  c   = (FLOAT *)args -> c;
+  lda = args -> lda;
+  ldc = args -> ldc;
+
+#ifdef LEFT
+  nq = m;
+#else
+  nq = n;
+#endif
+
+  nb = QR_BLOCKING;
+  t  = (FLOAT *)args -> d;
+  w  = t + nb * nb;
+
+#ifdef FORWARD
+  i    = 0;
+  step = nb;
+#else
+  i    = ((k - 1) / nb) * nb;
+  step = -nb;
+#endif
+
+  for (; i >= 0 && i < k; i += step) {
+    ib = MIN(nb, k - i);
+
+    newarg.k   = 0;
+    newarg.m   = nq - i;
+    newarg.n   = ib;
+    newarg.a   = a + i + i * lda;
+    newarg.b   = tau + i;
+    newarg.c   = t;
+    newarg.lda = lda;
+    newarg.ldc = nb;
+#ifdef SMP
+    newarg.nthreads = 1;
+#endif
+    LARFT_K(&newarg, NULL, NULL, sa, sb, 0);
+
+#ifdef LEFT
+    newarg.m   = m - i;
+    newarg.n   = n;
+    newarg.c   = c + i;
+    newarg.ldd = nb;
+#else
+    newarg.m   = m;
+    newarg.n   = n - i;
+    newarg.c   = c + i * ldc;
+    newarg.ldd = m;
+#endif
+    newarg.k   = ib;
+    newarg.a   = a + i + i * lda;
+    newarg.b   = t;
+    newarg.d   = w;
+    newarg.lda = lda;
+    newarg.ldb = nb;
+    newarg.ldc = ldc;
+
+#ifdef SMP
+    if (args -> nthreads > 1) {
+#ifdef LEFT
+      gemm_thread_n(mode, &newarg, NULL, NULL, (int (*)(void))LARFB, sa, sb, args -> nthreads);
+#else
+      gemm_thread_m(mode, &newarg, NULL, NULL, (int (*)(void))LARFB, sa, sb, args -> nthreads);
+#endif
+      continue;
+    }
+#endif
+
+    LARFB(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  return 0;
+}
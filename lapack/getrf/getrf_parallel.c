@@ -384,6 +384,306 @@ static int inner_advanced_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *
   return 0;
 }
 
+/* Task based implementation with look-ahead.
+
+   The columns are cut into blocks of width nb, the first mn of them on
+   the panel boundaries.  A block gets the row swaps, triangular solve
+   and GEMM update of each earlier panel in turn, and a block on the
+   diagonal is then factored by GETRF_SINGLE.  The threads pick the
+   leftmost block whose next step is ready, so the next panel is updated
+   and factored as soon as the previous panel is done, while the other
+   threads carry on with the trailing update of the earlier panels.
+
+   A block is worked on by one thread at a time.  All of the scheduling
+   state is changed under one lock, held only for the scan; no thread
+   ever waits on another with work in hand, so the factorization
+   completes however the threads are scheduled. */
+
+#ifndef GETRF_TASK_MIN_NB
+#define GETRF_TASK_MIN_NB (GEMM_UNROLL_N * 4)
+#endif
+
+typedef struct {
+  /* Number of panels applied; j + 1 once block j has been factored */
+  volatile BLASLONG status;
+  volatile BLASLONG busy;
+  BLASLONG pad[CACHE_LINE_SIZE - 2];
+} task_block_t;
+
+typedef struct {
+  volatile BLASULONG lock;
+  blas_arg_t *args;
+  FLOAT *a;
+  BLASLONG m, n, mn, lda, nb;
+  BLASLONG panels, blocks;
+  volatile BLASLONG first, finished;
+  volatile blasint info;
+  task_block_t *block;
+} task_job_t;
+
+static __inline BLASLONG task_start(task_job_t *job, BLASLONG j) {
+  if (j < job -> panels) return j * job -> nb;
+  return MIN(job -> mn + (j - job -> panels) * job -> nb, job -> n);
+}
+
+static __inline BLASLONG task_target(task_job_t *job, BLASLONG j) {
+  return (j < job -> panels) ? j + 1 : job -> panels;
+}
+
+/* Next step of block j can run; called with the lock held */
+static __inline int task_ready(task_job_t *job, BLASLONG j) {
+
+  BLASLONG k = job -> block[j].status;
+
+  if (k < MIN(j, job -> panels)) return job -> block[k].status == k + 1;
+
+  return k < task_target(job, j);
+}
+
+/* Claim the leftmost block with a step ready, -1 if none, -2 when all done */
+static BLASLONG task_claim(task_job_t *job) {
+
+  BLASLONG j, found = -1;
+
+  blas_lock(&job -> lock);
+
+  if (job -> finished >= job -> blocks) {
+    found = -2;
+  } else {
+    for (j = job -> first; j < job -> blocks; j++) {
+      if (job -> block[j].busy) continue;
+      if (job -> block[j].status >= task_target(job, j)) continue;
+      if (task_ready(job, j)) {
+	job -> block[j].busy = 1;
+	found = j;
+	break;
+      }
+    }
+  }
+
+  blas_unlock(&job -> lock);
+
+  return found;
+}
+
+/* Record the step just done on block j; returns 1 if j stays claimed */
+static int task_done(task_job_t *job, BLASLONG j) {
+
+  int again = 0;
+
+  blas_lock(&job -> lock);
+
+  job -> block[j].status ++;
+
+  if (job -> block[j].status >= task_target(job, j)) {
+    job -> finished ++;
+    while (job -> first < job -> blocks &&
+	   job -> block[job -> first].status >= task_target(job, job -> first)) job -> first ++;
+  } else {
+    again = task_ready(job, j);
+  }
+
+  if (!again) job -> block[j].busy = 0;
+
+  blas_unlock(&job -> lock);
+
+  return again;
+}
+
+/* Apply panel k to block j */
+static void task_update(task_job_t *job, BLASLONG j, BLASLONG k, FLOAT *sa, FLOAT *sb) {
+
+  BLASLONG is, min_i, jjs, min_jj;
+
+  BLASLONG m   = job -> m;
+  BLASLONG lda = job -> lda;
+
+  BLASLONG kk = task_start(job, k);
+  BLASLONG bk = task_start(job, k + 1) - kk;
+  BLASLONG js = task_start(job, j);
+  BLASLONG nn = task_start(job, j + 1) - js;
+
+  FLOAT *a = job -> a;
+  FLOAT *sbb;
+
+  blasint *ipiv = (blasint *)job -> args -> c;
+
+  TRSM_ILTCOPY(bk, bk, a + (kk + kk * lda) * COMPSIZE, lda, 0, sb);
+
+  sbb = (FLOAT *)((((BLASULONG)(sb + bk * bk * COMPSIZE) + GEMM_ALIGN) & ~GEMM_ALIGN) + GEMM_OFFSET_B);
+
+  for (jjs = js; jjs < js + nn; jjs += min_jj) {
+    min_jj = js + nn - jjs;
+    if (min_jj > GEMM_UNROLL_N) min_jj = GEMM_UNROLL_N;
+
+    LASWP_PLUS(min_jj, kk + 1, kk + bk, ZERO,
+#ifdef COMPLEX
+	       ZERO,
+#endif
+	       a + jjs * lda * COMPSIZE, lda, NULL, 0, ipiv, 1);
+
+    GEMM_ONCOPY (bk, min_jj, a + (kk + jjs * lda) * COMPSIZE, lda, sbb + bk * (jjs - js) * COMPSIZE);
+
+    for (is = 0; is < bk; is += GEMM_P) {
+      min_i = bk - is;
+      if (min_i > GEMM_P) min_i = GEMM_P;
+
+      TRSM_KERNEL_LT(min_i, min_jj, bk, dm1,
+#ifdef COMPLEX
+		     ZERO,
+#endif
+		     sb  + bk * is * COMPSIZE,
+		     sbb + bk * (jjs - js) * COMPSIZE,
+		     a + (kk + is + jjs * lda) * COMPSIZE, lda, is);
+    }
+  }
+
+  for (is = kk + bk; is < m; is += GEMM_P) {
+    min_i = m - is;
+    if (min_i > GEMM_P) min_i = GEMM_P;
+
+    GEMM_ITCOPY (bk, min_i, a + (is + kk * lda) * COMPSIZE, lda, sa);
+
+    GEMM_KERNEL_N(min_i, nn, bk, dm1,
+#ifdef COMPLEX
+		  ZERO,
+#endif
+		  sa, sbb, a + (is + js * lda) * COMPSIZE, lda);
+  }
+}
+
+static int task_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG mypos) {
+
+  task_job_t *job = (task_job_t *)args -> common;
+  BLASLONG j, k, range[2];
+  blasint iinfo;
+
+  while ((j = task_claim(job)) != -2) {
+
+    if (j < 0) {
+      YIELDING;
+      continue;
+    }
+
+    do {
+      k = job -> block[j].status;
+
+      if (k < MIN(j, job -> panels)) {
+	task_update(job, j, k, sa, sb);
+      } else {
+	/* Panels are factored in order, so the first to fail comes first */
+	range[0] = task_start(job, j);
+	range[1] = task_start(job, j + 1);
+
+	iinfo = GETRF_SINGLE(job -> args, NULL, range, sa, sb, 0);
+
+	if (iinfo && !job -> info) job -> info = iinfo + task_start(job, j);
+      }
+
+      MB;
+    } while (task_done(job, j));
+  }
+
+  return 0;
+}
+
+/* Block width for the task driver, 0 if there are too few blocks to share */
+static BLASLONG task_blocking(BLASLONG m, BLASLONG n, BLASLONG nthreads) {
+
+  BLASLONG nb = GEMM_Q;
+
+  while (nb / 2 >= GETRF_TASK_MIN_NB && (n + nb - 1) / nb < nthreads * 8)
+    nb = ((nb / 2 + GEMM_UNROLL_N - 1) / GEMM_UNROLL_N) * GEMM_UNROLL_N;
+
+  if (MIN(m, n) < nb * 2 || (n + nb - 1) / nb < nthreads * 4) return 0;
+
+  return nb;
+}
+
+static blasint getrf_tasks(blas_arg_t *args, BLASLONG nb, FLOAT *sa, FLOAT *sb) {
+
+  blas_arg_t newarg;
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  task_job_t job;
+
+  BLASLONG i, is, bk, num_cpu;
+  FLOAT dummyalpha[2] = {ZERO, ZERO};
+  int mode;
+
+#ifndef COMPLEX
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#else
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_COMPLEX;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_COMPLEX;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_COMPLEX;
+#endif
+#endif
+
+  job.lock   = 0;
+  job.args   = args;
+  job.a      = (FLOAT *)args -> a;
+  job.m      = args -> m;
+  job.n      = args -> n;
+  job.mn     = MIN(job.m, job.n);
+  job.lda    = args -> lda;
+  job.nb     = nb;
+  job.panels = (job.mn + nb - 1) / nb;
+  job.blocks = job.panels + (job.n - job.mn + nb - 1) / nb;
+  job.first  = 0;
+  job.finished = 0;
+  job.info   = 0;
+
+  job.block = (task_block_t *)calloc(job.blocks, sizeof(task_block_t));
+  if (job.block == NULL) return -1;
+
+  newarg = *args;
+  newarg.common = (void *)&job;
+
+  num_cpu = MIN(args -> nthreads, job.blocks);
+
+  for (i = 0; i < num_cpu; i++) {
+    queue[i].mode    = mode;
+    queue[i].routine = task_thread;
+    queue[i].args    = &newarg;
+    queue[i].range_m = NULL;
+    queue[i].range_n = NULL;
+    queue[i].sa      = NULL;
+    queue[i].sb      = NULL;
+    queue[i].next    = &queue[i + 1];
+  }
+
+  queue[0].sa = sa;
+  queue[0].sb = sb;
+
+  queue[num_cpu - 1].next = NULL;
+
+  WMB;
+
+  exec_blas(num_cpu, &queue[0]);
+
+  free(job.block);
+
+  /* Row swaps of the later panels on the columns left of them */
+  for (is = 0; is < job.mn; is += bk) {
+    bk = MIN(nb, job.mn - is);
+
+    blas_level1_thread(mode, bk, is + bk + 1, job.mn, (void *)dummyalpha,
+		       job.a + (is * job.lda) * COMPSIZE, job.lda, NULL, 0,
+		       args -> c, 1, (void *)LASWP_PLUS, args -> nthreads);
+  }
+
+  return job.info;
+}
+
 #if 1
 
 blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
@@ -454,6 +754,11 @@ blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa,
 
   if (m <= 0 || n <= 0) return 0;
 
+  if (range_n == NULL && (bk = task_blocking(m, n, args -> nthreads)) > 0) {
+    info = getrf_tasks(args, bk, sa, sb);
+    if (info >= 0) return info;
+  }
+
   newarg.c   = ipiv;
   newarg.lda = lda;
 
@@ -39,6 +39,243 @@
 #include <stdio.h>
 #include "common.h"
 
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 8
+#endif
+
+#ifndef POTRF_TASK_MIN_NB
+#define POTRF_TASK_MIN_NB (GEMM_UNROLL_N * 4)
+#endif
+
+/* Task based implementation with look-ahead. The matrix is cut into
+   column blocks of width nb; a column block gets the update of each
+   earlier panel in turn and is then factored itself. The threads pick
+   the leftmost block whose next step is ready, so a panel is factored
+   as soon as the previous one is done while the other threads carry on
+   with the trailing update, instead of waiting for the whole update of
+   each step as the loop in CNAME does. All scheduling state is changed
+   under one lock and no thread waits on another with work in hand. */
+
+typedef struct {
+  /* Number of panels applied; j + 1 once block j has been factored */
+  volatile BLASLONG status;
+  volatile BLASLONG busy;
+  BLASLONG pad[CACHE_LINE_SIZE - 2];
+} task_block_t;
+
+typedef struct {
+  volatile BLASULONG lock;
+  FLOAT *a;
+  BLASLONG n, lda, nb, blocks;
+  volatile BLASLONG first, finished;
+  volatile blasint info;
+  task_block_t *block;
+} task_job_t;
+
+/* Next step of block j can run; called with the lock held */
+static __inline int task_ready(task_job_t *job, BLASLONG j) {
+
+  BLASLONG k = job -> block[j].status;
+
+  if (k < j) return job -> block[k].status == k + 1;
+
+  return k == j;
+}
+
+/* Claim the leftmost block with a step ready, -1 if none, -2 when done */
+static BLASLONG task_claim(task_job_t *job) {
+
+  BLASLONG j, found = -1;
+
+  blas_lock(&job -> lock);
+
+  if (job -> finished >= job -> blocks || job -> info) {
+    found = -2;
+  } else {
+    for (j = job -> first; j < job -> blocks; j++) {
+      if (job -> block[j].busy || job -> block[j].status > j) continue;
+      if (task_ready(job, j)) {
+	job -> block[j].busy = 1;
+	found = j;
+	break;
+      }
+    }
+  }
+
+  blas_unlock(&job -> lock);
+
+  return found;
+}
+
+/* Record the step just done on block j; returns 1 if j stays claimed */
+static int task_done(task_job_t *job, BLASLONG j) {
+
+  int again = 0;
+
+  blas_lock(&job -> lock);
+
+  job -> block[j].status ++;
+
+  if (job -> block[j].status > j) {
+    job -> finished ++;
+    while (job -> first < job -> blocks &&
+	   job -> block[job -> first].status > job -> first) job -> first ++;
+  } else {
+    again = !job -> info && task_ready(job, j);
+  }
+
+  if (!again) job -> block[j].busy = 0;
+
+  blas_unlock(&job -> lock);
+
+  return again;
+}
+
+static int task_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG mypos) {
+
+  task_job_t *job = (task_job_t *)args -> common;
+  blas_arg_t newarg;
+
+  BLASLONG j, k, kk, bk, js, nn, rest;
+  BLASLONG n   = job -> n;
+  BLASLONG lda = job -> lda;
+  FLOAT *a = job -> a;
+  FLOAT alpha[2] = { -ONE, ZERO};
+  blasint iinfo;
+
+  newarg.lda = lda;
+  newarg.ldb = lda;
+  newarg.ldc = lda;
+  newarg.alpha = alpha;
+  newarg.beta = NULL;
+  newarg.nthreads = 1;
+
+  while ((j = task_claim(job)) != -2) {
+
+    if (j < 0) {
+      YIELDING;
+      continue;
+    }
+
+    js = j * job -> nb;
+    nn = MIN(job -> nb, n - js);
+    rest = n - js - nn;
+
+    do {
+      k = job -> block[j].status;
+
+      if (k < j) {
+	kk = k * job -> nb;
+	bk = job -> nb;
+
+	/* A(js:n, js:js+nn) -= L(js:n, k) * L(js:js+nn, k)' */
+	newarg.n = nn;
+	newarg.k = bk;
+	newarg.a = a + (js + kk * lda) * COMPSIZE;
+	newarg.c = a + (js + js * lda) * COMPSIZE;
+
+	HERK_LN(&newarg, NULL, NULL, sa, sb, 0);
+
+	if (rest > 0) {
+	  newarg.m = rest;
+	  newarg.n = nn;
+	  newarg.k = bk;
+	  newarg.a = a + (js + nn + kk * lda) * COMPSIZE;
+	  newarg.b = a + (js      + kk * lda) * COMPSIZE;
+	  newarg.c = a + (js + nn + js * lda) * COMPSIZE;
+
+	  GEMM_NC(&newarg, NULL, NULL, sa, sb, 0);
+	}
+      } else {
+	newarg.m = nn;
+	newarg.n = nn;
+	newarg.a = a + (js + js * lda) * COMPSIZE;
+
+	iinfo = POTRF_L_SINGLE(&newarg, NULL, NULL, sa, sb, 0);
+
+	if (iinfo) {
+	  /* Panels are factored in order, so the first to fail comes first */
+	  if (!job -> info) job -> info = iinfo + js;
+	} else if (rest > 0) {
+	  newarg.m = rest;
+	  newarg.n = nn;
+	  newarg.a = a + (js      + js * lda) * COMPSIZE;
+	  newarg.b = a + (js + nn + js * lda) * COMPSIZE;
+
+	  TRSM_RCLN(&newarg, NULL, NULL, sa, sb, 0);
+	}
+      }
+
+      MB;
+    } while (task_done(job, j));
+  }
+
+  return 0;
+}
+
+/* Block width for the task driver, 0 if there are too few blocks to share */
+static BLASLONG task_blocking(BLASLONG n, BLASLONG nthreads) {
+
+  BLASLONG nb = GEMM_Q;
+
+  while (nb / 2 >= POTRF_TASK_MIN_NB && (n + nb - 1) / nb < nthreads * 8)
+    nb = ((nb / 2 + GEMM_UNROLL_N - 1) / GEMM_UNROLL_N) * GEMM_UNROLL_N;
+
+  if ((n + nb - 1) / nb < nthreads * 4) return 0;
+
+  return nb;
+}
+
+static blasint potrf_tasks(blas_arg_t *args, BLASLONG nb, int mode, FLOAT *sa, FLOAT *sb) {
+
+  blas_arg_t newarg;
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  task_job_t job;
+  BLASLONG i, num_cpu;
+
+  job.lock   = 0;
+  job.a      = (FLOAT *)args -> a;
+  job.n      = args -> n;
+  job.lda    = args -> lda;
+  job.nb     = nb;
+  job.blocks = (job.n + nb - 1) / nb;
+  job.first  = 0;
+  job.finished = 0;
+  job.info   = 0;
+
+  job.block = (task_block_t *)calloc(job.blocks, sizeof(task_block_t));
+  if (job.block == NULL) return -1;
+
+  newarg = *args;
+  newarg.common = (void *)&job;
+
+  num_cpu = MIN(args -> nthreads, job.blocks);
+
+  for (i = 0; i < num_cpu; i++) {
+    queue[i].mode    = mode;
+    queue[i].routine = task_thread;
+    queue[i].args    = &newarg;
+    queue[i].range_m = NULL;
+    queue[i].range_n = NULL;
+    queue[i].sa      = NULL;
+    queue[i].sb      = NULL;
+    queue[i].next    = &queue[i + 1];
+  }
+
+  queue[0].sa = sa;
+  queue[0].sb = sb;
+
+  queue[num_cpu - 1].next = NULL;
+
+  WMB;
+
+  exec_blas(num_cpu, &queue[0]);
+
+  free(job.block);
+
+  return job.info;
+}
+
 blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
 
   BLASLONG n, bk, i, blocking, lda;
@@ -82,6 +319,11 @@ blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa,
     return info;
   }
 
+  if (range_n == NULL && (blocking = task_blocking(n, args -> nthreads)) > 0) {
+    info = potrf_tasks(args, blocking, mode, sa, sb);
+    if (info >= 0) return info;
+  }
+
   newarg.lda = lda;
   newarg.ldb = lda;
   newarg.ldc = lda;
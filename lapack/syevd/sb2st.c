@@ -0,0 +1,215 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Second stage of the two-stage tridiagonal reduction, as ?SYTRD_SB2ST
+   for UPLO = 'L': reduces the band of half width nb = args -> k to
+   symmetric tridiagonal form by bulge chasing, Q2' B Q2 = T.
+
+   The band is held in args -> a with leading dimension lda = 2 nb, so
+   element (i, j), i >= j, is at a[i + j * lda] for i - j <= 2 nb and the
+   band can be addressed as a general matrix as long as only its lower
+   triangle is touched; the rows below the band take the bulge and must
+   be zero on entry.  Sweep s annihilates column s below the
+   subdiagonal with a reflector on rows s+1 .. s+nb, then chases the
+   bulge this creates down the band, each step annihilating the first
+   column of the bulge with a reflector nb rows further down.
+
+   If args -> b is not NULL the reflectors are kept for the back
+   transformation in sb2st_back: sweeps are grouped nb at a time and
+   group g, of K(g) = (n - 3) / nb + 1 - g steps, holds an nb by nb
+   block of vectors per step (v(0) = 1 included, zero padded), step by
+   step, starting at element nb * nb * (g K(0) - g (g - 1) / 2) of
+   args -> b; args -> c holds the matching tau, nb per step.  Both are
+   cleared here so that missing steps at the end of the band act as
+   the identity.  The reflector and its products are kept at the start
+   of sb, the level 2 kernels get the rest. */
+
+#include <stdio.h>
+#include <math.h>
+#include <float.h>
+#include "common.h"
+
+#ifdef DOUBLE
+#define SAFMIN (DBL_MIN / (DBL_EPSILON * 0.5))
+#define BIG    DBL_MAX
+#else
+#define SAFMIN (FLT_MIN / (FLT_EPSILON * 0.5))
+#define BIG    FLT_MAX
+#endif
+
+static FLOAT dp1 =  1.;
+
+static FLOAT lapy2(FLOAT x, FLOAT y) {
+
+  FLOAT w, z;
+
+  if (x != x) return x;
+  if (y != y) return y;
+
+  x = fabs(x);
+  y = fabs(y);
+  w = MAX(x, y);
+  z = MIN(x, y);
+
+  if (z == ZERO || w > BIG) return w;
+
+  return w * sqrt(ONE + (z / w) * (z / w));
+}
+
+/* ?LARFG: H (alpha; x) = (beta; 0) with H = I - tau (1; v) (1; v)' */
+static FLOAT larfg(BLASLONG n, FLOAT *alpha, FLOAT *x) {
+
+  FLOAT xnorm, beta, tau;
+  BLASLONG knt, j;
+
+  if (n <= 1) return ZERO;
+
+  xnorm = NRM2_K(n - 1, x, 1);
+  if (xnorm == ZERO) return ZERO;
+
+  beta = -copysign(lapy2(*alpha, xnorm), *alpha);
+  knt  = 0;
+
+  if (fabs(beta) < SAFMIN) {
+    do {
+      knt ++;
+      SCAL_K(n - 1, 0, 0, ONE / SAFMIN, x, 1, NULL, 0, NULL, 0);
+      beta   *= ONE / SAFMIN;
+      *alpha *= ONE / SAFMIN;
+    } while (fabs(beta) < SAFMIN && knt < 20);
+
+    xnorm = NRM2_K(n - 1, x, 1);
+    beta  = -copysign(lapy2(*alpha, xnorm), *alpha);
+  }
+
+  tau = (beta - *alpha) / beta;
+  SCAL_K(n - 1, 0, 0, ONE / (*alpha - beta), x, 1, NULL, 0, NULL, 0);
+
+  for (j = 0; j < knt; j++) beta *= SAFMIN;
+  *alpha = beta;
+
+  return tau;
+}
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG n, nb, lda, k0, ng, g, s, c, r, k, len, mb, j;
+  FLOAT *a, *v2, *tau2, *vs, *ts, *v, *w, tau, temp;
+
+  n    = args -> n;
+  nb   = args -> k;
+  a    = (FLOAT *)args -> a;
+  v2   = (FLOAT *)args -> b;
+  tau2 = (FLOAT *)args -> c;
+  lda  = args -> lda;
+
+  if (n <= 2 || nb <= 1) return 0;
+
+  v = sb;
+  w = sb + nb;
+
+  k0 = (n - 3) / nb + 1;
+  ng = (n - 2 + nb - 1) / nb;
+
+  if (v2) {
+    for (j = 0; j < nb * nb * (ng * k0 - ng * (ng - 1) / 2); j++) v2[j] = ZERO;
+    for (j = 0; j < nb *      (ng * k0 - ng * (ng - 1) / 2); j++) tau2[j] = ZERO;
+  }
+
+  vs = NULL;
+  ts = NULL;
+
+  for (s = 0; s < n - 2; s++) {
+
+    if (v2) {
+      g  = s / nb;
+      vs = v2   + nb * nb * (g * k0 - g * (g - 1) / 2) + (s % nb) * nb;
+      ts = tau2 + nb *      (g * k0 - g * (g - 1) / 2) + (s % nb);
+    }
+
+    c = s;
+    r = s + 1;
+
+    for (k = 0; r < n - 1; k++) {
+
+      len = MIN(nb, n - r);
+
+      /* annihilate A(r+1 : r+len, c) */
+      tau  = larfg(len, a + r + c * lda, a + r + 1 + c * lda);
+      v[0] = ONE;
+      for (j = 1; j < len; j++) {
+	v[j] = a[r + j + c * lda];
+	a[r + j + c * lda] = ZERO;
+      }
+
+      if (v2) {
+	COPY_K(len, v, 1, vs + k * nb * nb, 1);
+	ts[k * nb] = tau;
+      }
+
+      if (tau != ZERO) {
+
+	/* H from the left to the rest of the bulge, columns c+1 .. r-1 */
+	if (r - c > 1) {
+	  for (j = 0; j < r - c - 1; j++) w[j] = ZERO;
+	  GEMV_T(len, r - c - 1, 0, dp1, a + r + (c + 1) * lda, lda, v, 1, w, 1, sb + 2 * nb);
+	  GERU_K(len, r - c - 1, 0, -tau, v, 1, w, 1, a + r + (c + 1) * lda, lda, sb + 2 * nb);
+	}
+
+	/* H D H on the diagonal block */
+	for (j = 0; j < len; j++) w[j] = ZERO;
+	SYMV_L(len, len, tau, a + r + r * lda, lda, v, 1, w, 1, sb + 2 * nb);
+	temp = -0.5 * tau * DOTU_K(len, w, 1, v, 1);
+	AXPYU_K(len, 0, 0, temp, v, 1, w, 1, NULL, 0);
+	for (j = 0; j < len; j++) {
+	  AXPYU_K(len - j, 0, 0, -v[j], w + j, 1, a + (r + j) + (r + j) * lda, 1, NULL, 0);
+	  AXPYU_K(len - j, 0, 0, -w[j], v + j, 1, a + (r + j) + (r + j) * lda, 1, NULL, 0);
+	}
+
+	/* H from the right to the rows below, which fills in the next bulge */
+	mb = MIN(nb, n - r - len);
+	if (mb > 0) {
+	  for (j = 0; j < mb; j++) w[j] = ZERO;
+	  GEMV_N(mb, len, 0, dp1, a + r + len + r * lda, lda, v, 1, w, 1, sb + 2 * nb);
+	  GERU_K(mb, len, 0, -tau, w, 1, v, 1, a + r + len + r * lda, lda, sb + 2 * nb);
+	}
+      }
+
+      c  = r;
+      r += nb;
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,176 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Back transformation of the second stage: Z = Q2 Z, with Q2 the
+   product of the reflectors sb2st left in args -> a and args -> b.
+   Within a group of nb consecutive sweeps, the reflectors of the same
+   step overlap only each other and those one step up or down, so a
+   group can be applied a step at a time, first step first, each step
+   as one block reflector of nb vectors on 2 nb - 1 rows; the groups
+   themselves go last to first.  V and T of all the steps of a group
+   are formed once and then applied by LARFB_LN, threaded over the
+   columns of Z, so each thread runs through the whole group on its own
+   columns.
+
+   args -> m is the order of Q2, args -> n the number of columns of Z
+   (args -> c), args -> k the band width.  args -> d is a workspace of
+   3 * nb * nb * ((m - 3) / nb + 1) + nb * n elements. */
+
+#include <stdio.h>
+#include "common.h"
+
+typedef struct {
+  BLASLONG s0, size, steps;
+  FLOAT *v, *t;
+} group_t;
+
+static int apply_group(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  group_t *group = (group_t *)args -> a;
+  BLASLONG m, nb, k, base, h;
+  blas_arg_t newarg;
+
+  m  = args -> m;
+  nb = args -> k;
+
+  newarg.n   = args -> n;
+  newarg.lda = 2 * nb;
+  newarg.ldb = nb;
+  newarg.ldc = args -> ldc;
+  newarg.d   = args -> d;
+  newarg.ldd = nb;
+
+  for (k = 0; k < group -> steps; k++) {
+    base = group -> s0 + 1 + k * nb;
+    h    = MIN(2 * nb - 1, m - base);
+
+    newarg.m = h;
+    newarg.k = MIN(group -> size, h - 1);
+    newarg.a = group -> v + k * 2 * nb * nb;
+    newarg.b = group -> t + k * nb * nb;
+    newarg.c = (FLOAT *)args -> c + base;
+    LARFB_LN(&newarg, NULL, range_n, sa, sb, 0);
+  }
+
+  return 0;
+}
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG m, nb, k0, ng, g, k, i, j, base, h, kb;
+  FLOAT *v2, *tau2, *vg, *tg, *v, *vk;
+  group_t group;
+  blas_arg_t newarg;
+#ifdef SMP
+  int mode;
+
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#endif
+
+  m    = args -> m;
+  nb   = args -> k;
+  v2   = (FLOAT *)args -> a;
+  tau2 = (FLOAT *)args -> b;
+
+  if (m <= 2 || nb <= 1 || args -> n <= 0) return 0;
+
+  k0 = (m - 3) / nb + 1;
+  ng = (m - 2 + nb - 1) / nb;
+
+  group.v = (FLOAT *)args -> d;
+  group.t = group.v + k0 * 2 * nb * nb;
+
+  newarg.d = group.t + k0 * nb * nb;
+
+  for (g = ng - 1; g >= 0; g--) {
+
+    group.s0    = g * nb;
+    group.size  = MIN(nb, m - 2 - group.s0);
+    group.steps = k0 - g;
+
+    vg = v2   + nb * nb * (g * k0 - g * (g - 1) / 2);
+    tg = tau2 + nb *      (g * k0 - g * (g - 1) / 2);
+
+    for (k = 0; k < group.steps; k++) {
+      base = group.s0 + 1 + k * nb;
+      h    = MIN(2 * nb - 1, m - base);
+      kb   = MIN(group.size, h - 1);
+      v    = group.v + k * 2 * nb * nb;
+
+      /* vector i of the step starts i rows further down */
+      for (i = 0; i < kb; i++) {
+	vk = vg + k * nb * nb + i * nb;
+	for (j = 0; j < h; j++) v[j + i * 2 * nb] = ZERO;
+	for (j = 0; j < nb && i + j < h; j++) v[i + j + i * 2 * nb] = vk[j];
+      }
+
+      newarg.k   = 0;
+      newarg.m   = h;
+      newarg.n   = kb;
+      newarg.a   = v;
+      newarg.b   = tg + k * nb;
+      newarg.c   = group.t + k * nb * nb;
+      newarg.lda = 2 * nb;
+      newarg.ldc = nb;
+#ifdef SMP
+      newarg.nthreads = 1;
+#endif
+      LARFT_K(&newarg, NULL, NULL, sa, sb, 0);
+    }
+
+    newarg.m   = m;
+    newarg.n   = args -> n;
+    newarg.k   = nb;
+    newarg.a   = (void *)&group;
+    newarg.c   = args -> c;
+    newarg.ldc = args -> ldc;
+
+#ifdef SMP
+    if (args -> nthreads > 1) {
+      gemm_thread_n(mode, &newarg, NULL, NULL, (int (*)(void))apply_group, sa, sb, args -> nthreads);
+      continue;
+    }
+#endif
+
+    apply_group(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  return 0;
+}
@@ -0,0 +1,229 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* First stage of the two-stage tridiagonal reduction, as ?SYTRD_SY2SB
+   for UPLO = 'L': reduces the symmetric matrix A (lower triangle) to a
+   band of half width nb = args -> k by orthogonal similarity,
+   Q1' A Q1 = B.  Each step QR factors the panel below the band with
+   geqrf_panel and applies the block reflector H = I - V T V' to both
+   sides of the trailing matrix through the level 3 drivers,
+
+     X = A V T,  X -= 1/2 V (T' V' X),  A -= V X' + X V',
+
+   so the bulk of the work is SYMM and SYR2K, threaded if args ->
+   nthreads > 1.  On exit the band is in the lower triangle of A and the
+   reflectors below it, with V(:, j) starting at row j + nb + 1 as geqrf
+   would leave them for the (n - nb) by (n - nb) matrix at A(nb, 0);
+   args -> b gets the n - nb - 1 scalar factors.  args -> c is a
+   workspace of 3 * nb * nb + 2 * n * nb elements. */
+
+#include <stdio.h>
+#include "common.h"
+
+static FLOAT dp1 =  1.;
+static FLOAT dm1 = -1.;
+static FLOAT dmh = -0.5;
+static FLOAT dz0 =  0.;
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG n, nb, lda, pm, kk, i, j, l;
+  FLOAT *a, *tau, *t, *y, *w, *v, *x, *a1, *a2;
+  blas_arg_t newarg;
+#ifdef SMP
+  int mode;
+
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+#endif
+
+  n   = args -> n;
+  nb  = args -> k;
+  a   = (FLOAT *)args -> a;
+  tau = (FLOAT *)args -> b;
+  lda = args -> lda;
+
+  t = (FLOAT *)args -> c;
+  y = t + nb * nb;
+  w = y + nb * nb;
+  v = w + nb * nb;
+  x = v + n  * nb;
+
+#ifdef SMP
+  newarg.common = NULL;
+#endif
+
+  for (i = 0; i + nb + 1 < n; i += nb) {
+
+    pm = n - i - nb;
+    kk = MIN(nb, pm - 1);
+    a1 = a + (i + nb) +  i       * lda;
+    a2 = a + (i + nb) + (i + nb) * lda;
+
+    newarg.m   = pm;
+    newarg.n   = kk;
+    newarg.a   = a1;
+    newarg.b   = tau + i;
+    newarg.c   = t;
+    newarg.d   = w;
+    newarg.lda = lda;
+    newarg.ldc = nb;
+    newarg.ldd = nb;
+#ifdef SMP
+    newarg.nthreads = 1;
+#endif
+    GEQRF_PANEL(&newarg, NULL, NULL, sa, sb, 0);
+
+    /* the last panel is narrower than the band; H' still applies to the rest of it */
+    if (kk < nb) {
+      newarg.m   = pm;
+      newarg.n   = nb - kk;
+      newarg.k   = kk;
+      newarg.a   = a1;
+      newarg.b   = t;
+      newarg.c   = a1 + kk * lda;
+      newarg.d   = w;
+      newarg.lda = lda;
+      newarg.ldb = nb;
+      newarg.ldc = lda;
+      newarg.ldd = nb;
+      LARFB_LT(&newarg, NULL, NULL, sa, sb, 0);
+    }
+
+    /* V with its unit triangle made explicit for SYMM and SYR2K */
+    for (j = 0; j < kk; j++) {
+      for (l = 0; l < j; l++) v[l + j * pm] = ZERO;
+      v[j + j * pm] = ONE;
+      for (l = j + 1; l < pm; l++) v[l + j * pm] = a1[l + j * lda];
+    }
+
+    /* X = A22 V */
+    newarg.m     = pm;
+    newarg.n     = kk;
+    newarg.a     = a2;
+    newarg.b     = v;
+    newarg.c     = x;
+    newarg.lda   = lda;
+    newarg.ldb   = pm;
+    newarg.ldc   = pm;
+    newarg.alpha = &dp1;
+    newarg.beta  = &dz0;
+#ifdef SMP
+    newarg.nthreads = args -> nthreads;
+    if (args -> nthreads > 1) {
+      SYMM_THREAD_LL(&newarg, NULL, NULL, sa, sb, 0);
+    } else
+#endif
+    SYMM_LL(&newarg, NULL, NULL, sa, sb, 0);
+
+#ifdef SMP
+    newarg.nthreads = 1;
+#endif
+
+    /* X = X T */
+    newarg.m    = pm;
+    newarg.n    = kk;
+    newarg.a    = t;
+    newarg.b    = x;
+    newarg.lda  = nb;
+    newarg.ldb  = pm;
+    newarg.beta = NULL;
+    TRMM_RNUN(&newarg, NULL, NULL, sa, sb, 0);
+
+    /* Y = T' (V' X) */
+    newarg.m     = kk;
+    newarg.n     = kk;
+    newarg.k     = pm;
+    newarg.a     = v;
+    newarg.b     = x;
+    newarg.c     = y;
+    newarg.lda   = pm;
+    newarg.ldb   = pm;
+    newarg.ldc   = nb;
+    newarg.alpha = &dp1;
+    newarg.beta  = &dz0;
+    GEMM_TN(&newarg, NULL, NULL, sa, sb, 0);
+
+    newarg.m    = kk;
+    newarg.n    = kk;
+    newarg.a    = t;
+    newarg.b    = y;
+    newarg.lda  = nb;
+    newarg.ldb  = nb;
+    newarg.beta = NULL;
+    TRMM_LTUN(&newarg, NULL, NULL, sa, sb, 0);
+
+    /* X -= 1/2 V Y */
+    newarg.m     = pm;
+    newarg.n     = kk;
+    newarg.k     = kk;
+    newarg.a     = v;
+    newarg.b     = y;
+    newarg.c     = x;
+    newarg.lda   = pm;
+    newarg.ldb   = nb;
+    newarg.ldc   = pm;
+    newarg.alpha = &dmh;
+    newarg.beta  = NULL;
+    GEMM_NN(&newarg, NULL, NULL, sa, sb, 0);
+
+    /* A22 -= V X' + X V' */
+    newarg.n     = pm;
+    newarg.k     = kk;
+    newarg.a     = v;
+    newarg.b     = x;
+    newarg.c     = a2;
+    newarg.lda   = pm;
+    newarg.ldb   = pm;
+    newarg.ldc   = lda;
+    newarg.alpha = &dm1;
+    newarg.beta  = NULL;
+#ifdef SMP
+    if (args -> nthreads > 1) {
+      newarg.nthreads = args -> nthreads;
+      syrk_thread(mode | BLAS_TRANSA_N | BLAS_TRANSB_T | BLAS_UPLO,
+		  &newarg, NULL, NULL, (void *)SYR2K_LN, sa, sb, args -> nthreads);
+      continue;
+    }
+#endif
+    SYR2K_LN(&newarg, NULL, NULL, sa, sb, 0);
+  }
+
+  return 0;
+}
@@ -0,0 +1,300 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Bunch-Kaufman panel, as the factorization loop of ?LASYF.  Factors up
+   to nb = args -> k columns of the n by n symmetric matrix args -> a
+   (lower triangle from the first column with LOWER, upper triangle from
+   the last one otherwise) and leaves L W' (or U W') in the workspace
+   args -> b, n by nb with leading dimension ldb, for the caller to
+   apply to the rest of the matrix.  The columns of the panel are kept
+   as ?LASYF has them before its trailing update: later interchanges of
+   the panel are applied to its earlier columns too, so the caller must
+   undo them (the last loop of ?LASYF) once the update is done.
+
+   args -> c gets the pivots of the panel columns as in ?SYTRF, relative
+   to the first row of args -> a.  The number of columns factored, nb or
+   nb - 1 if the last pivot would be split, is returned in args -> m; or
+   all n columns if nb >= n.  Returns the first zero pivot.
+
+   Under the threaded sytrf the caller may still be updating the matrix
+   outside the panel; then args -> common lists the slices of that
+   update (sytrf_sync_t) and a column is only read or swapped once every
+   slice it depends on is finished. */
+
+#include <stdio.h>
+#include <math.h>
+#include "common.h"
+
+static FLOAT dm1 = -1.;
+
+#ifdef SMP
+static void wait_column(blas_arg_t *args, BLASLONG col) {
+
+  sytrf_sync_t *sync = (sytrf_sync_t *)args -> common;
+  BLASLONG i;
+
+  if (sync == NULL) return;
+
+  for (i = 0; i < sync -> num; i++) {
+#ifdef LOWER
+    if (sync -> range[i] > col) break;
+#else
+    if (sync -> range[i + 1] <= col) continue;
+#endif
+    while (!sync -> done[i]) { YIELDING; };
+  }
+
+  MB;
+}
+#endif
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG n, nb, lda, ldw, k, kk, kp, kstep, imax, jmax, j;
+  FLOAT *a, *w, *wk, *wk1;
+  FLOAT alpha, absakk, colmax, rowmax, d11, d21, d22, r1, t;
+  blasint *ipiv, info;
+
+  n    = args -> n;
+  nb   = args -> k;
+  a    = (FLOAT *)args -> a;
+  w    = (FLOAT *)args -> b;
+  ipiv = (blasint *)args -> c;
+  lda  = args -> lda;
+  ldw  = args -> ldb;
+
+  alpha = (ONE + sqrt(17.)) / 8.;
+  info  = 0;
+
+#ifdef LOWER
+  k = 0;
+
+  while (k < n && (k < nb - 1 || nb >= n)) {
+
+    /* column k of the updated matrix */
+    wk = w + k * ldw;
+    COPY_K(n - k, a + k + k * lda, 1, wk + k, 1);
+    if (k > 0) GEMV_N(n - k, k, 0, dm1, a + k, lda, w + k, ldw, wk + k, 1, sb);
+
+    kstep  = 1;
+    absakk = fabs(wk[k]);
+    imax   = k;
+    colmax = ZERO;
+    if (k < n - 1) {
+      imax   = k + MAX(IAMAX_K(n - k - 1, wk + k + 1, 1), 1);
+      colmax = fabs(wk[imax]);
+    }
+
+    if (MAX(absakk, colmax) == ZERO) {
+      if (!info) info = k + 1;
+      kp = k;
+    } else {
+      if (absakk >= alpha * colmax) {
+	kp = k;
+      } else {
+	/* column imax of the updated matrix */
+#ifdef SMP
+	wait_column(args, imax);
+#endif
+	wk1 = wk + ldw;
+	COPY_K(imax - k, a + imax + k * lda, lda, wk1 + k, 1);
+	COPY_K(n - imax, a + imax + imax * lda, 1, wk1 + imax, 1);
+	if (k > 0) GEMV_N(n - k, k, 0, dm1, a + k, lda, w + imax, ldw, wk1 + k, 1, sb);
+
+	jmax   = k - 1 + MAX(IAMAX_K(imax - k, wk1 + k, 1), 1);
+	rowmax = fabs(wk1[jmax]);
+	if (imax < n - 1) {
+	  jmax   = imax + MAX(IAMAX_K(n - imax - 1, wk1 + imax + 1, 1), 1);
+	  rowmax = MAX(rowmax, fabs(wk1[jmax]));
+	}
+
+	if (absakk >= alpha * colmax * (colmax / rowmax)) {
+	  kp = k;
+	} else if (fabs(wk1[imax]) >= alpha * rowmax) {
+	  kp = imax;
+	  COPY_K(n - k, wk1 + k, 1, wk + k, 1);
+	} else {
+	  kp = imax;
+	  kstep = 2;
+	}
+      }
+
+      /* interchange rows and columns kk and kp of the rest of the matrix */
+      kk = k + kstep - 1;
+      if (kp != kk) {
+	a[kp + kp * lda] = a[kk + kk * lda];
+	COPY_K(kp - kk - 1, a + kk + 1 + kk * lda, 1, a + kp + (kk + 1) * lda, lda);
+	if (kp < n - 1) COPY_K(n - kp - 1, a + kp + 1 + kk * lda, 1, a + kp + 1 + kp * lda, 1);
+	if (k > 0) SWAP_K(k, 0, 0, ZERO, a + kk, lda, a + kp, lda, NULL, 0);
+	SWAP_K(kk + 1, 0, 0, ZERO, w + kk, ldw, w + kp, ldw, NULL, 0);
+      }
+
+      if (kstep == 1) {
+	COPY_K(n - k, wk + k, 1, a + k + k * lda, 1);
+	if (k < n - 1) {
+	  r1 = ONE / a[k + k * lda];
+	  SCAL_K(n - k - 1, 0, 0, r1, a + k + 1 + k * lda, 1, NULL, 0, NULL, 0);
+	}
+      } else {
+	wk1 = wk + ldw;
+	if (k < n - 2) {
+	  d21 = wk[k + 1];
+	  d11 = wk1[k + 1] / d21;
+	  d22 = wk[k] / d21;
+	  t   = ONE / (d11 * d22 - ONE);
+	  d21 = t / d21;
+	  for (j = k + 2; j < n; j++) {
+	    a[j + k * lda]       = d21 * (d11 * wk[j] - wk1[j]);
+	    a[j + (k + 1) * lda] = d21 * (d22 * wk1[j] - wk[j]);
+	  }
+	}
+	a[k + k * lda]           = wk[k];
+	a[k + 1 + k * lda]       = wk[k + 1];
+	a[k + 1 + (k + 1) * lda] = wk1[k + 1];
+      }
+    }
+
+    if (kstep == 1) {
+      ipiv[k] = kp + 1;
+    } else {
+      ipiv[k]     = -(kp + 1);
+      ipiv[k + 1] = -(kp + 1);
+    }
+
+    k += kstep;
+  }
+
+  args -> m = k;
+
+#else
+  k = n - 1;
+
+  while (k >= 0 && (k > n - nb || nb >= n)) {
+
+    /* column k of the updated matrix, in column nb - n + k of W */
+    wk = w + (nb - n + k) * ldw;
+    COPY_K(k + 1, a + k * lda, 1, wk, 1);
+    if (k < n - 1) GEMV_N(k + 1, n - k - 1, 0, dm1, a + (k + 1) * lda, lda, wk + k + ldw, ldw, wk, 1, sb);
+
+    kstep  = 1;
+    absakk = fabs(wk[k]);
+    imax   = k;
+    colmax = ZERO;
+    if (k > 0) {
+      imax   = MAX(IAMAX_K(k, wk, 1), 1) - 1;
+      colmax = fabs(wk[imax]);
+    }
+
+    if (MAX(absakk, colmax) == ZERO) {
+      if (!info) info = k + 1;
+      kp = k;
+    } else {
+      if (absakk >= alpha * colmax) {
+	kp = k;
+      } else {
+	/* column imax of the updated matrix */
+#ifdef SMP
+	wait_column(args, imax);
+#endif
+	wk1 = wk - ldw;
+	COPY_K(imax + 1, a + imax * lda, 1, wk1, 1);
+	COPY_K(k - imax, a + imax + (imax + 1) * lda, lda, wk1 + imax + 1, 1);
+	if (k < n - 1) GEMV_N(k + 1, n - k - 1, 0, dm1, a + (k + 1) * lda, lda, wk + imax + ldw, ldw, wk1, 1, sb);
+
+	jmax   = imax + MAX(IAMAX_K(k - imax, wk1 + imax + 1, 1), 1);
+	rowmax = fabs(wk1[jmax]);
+	if (imax > 0) {
+	  jmax   = MAX(IAMAX_K(imax, wk1, 1), 1) - 1;
+	  rowmax = MAX(rowmax, fabs(wk1[jmax]));
+	}
+
+	if (absakk >= alpha * colmax * (colmax / rowmax)) {
+	  kp = k;
+	} else if (fabs(wk1[imax]) >= alpha * rowmax) {
+	  kp = imax;
+	  COPY_K(k + 1, wk1, 1, wk, 1);
+	} else {
+	  kp = imax;
+	  kstep = 2;
+	}
+      }
+
+      /* interchange rows and columns kk and kp of the rest of the matrix */
+      kk = k - kstep + 1;
+      if (kp != kk) {
+	a[kp + kp * lda] = a[kk + kk * lda];
+	COPY_K(kk - kp - 1, a + kp + 1 + kk * lda, 1, a + kp + (kp + 1) * lda, lda);
+	if (kp > 0) COPY_K(kp, a + kk * lda, 1, a + kp * lda, 1);
+	if (k < n - 1) SWAP_K(n - k - 1, 0, 0, ZERO, a + kk + (k + 1) * lda, lda, a + kp + (k + 1) * lda, lda, NULL, 0);
+	SWAP_K(n - kk, 0, 0, ZERO, w + kk + (nb - n + kk) * ldw, ldw, w + kp + (nb - n + kk) * ldw, ldw, NULL, 0);
+      }
+
+      if (kstep == 1) {
+	COPY_K(k + 1, wk, 1, a + k * lda, 1);
+	r1 = ONE / a[k + k * lda];
+	SCAL_K(k, 0, 0, r1, a + k * lda, 1, NULL, 0, NULL, 0);
+      } else {
+	wk1 = wk - ldw;
+	if (k > 1) {
+	  d21 = wk[k - 1];
+	  d11 = wk[k] / d21;
+	  d22 = wk1[k - 1] / d21;
+	  t   = ONE / (d11 * d22 - ONE);
+	  d21 = t / d21;
+	  for (j = 0; j < k - 1; j++) {
+	    a[j + (k - 1) * lda] = d21 * (d11 * wk1[j] - wk[j]);
+	    a[j + k * lda]       = d21 * (d22 * wk[j] - wk1[j]);
+	  }
+	}
+	a[k - 1 + (k - 1) * lda] = wk1[k - 1];
+	a[k - 1 + k * lda]       = wk[k - 1];
+	a[k + k * lda]           = wk[k];
+      }
+    }
+
+    if (kstep == 1) {
+      ipiv[k] = kp + 1;
+    } else {
+      ipiv[k]     = -(kp + 1);
+      ipiv[k - 1] = -(kp + 1);
+    }
+
+    k -= kstep;
+  }
+
+  args -> m = n - 1 - k;
+#endif
+
+  return info;
+}
@@ -0,0 +1,339 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Threaded Bunch-Kaufman factorization with look-ahead, otherwise as
+   sytrf_single.  While the other threads apply the update of a panel to
+   the columns beyond the next one, split as syrk_thread would, the
+   first thread updates the next panel's columns and factors that
+   panel.  Unlike the pivot search of LU, a Bunch-Kaufman step may need
+   any column of the trailing matrix; the panel then waits for the
+   slices of the update up to that column (sytrf_panel), so the overlap
+   is largest when the pivots are found near the diagonal.
+
+   args -> b is the workspace, 2 n nb: the W of the panel being applied
+   and that of the next one.  With OpenMP, which may run the queue one
+   entry after the other, the update goes through syrk_thread first and
+   the panel is factored after it. */
+
+#include <stdio.h>
+#include <math.h>
+#include "common.h"
+
+static FLOAT dm1 = -1.;
+
+typedef struct {
+  sytrf_sync_t sync;	/* first, the update slices only see this */
+  blas_arg_t panel;
+  BLASLONG range[2];
+  blasint info;
+} lookahead_t;
+
+#ifdef LOWER
+#define SYTRF_PANEL	SYTRF_PANEL_L
+#define GEMMT_UPDATE	GEMMT_LNT
+#else
+#define SYTRF_PANEL	SYTRF_PANEL_U
+#define GEMMT_UPDATE	GEMMT_UNT
+#endif
+
+/* First thread: update and factor the next panel */
+static int lookahead_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG mypos) {
+
+  lookahead_t *look = (lookahead_t *)args -> common;
+
+  GEMMT_UPDATE(args, NULL, look -> range, sa, sb, 0);
+
+  look -> info = SYTRF_PANEL(&look -> panel, NULL, NULL, sa, sb, 0);
+
+  return 0;
+}
+
+static int update_thread(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG mypos) {
+
+  sytrf_sync_t *sync = (sytrf_sync_t *)args -> common;
+
+  GEMMT_UPDATE(args, NULL, range_n, sa, sb, 0);
+
+  WMB;
+  sync -> done[range_n - sync -> range] = 1;
+
+  return 0;
+}
+
+/* Columns from .. to of an n by n triangle in num slices of about equal
+   work, as syrk_thread splits them; returns the number of slices */
+static BLASLONG split(BLASLONG n, BLASLONG from, BLASLONG to, BLASLONG num, BLASLONG *range) {
+
+  BLASLONG i, width, count;
+  BLASLONG mask = GEMM_UNROLL_MN - 1;
+  double di, dnum;
+
+#ifdef LOWER
+  dnum = ((double)(n - to) * (double)(n - to) - (double)(n - from) * (double)(n - from)) / (double)num;
+#else
+  dnum = ((double)to * (double)to - (double)from * (double)from) / (double)num;
+#endif
+
+  count    = 0;
+  range[0] = from;
+
+  for (i = from; i < to; i += width) {
+    width = to - i;
+
+    if (num - count > 1) {
+#ifdef LOWER
+      di = (double)(n - i);
+      if (di * di + dnum > 0.)
+	width = (((BLASLONG)(di - sqrt(di * di + dnum)) + mask) / (mask + 1)) * (mask + 1);
+#else
+      di = (double)i;
+      width = (((BLASLONG)(sqrt(di * di + dnum) - di) + mask) / (mask + 1)) * (mask + 1);
+#endif
+      if ((width <= 0) || (width > to - i)) width = to - i;
+    }
+
+    range[count + 1] = range[count] + width;
+    count ++;
+  }
+
+  return count;
+}
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG n, lda, nb, k, kb, kn, n2, nb2, num, i, j, jj, jp;
+  BLASLONG mask = GEMM_UNROLL_MN - 1;
+  FLOAT *a, *w, *wnext, *tmp;
+  blasint *ipiv, info, iinfo;
+  blas_arg_t newarg;
+  lookahead_t look;
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  int mode;
+
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+
+  n    = args -> n;
+  a    = (FLOAT *)args -> a;
+  ipiv = (blasint *)args -> c;
+  lda  = args -> lda;
+
+  nb = SYTRF_BLOCKING;
+
+  if (args -> nthreads == 1 || n < 4 * nb) {
+#ifdef LOWER
+    return SYTRF_L_SINGLE(args, NULL, NULL, sa, sb, 0);
+#else
+    return SYTRF_U_SINGLE(args, NULL, NULL, sa, sb, 0);
+#endif
+  }
+
+  w     = (FLOAT *)args -> b;
+  wnext = w + n * nb;
+
+  look.panel.n   = n;
+  look.panel.k   = nb;
+  look.panel.a   = a;
+  look.panel.b   = w;
+  look.panel.c   = ipiv;
+  look.panel.lda = lda;
+  look.panel.ldb = n;
+  look.panel.nthreads = 1;
+  look.panel.common   = NULL;
+  info = SYTRF_PANEL(&look.panel, NULL, NULL, sa, sb, 0);
+  kb = look.panel.m;
+
+  newarg.alpha = &dm1;
+  newarg.beta  = NULL;
+  newarg.lda   = lda;
+  newarg.ldb   = n;
+  newarg.ldc   = lda;
+  newarg.nthreads = 1;
+  newarg.common   = (void *)&look;
+
+#ifdef LOWER
+  k = 0;
+#else
+  k = n;
+#endif
+
+  while (1) {
+
+    /* panel k, of kb columns, is factored; its update goes to the n2 by
+       n2 matrix that the next panel starts */
+#ifdef LOWER
+    n2 = n - k - kb;
+    newarg.a = a + k + kb + k * lda;
+    newarg.b = w + kb;
+    newarg.c = a + (k + kb) + (k + kb) * lda;
+    look.panel.a = newarg.c;
+    look.panel.c = ipiv + k + kb;
+#else
+    n2 = k - kb;
+    newarg.a = a + n2 * lda;
+    newarg.b = w + (nb - kb) * n;
+    newarg.c = a;
+    look.panel.a = a;
+    look.panel.c = ipiv;
+#endif
+    newarg.n = n2;
+    newarg.k = kb;
+
+    look.panel.n = n2;
+    look.panel.b = wnext;
+
+    kn    = 0;
+    iinfo = 0;
+
+    if (n2 > 0) {
+      nb2 = MIN(nb, n2);
+      num = 0;
+
+#ifndef USE_OPENMP
+      /* the GEMMT kernels need the column ranges aligned as
+	 syrk_thread has them, so the look-ahead may take a few more */
+#ifdef LOWER
+      look.range[0] = 0;
+      look.range[1] = ((nb2 + mask) / (mask + 1)) * (mask + 1);
+      if (n2 - look.range[1] >= nb)
+	num = split(n2, look.range[1], n2, args -> nthreads - 1, look.sync.range);
+#else
+      look.range[0] = ((n2 - nb2) / (mask + 1)) * (mask + 1);
+      look.range[1] = n2;
+      if (look.range[0] >= nb)
+	num = split(n2, 0, look.range[0], args -> nthreads - 1, look.sync.range);
+#endif
+#endif
+
+      if (num == 0) {
+	syrk_thread(mode | BLAS_TRANSA_N | BLAS_TRANSB_T
+#ifdef LOWER
+		    | BLAS_UPLO
+#endif
+		    , &newarg, NULL, NULL, (void *)GEMMT_UPDATE, sa, sb, args -> nthreads);
+
+	look.panel.common = NULL;
+	iinfo = SYTRF_PANEL(&look.panel, NULL, NULL, sa, sb, 0);
+
+      } else {
+	look.sync.num = num;
+	for (i = 0; i < num; i++) look.sync.done[i] = 0;
+	look.panel.common = (void *)&look.sync;
+
+	queue[0].mode    = mode;
+	queue[0].routine = lookahead_thread;
+	queue[0].args    = &newarg;
+	queue[0].range_m = NULL;
+	queue[0].range_n = NULL;
+	queue[0].sa      = sa;
+	queue[0].sb      = sb;
+	queue[0].next    = &queue[1];
+
+	for (i = 1; i <= num; i++) {
+	  queue[i].mode    = mode;
+	  queue[i].routine = update_thread;
+	  queue[i].args    = &newarg;
+	  queue[i].range_m = NULL;
+	  queue[i].range_n = &look.sync.range[i - 1];
+	  queue[i].sa      = NULL;
+	  queue[i].sb      = NULL;
+	  queue[i].next    = &queue[i + 1];
+	}
+
+	queue[num].next = NULL;
+
+	WMB;
+
+	exec_blas(num + 1, queue);
+
+	iinfo = look.info;
+      }
+
+      kn = look.panel.m;
+    }
+
+    /* the update is done: put panel k back in the ?SYTRF form */
+#ifdef LOWER
+    j = kb - 1;
+    do {
+      jj = j;
+      jp = ipiv[k + j];
+      if (jp < 0) {
+	jp = -jp;
+	j--;
+      }
+      j--;
+      if (jp - 1 != jj && j >= 0)
+	SWAP_K(j + 1, 0, 0, ZERO, a + k + jp - 1 + k * lda, lda, a + k + jj + k * lda, lda, NULL, 0);
+    } while (j > 0);
+
+    for (j = k; j < k + kb; j++) {
+      if (ipiv[j] > 0) ipiv[j] += k; else ipiv[j] -= k;
+    }
+
+    if (iinfo && !info) info = iinfo + k + kb;
+    k += kb;
+#else
+    j = k - kb;
+    do {
+      jj = j;
+      jp = ipiv[j];
+      if (jp < 0) {
+	jp = -jp;
+	j++;
+      }
+      j++;
+      if (jp - 1 != jj && j < k)
+	SWAP_K(k - j, 0, 0, ZERO, a + jp - 1 + j * lda, lda, a + jj + j * lda, lda, NULL, 0);
+    } while (j < k - 1);
+
+    if (iinfo && !info) info = iinfo;
+    k -= kb;
+#endif
+
+    if (n2 == 0) break;
+
+    kb    = kn;
+    tmp   = w;
+    w     = wnext;
+    wnext = tmp;
+  }
+
+  return info;
+}
@@ -0,0 +1,160 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Blocked Bunch-Kaufman factorization, as ?SYTRF: A = L D L' with
+   LOWER, A = U D U' otherwise, pivots in args -> c in the ?SYTRF
+   format.  Each block column of width SYTRF_BLOCKING is factored by
+   sytrf_panel and the rest of the matrix gets the rank kb update
+   A -= L W' (U W') through GEMMT.  args -> b is the n by nb workspace
+   W.  Returns the first zero pivot, 0 if none. */
+
+#include <stdio.h>
+#include "common.h"
+
+static FLOAT dm1 = -1.;
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG n, lda, nb, k, kb, j, jj, jp;
+  FLOAT *a, *w;
+  blasint *ipiv, info, iinfo;
+  blas_arg_t newarg;
+
+  n    = args -> n;
+  a    = (FLOAT *)args -> a;
+  w    = (FLOAT *)args -> b;
+  ipiv = (blasint *)args -> c;
+  lda  = args -> lda;
+
+  nb   = SYTRF_BLOCKING;
+  info = 0;
+
+  newarg.alpha = &dm1;
+  newarg.beta  = NULL;
+#ifdef SMP
+  newarg.common   = NULL;
+  newarg.nthreads = 1;
+#endif
+
+#ifdef LOWER
+  for (k = 0; k < n; k += kb) {
+
+    newarg.n   = n - k;
+    newarg.k   = nb;
+    newarg.a   = a + k + k * lda;
+    newarg.b   = w;
+    newarg.c   = ipiv + k;
+    newarg.lda = lda;
+    newarg.ldb = n;
+    iinfo = SYTRF_PANEL_L(&newarg, NULL, NULL, sa, sb, 0);
+    kb = newarg.m;
+
+    if (iinfo && !info) info = iinfo + k;
+
+    if (k + kb < n) {
+      newarg.n   = n - k - kb;
+      newarg.k   = kb;
+      newarg.a   = a + k + kb + k * lda;
+      newarg.b   = w + kb;
+      newarg.c   = a + (k + kb) + (k + kb) * lda;
+      newarg.lda = lda;
+      newarg.ldb = n;
+      newarg.ldc = lda;
+      GEMMT_LNT(&newarg, NULL, NULL, sa, sb, 0);
+    }
+
+    /* put the panel back in the ?SYTRF form, each column with the
+       interchanges up to its own */
+    j = kb - 1;
+    do {
+      jj = j;
+      jp = ipiv[k + j];
+      if (jp < 0) {
+	jp = -jp;
+	j--;
+      }
+      j--;
+      if (jp - 1 != jj && j >= 0)
+	SWAP_K(j + 1, 0, 0, ZERO, a + k + jp - 1 + k * lda, lda, a + k + jj + k * lda, lda, NULL, 0);
+    } while (j > 0);
+
+    for (j = k; j < k + kb; j++) {
+      if (ipiv[j] > 0) ipiv[j] += k; else ipiv[j] -= k;
+    }
+  }
+
+#else
+  for (k = n; k > 0; k -= kb) {
+
+    newarg.n   = k;
+    newarg.k   = nb;
+    newarg.a   = a;
+    newarg.b   = w;
+    newarg.c   = ipiv;
+    newarg.lda = lda;
+    newarg.ldb = n;
+    iinfo = SYTRF_PANEL_U(&newarg, NULL, NULL, sa, sb, 0);
+    kb = newarg.m;
+
+    if (iinfo && !info) info = iinfo;
+
+    if (k > kb) {
+      newarg.n   = k - kb;
+      newarg.k   = kb;
+      newarg.a   = a + (k - kb) * lda;
+      newarg.b   = w + (nb - kb) * n;
+      newarg.c   = a;
+      newarg.lda = lda;
+      newarg.ldb = n;
+      newarg.ldc = lda;
+      GEMMT_UNT(&newarg, NULL, NULL, sa, sb, 0);
+    }
+
+    j = k - kb;
+    do {
+      jj = j;
+      jp = ipiv[j];
+      if (jp < 0) {
+	jp = -jp;
+	j++;
+      }
+      j++;
+      if (jp - 1 != jj && j < k)
+	SWAP_K(k - j, 0, 0, ZERO, a + jp - 1 + j * lda, lda, a + jj + j * lda, lda, NULL, 0);
+    } while (j < k - 1);
+  }
+#endif
+
+  return info;
+}
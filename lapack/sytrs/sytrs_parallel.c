@@ -0,0 +1,104 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Threaded sytrs: the right hand sides are shared out by columns and
+   each thread solves its own with sytrs_single, with its own part of
+   the workspace args -> d, n (nb + 1) elements per thread. */
+
+#include <stdio.h>
+#include "common.h"
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG n, nrhs, num_cpu, width, from, i;
+  blas_arg_t newarg[MAX_CPU_NUMBER];
+  blas_queue_t queue[MAX_CPU_NUMBER];
+  int mode;
+
+#ifdef XDOUBLE
+  mode  =  BLAS_XDOUBLE | BLAS_REAL;
+#elif defined(DOUBLE)
+  mode  =  BLAS_DOUBLE  | BLAS_REAL;
+#else
+  mode  =  BLAS_SINGLE  | BLAS_REAL;
+#endif
+
+  n    = args -> m;
+  nrhs = args -> n;
+
+  num_cpu = MIN(args -> nthreads, nrhs / 2);
+
+  if (num_cpu <= 1) {
+#ifdef LOWER
+    return SYTRS_L_SINGLE(args, NULL, NULL, sa, sb, 0);
+#else
+    return SYTRS_U_SINGLE(args, NULL, NULL, sa, sb, 0);
+#endif
+  }
+
+  from = 0;
+
+  for (i = 0; i < num_cpu; i++) {
+    width = (nrhs - from) / (num_cpu - i);
+
+    newarg[i] = *args;
+    newarg[i].n = width;
+    newarg[i].b = (FLOAT *)args -> b + from * args -> ldb;
+    newarg[i].d = (FLOAT *)args -> d + i * n * (SYTRF_BLOCKING + 1);
+    newarg[i].nthreads = 1;
+
+#ifdef LOWER
+    queue[i].routine = SYTRS_L_SINGLE;
+#else
+    queue[i].routine = SYTRS_U_SINGLE;
+#endif
+    queue[i].mode    = mode;
+    queue[i].args    = &newarg[i];
+    queue[i].range_m = NULL;
+    queue[i].range_n = NULL;
+    queue[i].sa      = NULL;
+    queue[i].sb      = NULL;
+    queue[i].next    = &queue[i + 1];
+
+    from += width;
+  }
+
+  queue[0].sa = sa;
+  queue[0].sb = sb;
+  queue[num_cpu - 1].next = NULL;
+
+  exec_blas(num_cpu, queue);
+
+  return 0;
+}
@@ -0,0 +1,377 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+/* Solves A X = B with the factorization from sytrf, as ?SYTRS, for
+   args -> n right hand sides of order args -> m; args -> c is the
+   pivot vector.
+
+   ?SYTRS applies L (U) one pivot at a time with rank one updates.  Here
+   the pivots go by blocks of about SYTRF_BLOCKING: the columns of a
+   block are copied to the workspace args -> d, n (nb + 1) elements,
+   with the interchanges of the later pivots of the block applied to
+   them as in sytrf_panel, so that the interchanges of the whole block
+   can be done first and the block applied through TRSM and GEMM.  A
+   single right hand side takes the level 2 loop of ?SYTRS instead, and
+   so does every column when args -> d is NULL. */
+
+#include <stdio.h>
+#include "common.h"
+
+static FLOAT dm1 = -1.;
+
+/* Does a block boundary in front of column j split a 2 by 2 pivot? */
+static int splits_pair(blasint *ipiv, BLASLONG n, BLASLONG j) {
+
+  BLASLONG i;
+
+  if (j <= 0 || j >= n || ipiv[j - 1] > 0 || ipiv[j] > 0) return 0;
+
+  /* negative entries come in whole pairs, so count from the start of the run */
+  for (i = j - 1; i > 0 && ipiv[i - 1] < 0; i--);
+
+  return (j - i) & 1;
+}
+
+/* Interchanges of pivots j0 .. j1 - 1 on the rows of B, in increasing
+   or decreasing order */
+static void swap_block(BLASLONG nrhs, FLOAT *b, BLASLONG ldb, blasint *ipiv,
+		       BLASLONG j0, BLASLONG j1, int ascending) {
+
+  BLASLONG k, r, kp, step;
+
+  step = ascending ? 1 : -1;
+  k    = ascending ? j0 : j1 - 1;
+
+  while (k >= j0 && k < j1) {
+    r  = k;
+    kp = ipiv[k] - 1;
+
+    if (ipiv[k] < 0) {
+      /* 2 by 2: its second row (first with upper) is interchanged */
+      kp = -ipiv[k] - 1;
+#ifdef LOWER
+      if (ascending) r = k + 1;
+#else
+      if (!ascending) r = k - 1;
+#endif
+      k += step;
+    }
+
+    if (kp != r) SWAP_K(nrhs, 0, 0, ZERO, b + r, ldb, b + kp, ldb, NULL, 0);
+
+    k += step;
+  }
+}
+
+/* Columns j0 .. j1 - 1 of L, rows j0 .. n - 1 (of U, rows 0 .. j1 - 1)
+   to l, as sytrf_panel leaves them: the off diagonal of each 2 by 2
+   pivot cleared and later interchanges of the block applied */
+static BLASLONG copy_block(BLASLONG n, FLOAT *a, BLASLONG lda, blasint *ipiv,
+			   BLASLONG j0, BLASLONG j1, FLOAT *l) {
+
+  BLASLONG j, k, r, kp, ldl;
+
+#ifdef LOWER
+  ldl = n - j0;
+  for (j = j0; j < j1; j++) COPY_K(ldl, a + j0 + j * lda, 1, l + (j - j0) * ldl, 1);
+
+  for (k = j0; k < j1; k++) {
+    r  = k;
+    kp = ipiv[k] - 1;
+    if (ipiv[k] < 0) {
+      kp = -ipiv[k] - 1;
+      r  = k + 1;
+      l[r - j0 + (k - j0) * ldl] = ZERO;
+    }
+    if (kp != r && k > j0)
+      SWAP_K(k - j0, 0, 0, ZERO, l + r - j0, ldl, l + kp - j0, ldl, NULL, 0);
+    k = r;
+  }
+#else
+  ldl = j1;
+  for (j = j0; j < j1; j++) COPY_K(ldl, a + j * lda, 1, l + (j - j0) * ldl, 1);
+
+  for (k = j1 - 1; k >= j0; k--) {
+    r  = k;
+    kp = ipiv[k] - 1;
+    if (ipiv[k] < 0) {
+      kp = -ipiv[k] - 1;
+      r  = k - 1;
+      l[r + (k - j0) * ldl] = ZERO;
+    }
+    if (kp != r && k < j1 - 1)
+      SWAP_K(j1 - 1 - k, 0, 0, ZERO, l + r + (k + 1 - j0) * ldl, ldl, l + kp + (k + 1 - j0) * ldl, ldl, NULL, 0);
+    k = r;
+  }
+#endif
+
+  return ldl;
+}
+
+/* B = D \ B */
+static void solve_diagonal(BLASLONG n, BLASLONG nrhs, FLOAT *a, BLASLONG lda, blasint *ipiv, FLOAT *b, BLASLONG ldb) {
+
+  BLASLONG j, k, p, q;
+  FLOAT akm1k, akm1, ak, denom, bkm1, bk;
+
+  for (k = 0; k < n; k++) {
+
+    if (ipiv[k] > 0) {
+      SCAL_K(nrhs, 0, 0, ONE / a[k + k * lda], b + k, ldb, NULL, 0, NULL, 0);
+      continue;
+    }
+
+    /* 2 by 2 pivot in rows p, q = k, k + 1 */
+    p = k;
+    q = k + 1;
+#ifdef LOWER
+    akm1k = a[q + p * lda];
+#else
+    akm1k = a[p + q * lda];
+#endif
+    akm1  = a[p + p * lda] / akm1k;
+    ak    = a[q + q * lda] / akm1k;
+    denom = akm1 * ak - ONE;
+
+    for (j = 0; j < nrhs; j++) {
+      bkm1 = b[p + j * ldb] / akm1k;
+      bk   = b[q + j * ldb] / akm1k;
+      b[p + j * ldb] = (ak * bkm1 - bk) / denom;
+      b[q + j * ldb] = (akm1 * bk - bkm1) / denom;
+    }
+
+    k++;
+  }
+}
+
+/* One right hand side: the loops of ?SYTRS */
+static void solve_vector(BLASLONG n, FLOAT *a, BLASLONG lda, blasint *ipiv, FLOAT *b) {
+
+  BLASLONG k, kp;
+  FLOAT temp;
+
+#ifdef LOWER
+  for (k = 0; k < n; k++) {
+    kp = ((ipiv[k] > 0) ? ipiv[k] : -ipiv[k]) - 1;
+    if (ipiv[k] > 0) {
+      if (kp != k) { temp = b[k]; b[k] = b[kp]; b[kp] = temp; }
+      AXPYU_K(n - k - 1, 0, 0, -b[k], a + k + 1 + k * lda, 1, b + k + 1, 1, NULL, 0);
+    } else {
+      if (kp != k + 1) { temp = b[k + 1]; b[k + 1] = b[kp]; b[kp] = temp; }
+      if (k < n - 2) {
+	AXPYU_K(n - k - 2, 0, 0, -b[k],     a + k + 2 +  k      * lda, 1, b + k + 2, 1, NULL, 0);
+	AXPYU_K(n - k - 2, 0, 0, -b[k + 1], a + k + 2 + (k + 1) * lda, 1, b + k + 2, 1, NULL, 0);
+      }
+      k++;
+    }
+  }
+
+  solve_diagonal(n, 1, a, lda, ipiv, b, n);
+
+  for (k = n - 1; k >= 0; k--) {
+    kp = ((ipiv[k] > 0) ? ipiv[k] : -ipiv[k]) - 1;
+    if (k < n - 1) b[k] -= DOTU_K(n - k - 1, a + k + 1 + k * lda, 1, b + k + 1, 1);
+    if (ipiv[k] < 0) {
+      if (k < n - 1) b[k - 1] -= DOTU_K(n - k - 1, a + k + 1 + (k - 1) * lda, 1, b + k + 1, 1);
+    }
+    if (kp != k) { temp = b[k]; b[k] = b[kp]; b[kp] = temp; }
+    if (ipiv[k] < 0) k--;
+  }
+
+#else
+  for (k = n - 1; k >= 0; k--) {
+    kp = ((ipiv[k] > 0) ? ipiv[k] : -ipiv[k]) - 1;
+    if (ipiv[k] > 0) {
+      if (kp != k) { temp = b[k]; b[k] = b[kp]; b[kp] = temp; }
+      AXPYU_K(k, 0, 0, -b[k], a + k * lda, 1, b, 1, NULL, 0);
+    } else {
+      if (kp != k - 1) { temp = b[k - 1]; b[k - 1] = b[kp]; b[kp] = temp; }
+      AXPYU_K(k - 1, 0, 0, -b[k],     a +  k      * lda, 1, b, 1, NULL, 0);
+      AXPYU_K(k - 1, 0, 0, -b[k - 1], a + (k - 1) * lda, 1, b, 1, NULL, 0);
+      k--;
+    }
+  }
+
+  solve_diagonal(n, 1, a, lda, ipiv, b, n);
+
+  for (k = 0; k < n; k++) {
+    kp = ((ipiv[k] > 0) ? ipiv[k] : -ipiv[k]) - 1;
+    b[k] -= DOTU_K(k, a + k * lda, 1, b, 1);
+    if (ipiv[k] < 0) b[k + 1] -= DOTU_K(k, a + (k + 1) * lda, 1, b, 1);
+    if (kp != k) { temp = b[k]; b[k] = b[kp]; b[kp] = temp; }
+    if (ipiv[k] < 0) k++;
+  }
+#endif
+}
+
+blasint CNAME(blas_arg_t *args, BLASLONG *range_m, BLASLONG *range_n, FLOAT *sa, FLOAT *sb, BLASLONG myid) {
+
+  BLASLONG n, nrhs, lda, ldb, ldl, nb, j, j0, j1;
+  FLOAT *a, *b, *l;
+  blasint *ipiv;
+  blas_arg_t newarg;
+
+  n    = args -> m;
+  nrhs = args -> n;
+  a    = (FLOAT *)args -> a;
+  b    = (FLOAT *)args -> b;
+  ipiv = (blasint *)args -> c;
+  l    = (FLOAT *)args -> d;
+  lda  = args -> lda;
+  ldb  = args -> ldb;
+
+  if (nrhs == 1 || l == NULL) {
+    for (j = 0; j < nrhs; j++) solve_vector(n, a, lda, ipiv, b + j * ldb);
+    return 0;
+  }
+
+  nb = SYTRF_BLOCKING;
+
+  newarg.n     = nrhs;
+  newarg.ldb   = ldb;
+  newarg.ldc   = ldb;
+  newarg.alpha = &dm1;
+  newarg.beta  = NULL;
+#ifdef SMP
+  newarg.common   = NULL;
+  newarg.nthreads = 1;
+#endif
+
+#ifdef LOWER
+  /* B = L \ P' B */
+  for (j0 = 0; j0 < n; j0 = j1) {
+    j1 = MIN(j0 + nb, n);
+    if (splits_pair(ipiv, n, j1)) j1++;
+
+    ldl = copy_block(n, a, lda, ipiv, j0, j1, l);
+    swap_block(nrhs, b, ldb, ipiv, j0, j1, 1);
+
+    newarg.m   = j1 - j0;
+    newarg.a   = l;
+    newarg.lda = ldl;
+    newarg.b   = b + j0;
+    TRSM_LNLU(&newarg, NULL, NULL, sa, sb, 0);
+
+    if (j1 < n) {
+      newarg.m = n - j1;
+      newarg.k = j1 - j0;
+      newarg.a = l + (j1 - j0);
+      newarg.c = b + j1;
+      GEMM_NN(&newarg, NULL, NULL, sa, sb, 0);
+    }
+  }
+
+  solve_diagonal(n, nrhs, a, lda, ipiv, b, ldb);
+
+  /* B = P L' \ B */
+  for (j1 = n; j1 > 0; j1 = j0) {
+    j0 = MAX(j1 - nb, 0);
+    if (splits_pair(ipiv, n, j0)) j0--;
+
+    ldl = copy_block(n, a, lda, ipiv, j0, j1, l);
+
+    newarg.lda = ldl;
+
+    if (j1 < n) {
+      newarg.m = j1 - j0;
+      newarg.k = n - j1;
+      newarg.a = l + (j1 - j0);
+      newarg.b = b + j1;
+      newarg.c = b + j0;
+      GEMM_TN(&newarg, NULL, NULL, sa, sb, 0);
+    }
+
+    newarg.m = j1 - j0;
+    newarg.a = l;
+    newarg.b = b + j0;
+    TRSM_LTLU(&newarg, NULL, NULL, sa, sb, 0);
+
+    swap_block(nrhs, b, ldb, ipiv, j0, j1, 0);
+  }
+
+#else
+  /* B = U \ P' B */
+  for (j1 = n; j1 > 0; j1 = j0) {
+    j0 = MAX(j1 - nb, 0);
+    if (splits_pair(ipiv, n, j0)) j0--;
+
+    ldl = copy_block(n, a, lda, ipiv, j0, j1, l);
+    swap_block(nrhs, b, ldb, ipiv, j0, j1, 0);
+
+    newarg.m   = j1 - j0;
+    newarg.a   = l + j0;
+    newarg.lda = ldl;
+    newarg.b   = b + j0;
+    TRSM_LNUU(&newarg, NULL, NULL, sa, sb, 0);
+
+    if (j0 > 0) {
+      newarg.m = j0;
+      newarg.k = j1 - j0;
+      newarg.a = l;
+      newarg.c = b;
+      GEMM_NN(&newarg, NULL, NULL, sa, sb, 0);
+    }
+  }
+
+  solve_diagonal(n, nrhs, a, lda, ipiv, b, ldb);
+
+  /* B = P U' \ B */
+  for (j0 = 0; j0 < n; j0 = j1) {
+    j1 = MIN(j0 + nb, n);
+    if (splits_pair(ipiv, n, j1)) j1++;
+
+    ldl = copy_block(n, a, lda, ipiv, j0, j1, l);
+
+    newarg.lda = ldl;
+
+    if (j0 > 0) {
+      newarg.m = j1 - j0;
+      newarg.k = j0;
+      newarg.a = l;
+      newarg.b = b;
+      newarg.c = b + j0;
+      GEMM_TN(&newarg, NULL, NULL, sa, sb, 0);
+    }
+
+    newarg.m = j1 - j0;
+    newarg.a = l + j0;
+    newarg.b = b + j0;
+    TRSM_LTUU(&newarg, NULL, NULL, sa, sb, 0);
+
+    swap_block(nrhs, b, ldb, ipiv, j0, j1, 1);
+  }
+#endif
+
+  return 0;
+}
@@ -40,6 +40,9 @@ typedef BLASLONG blasint;
 typedef int blasint;
 #endif
 
+/* bfloat16 values are passed around as their raw 16-bit pattern */
+typedef unsigned short bfloat16;
+
 #if defined(XDOUBLE) || defined(DOUBLE)
 #define FLOATRET	FLOAT
 #else
@@ -1681,6 +1681,21 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #define SGEMM_DEFAULT_UNROLL_MN 32
 #define DGEMM_DEFAULT_UNROLL_MN 32
+
+/* bfloat16 panels pair up k values, so a 32x8 tile streams half the
+   bytes of the single precision one; a deeper Q keeps the A block in L2 */
+#undef  SHGEMM_DEFAULT_UNROLL_M
+#undef  SHGEMM_DEFAULT_UNROLL_N
+#undef  SHGEMM_DEFAULT_UNROLL_MN
+#undef  SHGEMM_DEFAULT_P
+#undef  SHGEMM_DEFAULT_Q
+#undef  SHGEMM_DEFAULT_R
+#define SHGEMM_DEFAULT_UNROLL_M 32
+#define SHGEMM_DEFAULT_UNROLL_N 8
+#define SHGEMM_DEFAULT_UNROLL_MN 32
+#define SHGEMM_DEFAULT_P 256
+#define SHGEMM_DEFAULT_Q 512
+#define SHGEMM_DEFAULT_R 4096
 #endif
 
 #ifdef ARCH_X86
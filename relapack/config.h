@@ -24,8 +24,8 @@
 #define BLAS_COMPLEX_FUNCTIONS_AS_ROUTINES COMPLEX_FUNCTIONS_AS_ROUTINES
 #define LAPACK_BLAS_COMPLEX_FUNCTIONS_AS_ROUTINES COMPLEX_FUNCTIONS_AS_ROUTINES
 
-// The BLAS-like extension xgemmt is provided by an external library.
-#define HAVE_XGEMMT 0
+// The BLAS-like extension xgemmt is provided by OpenBLAS itself.
+#define HAVE_XGEMMT 1
 
 
 ////////////////////////////
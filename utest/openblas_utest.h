@@ -38,8 +38,60 @@ USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ctest.h"
 
 #include <common.h>
+#include <cblas.h>
 #include <math.h>
 
 #define SINGLE_EPS 1e-04
 #define DOUBLE_EPS 1e-13
+
+/* Short repeating pattern in [-0.5, 0.5); products and sums stay well
+   scaled, so results can be checked with a tight tolerance */
+static __inline void utest_fill_pattern(double *x, BLASLONG len, BLASLONG seed)
+{
+	BLASLONG i;
+
+	for (i = 0; i < len; i++)
+		x[i] = (double)(((i + seed) * 7) % 23) / 23.0 - 0.5;
+}
+
+/* Reproducible values in [-1, 1) from a linear congruential generator,
+   the same sequence on every platform */
+static __inline void utest_fill_random(double *a, BLASLONG n, unsigned int seed)
+{
+	BLASLONG i;
+
+	for (i = 0; i < n; i++) {
+		seed = seed * 1103515245 + 12345;
+		a[i] = (double)((seed >> 8) & 0xffff) / 32768.0 - 1.0;
+	}
+}
+
+static __inline double utest_maxabs(BLASLONG n, const double *a)
+{
+	double r = 0.0;
+	BLASLONG i;
+
+	for (i = 0; i < n; i++)
+		if (fabs(a[i]) > r) r = fabs(a[i]);
+	return r;
+}
+
+/* Sets the thread count for a threaded check and returns the previous
+   one for the restore.  A failed assertion leaves the test through
+   longjmp, so an info check made in between has to put the count back
+   first: UTEST_ASSERT_EQUAL_THREADS does. */
+static __inline int utest_set_threads(int nthreads)
+{
+	int saved = openblas_get_num_threads();
+
+	openblas_set_num_threads(nthreads);
+	return saved;
+}
+
+#define UTEST_ASSERT_EQUAL_THREADS(saved, exp, real) \
+	do { \
+		if ((exp) != (real)) openblas_set_num_threads(saved); \
+		ASSERT_EQUAL(exp, real); \
+	} while (0)
+
 #endif
@@ -0,0 +1,274 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <string.h>
+
+/* Inputs are small dyadic values that bfloat16 holds exactly, so every
+   product and partial sum is exact in single precision and the results
+   can be compared against a plain reference with a tight tolerance. */
+
+static float bf16_val(bfloat16 x)
+{
+	unsigned int u = (unsigned int)x << 16;
+	float f;
+
+	memcpy(&f, &u, sizeof(f));
+	return f;
+}
+
+static bfloat16 bf16_bits(float f)
+{
+	unsigned int u;
+
+	memcpy(&u, &f, sizeof(u));
+	return (bfloat16)(u >> 16);
+}
+
+static void fill(bfloat16 *x, blasint len, blasint seed)
+{
+	blasint i;
+
+	for (i = 0; i < len; i++)
+		x[i] = bf16_bits((float)(((i + seed) * 7) % 9 - 4) / 4.0f);
+}
+
+static void fill_float(float *x, blasint len, blasint seed)
+{
+	blasint i;
+
+	for (i = 0; i < len; i++)
+		x[i] = (float)(((i + seed) * 5) % 11 - 5) / 8.0f;
+}
+
+CTEST(bf16, conversion)
+{
+	float in[8], out[8];
+	bfloat16 bf[8];
+	unsigned int nan_bits = 0x7f800001u;
+	int i;
+
+	in[0] = 1.0f;
+	in[1] = 1.0f + 1.0f / 256.0f;		/* tie, rounds down to even */
+	in[2] = 1.0f + 3.0f / 256.0f;		/* tie, rounds up to even */
+	in[3] = -(1.0f + 7.0f / 512.0f);	/* above the tie, rounds up */
+	in[4] = 3.0e38f;
+	in[5] = 1.0f / 0.0f;
+	memcpy(&in[6], &nan_bits, sizeof(float));	/* signalling NaN */
+	in[7] = 0.0f;
+
+	cblas_shstobf16(8, in, 1, bf, 1);
+
+	ASSERT_EQUAL(0x3f80, bf[0]);
+	ASSERT_EQUAL(0x3f80, bf[1]);
+	ASSERT_EQUAL(0x3f82, bf[2]);
+	ASSERT_EQUAL(0xbf82, bf[3]);
+	ASSERT_EQUAL(0x7f62, bf[4]);
+	ASSERT_EQUAL(0x7f80, bf[5]);
+	ASSERT_TRUE((bf[6] & 0x7f80) == 0x7f80 && (bf[6] & 0x007f) != 0);
+	ASSERT_EQUAL(0x0000, bf[7]);
+
+	cblas_shbf16tos(8, bf, 1, out, 1);
+	for (i = 0; i < 6; i++)
+		ASSERT_DBL_NEAR_TOL((double)bf16_val(bf[i]), (double)out[i], 0.0);
+	ASSERT_TRUE(out[6] != out[6]);
+}
+
+CTEST(bf16, conversion_long_strided)
+{
+	blasint n = 1037, i;
+	float *in, *out;
+	bfloat16 *bf;
+
+	in = (float *)malloc(2 * n * sizeof(float));
+	out = (float *)malloc(3 * n * sizeof(float));
+	bf = (bfloat16 *)malloc(n * sizeof(bfloat16));
+
+	fill_float(in, 2 * n, 1);
+	memset(out, 0, 3 * n * sizeof(float));
+
+	/* the values are exact in bfloat16 so the round trip is lossless;
+	   negative increments walk the vectors backwards */
+	cblas_shstobf16(n, in, 2, bf, 1);
+	cblas_shbf16tos(n, bf, -1, out, 3);
+
+	for (i = 0; i < n; i++)
+		ASSERT_DBL_NEAR_TOL((double)in[2 * i], (double)out[3 * (n - 1 - i)], 0.0);
+
+	free(in);
+	free(out);
+	free(bf);
+}
+
+static void check_shgemm(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE ta, enum CBLAS_TRANSPOSE tb,
+			 blasint m, blasint n, blasint k, float alpha, float beta)
+{
+	blasint lda, ldb, ldc, i, j, l, rows_a, rows_b;
+	bfloat16 *a, *b;
+	float *c, *ref;
+
+	/* column major view; a row major call is the transposed problem */
+	if (order == CblasRowMajor) {
+		blasint t = m;
+		enum CBLAS_TRANSPOSE tt = ta;
+		m = n;
+		n = t;
+		ta = tb;
+		tb = tt;
+	}
+
+	rows_a = (ta == CblasNoTrans) ? m : k;
+	rows_b = (tb == CblasNoTrans) ? k : n;
+	lda = rows_a + 3;
+	ldb = rows_b + 1;
+	ldc = m + 2;
+
+	a = (bfloat16 *)malloc((size_t)lda * MAX(m, k) * sizeof(bfloat16));
+	b = (bfloat16 *)malloc((size_t)ldb * MAX(n, k) * sizeof(bfloat16));
+	c = (float *)malloc((size_t)ldc * n * sizeof(float));
+	ref = (float *)malloc((size_t)ldc * n * sizeof(float));
+
+	fill(a, lda * MAX(m, k), 1);
+	fill(b, ldb * MAX(n, k), 2);
+	fill_float(c, ldc * n, 3);
+	fill_float(ref, ldc * n, 3);
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++) {
+			double sum = 0.0;
+			for (l = 0; l < k; l++) {
+				float av = bf16_val(ta == CblasNoTrans ? a[i + l * lda] : a[l + i * lda]);
+				float bv = bf16_val(tb == CblasNoTrans ? b[l + j * ldb] : b[j + l * ldb]);
+				sum += (double)av * (double)bv;
+			}
+			ref[i + j * ldc] = (float)(alpha * sum + beta * ref[i + j * ldc]);
+		}
+
+	if (order == CblasRowMajor)
+		cblas_shgemm(order, tb, ta, n, m, k, alpha, b, ldb, a, lda, beta, c, ldc);
+	else
+		cblas_shgemm(order, ta, tb, m, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < ldc; i++)
+			ASSERT_DBL_NEAR_TOL((double)ref[i + j * ldc], (double)c[i + j * ldc], 1e-4);
+
+	free(a);
+	free(b);
+	free(c);
+	free(ref);
+}
+
+CTEST(bf16, shgemm_small)
+{
+	check_shgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, 1, 1, 1, 0.5f, 1.5f);
+	check_shgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, 77, 45, 133, 0.5f, 1.5f);
+	check_shgemm(CblasColMajor, CblasTrans, CblasNoTrans, 33, 9, 18, 0.5f, 1.5f);
+	check_shgemm(CblasColMajor, CblasNoTrans, CblasTrans, 17, 15, 3, 0.5f, 1.5f);
+	check_shgemm(CblasColMajor, CblasTrans, CblasTrans, 49, 23, 64, 0.5f, 1.5f);
+}
+
+CTEST(bf16, shgemm_blocked)
+{
+	/* crosses the P and Q blocking with odd remainders */
+	check_shgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, 301, 67, 601, 0.5f, 1.5f);
+	check_shgemm(CblasColMajor, CblasTrans, CblasTrans, 263, 41, 517, 0.5f, 1.5f);
+	check_shgemm(CblasRowMajor, CblasNoTrans, CblasTrans, 95, 130, 257, 0.5f, 1.5f);
+}
+
+CTEST(bf16, shgemm_rowmajor_nn)
+{
+	/* alpha = 1, beta = 0 row major NN is the shape the direct sgemm
+	   kernel takes for float; bfloat16 must not go there */
+	check_shgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 64, 64, 64, 1.0f, 0.0f);
+	check_shgemm(CblasRowMajor, CblasNoTrans, CblasNoTrans, 64, 64, 64, 1.0f, 0.5f);
+}
+
+static void check_shgemv(enum CBLAS_TRANSPOSE trans, blasint m, blasint n, blasint incx, blasint incy, float beta)
+{
+	blasint lda = m + 5, lenx, leny, i, j;
+	float alpha = 0.25f;
+	bfloat16 *a, *x;
+	float *y, *ref;
+
+	lenx = (trans == CblasNoTrans) ? n : m;
+	leny = (trans == CblasNoTrans) ? m : n;
+
+	a = (bfloat16 *)malloc((size_t)lda * n * sizeof(bfloat16));
+	x = (bfloat16 *)malloc((size_t)lenx * abs(incx) * sizeof(bfloat16));
+	y = (float *)malloc((size_t)leny * abs(incy) * sizeof(float));
+	ref = (float *)malloc((size_t)leny * abs(incy) * sizeof(float));
+
+	fill(a, lda * n, 4);
+	fill(x, lenx * abs(incx), 5);
+	fill_float(y, leny * abs(incy), 6);
+	fill_float(ref, leny * abs(incy), 6);
+
+	for (i = 0; i < leny; i++) {
+		blasint iy = (incy > 0) ? i * incy : (leny - 1 - i) * -incy;
+		double sum = 0.0;
+		for (j = 0; j < lenx; j++) {
+			blasint ix = (incx > 0) ? j * incx : (lenx - 1 - j) * -incx;
+			float av = bf16_val(trans == CblasNoTrans ? a[i + j * lda] : a[j + i * lda]);
+			sum += (double)av * (double)bf16_val(x[ix]);
+		}
+		ref[iy] = (float)(alpha * sum + (beta == 0.0f ? 0.0 : beta * ref[iy]));
+	}
+
+	cblas_shgemv(CblasColMajor, trans, m, n, alpha, a, lda, x, incx, beta, y, incy);
+
+	for (i = 0; i < leny * abs(incy); i++)
+		ASSERT_DBL_NEAR_TOL((double)ref[i], (double)y[i], 1e-4);
+
+	free(a);
+	free(x);
+	free(y);
+	free(ref);
+}
+
+CTEST(bf16, shgemv_n)
+{
+	check_shgemv(CblasNoTrans, 1, 1, 1, 1, 1.0f);
+	check_shgemv(CblasNoTrans, 301, 77, 1, 1, 0.5f);
+	check_shgemv(CblasNoTrans, 129, 40, -2, 1, 0.0f);
+	check_shgemv(CblasNoTrans, 45, 31, 1, 3, 2.0f);
+}
+
+CTEST(bf16, shgemv_t)
+{
+	check_shgemv(CblasTrans, 1, 1, 1, 1, 1.0f);
+	check_shgemv(CblasTrans, 301, 77, 1, 1, 0.5f);
+	check_shgemv(CblasTrans, 129, 40, 1, -2, 0.0f);
+	check_shgemv(CblasTrans, 45, 31, 3, 1, 2.0f);
+}
@@ -0,0 +1,95 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+#define BUF_N 200
+
+static void buffer_totals(int *allocated, int *in_use)
+{
+	int node, nodes, a, u;
+
+	*allocated = 0;
+	*in_use = 0;
+	nodes = openblas_get_buffer_usage(0, NULL, NULL);
+	for (node = 0; node < nodes; node++) {
+		openblas_get_buffer_usage(node, &a, &u);
+		*allocated += a;
+		*in_use += u;
+	}
+}
+
+static void buffer_dgemm(double *a, double *b, double *c)
+{
+	cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, BUF_N, BUF_N, BUF_N,
+		    1.0, a, BUF_N, b, BUF_N, 0.0, c, BUF_N);
+}
+
+CTEST(buffer_usage, node_range)
+{
+	int nodes = openblas_get_buffer_usage(0, NULL, NULL);
+
+	ASSERT_TRUE(nodes >= 1);
+	ASSERT_EQUAL(-1, openblas_get_buffer_usage(-1, NULL, NULL));
+	ASSERT_EQUAL(-1, openblas_get_buffer_usage(nodes, NULL, NULL));
+}
+
+CTEST(buffer_usage, balanced_after_gemm)
+{
+	double *a, *b, *c;
+	int i, allocated, in_use, allocated2, in_use2;
+
+	a = (double *)malloc(sizeof(double) * BUF_N * BUF_N);
+	b = (double *)malloc(sizeof(double) * BUF_N * BUF_N);
+	c = (double *)malloc(sizeof(double) * BUF_N * BUF_N);
+	for (i = 0; i < BUF_N * BUF_N; i++) {
+		a[i] = 1.0;
+		b[i] = 2.0;
+	}
+
+	buffer_dgemm(a, b, c);
+	buffer_totals(&allocated, &in_use);
+	ASSERT_TRUE(allocated >= 1);
+	ASSERT_TRUE(in_use <= allocated);
+
+	/* buffers of the finished call went back to the pool */
+	buffer_dgemm(a, b, c);
+	buffer_totals(&allocated2, &in_use2);
+	ASSERT_EQUAL(in_use, in_use2);
+	ASSERT_EQUAL(allocated, allocated2);
+
+	free(a);
+	free(b);
+	free(c);
+}
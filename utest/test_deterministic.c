@@ -0,0 +1,152 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <string.h>
+
+/* With the deterministic switch on, results must not change by a single
+   bit between one thread and several.  The ?gemm depth lies between Q
+   and 2Q, where the threaded driver used to split K differently from the
+   single threaded one. */
+
+static void fill(double *a, blasint len, blasint seed)
+{
+	blasint i;
+
+	for (i = 0; i < len; i++)
+		a[i] = (double)((((BLASLONG)i + seed) * 7919) % 1009) / 1009.0 - 0.5 + 1e-7 * (i % 13);
+}
+
+static int threads[] = {1, 2, 3, 4};
+
+#define NTHREADS (int)(sizeof(threads) / sizeof(threads[0]))
+
+CTEST(deterministic, switch)
+{
+	int saved = openblas_get_deterministic();
+
+	openblas_set_deterministic(5);
+	ASSERT_EQUAL(1, openblas_get_deterministic());
+	openblas_set_deterministic(0);
+	ASSERT_EQUAL(0, openblas_get_deterministic());
+	openblas_set_deterministic(saved);
+}
+
+CTEST(deterministic, ddot)
+{
+	blasint n = 300007, i;
+	int saved = openblas_get_num_threads();
+	double *x = malloc(n * 2 * sizeof(double)), *y = malloc(n * 2 * sizeof(double));
+	double ref[2], dot;
+
+	fill(x, n * 2, 1);
+	fill(y, n * 2, 2);
+
+	openblas_set_deterministic(1);
+	for (i = 0; i < NTHREADS; i++) {
+		openblas_set_num_threads(threads[i]);
+		dot = cblas_ddot(n, x, 1, y, 1);
+		if (i == 0) ref[0] = dot;
+		ASSERT_TRUE(memcmp(&dot, &ref[0], sizeof(double)) == 0);
+
+		dot = cblas_ddot(n, x, -2, y, 2);
+		if (i == 0) ref[1] = dot;
+		ASSERT_TRUE(memcmp(&dot, &ref[1], sizeof(double)) == 0);
+	}
+	openblas_set_deterministic(0);
+	openblas_set_num_threads(saved);
+
+	ASSERT_DBL_NEAR_TOL(ref[0], cblas_ddot(n, x, 1, y, 1), 1e-9);
+
+	free(x);
+	free(y);
+}
+
+CTEST(deterministic, zdotu)
+{
+	blasint n = 200003, i;
+	int saved = openblas_get_num_threads();
+	double *x = malloc(n * 2 * sizeof(double)), *y = malloc(n * 2 * sizeof(double));
+	openblas_complex_double ref, dot;
+
+	fill(x, n * 2, 3);
+	fill(y, n * 2, 4);
+
+	openblas_set_deterministic(1);
+	for (i = 0; i < NTHREADS; i++) {
+		openblas_set_num_threads(threads[i]);
+		dot = cblas_zdotu(n, x, 1, y, 1);
+		if (i == 0) ref = dot;
+		ASSERT_TRUE(memcmp(&dot, &ref, sizeof(dot)) == 0);
+	}
+	openblas_set_deterministic(0);
+	openblas_set_num_threads(saved);
+
+	free(x);
+	free(y);
+}
+
+CTEST(deterministic, dgemm)
+{
+	blasint m = 301, n = 257, k, i;
+	int saved = openblas_get_num_threads(), p, q, r;
+	double *a, *b, *c, *ref;
+
+	openblas_get_gemm_blocking('d', &p, &q, &r);
+	k = q + q / 2 + 3;
+
+	a = malloc(m * k * sizeof(double));
+	b = malloc(k * n * sizeof(double));
+	c = malloc(m * n * sizeof(double));
+	ref = malloc(m * n * sizeof(double));
+	fill(a, m * k, 5);
+	fill(b, k * n, 6);
+
+	openblas_set_deterministic(1);
+	for (i = 0; i < NTHREADS; i++) {
+		openblas_set_num_threads(threads[i]);
+		memset(c, 0, m * n * sizeof(double));
+		cblas_dgemm(CblasColMajor, CblasNoTrans, CblasTrans, m, n, k,
+			    1.0, a, m, b, n, 0.0, c, m);
+		if (i == 0) memcpy(ref, c, m * n * sizeof(double));
+		ASSERT_TRUE(memcmp(c, ref, m * n * sizeof(double)) == 0);
+	}
+	openblas_set_deterministic(0);
+	openblas_set_num_threads(saved);
+
+	free(a);
+	free(b);
+	free(c);
+	free(ref);
+}
@@ -0,0 +1,178 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include "openblas_utest.h"
+
+/* Mixed precision solvers: the solution must have a double precision
+   residual, and ITER must report refinement (>= 0) or the reason for
+   falling back to the double precision solve (< 0). */
+
+/* max |B - A * X| over max |A| * max |X| */
+static double solve_residual(blasint n, blasint nrhs, double *a, double *b, double *x)
+{
+	double s, err = 0.0, anrm = 0.0, xnrm = 0.0;
+	blasint i, j, k;
+
+	for (i = 0; i < n * n; i++) if (fabs(a[i]) > anrm) anrm = fabs(a[i]);
+	for (i = 0; i < n * nrhs; i++) if (fabs(x[i]) > xnrm) xnrm = fabs(x[i]);
+
+	for (j = 0; j < nrhs; j++)
+		for (i = 0; i < n; i++) {
+			s = b[i + j * n];
+			for (k = 0; k < n; k++) s -= a[i + k * n] * x[k + j * n];
+			if (fabs(s) > err) err = fabs(s);
+		}
+
+	return err / (anrm * xnrm * n);
+}
+
+/* B * B' + n * I */
+static void spd(double *a, blasint n)
+{
+	double *b = (double *)malloc(sizeof(double) * n * n);
+	double one = 1.0, zero = 0.0;
+	char transa = 'N', transb = 'T';
+	blasint i;
+
+	utest_fill_random(b, (BLASLONG)n * n, n);
+	BLASFUNC(dgemm)(&transa, &transb, &n, &n, &n, &one, b, &n, b, &n, &zero, a, &n);
+	for (i = 0; i < n; i++) a[i + i * n] += n;
+
+	free(b);
+}
+
+static void check_gesv(blasint n, blasint nrhs, double big, int half, blasint iter_expect)
+{
+	double *a  = (double *)malloc(sizeof(double) * n * n);
+	double *a1 = (double *)malloc(sizeof(double) * n * n);
+	double *b  = (double *)malloc(sizeof(double) * n * nrhs);
+	double *x  = (double *)malloc(sizeof(double) * n * nrhs);
+	double *work = (double *)malloc(sizeof(double) * n * nrhs);
+	float *swork = (float *)malloc(sizeof(float) * n * (n + nrhs));
+	blasint *ipiv = (blasint *)malloc(sizeof(blasint) * n);
+	blasint iter, info, i;
+
+	utest_fill_random(a, (BLASLONG)n * n, n);
+	utest_fill_random(b, (BLASLONG)n * nrhs, nrhs);
+	for (i = 0; i < n; i++) a[i + i * n] += n;
+	if (big != 0.0) a[n - 1] = big;
+	for (i = 0; i < n * n; i++) a1[i] = a[i];
+
+#ifdef BUILD_HALF
+	if (half)
+		BLASFUNC(dshgesv)(&n, &nrhs, a1, &n, ipiv, b, &n, x, &n, work, swork, &iter, &info);
+	else
+#endif
+	BLASFUNC(dsgesv)(&n, &nrhs, a1, &n, ipiv, b, &n, x, &n, work, swork, &iter, &info);
+
+	ASSERT_EQUAL(0, info);
+	if (iter_expect < 0)
+		ASSERT_EQUAL(iter_expect, iter);
+	else
+		ASSERT_TRUE(iter >= 0);
+	ASSERT_TRUE(solve_residual(n, nrhs, a, b, x) < 1e-15);
+
+	free(a);
+	free(a1);
+	free(b);
+	free(x);
+	free(work);
+	free(swork);
+	free(ipiv);
+}
+
+static void check_posv(char uplo, blasint n, blasint nrhs, blasint iter_expect)
+{
+	double *a  = (double *)malloc(sizeof(double) * n * n);
+	double *a1 = (double *)malloc(sizeof(double) * n * n);
+	double *b  = (double *)malloc(sizeof(double) * n * nrhs);
+	double *x  = (double *)malloc(sizeof(double) * n * nrhs);
+	double *work = (double *)malloc(sizeof(double) * n * nrhs);
+	float *swork = (float *)malloc(sizeof(float) * n * (n + nrhs));
+	blasint iter, info, i;
+
+	if (iter_expect == -3) {
+		/* positive definite in double, singular once rounded to single */
+		for (i = 0; i < n * n; i++) a[i] = 1.0;
+		for (i = 1; i < n; i++) a[i + i * n] += 1e-10 * i;
+	} else
+		spd(a, n);
+	utest_fill_random(b, (BLASLONG)n * nrhs, nrhs);
+	for (i = 0; i < n * n; i++) a1[i] = a[i];
+
+	BLASFUNC(dsposv)(&uplo, &n, &nrhs, a1, &n, b, &n, x, &n, work, swork, &iter, &info);
+
+	ASSERT_EQUAL(0, info);
+	if (iter_expect < 0)
+		ASSERT_EQUAL(iter_expect, iter);
+	else
+		ASSERT_TRUE(iter >= 0);
+	ASSERT_TRUE(solve_residual(n, nrhs, a, b, x) < 1e-15);
+
+	free(a);
+	free(a1);
+	free(b);
+	free(x);
+	free(work);
+	free(swork);
+}
+
+CTEST(dsgesv, refine)
+{
+	check_gesv(300, 3, 0.0, 0, 0);
+}
+
+CTEST(dsgesv, overflow)
+{
+	check_gesv(50, 2, 1e300, 0, -2);
+}
+
+#ifdef BUILD_HALF
+CTEST(dshgesv, refine)
+{
+	check_gesv(600, 3, 0.0, 1, 0);
+}
+#endif
+
+CTEST(dsposv, refine)
+{
+	check_posv('L', 300, 3, 0);
+	check_posv('U', 300, 3, 0);
+}
+
+CTEST(dsposv, fallback)
+{
+	check_posv('L', 4, 1, -3);
+	check_posv('U', 4, 1, -3);
+}
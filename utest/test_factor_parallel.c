@@ -0,0 +1,191 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* ?getrf and ?potrf with four threads, on sizes that take the task
+   driver with look-ahead.  LU is checked through the residual
+   P * A - L * U; Cholesky against the factor computed on one thread.
+   The info of a singular or indefinite matrix must match as well. */
+
+#define FACTOR_THREADS 4
+
+/* max |P * A - L * U| over max |A| for the factors held in lu */
+static double getrf_residual(blasint m, blasint n, double *a, double *lu, blasint *ipiv)
+{
+	blasint mn = MIN(m, n), i, j, k;
+	double *pa = (double *)malloc(sizeof(double) * m * n);
+	double s, t, err = 0.0, norm = 0.0;
+
+	for (i = 0; i < m * n; i++) {
+		pa[i] = a[i];
+		if (fabs(a[i]) > norm) norm = fabs(a[i]);
+	}
+
+	for (i = 0; i < mn; i++)
+		if (ipiv[i] - 1 != i)
+			for (j = 0; j < n; j++) {
+				t = pa[i + j * m];
+				pa[i + j * m] = pa[ipiv[i] - 1 + j * m];
+				pa[ipiv[i] - 1 + j * m] = t;
+			}
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++) {
+			s = 0.0;
+			for (k = 0; k <= MIN(i, j) && k < mn; k++)
+				s += ((k == i) ? 1.0 : lu[i + k * m]) * lu[k + j * m];
+			if (fabs(pa[i + j * m] - s) > err) err = fabs(pa[i + j * m] - s);
+		}
+
+	free(pa);
+	return err / norm;
+}
+
+static void check_getrf(blasint m, blasint n, blasint zero)
+{
+	double *a  = (double *)malloc(sizeof(double) * m * n);
+	double *lu = (double *)malloc(sizeof(double) * m * n);
+	blasint *ipiv = (blasint *)malloc(sizeof(blasint) * MIN(m, n));
+	blasint info, info1, i;
+	int saved;
+
+	utest_fill_random(a, (BLASLONG)m * n, m + n);
+	if (zero >= 0)
+		for (i = 0; i < m; i++) a[i + zero * m] = 0.0;
+
+	for (i = 0; i < m * n; i++) lu[i] = a[i];
+	saved = utest_set_threads(1);
+	BLASFUNC(dgetrf)(&m, &n, lu, &m, ipiv, &info1);
+
+	for (i = 0; i < m * n; i++) lu[i] = a[i];
+	utest_set_threads(FACTOR_THREADS);
+	BLASFUNC(dgetrf)(&m, &n, lu, &m, ipiv, &info);
+	utest_set_threads(saved);
+
+	ASSERT_EQUAL(info1, info);
+	ASSERT_TRUE(getrf_residual(m, n, a, lu, ipiv) < 1e-12);
+
+	free(a);
+	free(lu);
+	free(ipiv);
+}
+
+CTEST(getrf, lookahead_square)
+{
+	check_getrf(600, 600, -1);
+}
+
+CTEST(getrf, lookahead_tall)
+{
+	check_getrf(700, 520, -1);
+}
+
+CTEST(getrf, lookahead_wide)
+{
+	check_getrf(410, 650, -1);
+}
+
+CTEST(getrf, lookahead_singular)
+{
+	check_getrf(600, 600, 450);
+}
+
+/* B * B' + n * I, with an optional negative entry on the diagonal */
+static void spd(double *a, blasint n, blasint bad)
+{
+	double *b = (double *)malloc(sizeof(double) * n * n);
+	double one = 1.0, zero = 0.0;
+	char transa = 'N', transb = 'T';
+	blasint i;
+
+	utest_fill_random(b, (BLASLONG)n * n, n);
+	BLASFUNC(dgemm)(&transa, &transb, &n, &n, &n, &one, b, &n, b, &n, &zero, a, &n);
+	for (i = 0; i < n; i++) a[i + i * n] += n;
+	if (bad >= 0) a[bad + bad * n] = -1e6;
+
+	free(b);
+}
+
+static void check_potrf(char uplo, blasint n, blasint bad)
+{
+	double *a  = (double *)malloc(sizeof(double) * n * n);
+	double *c1 = (double *)malloc(sizeof(double) * n * n);
+	double *c  = (double *)malloc(sizeof(double) * n * n);
+	blasint info, info1, i, j, lim;
+	double err = 0.0;
+	int saved;
+
+	spd(a, n, bad);
+
+	for (i = 0; i < n * n; i++) c1[i] = a[i];
+	saved = utest_set_threads(1);
+	BLASFUNC(dpotrf)(&uplo, &n, c1, &n, &info1);
+
+	for (i = 0; i < n * n; i++) c[i] = a[i];
+	utest_set_threads(FACTOR_THREADS);
+	BLASFUNC(dpotrf)(&uplo, &n, c, &n, &info);
+	utest_set_threads(saved);
+
+	ASSERT_EQUAL(info1, info);
+
+	/* Only the leading minor is factored when info is set */
+	lim = info ? info - 1 : n;
+	for (j = 0; j < lim; j++)
+		for (i = 0; i < lim; i++)
+			if (fabs(c[i + j * n] - c1[i + j * n]) > err)
+				err = fabs(c[i + j * n] - c1[i + j * n]);
+
+	ASSERT_TRUE(err < 1e-10);
+
+	free(a);
+	free(c1);
+	free(c);
+}
+
+CTEST(potrf, lookahead_lower)
+{
+	check_potrf('L', 620, -1);
+}
+
+CTEST(potrf, lookahead_upper)
+{
+	check_potrf('U', 620, -1);
+}
+
+CTEST(potrf, lookahead_indefinite)
+{
+	check_potrf('L', 620, 333);
+	check_potrf('U', 620, 333);
+}
@@ -0,0 +1,164 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* Every entry of a batch must give the same result as the matching
+   cblas_?gemm call. The batches mix small and packed-path shapes and
+   are long enough to be spread over several threads. */
+
+#define NGROUPS 3
+#define BATCH 12
+#define MAXDIM 40
+
+static void fill(double *x, blasint len, blasint seed)
+{
+	blasint i;
+
+	for (i = 0; i < len; i++)
+		x[i] = (double)(((i + seed) * 7) % 17) / 17.0 - 0.5;
+}
+
+CTEST(gemm_batch, dgemm_grouped)
+{
+	enum CBLAS_TRANSPOSE ta[NGROUPS] = {CblasNoTrans, CblasTrans, CblasNoTrans};
+	enum CBLAS_TRANSPOSE tb[NGROUPS] = {CblasNoTrans, CblasNoTrans, CblasTrans};
+	blasint m[NGROUPS] = {5, 40, 17}, n[NGROUPS] = {3, 33, 0}, k[NGROUPS] = {7, 29, 11};
+	blasint lda[NGROUPS], ldb[NGROUPS], ldc[NGROUPS];
+	blasint size[NGROUPS] = {5, 4, 3};
+	double alpha[NGROUPS] = {1.0, -0.5, 2.0}, beta[NGROUPS] = {0.0, 1.5, 1.0};
+	double *a[BATCH], *b[BATCH], *c[BATCH], *ref[BATCH];
+	blasint g, i, l, pos;
+
+	for (g = 0, pos = 0; g < NGROUPS; g++) {
+		lda[g] = MAXDIM;
+		ldb[g] = MAXDIM;
+		ldc[g] = MAXDIM;
+		for (i = 0; i < size[g]; i++, pos++) {
+			a[pos]   = (double *)malloc(MAXDIM * MAXDIM * sizeof(double));
+			b[pos]   = (double *)malloc(MAXDIM * MAXDIM * sizeof(double));
+			c[pos]   = (double *)malloc(MAXDIM * MAXDIM * sizeof(double));
+			ref[pos] = (double *)malloc(MAXDIM * MAXDIM * sizeof(double));
+			fill(a[pos], MAXDIM * MAXDIM, pos);
+			fill(b[pos], MAXDIM * MAXDIM, 3 * pos + 1);
+			fill(c[pos], MAXDIM * MAXDIM, 5 * pos + 2);
+			fill(ref[pos], MAXDIM * MAXDIM, 5 * pos + 2);
+			if (n[g] > 0)
+				cblas_dgemm(CblasColMajor, ta[g], tb[g], m[g], n[g], k[g], alpha[g],
+					    a[pos], lda[g], b[pos], ldb[g], beta[g], ref[pos], ldc[g]);
+		}
+	}
+
+	cblas_dgemm_batch(CblasColMajor, ta, tb, m, n, k, alpha, a, lda, b, ldb,
+			  beta, c, ldc, NGROUPS, size);
+
+	for (pos = 0; pos < BATCH; pos++) {
+		for (l = 0; l < MAXDIM * MAXDIM; l++)
+			ASSERT_DBL_NEAR_TOL(ref[pos][l], c[pos][l], DOUBLE_EPS);
+		free(a[pos]);
+		free(b[pos]);
+		free(c[pos]);
+		free(ref[pos]);
+	}
+}
+
+CTEST(gemm_batch, dgemm_strided_rowmajor)
+{
+	blasint m = 9, n = 6, k = 8, lda = 8, ldb = 9, ldc = 7;
+	blasint sa = 9 * 8, sb = 8 * 9, sc = 9 * 7;
+	double a[BATCH * 9 * 8], b[BATCH * 8 * 9], c[BATCH * 9 * 7], ref[BATCH * 9 * 7];
+	blasint i;
+
+	fill(a, BATCH * 9 * 8, 1);
+	fill(b, BATCH * 8 * 9, 2);
+	fill(c, BATCH * 9 * 7, 3);
+	fill(ref, BATCH * 9 * 7, 3);
+
+	/* A is m x k, B is n x k (transposed), both row major */
+	for (i = 0; i < BATCH; i++)
+		cblas_dgemm(CblasRowMajor, CblasNoTrans, CblasTrans, m, n, k, 0.75,
+			    a + i * sa, lda, b + i * sb, ldb, -1.0, ref + i * sc, ldc);
+
+	cblas_dgemm_batch_strided(CblasRowMajor, CblasNoTrans, CblasTrans, m, n, k, 0.75,
+				  a, lda, sa, b, ldb, sb, -1.0, c, ldc, sc, BATCH);
+
+	for (i = 0; i < BATCH * 9 * 7; i++)
+		ASSERT_DBL_NEAR_TOL(ref[i], c[i], DOUBLE_EPS);
+}
+
+CTEST(gemm_batch, sgemm_strided)
+{
+	blasint m = 4, n = 5, k = 3, s = 32;
+	float a[BATCH * 32], b[BATCH * 32], c[BATCH * 32], ref[BATCH * 32];
+	blasint i;
+
+	for (i = 0; i < BATCH * 32; i++) {
+		a[i] = (float)(i % 7) - 3.0f;
+		b[i] = (float)(i % 5) - 2.0f;
+		c[i] = ref[i] = (float)(i % 3);
+	}
+
+	for (i = 0; i < BATCH; i++)
+		cblas_sgemm(CblasColMajor, CblasTrans, CblasTrans, m, n, k, 1.0f,
+			    a + i * s, k, b + i * s, n, 0.5f, ref + i * s, m);
+
+	cblas_sgemm_batch_strided(CblasColMajor, CblasTrans, CblasTrans, m, n, k, 1.0f,
+				  a, k, s, b, n, s, 0.5f, c, m, s, BATCH);
+
+	for (i = 0; i < BATCH * 32; i++)
+		ASSERT_DBL_NEAR_TOL(ref[i], c[i], SINGLE_EPS);
+}
+
+CTEST(gemm_batch, zgemm_strided)
+{
+	blasint m = 6, n = 4, k = 5, s = 30;
+	double alpha[2] = {0.5, -1.0}, beta[2] = {1.0, 0.25};
+	double a[2 * BATCH * 30], b[2 * BATCH * 30], c[2 * BATCH * 30], ref[2 * BATCH * 30];
+	blasint i;
+
+	fill(a, 2 * BATCH * 30, 4);
+	fill(b, 2 * BATCH * 30, 5);
+	fill(c, 2 * BATCH * 30, 6);
+	fill(ref, 2 * BATCH * 30, 6);
+
+	for (i = 0; i < BATCH; i++)
+		cblas_zgemm(CblasColMajor, CblasConjTrans, CblasNoTrans, m, n, k, alpha,
+			    a + 2 * i * s, k, b + 2 * i * s, k, beta, ref + 2 * i * s, m);
+
+	cblas_zgemm_batch_strided(CblasColMajor, CblasConjTrans, CblasNoTrans, m, n, k, alpha,
+				  a, k, s, b, k, s, beta, c, m, s, BATCH);
+
+	for (i = 0; i < 2 * BATCH * 30; i++)
+		ASSERT_DBL_NEAR_TOL(ref[i], c[i], DOUBLE_EPS);
+}
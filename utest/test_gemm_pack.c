@@ -0,0 +1,134 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* ?gemm_compute with packed operands must match ?gemm on the same data.
+   The sizes cross GEMM_P / GEMM_Q so several k and m blocks are read
+   from the packed panels, and are not multiples of the unroll factors. */
+
+static void check_dgemm_compute(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE ta, enum CBLAS_TRANSPOSE tb,
+				int pack_a, int pack_b, blasint m, blasint n, blasint k)
+{
+	/* leading dimensions valid for either order and transpose */
+	blasint lda = MAX(m, k) + 1, ldb = MAX(n, k) + 2, ldc = MAX(m, n) + 3, i;
+	double alpha = 1.25, beta = -0.5;
+	double *a, *b, *c, *ref, *pa = NULL, *pb = NULL;
+
+	a = (double *)malloc((size_t)lda * MAX(m, k) * sizeof(double));
+	b = (double *)malloc((size_t)ldb * MAX(n, k) * sizeof(double));
+	c = (double *)malloc((size_t)ldc * MAX(m, n) * sizeof(double));
+	ref = (double *)malloc((size_t)ldc * MAX(m, n) * sizeof(double));
+
+	utest_fill_pattern(a, lda * MAX(m, k), 1);
+	utest_fill_pattern(b, ldb * MAX(n, k), 2);
+	utest_fill_pattern(c, ldc * MAX(m, n), 3);
+	utest_fill_pattern(ref, ldc * MAX(m, n), 3);
+
+	cblas_dgemm(order, ta, tb, m, n, k, alpha, a, lda, b, ldb, beta, ref, ldc);
+
+	if (pack_a) {
+		pa = (double *)malloc(cblas_dgemm_pack_get_size(CblasAMatrix, m, n, k));
+		cblas_dgemm_pack(order, CblasAMatrix, ta, m, n, k, alpha, a, lda, pa);
+	}
+	if (pack_b) {
+		pb = (double *)malloc(cblas_dgemm_pack_get_size(CblasBMatrix, m, n, k));
+		cblas_dgemm_pack(order, CblasBMatrix, tb, m, n, k, pack_a ? 1.0 : alpha, b, ldb, pb);
+	}
+
+	cblas_dgemm_compute(order, pack_a ? CblasPacked : ta, pack_b ? CblasPacked : tb, m, n, k,
+			    pack_a ? pa : a, lda, pack_b ? pb : b, ldb, beta, c, ldc);
+
+	for (i = 0; i < ldc * MAX(m, n); i++)
+		ASSERT_DBL_NEAR_TOL(ref[i], c[i], 1e-10);
+
+	free(a);
+	free(b);
+	free(c);
+	free(ref);
+	free(pa);
+	free(pb);
+}
+
+CTEST(gemm_pack, dgemm_packed_a)
+{
+	check_dgemm_compute(CblasColMajor, CblasNoTrans, CblasNoTrans, 1, 0, 301, 37, 530);
+	check_dgemm_compute(CblasColMajor, CblasTrans, CblasTrans, 1, 0, 45, 29, 77);
+}
+
+CTEST(gemm_pack, dgemm_packed_b)
+{
+	check_dgemm_compute(CblasColMajor, CblasNoTrans, CblasNoTrans, 0, 1, 93, 211, 419);
+	check_dgemm_compute(CblasColMajor, CblasTrans, CblasTrans, 0, 1, 17, 50, 33);
+}
+
+CTEST(gemm_pack, dgemm_packed_both_rowmajor)
+{
+	check_dgemm_compute(CblasRowMajor, CblasNoTrans, CblasTrans, 1, 1, 66, 71, 301);
+	check_dgemm_compute(CblasRowMajor, CblasTrans, CblasNoTrans, 0, 1, 19, 23, 5);
+}
+
+CTEST(gemm_pack, sgemm_packed_b)
+{
+	blasint m = 70, n = 45, k = 130, i, j, l;
+	float *a, *b, *c, *pb;
+	double ref;
+
+	a = (float *)malloc(m * k * sizeof(float));
+	b = (float *)malloc(k * n * sizeof(float));
+	c = (float *)malloc(m * n * sizeof(float));
+	for (i = 0; i < m * k; i++)
+		a[i] = (float)(i % 7) - 3.0f;
+	for (i = 0; i < k * n; i++)
+		b[i] = (float)(i % 5) - 2.0f;
+	for (i = 0; i < m * n; i++)
+		c[i] = 1.0f;
+
+	pb = (float *)malloc(cblas_sgemm_pack_get_size(CblasBMatrix, m, n, k));
+	cblas_sgemm_pack(CblasColMajor, CblasBMatrix, CblasNoTrans, m, n, k, 2.0f, b, k, pb);
+	cblas_sgemm_compute(CblasColMajor, CblasNoTrans, CblasPacked, m, n, k, a, m, pb, k, 1.0f, c, m);
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++) {
+			ref = 0.0;
+			for (l = 0; l < k; l++)
+				ref += a[i + l * m] * b[l + j * k];
+			ASSERT_DBL_NEAR_TOL(2.0 * ref + 1.0, c[i + j * m], 1e-3);
+		}
+
+	free(a);
+	free(b);
+	free(c);
+	free(pb);
+}
@@ -0,0 +1,179 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+
+/* Shapes small enough to take the unpacked small matrix path on targets
+   that have it, checked against a plain triple loop. Leading dimensions
+   are padded so that reads or writes outside the matrices show up. */
+
+#define SM 7
+#define SN 5
+#define SK 9
+#define LDPAD 3
+
+static void dgemm_ref(char ta, char tb, blasint m, blasint n, blasint k, double alpha,
+		      double *a, blasint lda, double *b, blasint ldb, double beta, double *c, blasint ldc)
+{
+	blasint i, j, l;
+	double s, av, bv;
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++) {
+			s = 0.0;
+			for (l = 0; l < k; l++) {
+				av = (ta == 'N') ? a[i + l * lda] : a[l + i * lda];
+				bv = (tb == 'N') ? b[l + j * ldb] : b[j + l * ldb];
+				s += av * bv;
+			}
+			c[i + j * ldc] = alpha * s + (beta == 0.0 ? 0.0 : beta * c[i + j * ldc]);
+		}
+}
+
+static void check_dgemm(char ta, char tb, double beta)
+{
+	blasint m = SM, n = SN, k = SK;
+	blasint lda = ((ta == 'N') ? m : k) + LDPAD;
+	blasint ldb = ((tb == 'N') ? k : n) + LDPAD;
+	blasint ldc = m + LDPAD;
+	double a[(SK + LDPAD) * SK], b[(SK + LDPAD) * SK];
+	double c1[(SM + LDPAD) * SN], c2[(SM + LDPAD) * SN];
+	double alpha = 1.5;
+	blasint i;
+
+	for (i = 0; i < (SK + LDPAD) * SK; i++) {
+		a[i] = (double)((i * 7) % 13) / 13.0 - 0.5;
+		b[i] = (double)((i * 5) % 11) / 11.0 - 0.5;
+	}
+	for (i = 0; i < (SM + LDPAD) * SN; i++)
+		c1[i] = c2[i] = (double)(i % 9) - 4.0;
+
+	BLASFUNC(dgemm)(&ta, &tb, &m, &n, &k, &alpha, a, &lda, b, &ldb, &beta, c1, &ldc);
+	dgemm_ref(ta, tb, m, n, k, alpha, a, lda, b, ldb, beta, c2, ldc);
+
+	for (i = 0; i < (SM + LDPAD) * SN; i++)
+		ASSERT_DBL_NEAR_TOL(c2[i], c1[i], DOUBLE_EPS);
+}
+
+CTEST(gemm_small, dgemm_nn)
+{
+	check_dgemm('N', 'N', 0.5);
+	check_dgemm('N', 'N', 0.0);
+}
+
+CTEST(gemm_small, dgemm_nt)
+{
+	check_dgemm('N', 'T', 0.5);
+	check_dgemm('N', 'T', 0.0);
+}
+
+CTEST(gemm_small, dgemm_tn)
+{
+	check_dgemm('T', 'N', 0.5);
+	check_dgemm('T', 'N', 0.0);
+}
+
+CTEST(gemm_small, dgemm_tt)
+{
+	check_dgemm('T', 'T', 0.5);
+	check_dgemm('T', 'T', 0.0);
+}
+
+CTEST(gemm_small, sgemm_nn)
+{
+	blasint m = SM, n = SN, k = SK, ld = SM + LDPAD, ldb = SK;
+	float a[(SM + LDPAD) * SK], b[SK * SN], c[(SM + LDPAD) * SN];
+	float alpha = 2.0f, beta = 0.0f;
+	double ref;
+	blasint i, j, l;
+
+	for (i = 0; i < (SM + LDPAD) * SK; i++)
+		a[i] = (float)(i % 5) - 2.0f;
+	for (i = 0; i < SK * SN; i++)
+		b[i] = (float)(i % 3) - 1.0f;
+	for (i = 0; i < (SM + LDPAD) * SN; i++)
+		c[i] = 99.0f;
+
+	BLASFUNC(sgemm)("N", "N", &m, &n, &k, &alpha, a, &ld, b, &ldb, &beta, c, &ld);
+
+	for (j = 0; j < n; j++) {
+		for (i = 0; i < m; i++) {
+			ref = 0.0;
+			for (l = 0; l < k; l++)
+				ref += a[i + l * ld] * b[l + j * ldb];
+			ASSERT_DBL_NEAR_TOL(alpha * ref, c[i + j * ld], SINGLE_EPS);
+		}
+		/* padding rows must not be touched */
+		for (; i < ld; i++)
+			ASSERT_DBL_NEAR_TOL(99.0, c[i + j * ld], SINGLE_EPS);
+	}
+}
+
+CTEST(gemm_small, zgemm_cn)
+{
+	blasint m = 3, n = 2, k = 4, lda = 4, ldb = 4, ldc = 3;
+	double alpha[2] = {1.0, 0.5}, beta[2] = {0.5, -1.0};
+	double a[2 * 4 * 3], b[2 * 4 * 2], c[2 * 3 * 2], ref[2 * 3 * 2];
+	double sr, si, ar, ai, br, bi, cr, ci;
+	blasint i, j, l;
+
+	for (i = 0; i < 2 * 4 * 3; i++)
+		a[i] = (double)((i * 3) % 7) - 3.0;
+	for (i = 0; i < 2 * 4 * 2; i++)
+		b[i] = (double)((i * 5) % 9) - 4.0;
+	for (i = 0; i < 2 * 3 * 2; i++)
+		c[i] = ref[i] = (double)(i % 4) - 1.5;
+
+	/* C = alpha * A**H * B + beta * C */
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++) {
+			sr = si = 0.0;
+			for (l = 0; l < k; l++) {
+				ar = a[2 * (l + i * lda)];
+				ai = -a[2 * (l + i * lda) + 1];
+				br = b[2 * (l + j * ldb)];
+				bi = b[2 * (l + j * ldb) + 1];
+				sr += ar * br - ai * bi;
+				si += ar * bi + ai * br;
+			}
+			cr = ref[2 * (i + j * ldc)];
+			ci = ref[2 * (i + j * ldc) + 1];
+			ref[2 * (i + j * ldc)] = alpha[0] * sr - alpha[1] * si + beta[0] * cr - beta[1] * ci;
+			ref[2 * (i + j * ldc) + 1] = alpha[0] * si + alpha[1] * sr + beta[0] * ci + beta[1] * cr;
+		}
+
+	BLASFUNC(zgemm)("C", "N", &m, &n, &k, alpha, a, &lda, b, &ldb, beta, c, &ldc);
+
+	for (i = 0; i < 2 * 3 * 2; i++)
+		ASSERT_DBL_NEAR_TOL(ref[i], c[i], DOUBLE_EPS);
+}
@@ -0,0 +1,108 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <stdio.h>
+#include <string.h>
+
+static int dynamic_arch(void)
+{
+	return strstr(openblas_get_config(), "DYNAMIC_ARCH") != NULL;
+}
+
+CTEST(gemm_tune, blocking)
+{
+	int p, q, r;
+
+	ASSERT_EQUAL(-1, openblas_get_gemm_blocking('x', &p, &q, &r));
+	ASSERT_EQUAL(0, openblas_get_gemm_blocking('d', &p, &q, &r));
+	ASSERT_TRUE(p > 0 && q > 0 && r > 0);
+	ASSERT_EQUAL(0, openblas_get_gemm_blocking('z', &p, &q, &r));
+	ASSERT_TRUE(p > 0 && q > 0 && r > 0);
+}
+
+#if !defined(_WIN32)
+#include <unistd.h>
+
+/* The tuner leaves one line per precision in the cache file, holding
+   the blocking sizes now in use, and ?gemm still computes the same. */
+CTEST(gemm_tune, tune)
+{
+	char path[] = "/tmp/openblas_gemm_blockingXXXXXX", line[256], core[64], sig[64], prec;
+	double a[4 * 300], b[300 * 5], c[4 * 5], s;
+	FILE *fp;
+	int fd, i, j, k, lines = 0, p, q, r, tp, tq, tr;
+
+	fd = mkstemp(path);
+	ASSERT_TRUE(fd >= 0);
+	close(fd);
+	setenv("OPENBLAS_GEMM_TUNE_FILE", path, 1);
+
+	if (!dynamic_arch()) {
+		ASSERT_EQUAL(-1, openblas_tune_gemm());
+	} else {
+		ASSERT_EQUAL(0, openblas_tune_gemm());
+
+		fp = fopen(path, "r");
+		ASSERT_TRUE(fp != NULL);
+		while (fgets(line, sizeof(line), fp)) {
+			if (line[0] == '#') continue;
+			ASSERT_EQUAL(6, sscanf(line, "%63s %63s %c %d %d %d", core, sig, &prec, &tp, &tq, &tr));
+			ASSERT_STR(openblas_get_corename(), core);
+			ASSERT_EQUAL(0, openblas_get_gemm_blocking(prec, &p, &q, &r));
+			ASSERT_EQUAL(tp, p);
+			ASSERT_EQUAL(tq, q);
+			ASSERT_EQUAL(tr, r);
+			lines++;
+		}
+		fclose(fp);
+		ASSERT_EQUAL(4, lines);
+
+		for (i = 0; i < 4 * 300; i++) a[i] = (double)(i % 7) - 3.0;
+		for (i = 0; i < 300 * 5; i++) b[i] = (double)(i % 5) - 2.0;
+		cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, 4, 5, 300,
+			    1.0, a, 4, b, 300, 0.0, c, 4);
+		for (j = 0; j < 5; j++)
+			for (i = 0; i < 4; i++) {
+				s = 0.0;
+				for (k = 0; k < 300; k++) s += a[i + k * 4] * b[k + j * 300];
+				ASSERT_DBL_NEAR_TOL(s, c[i + j * 4], 1e-10);
+			}
+	}
+
+	unsetenv("OPENBLAS_GEMM_TUNE_FILE");
+	remove(path);
+}
+#endif
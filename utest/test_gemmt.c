@@ -0,0 +1,151 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* ?gemmt must match ?gemm inside the selected triangle and leave the
+   other one untouched.  n crosses GEMM_P and is not a multiple of the
+   unroll factors so both full and diagonal tiles are exercised. */
+
+static int in_triangle(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo, blasint i, blasint j)
+{
+	/* i, j are the storage row / column of the column major view */
+	if (order == CblasRowMajor) {
+		blasint t = i;
+		i = j;
+		j = t;
+	}
+	return (uplo == CblasUpper) ? (i <= j) : (i >= j);
+}
+
+static void check_dgemmt(enum CBLAS_ORDER order, enum CBLAS_UPLO uplo,
+			 enum CBLAS_TRANSPOSE ta, enum CBLAS_TRANSPOSE tb, blasint n, blasint k)
+{
+	blasint lda = MAX(n, k) + 1, ldb = MAX(n, k) + 2, ldc = n + 3, i, j;
+	double alpha = 0.75, beta = 1.5;
+	double *a, *b, *c, *ref, *orig;
+
+	a = (double *)malloc((size_t)lda * MAX(n, k) * sizeof(double));
+	b = (double *)malloc((size_t)ldb * MAX(n, k) * sizeof(double));
+	c = (double *)malloc((size_t)ldc * n * sizeof(double));
+	ref = (double *)malloc((size_t)ldc * n * sizeof(double));
+	orig = (double *)malloc((size_t)ldc * n * sizeof(double));
+
+	utest_fill_pattern(a, lda * MAX(n, k), 1);
+	utest_fill_pattern(b, ldb * MAX(n, k), 2);
+	utest_fill_pattern(c, ldc * n, 3);
+	utest_fill_pattern(ref, ldc * n, 3);
+	utest_fill_pattern(orig, ldc * n, 3);
+
+	cblas_dgemm(order, ta, tb, n, n, k, alpha, a, lda, b, ldb, beta, ref, ldc);
+	cblas_dgemmt(order, uplo, ta, tb, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < ldc; i++) {
+			if (i < n && in_triangle(order, uplo, i, j))
+				ASSERT_DBL_NEAR_TOL(ref[i + j * ldc], c[i + j * ldc], 1e-10);
+			else
+				ASSERT_DBL_NEAR_TOL(orig[i + j * ldc], c[i + j * ldc], 0.0);
+		}
+
+	free(a);
+	free(b);
+	free(c);
+	free(ref);
+	free(orig);
+}
+
+CTEST(gemmt, dgemmt_upper)
+{
+	check_dgemmt(CblasColMajor, CblasUpper, CblasNoTrans, CblasNoTrans, 517, 301);
+	check_dgemmt(CblasColMajor, CblasUpper, CblasTrans, CblasNoTrans, 37, 45);
+	check_dgemmt(CblasColMajor, CblasUpper, CblasNoTrans, CblasTrans, 23, 7);
+}
+
+CTEST(gemmt, dgemmt_lower)
+{
+	check_dgemmt(CblasColMajor, CblasLower, CblasNoTrans, CblasNoTrans, 517, 301);
+	check_dgemmt(CblasColMajor, CblasLower, CblasTrans, CblasTrans, 61, 19);
+	check_dgemmt(CblasColMajor, CblasLower, CblasNoTrans, CblasTrans, 5, 130);
+}
+
+CTEST(gemmt, dgemmt_rowmajor)
+{
+	check_dgemmt(CblasRowMajor, CblasUpper, CblasNoTrans, CblasTrans, 99, 33);
+	check_dgemmt(CblasRowMajor, CblasLower, CblasTrans, CblasNoTrans, 70, 41);
+}
+
+CTEST(gemmt, zgemmt_conj)
+{
+	blasint n = 53, k = 29, lda = 60, ldb = 60, ldc = 55, i, j;
+	double alpha[2] = {0.5, -1.0}, beta[2] = {1.0, 0.25};
+	double *a, *b, *c, *ref;
+
+	a = (double *)malloc((size_t)2 * lda * n * sizeof(double));
+	b = (double *)malloc((size_t)2 * ldb * n * sizeof(double));
+	c = (double *)malloc((size_t)2 * ldc * n * sizeof(double));
+	ref = (double *)malloc((size_t)2 * ldc * n * sizeof(double));
+
+	utest_fill_pattern(a, 2 * lda * n, 4);
+	utest_fill_pattern(b, 2 * ldb * n, 5);
+	utest_fill_pattern(c, 2 * ldc * n, 6);
+	utest_fill_pattern(ref, 2 * ldc * n, 6);
+
+	/* lower triangle of conj(A)^T * B^T */
+	cblas_zgemm(CblasColMajor, CblasConjTrans, CblasTrans, n, n, k, alpha, a, lda, b, ldb, beta, ref, ldc);
+	cblas_zgemmt(CblasColMajor, CblasLower, CblasConjTrans, CblasTrans, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+
+	for (j = 0; j < n; j++)
+		for (i = j; i < n; i++) {
+			ASSERT_DBL_NEAR_TOL(ref[2 * (i + j * ldc)    ], c[2 * (i + j * ldc)    ], 1e-10);
+			ASSERT_DBL_NEAR_TOL(ref[2 * (i + j * ldc) + 1], c[2 * (i + j * ldc) + 1], 1e-10);
+		}
+
+	/* upper triangle of A * conj(B) */
+	utest_fill_pattern(c, 2 * ldc * n, 6);
+	utest_fill_pattern(ref, 2 * ldc * n, 6);
+	cblas_zgemm(CblasColMajor, CblasNoTrans, CblasConjTrans, n, n, k, alpha, a, lda, b, ldb, beta, ref, ldc);
+	cblas_zgemmt(CblasColMajor, CblasUpper, CblasNoTrans, CblasConjTrans, n, k, alpha, a, lda, b, ldb, beta, c, ldc);
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i <= j; i++) {
+			ASSERT_DBL_NEAR_TOL(ref[2 * (i + j * ldc)    ], c[2 * (i + j * ldc)    ], 1e-10);
+			ASSERT_DBL_NEAR_TOL(ref[2 * (i + j * ldc) + 1], c[2 * (i + j * ldc) + 1], 1e-10);
+		}
+
+	free(a);
+	free(b);
+	free(c);
+	free(ref);
+}
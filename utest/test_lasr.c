@@ -0,0 +1,188 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include "openblas_utest.h"
+
+/* ?LASR as the reference writes it: one rotation at a time over a whole
+   pair of rows or columns. */
+static void lasr_ref(char side, char pivot, char direct, blasint m, blasint n,
+		     double *c, double *s, double *a, blasint lda, int comp)
+{
+	blasint z = (side == 'L') ? m : n, o = (side == 'L') ? n : m;
+	blasint jj, j, p, q, i, r;
+	double t, *x, *y;
+
+	for (jj = 0; jj < z - 1; jj++) {
+		j = (direct == 'F') ? jj : z - 2 - jj;
+		if (c[j] == 1.0 && s[j] == 0.0) continue;
+		p = (pivot == 'T') ? 0 : j;
+		q = (pivot == 'B') ? z - 1 : j + 1;
+		for (i = 0; i < o; i++)
+			for (r = 0; r < comp; r++) {
+				if (side == 'L') {
+					x = a + (p + i * lda) * comp + r;
+					y = a + (q + i * lda) * comp + r;
+				} else {
+					x = a + (i + p * lda) * comp + r;
+					y = a + (i + q * lda) * comp + r;
+				}
+				t = *y;
+				*y = c[j] * t - s[j] * *x;
+				*x = s[j] * t + c[j] * *x;
+			}
+	}
+}
+
+static void fill(blasint len, double *a)
+{
+	blasint i;
+
+	for (i = 0; i < len; i++)
+		a[i] = sin(0.37 * i + 1.0);
+}
+
+static void angles(blasint k, double *c, double *s)
+{
+	blasint j;
+
+	for (j = 0; j < k; j++) {
+		c[j] = cos(0.3 * j + 0.1);
+		s[j] = sin(0.3 * j + 0.1);
+	}
+	/* identity rotations are skipped */
+	if (k > 3) {
+		c[3] = 1.0;
+		s[3] = 0.0;
+	}
+}
+
+CTEST(lasr, dlasr_all)
+{
+	char sides[] = "LR", pivots[] = "VTB", directs[] = "FB";
+	blasint m = 77, n = 45, lda = 80, i, a1, a2, a3;
+	double c[80], s[80], a[80 * 45], ar[80 * 45];
+
+	angles(80, c, s);
+
+	for (a1 = 0; a1 < 2; a1++)
+		for (a2 = 0; a2 < 3; a2++)
+			for (a3 = 0; a3 < 2; a3++) {
+				fill(lda * n, a);
+				fill(lda * n, ar);
+				lasr_ref(sides[a1], pivots[a2], directs[a3], m, n, c, s, ar, lda, 1);
+				BLASFUNC(dlasr)(sides + a1, pivots + a2, directs + a3, &m, &n, c, s, a, &lda);
+				for (i = 0; i < lda * n; i++)
+					ASSERT_DBL_NEAR_TOL(ar[i], a[i], DOUBLE_EPS);
+			}
+}
+
+/* Enough rows for the vector kernel and a tail, and a long wave */
+CTEST(lasr, dlasr_wave)
+{
+	blasint m = 1000 + 13, n = 301, lda = 1020, i, d;
+	char side = 'R', pivot = 'V', directs[] = "FB";
+	double *a = malloc(sizeof(double) * lda * n), *ar = malloc(sizeof(double) * lda * n);
+	double c[300], s[300];
+
+	angles(n - 1, c, s);
+
+	for (d = 0; d < 2; d++) {
+		fill(lda * n, a);
+		fill(lda * n, ar);
+		lasr_ref(side, pivot, directs[d], m, n, c, s, ar, lda, 1);
+		BLASFUNC(dlasr)(&side, &pivot, directs + d, &m, &n, c, s, a, &lda);
+		for (i = 0; i < lda * n; i++)
+			ASSERT_DBL_NEAR_TOL(ar[i], a[i], DOUBLE_EPS);
+	}
+
+	/* an identity rotation next to an infinity leaves no NaN behind */
+	fill(lda * n, a);
+	a[5 + 4 * lda] = 1.0 / 0.0;
+	c[3] = 1.0;
+	s[3] = 0.0;
+	c[4] = 1.0;
+	s[4] = 0.0;
+	BLASFUNC(dlasr)(&side, &pivot, directs, &m, &n, c, s, a, &lda);
+	ASSERT_TRUE(isinf(a[5 + 4 * lda]));
+	ASSERT_FALSE(isnan(a[5 + 3 * lda]));
+
+	free(a);
+	free(ar);
+}
+
+CTEST(lasr, slasr_wave)
+{
+	blasint m = 259, n = 40, lda = 259, i;
+	char side = 'R', pivot = 'V', direct = 'B';
+	float a[259 * 40], c[39], s[39];
+	double ad[259 * 40], cd[39], sd[39];
+
+	angles(n - 1, cd, sd);
+	fill(lda * n, ad);
+	for (i = 0; i < n - 1; i++) {
+		c[i] = cd[i];
+		s[i] = sd[i];
+		cd[i] = c[i];
+		sd[i] = s[i];
+	}
+	for (i = 0; i < lda * n; i++) {
+		a[i] = ad[i];
+		ad[i] = a[i];
+	}
+
+	lasr_ref(side, pivot, direct, m, n, cd, sd, ad, lda, 1);
+	BLASFUNC(slasr)(&side, &pivot, &direct, &m, &n, c, s, a, &lda);
+	for (i = 0; i < lda * n; i++)
+		ASSERT_DBL_NEAR_TOL(ad[i], a[i], SINGLE_EPS);
+}
+
+CTEST(lasr, zlasr)
+{
+	char sides[] = "LR", pivots[] = "VTB", directs[] = "FB";
+	blasint m = 37, n = 21, lda = 40, i, a1, a2, a3;
+	double c[40], s[40], a[2 * 40 * 21], ar[2 * 40 * 21];
+
+	angles(40, c, s);
+
+	for (a1 = 0; a1 < 2; a1++)
+		for (a2 = 0; a2 < 3; a2++)
+			for (a3 = 0; a3 < 2; a3++) {
+				fill(2 * lda * n, a);
+				fill(2 * lda * n, ar);
+				lasr_ref(sides[a1], pivots[a2], directs[a3], m, n, c, s, ar, lda, 2);
+				BLASFUNC(zlasr)(sides + a1, pivots + a2, directs + a3, &m, &n, c, s, a, &lda);
+				for (i = 0; i < 2 * lda * n; i++)
+					ASSERT_DBL_NEAR_TOL(ar[i], a[i], DOUBLE_EPS);
+			}
+}
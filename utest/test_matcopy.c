@@ -0,0 +1,169 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* ?omatcopy and ?imatcopy against a plain loop for both orders and
+   transposes.  The sizes are not multiples of the register tiles of the
+   transpose kernels, the largest ones are above the threading cutoff and
+   the in-place cases change the leading dimension and the shape. */
+
+/* expected element (i, j) of the column major view of the result, -1 if
+   the position lies in the padding of ldb */
+static double expect(const double *a, int trans, blasint m, blasint n,
+		     blasint lda, double alpha, blasint i, blasint j)
+{
+	/* a is m x n, b is m x n or n x m */
+	if (!trans)
+		return (i < m) ? alpha * a[i + j * lda] : -1.0;
+	return (i < n) ? alpha * a[j + i * lda] : -1.0;
+}
+
+static void check_domatcopy(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+			    blasint rows, blasint cols, double alpha)
+{
+	int t = (trans == CblasTrans);
+	/* m x n is the column major view of a */
+	blasint m = (order == CblasColMajor) ? rows : cols;
+	blasint n = (order == CblasColMajor) ? cols : rows;
+	blasint lda = m + 3, ldb = (t ? n : m) + 2, bcols = t ? m : n, i, j;
+	double *a, *b;
+
+	a = (double *)malloc((size_t)lda * n * sizeof(double));
+	b = (double *)malloc((size_t)ldb * bcols * sizeof(double));
+
+	utest_fill_pattern(a, lda * n, 1);
+	for (i = 0; i < ldb * bcols; i++) b[i] = -1.0;
+
+	cblas_domatcopy(order, trans, rows, cols, alpha, a, lda, b, ldb);
+
+	for (j = 0; j < bcols; j++)
+		for (i = 0; i < ldb; i++)
+			ASSERT_DBL_NEAR_TOL(expect(a, t, m, n, lda, alpha, i, j), b[i + j * ldb], 0.0);
+
+	free(a);
+	free(b);
+}
+
+static void check_somatcopy(enum CBLAS_ORDER order, blasint rows, blasint cols)
+{
+	blasint m = (order == CblasColMajor) ? rows : cols;
+	blasint n = (order == CblasColMajor) ? cols : rows;
+	blasint lda = m + 1, ldb = n + 5, i, j;
+	float *a, *b;
+
+	a = (float *)malloc((size_t)lda * n * sizeof(float));
+	b = (float *)malloc((size_t)ldb * m * sizeof(float));
+
+	for (i = 0; i < lda * n; i++) a[i] = (float)(i % 97) - 40.0f;
+
+	cblas_somatcopy(order, CblasTrans, rows, cols, 2.0f, a, lda, b, ldb);
+
+	for (j = 0; j < m; j++)
+		for (i = 0; i < n; i++)
+			ASSERT_DBL_NEAR_TOL(2.0 * a[j + i * lda], b[i + j * ldb], 0.0);
+
+	free(a);
+	free(b);
+}
+
+static void check_dimatcopy(enum CBLAS_ORDER order, enum CBLAS_TRANSPOSE trans,
+			    blasint rows, blasint cols, blasint lda, blasint ldb, double alpha)
+{
+	int t = (trans == CblasTrans);
+	blasint m = (order == CblasColMajor) ? rows : cols;
+	blasint n = (order == CblasColMajor) ? cols : rows;
+	blasint bcols = t ? m : n, bm = t ? n : m, size, i, j;
+	double *a, *orig;
+
+	size = MAX(lda * n, ldb * bcols);
+	a = (double *)malloc((size_t)size * sizeof(double));
+	orig = (double *)malloc((size_t)size * sizeof(double));
+
+	utest_fill_pattern(a, size, 2);
+	utest_fill_pattern(orig, size, 2);
+
+	cblas_dimatcopy(order, trans, rows, cols, alpha, a, lda, ldb);
+
+	for (j = 0; j < bcols; j++)
+		for (i = 0; i < bm; i++)
+			ASSERT_DBL_NEAR_TOL(expect(orig, t, m, n, lda, alpha, i, j), a[i + j * ldb], 0.0);
+
+	free(a);
+	free(orig);
+}
+
+CTEST(matcopy, domatcopy_colmajor)
+{
+	check_domatcopy(CblasColMajor, CblasNoTrans, 37, 45, 0.5);
+	check_domatcopy(CblasColMajor, CblasTrans, 1, 1, 1.0);
+	check_domatcopy(CblasColMajor, CblasTrans, 37, 45, 0.5);
+	check_domatcopy(CblasColMajor, CblasTrans, 131, 7, 0.0);
+	check_domatcopy(CblasColMajor, CblasTrans, 517, 613, -1.5);
+	check_domatcopy(CblasColMajor, CblasNoTrans, 613, 517, 2.0);
+}
+
+CTEST(matcopy, domatcopy_rowmajor)
+{
+	check_domatcopy(CblasRowMajor, CblasNoTrans, 45, 37, 0.5);
+	check_domatcopy(CblasRowMajor, CblasTrans, 45, 37, 0.5);
+	check_domatcopy(CblasRowMajor, CblasTrans, 9, 300, 1.0);
+	check_domatcopy(CblasRowMajor, CblasTrans, 613, 517, 3.0);
+	check_domatcopy(CblasRowMajor, CblasNoTrans, 517, 613, -1.0);
+}
+
+CTEST(matcopy, somatcopy_trans)
+{
+	check_somatcopy(CblasColMajor, 33, 50);
+	check_somatcopy(CblasColMajor, 70, 17);
+	check_somatcopy(CblasRowMajor, 50, 33);
+	check_somatcopy(CblasRowMajor, 600, 530);
+}
+
+CTEST(matcopy, dimatcopy_inplace)
+{
+	/* square with lda == ldb stays with the kernels */
+	check_dimatcopy(CblasColMajor, CblasTrans, 40, 40, 40, 40, 2.0);
+	/* shape changes follow the permutation cycles */
+	check_dimatcopy(CblasColMajor, CblasTrans, 37, 45, 37, 45, 1.0);
+	check_dimatcopy(CblasColMajor, CblasTrans, 37, 45, 40, 50, 0.5);
+	check_dimatcopy(CblasColMajor, CblasTrans, 1, 64, 1, 64, -1.0);
+	check_dimatcopy(CblasRowMajor, CblasTrans, 45, 37, 37, 45, 1.0);
+	check_dimatcopy(CblasRowMajor, CblasTrans, 45, 37, 39, 46, 3.0);
+	check_dimatcopy(CblasColMajor, CblasTrans, 30, 30, 31, 33, 1.0);
+	/* only the leading dimension changes */
+	check_dimatcopy(CblasColMajor, CblasNoTrans, 37, 45, 40, 37, 0.5);
+	check_dimatcopy(CblasColMajor, CblasNoTrans, 37, 45, 37, 50, 0.0);
+	check_dimatcopy(CblasRowMajor, CblasNoTrans, 45, 37, 50, 40, 1.0);
+}
@@ -0,0 +1,157 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <string.h>
+
+/* Reference norm: scaled by the largest magnitude, summed in long double */
+static double reference(blasint n, double *x, blasint inc)
+{
+	long double scale = 0.0L, sum = 0.0L, t;
+	blasint i;
+
+	for (i = 0; i < n; i++)
+		if (fabsl((long double)x[i * inc]) > scale) scale = fabsl((long double)x[i * inc]);
+	if (scale == 0.0L) return 0.0;
+	for (i = 0; i < n; i++) {
+		t = x[i * inc] / scale;
+		sum += t * t;
+	}
+	return (double)(scale * sqrtl(sum));
+}
+
+static void fill(double *x, blasint len, double scale)
+{
+	blasint i;
+
+	for (i = 0; i < len; i++)
+		x[i] = scale * ((double)((i * 7919) % 1013) / 1013.0 - 0.5) * ((i % 5) ? 1.0 : 1e-3);
+}
+
+static void check(double scale)
+{
+	blasint sizes[] = {1, 7, 16, 37, 100, 1031}, incs[] = {1, 2, 3};
+	blasint s, k, n, inc;
+	double *x = malloc(2 * 1031 * 3 * sizeof(double)), ref, norm;
+
+	for (s = 0; s < (blasint)(sizeof(sizes) / sizeof(sizes[0])); s++) {
+		for (k = 0; k < 3; k++) {
+			n = sizes[s];
+			inc = incs[k];
+			fill(x, 2 * n * inc, scale);
+
+			ref  = reference(n, x, inc);
+			norm = BLASFUNC(dnrm2)(&n, x, &inc);
+			ASSERT_TRUE(fabs(norm - ref) <= 1e-14 * ref);
+
+			/* the complex vector holds the real one's elements
+			   in pairs, so it is the norm of 2n reals at stride 1
+			   when inc is 1 */
+			if (inc == 1) {
+				blasint n2 = 2 * n;
+				ref  = reference(n2, x, 1);
+				norm = BLASFUNC(dznrm2)(&n, x, &inc);
+				ASSERT_TRUE(fabs(norm - ref) <= 1e-14 * ref);
+			}
+		}
+	}
+
+	free(x);
+}
+
+CTEST(nrm2, dnrm2_scaled)
+{
+	check(1.0);
+	check(1e300);
+	check(1e-300);
+	check(1e-160);
+	check(1e160);
+}
+
+CTEST(nrm2, dnrm2_mixed)
+{
+	blasint n = 40, inc = 1, i;
+	double x[40];
+
+	for (i = 0; i < n; i++)
+		x[i] = (i % 3 == 0) ? 1e300 : (i % 3 == 1) ? 1e-300 : 1.0;
+	ASSERT_DBL_NEAR_TOL(reference(n, x, 1) / 1e300, BLASFUNC(dnrm2)(&n, x, &inc) / 1e300, 1e-14);
+
+	for (i = 0; i < n; i++)
+		x[i] = 1e-310 * (i + 1);
+	ASSERT_DBL_NEAR_TOL(reference(n, x, 1) / 1e-308, BLASFUNC(dnrm2)(&n, x, &inc) / 1e-308, 1e-12);
+}
+
+CTEST(nrm2, dnrm2_special)
+{
+	blasint n = 40, inc = 1, zero = 0, i;
+	double x[40];
+
+	for (i = 0; i < n; i++)
+		x[i] = i + 1.0;
+	x[17] = 1.0 / 0.0;
+	ASSERT_TRUE(isinf(BLASFUNC(dnrm2)(&n, x, &inc)));
+	x[23] = 0.0 / 0.0;
+	ASSERT_TRUE(isnan(BLASFUNC(dnrm2)(&n, x, &inc)));
+	ASSERT_TRUE(isnan(BLASFUNC(dznrm2)(&n, x, &inc)));
+	ASSERT_DBL_NEAR_TOL(0.0, BLASFUNC(dnrm2)(&n, x, &zero), 0.0);
+}
+
+/* Long enough to run threaded: the result is the same for any number of
+   threads and close to the reference. */
+CTEST(nrm2, dnrm2_threads)
+{
+	blasint n = 300007, inc = 1, i, threads[] = {1, 2, 3, 4};
+	int saved = openblas_get_num_threads();
+	double *x = malloc(2 * n * sizeof(double)), ref = 0.0, zref = 0.0, norm, znorm;
+
+	fill(x, 2 * n, 1e200);
+
+	for (i = 0; i < 4; i++) {
+		openblas_set_num_threads(threads[i]);
+		norm  = BLASFUNC(dnrm2)(&n, x, &inc);
+		znorm = BLASFUNC(dznrm2)(&n, x, &inc);
+		if (i == 0) {
+			ref  = norm;
+			zref = znorm;
+		}
+		ASSERT_TRUE(memcmp(&norm, &ref, sizeof(double)) == 0);
+		ASSERT_TRUE(memcmp(&znorm, &zref, sizeof(double)) == 0);
+	}
+	openblas_set_num_threads(saved);
+
+	ASSERT_TRUE(fabs(ref - reference(n, x, 1)) <= 1e-13 * ref);
+
+	free(x);
+}
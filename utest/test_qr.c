@@ -0,0 +1,230 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <string.h>
+
+/* Native ?geqrf and ?ormqr.  Q' A must give back R with zeros below the
+   diagonal and Q R must give back A; C Q is checked against (Q' C')'.
+   Sizes span one block, several blocks and the look-ahead driver, and
+   the factors from four threads must match those from one. */
+
+#define QR_THREADS 4
+
+/* Factor A (m by n), returns max |Q' A - R| + max |Q R - A| over max |A| */
+static double check_dgeqrf(blasint m, blasint n, int nthreads)
+{
+	double *a   = (double *)malloc(sizeof(double) * m * n);
+	double *qr  = (double *)malloc(sizeof(double) * m * n);
+	double *c   = (double *)malloc(sizeof(double) * m * n);
+	double *tau = (double *)malloc(sizeof(double) * MIN(m, n));
+	double *work, query, err = 0.0;
+	blasint k = MIN(m, n), lwork = -1, info, i, j;
+	char left = 'L', notrans = 'N', trans = 'T';
+	int saved;
+
+	utest_fill_random(a, (BLASLONG)m * n, m * 7 + n);
+	for (i = 0; i < m * n; i++) qr[i] = a[i];
+
+	BLASFUNC(dgeqrf)(&m, &n, qr, &m, tau, &query, &lwork, &info);
+	ASSERT_EQUAL(0, info);
+	ASSERT_TRUE(query >= n);
+	lwork = (blasint)query;
+	work = (double *)malloc(sizeof(double) * lwork);
+
+	saved = utest_set_threads(nthreads);
+	BLASFUNC(dgeqrf)(&m, &n, qr, &m, tau, work, &lwork, &info);
+	UTEST_ASSERT_EQUAL_THREADS(saved, 0, info);
+
+	/* Q' A = R */
+	for (i = 0; i < m * n; i++) c[i] = a[i];
+	BLASFUNC(dormqr)(&left, &trans, &m, &n, &k, qr, &m, tau, c, &m, work, &lwork, &info);
+	UTEST_ASSERT_EQUAL_THREADS(saved, 0, info);
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++)
+			c[i + j * m] -= (i <= j) ? qr[i + j * m] : 0.0;
+	err = utest_maxabs((BLASLONG)m * n, c);
+
+	/* Q R = A, with the minimal workspace */
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++)
+			c[i + j * m] = (i <= j) ? qr[i + j * m] : 0.0;
+	lwork = n;
+	BLASFUNC(dormqr)(&left, &notrans, &m, &n, &k, qr, &m, tau, c, &m, work, &lwork, &info);
+	UTEST_ASSERT_EQUAL_THREADS(saved, 0, info);
+	for (i = 0; i < m * n; i++) c[i] -= a[i];
+	err += utest_maxabs((BLASLONG)m * n, c);
+
+	utest_set_threads(saved);
+
+	err /= utest_maxabs((BLASLONG)m * n, a);
+
+	free(a);
+	free(qr);
+	free(c);
+	free(tau);
+	free(work);
+	return err;
+}
+
+CTEST(qr, dgeqrf_small)
+{
+	ASSERT_TRUE(check_dgeqrf(5, 3, 1) < 1e-14);
+	ASSERT_TRUE(check_dgeqrf(3, 5, 1) < 1e-14);
+	ASSERT_TRUE(check_dgeqrf(1, 1, 1) < 1e-14);
+	ASSERT_TRUE(check_dgeqrf(70, 70, 1) < 1e-13);
+}
+
+CTEST(qr, dgeqrf_blocks)
+{
+	ASSERT_TRUE(check_dgeqrf(400, 230, 1) < 1e-12);
+	ASSERT_TRUE(check_dgeqrf(230, 400, 1) < 1e-12);
+	ASSERT_TRUE(check_dgeqrf(1000, 130, 1) < 1e-12);
+}
+
+CTEST(qr, dgeqrf_threads)
+{
+	ASSERT_TRUE(check_dgeqrf(700, 520, QR_THREADS) < 1e-12);
+	ASSERT_TRUE(check_dgeqrf(410, 650, QR_THREADS) < 1e-12);
+}
+
+CTEST(qr, dgeqrf_invariant)
+{
+	blasint m = 650, n = 600, lwork = -1, info, i;
+	double *a  = (double *)malloc(sizeof(double) * m * n);
+	double *a1 = (double *)malloc(sizeof(double) * m * n);
+	double *tau  = (double *)malloc(sizeof(double) * n);
+	double *tau1 = (double *)malloc(sizeof(double) * n);
+	double *work, query;
+	int saved;
+
+	utest_fill_random(a, (BLASLONG)m * n, 11);
+	for (i = 0; i < m * n; i++) a1[i] = a[i];
+
+	BLASFUNC(dgeqrf)(&m, &n, a, &m, tau, &query, &lwork, &info);
+	lwork = (blasint)query;
+	work = (double *)malloc(sizeof(double) * lwork);
+
+	saved = utest_set_threads(1);
+	BLASFUNC(dgeqrf)(&m, &n, a1, &m, tau1, work, &lwork, &info);
+	utest_set_threads(QR_THREADS);
+	BLASFUNC(dgeqrf)(&m, &n, a, &m, tau, work, &lwork, &info);
+	utest_set_threads(saved);
+
+	ASSERT_TRUE(memcmp(a, a1, sizeof(double) * m * n) == 0);
+	ASSERT_TRUE(memcmp(tau, tau1, sizeof(double) * n) == 0);
+
+	free(a);
+	free(a1);
+	free(tau);
+	free(tau1);
+	free(work);
+}
+
+/* C Q and C Q' against (Q' C')' and (Q C')' */
+CTEST(qr, dormqr_right)
+{
+	blasint m = 300, n = 180, p = 150, k = 180, lwork, info, i, j, t;
+	double *a   = (double *)malloc(sizeof(double) * m * n);
+	double *tau = (double *)malloc(sizeof(double) * n);
+	double *c   = (double *)malloc(sizeof(double) * p * m);
+	double *ct  = (double *)malloc(sizeof(double) * m * p);
+	double *work, err = 0.0;
+	char left = 'L', right = 'R', trans[2] = { 'N', 'T' };
+
+	utest_fill_random(a, (BLASLONG)m * n, 5);
+	lwork = 64 * (64 + m + 64);
+	work = (double *)malloc(sizeof(double) * lwork);
+	BLASFUNC(dgeqrf)(&m, &n, a, &m, tau, work, &lwork, &info);
+	ASSERT_EQUAL(0, info);
+
+	for (t = 0; t < 2; t++) {
+		utest_fill_random(c, (BLASLONG)p * m, 9);
+		for (j = 0; j < m; j++)
+			for (i = 0; i < p; i++) ct[j + i * m] = c[i + j * p];
+
+		BLASFUNC(dormqr)(&right, trans + t, &p, &m, &k, a, &m, tau, c, &p, work, &lwork, &info);
+		ASSERT_EQUAL(0, info);
+		BLASFUNC(dormqr)(&left, trans + 1 - t, &m, &p, &k, a, &m, tau, ct, &m, work, &lwork, &info);
+		ASSERT_EQUAL(0, info);
+
+		for (j = 0; j < m; j++)
+			for (i = 0; i < p; i++)
+				if (fabs(c[i + j * p] - ct[j + i * m]) > err)
+					err = fabs(c[i + j * p] - ct[j + i * m]);
+	}
+
+	ASSERT_TRUE(err < 1e-12);
+
+	free(a);
+	free(tau);
+	free(c);
+	free(ct);
+	free(work);
+}
+
+CTEST(qr, sgeqrf)
+{
+	blasint m = 260, n = 190, k = 190, lwork = 64 * (3 * 64 + 190), info, i, j;
+	float *a   = (float *)malloc(sizeof(float) * m * n);
+	float *c   = (float *)malloc(sizeof(float) * m * n);
+	float *tau = (float *)malloc(sizeof(float) * n);
+	float *work = (float *)malloc(sizeof(float) * lwork);
+	double err = 0.0, norm = 0.0;
+	char left = 'L', trans = 'T';
+
+	for (i = 0; i < m * n; i++) {
+		a[i] = c[i] = (float)sin(0.7 * i + 0.3);
+		if (fabs(a[i]) > norm) norm = fabs(a[i]);
+	}
+
+	BLASFUNC(sgeqrf)(&m, &n, a, &m, tau, work, &lwork, &info);
+	ASSERT_EQUAL(0, info);
+	BLASFUNC(sormqr)(&left, &trans, &m, &n, &k, a, &m, tau, c, &m, work, &lwork, &info);
+	ASSERT_EQUAL(0, info);
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < m; i++) {
+			double d = c[i + j * m] - ((i <= j) ? a[i + j * m] : 0.0f);
+			if (fabs(d) > err) err = fabs(d);
+		}
+
+	ASSERT_TRUE(err / norm < 1e-4);
+
+	free(a);
+	free(c);
+	free(tau);
+	free(work);
+}
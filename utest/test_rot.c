@@ -110,3 +110,108 @@ CTEST(rot, csrot_inc_0)
 		ASSERT_DBL_NEAR_TOL(y2[i], y1[i], SINGLE_EPS);
 	}
 }
+
+/* Long vectors, so that the vector kernels run, with a tail left over */
+CTEST(rot, drot_long)
+{
+	blasint i, k, n = 1003, incs[] = {1, 2, -1};
+	double c = 0.6, s = -0.8, x[2 * 1003], y[2 * 1003], xr[2 * 1003], yr[2 * 1003];
+
+	for (k = 0; k < 3; k++) {
+		blasint inc = incs[k], len = n * (inc < 0 ? -inc : inc);
+
+		for (i = 0; i < len; i++) {
+			xr[i] = x[i] = sin(i + 1.0);
+			yr[i] = y[i] = cos(3.0 * i);
+		}
+		for (i = 0; i < len; i++) {
+			double t = c * xr[i] + s * yr[i];
+			yr[i] = c * yr[i] - s * xr[i];
+			xr[i] = t;
+		}
+		if (inc == 2)
+			for (i = 1; i < len; i += 2) {
+				xr[i] = x[i];
+				yr[i] = y[i];
+			}
+
+		BLASFUNC(drot)(&n, x, &inc, y, &inc, &c, &s);
+
+		for (i = 0; i < len; i++) {
+			ASSERT_DBL_NEAR_TOL(xr[i], x[i], DOUBLE_EPS);
+			ASSERT_DBL_NEAR_TOL(yr[i], y[i], DOUBLE_EPS);
+		}
+	}
+}
+
+CTEST(rot, srot_long)
+{
+	blasint i, n = 1003, inc = 1;
+	float c = 0.6f, s = 0.8f, x[1003], y[1003], xr[1003], yr[1003];
+
+	for (i = 0; i < n; i++) {
+		xr[i] = x[i] = sinf(i + 1.0f);
+		yr[i] = y[i] = cosf(3.0f * i);
+	}
+	for (i = 0; i < n; i++) {
+		float t = c * xr[i] + s * yr[i];
+		yr[i] = c * yr[i] - s * xr[i];
+		xr[i] = t;
+	}
+
+	BLASFUNC(srot)(&n, x, &inc, y, &inc, &c, &s);
+
+	for (i = 0; i < n; i++) {
+		ASSERT_DBL_NEAR_TOL(xr[i], x[i], SINGLE_EPS);
+		ASSERT_DBL_NEAR_TOL(yr[i], y[i], SINGLE_EPS);
+	}
+}
+
+/* All four flags of the modified rotation, against the matrix they stand for */
+CTEST(rot, drotm_flags)
+{
+	blasint i, f, k, n = 203, incs[][2] = {{1, 1}, {2, -3}, {-1, -1}};
+	double flags[] = {-1.0, 0.0, 1.0, -2.0};
+	double x[3 * 203], y[3 * 203], xr[3 * 203], yr[3 * 203];
+	double param[5], h11, h12, h21, h22;
+
+	for (f = 0; f < 4; f++) {
+		param[0] = flags[f];
+		param[1] = 0.75;  param[2] = -0.5;
+		param[3] = 1.25;  param[4] = 0.375;
+
+		h11 = param[1];  h21 = param[2];  h12 = param[3];  h22 = param[4];
+		if (flags[f] == 0.0) {
+			h11 = 1.0;
+			h22 = 1.0;
+		} else if (flags[f] == 1.0) {
+			h12 = 1.0;
+			h21 = -1.0;
+		} else if (flags[f] == -2.0) {
+			h11 = h22 = 1.0;
+			h12 = h21 = 0.0;
+		}
+
+		for (k = 0; k < 3; k++) {
+			blasint incx = incs[k][0], incy = incs[k][1];
+			blasint ix = incx < 0 ? (1 - n) * incx : 0, iy = incy < 0 ? (1 - n) * incy : 0;
+
+			for (i = 0; i < 3 * n; i++) {
+				xr[i] = x[i] = sin(i + 1.0);
+				yr[i] = y[i] = cos(3.0 * i);
+			}
+			for (i = 0; i < n; i++, ix += incx, iy += incy) {
+				double w = xr[ix], z = yr[iy];
+				xr[ix] = h11 * w + h12 * z;
+				yr[iy] = h21 * w + h22 * z;
+			}
+
+			BLASFUNC(drotm)(&n, x, &incx, y, &incy, param);
+
+			for (i = 0; i < 3 * n; i++) {
+				ASSERT_DBL_NEAR_TOL(xr[i], x[i], DOUBLE_EPS);
+				ASSERT_DBL_NEAR_TOL(yr[i], y[i], DOUBLE_EPS);
+			}
+		}
+	}
+}
@@ -0,0 +1,210 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <string.h>
+
+/* Native two-stage ?syevd.  A Z must match Z diag(W) and Z' Z the
+   identity, with the eigenvalues in ascending order.  Sizes cover the
+   direct reduction of small matrices, the two-stage path with partial
+   last blocks and the threaded back transformation; the eigenvalues
+   alone must match those computed with the vectors. */
+
+#define SYEVD_THREADS 4
+
+/* max |A Z - Z diag(W)| / (n max |A|) + max |Z' Z - I| / n */
+static double check_vectors(blasint n, double *a, double *z, double *w)
+{
+	double *r = (double *)malloc(sizeof(double) * n * n);
+	double err;
+	blasint i, j;
+
+	cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n, n, n,
+		    1.0, a, n, z, n, 0.0, r, n);
+	for (j = 0; j < n; j++)
+		for (i = 0; i < n; i++)
+			r[i + j * n] -= z[i + j * n] * w[j];
+	err = utest_maxabs((BLASLONG)n * n, r) / (n * utest_maxabs((BLASLONG)n * n, a));
+
+	cblas_dgemm(CblasColMajor, CblasTrans, CblasNoTrans, n, n, n,
+		    1.0, z, n, z, n, 0.0, r, n);
+	for (i = 0; i < n; i++) r[i + i * n] -= 1.0;
+	err += utest_maxabs((BLASLONG)n * n, r) / n;
+
+	for (i = 1; i < n; i++)
+		if (w[i] < w[i - 1]) err += 1.0;
+
+	free(r);
+	return err;
+}
+
+/* Random symmetric A given by its lower or upper triangle only */
+static double check_dsyevd(blasint n, char uplo, int nthreads)
+{
+	double *a = (double *)malloc(sizeof(double) * n * n);
+	double *z = (double *)malloc(sizeof(double) * n * n);
+	double *w = (double *)malloc(sizeof(double) * n);
+	double *w1 = (double *)malloc(sizeof(double) * n);
+	double *work, query, err;
+	blasint lwork = -1, liwork = -1, *iwork, iquery, info, i, j;
+	char jobz = 'V', novec = 'N';
+	int saved;
+
+	utest_fill_random(a, (BLASLONG)n * n, n * 3 + uplo);
+	for (j = 0; j < n; j++)
+		for (i = j + 1; i < n; i++) a[j + i * n] = a[i + j * n];
+
+	BLASFUNC(dsyevd)(&jobz, &uplo, &n, z, &n, w, &query, &lwork, &iquery, &liwork, &info);
+	ASSERT_EQUAL(0, info);
+	ASSERT_TRUE(query >= 1 + 6 * n + 2 * n * n || n <= 1);
+	lwork  = (blasint)query;
+	liwork = iquery;
+	work  = (double *)malloc(sizeof(double) * lwork);
+	iwork = (blasint *)malloc(sizeof(blasint) * liwork);
+
+	/* the other triangle must not be read */
+	for (j = 0; j < n; j++)
+		for (i = 0; i < n; i++)
+			z[i + j * n] = ((uplo == 'L') ? (i >= j) : (i <= j)) ? a[i + j * n] : NAN;
+
+	saved = utest_set_threads(nthreads);
+	BLASFUNC(dsyevd)(&jobz, &uplo, &n, z, &n, w, work, &lwork, iwork, &liwork, &info);
+	UTEST_ASSERT_EQUAL_THREADS(saved, 0, info);
+	err = check_vectors(n, a, z, w);
+
+	/* eigenvalues only, with the minimal workspace */
+	for (i = 0; i < n * n; i++) z[i] = a[i];
+	lwork = 2 * n + 1;
+	BLASFUNC(dsyevd)(&novec, &uplo, &n, z, &n, w1, work, &lwork, iwork, &liwork, &info);
+	UTEST_ASSERT_EQUAL_THREADS(saved, 0, info);
+	for (i = 0; i < n; i++) w1[i] -= w[i];
+	err += utest_maxabs(n, w1) / (n * utest_maxabs((BLASLONG)n * n, a));
+
+	utest_set_threads(saved);
+
+	free(a);
+	free(z);
+	free(w);
+	free(w1);
+	free(work);
+	free(iwork);
+	return err;
+}
+
+CTEST(syevd, dsyevd_small)
+{
+	ASSERT_TRUE(check_dsyevd(1, 'L', 1) < 1e-14);
+	ASSERT_TRUE(check_dsyevd(2, 'U', 1) < 1e-14);
+	ASSERT_TRUE(check_dsyevd(7, 'L', 1) < 1e-14);
+	ASSERT_TRUE(check_dsyevd(90, 'U', 1) < 1e-13);
+}
+
+CTEST(syevd, dsyevd_band)
+{
+	ASSERT_TRUE(check_dsyevd(128, 'L', 1) < 1e-13);
+	ASSERT_TRUE(check_dsyevd(161, 'U', 1) < 1e-13);
+	ASSERT_TRUE(check_dsyevd(300, 'L', 1) < 1e-13);
+}
+
+CTEST(syevd, dsyevd_threads)
+{
+	ASSERT_TRUE(check_dsyevd(333, 'L', SYEVD_THREADS) < 1e-13);
+	ASSERT_TRUE(check_dsyevd(290, 'U', SYEVD_THREADS) < 1e-13);
+}
+
+/* -1 2 -1, already tridiagonal, so most reflectors are trivial */
+CTEST(syevd, dsyevd_known)
+{
+	blasint n = 200, lwork = 1 + 6 * 200 + 2 * 200 * 200, liwork = 3 + 5 * 200, info, i;
+	double *a = (double *)calloc((size_t)n * n, sizeof(double));
+	double *w = (double *)malloc(sizeof(double) * n);
+	double *work = (double *)malloc(sizeof(double) * lwork);
+	blasint *iwork = (blasint *)malloc(sizeof(blasint) * liwork);
+	double err = 0.0;
+	char jobz = 'V', uplo = 'L';
+
+	for (i = 0; i < n; i++) {
+		a[i + i * n] = 2.0e-200;
+		if (i + 1 < n) a[i + 1 + i * n] = -1.0e-200;
+	}
+
+	BLASFUNC(dsyevd)(&jobz, &uplo, &n, a, &n, w, work, &lwork, iwork, &liwork, &info);
+	ASSERT_EQUAL(0, info);
+
+	for (i = 0; i < n; i++) {
+		double d = w[i] * 1.0e200 - (2.0 - 2.0 * cos((i + 1) * M_PI / (n + 1)));
+		if (fabs(d) > err) err = fabs(d);
+	}
+	ASSERT_TRUE(err < 1e-13);
+
+	free(a);
+	free(w);
+	free(work);
+	free(iwork);
+}
+
+CTEST(syevd, ssyevd)
+{
+	blasint n = 170, lwork = 1 + 6 * 170 + 2 * 170 * 170, liwork = 3 + 5 * 170, info, i, j, l;
+	float *a = (float *)malloc(sizeof(float) * n * n);
+	float *z = (float *)malloc(sizeof(float) * n * n);
+	float *w = (float *)malloc(sizeof(float) * n);
+	float *work = (float *)malloc(sizeof(float) * lwork);
+	blasint *iwork = (blasint *)malloc(sizeof(blasint) * liwork);
+	double err = 0.0;
+	char jobz = 'V', uplo = 'L';
+
+	for (j = 0; j < n; j++)
+		for (i = j; i < n; i++)
+			a[i + j * n] = a[j + i * n] = z[i + j * n] = (float)sin(0.7 * (i * n + j) + 0.3);
+
+	BLASFUNC(ssyevd)(&jobz, &uplo, &n, z, &n, w, work, &lwork, iwork, &liwork, &info);
+	ASSERT_EQUAL(0, info);
+
+	for (j = 0; j < n; j++)
+		for (i = 0; i < n; i++) {
+			double d = -w[j] * z[i + j * n];
+			for (l = 0; l < n; l++) d += (double)a[i + l * n] * z[l + j * n];
+			if (fabs(d) > err) err = fabs(d);
+		}
+
+	ASSERT_TRUE(err / n < 1e-5);
+
+	free(a);
+	free(z);
+	free(w);
+	free(work);
+	free(iwork);
+}
@@ -0,0 +1,270 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of
+      its contributors may be used to endorse or promote products
+      derived from this software without specific prior written
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <string.h>
+
+/* Native ?sytrf and ?sytrs.  The solution of A X = B must have a small
+   residual for both triangles, one and many right hand sides, the
+   unthreaded and the look-ahead driver.  KKT matrices [H A'; A 0] force
+   2 by 2 pivots, and the pivots must be in the ?SYTRF format: the
+   reference ?SYTRI inverts with the native factors and the native
+   ?SYTRS solves with the factors of the reference ?SYTF2. */
+
+#define SYTRF_THREADS 4
+
+int BLASFUNC(dsytf2)(char *, blasint *, double *, blasint *, blasint *, blasint *);
+int BLASFUNC(dsytri)(char *, blasint *, double *, blasint *, blasint *, double *, blasint *);
+
+/* Symmetric A of order n, a KKT matrix with a zero block of order p */
+static void fill_sym(double *a, blasint n, blasint p, unsigned int seed)
+{
+	blasint i, j;
+
+	utest_fill_random(a, (BLASLONG)n * n, seed);
+	for (j = 0; j < n; j++) {
+		for (i = j; i < n; i++) {
+			if (i >= n - p && j >= n - p) a[i + j * n] = 0.0;
+			a[j + i * n] = a[i + j * n];
+		}
+	}
+}
+
+/* max |A X - B| / (n max |A| max |X|) */
+static double residual(blasint n, blasint nrhs, double *a, double *x, double *b)
+{
+	double *r = (double *)malloc(sizeof(double) * n * nrhs);
+	double err;
+	blasint i;
+
+	for (i = 0; i < n * nrhs; i++) r[i] = b[i];
+	cblas_dgemm(CblasColMajor, CblasNoTrans, CblasNoTrans, n, nrhs, n,
+		    1.0, a, n, x, n, -1.0, r, n);
+	err = utest_maxabs((BLASLONG)n * nrhs, r) /
+		(n * utest_maxabs((BLASLONG)n * n, a) * utest_maxabs((BLASLONG)n * nrhs, x));
+
+	free(r);
+	return err;
+}
+
+static double check_dsytrf(blasint n, blasint p, char uplo, blasint nrhs, int nthreads)
+{
+	double *a  = (double *)malloc(sizeof(double) * n * n);
+	double *f  = (double *)malloc(sizeof(double) * n * n);
+	double *b  = (double *)malloc(sizeof(double) * n * nrhs);
+	double *x  = (double *)malloc(sizeof(double) * n * nrhs);
+	blasint *ipiv = (blasint *)malloc(sizeof(blasint) * n);
+	double *work, query, err;
+	blasint lwork = -1, info, i, j;
+	int saved;
+
+	fill_sym(a, n, p, n * 5 + p + uplo);
+	utest_fill_random(b, (BLASLONG)n * nrhs, nrhs);
+
+	BLASFUNC(dsytrf)(&uplo, &n, f, &n, ipiv, &query, &lwork, &info);
+	ASSERT_EQUAL(0, info);
+	ASSERT_TRUE(query >= n);
+	lwork = (blasint)query;
+	work = (double *)malloc(sizeof(double) * lwork);
+
+	/* the other triangle must not be read */
+	for (j = 0; j < n; j++)
+		for (i = 0; i < n; i++)
+			f[i + j * n] = ((uplo == 'L') ? (i >= j) : (i <= j)) ? a[i + j * n] : NAN;
+	for (i = 0; i < n * nrhs; i++) x[i] = b[i];
+
+	saved = utest_set_threads(nthreads);
+	BLASFUNC(dsytrf)(&uplo, &n, f, &n, ipiv, work, &lwork, &info);
+	UTEST_ASSERT_EQUAL_THREADS(saved, 0, info);
+	BLASFUNC(dsytrs)(&uplo, &n, &nrhs, f, &n, ipiv, x, &n, &info);
+	UTEST_ASSERT_EQUAL_THREADS(saved, 0, info);
+	utest_set_threads(saved);
+
+	err = residual(n, nrhs, a, x, b);
+
+	free(a);
+	free(f);
+	free(b);
+	free(x);
+	free(ipiv);
+	free(work);
+	return err;
+}
+
+CTEST(sytrf, dsytrf_small)
+{
+	ASSERT_TRUE(check_dsytrf(1, 0, 'L', 1, 1) < 1e-14);
+	ASSERT_TRUE(check_dsytrf(2, 1, 'U', 3, 1) < 1e-14);
+	ASSERT_TRUE(check_dsytrf(9, 3, 'L', 1, 1) < 1e-14);
+	ASSERT_TRUE(check_dsytrf(9, 3, 'U', 1, 1) < 1e-14);
+	ASSERT_TRUE(check_dsytrf(70, 0, 'L', 5, 1) < 1e-14);
+	ASSERT_TRUE(check_dsytrf(70, 0, 'U', 5, 1) < 1e-14);
+}
+
+CTEST(sytrf, dsytrf_blocks)
+{
+	ASSERT_TRUE(check_dsytrf(200, 0, 'L', 1, 1) < 1e-13);
+	ASSERT_TRUE(check_dsytrf(200, 0, 'U', 1, 1) < 1e-13);
+	ASSERT_TRUE(check_dsytrf(331, 90, 'L', 150, 1) < 1e-13);
+	ASSERT_TRUE(check_dsytrf(331, 90, 'U', 150, 1) < 1e-13);
+}
+
+CTEST(sytrf, dsytrf_threads)
+{
+	ASSERT_TRUE(check_dsytrf(600, 150, 'L', 40, SYTRF_THREADS) < 1e-13);
+	ASSERT_TRUE(check_dsytrf(555, 140, 'U', 40, SYTRF_THREADS) < 1e-13);
+	ASSERT_TRUE(check_dsytrf(700, 0, 'L', 1, SYTRF_THREADS) < 1e-13);
+	ASSERT_TRUE(check_dsytrf(700, 0, 'U', 1, SYTRF_THREADS) < 1e-13);
+}
+
+/* native factors through the reference ?SYTRI: A inv(A) = I */
+CTEST(sytrf, dsytrf_format)
+{
+	blasint n = 300, lwork = 2 * 300 * 64, info, i, t;
+	double *a = (double *)malloc(sizeof(double) * n * n);
+	double *f = (double *)malloc(sizeof(double) * n * n);
+	double *work = (double *)malloc(sizeof(double) * lwork);
+	double *eye = (double *)calloc((size_t)n * n, sizeof(double));
+	blasint *ipiv = (blasint *)malloc(sizeof(blasint) * n);
+	char uplo[2] = { 'L', 'U' };
+	blasint j;
+
+	fill_sym(a, n, 80, 17);
+	for (i = 0; i < n; i++) eye[i + i * n] = 1.0;
+
+	for (t = 0; t < 2; t++) {
+		for (i = 0; i < n * n; i++) f[i] = a[i];
+		BLASFUNC(dsytrf)(uplo + t, &n, f, &n, ipiv, work, &lwork, &info);
+		ASSERT_EQUAL(0, info);
+		BLASFUNC(dsytri)(uplo + t, &n, f, &n, ipiv, work, &info);
+		ASSERT_EQUAL(0, info);
+		for (j = 0; j < n; j++)
+			for (i = 0; i < n; i++)
+				if ((t == 0) ? (i < j) : (i > j)) f[i + j * n] = f[j + i * n];
+		ASSERT_TRUE(residual(n, n, a, f, eye) < 1e-13);
+	}
+
+	free(a);
+	free(f);
+	free(work);
+	free(eye);
+	free(ipiv);
+}
+
+/* reference ?SYTF2 factors through the native ?SYTRS */
+CTEST(sytrf, dsytrs_format)
+{
+	blasint n = 280, nrhs = 30, info, i, t;
+	double *a = (double *)malloc(sizeof(double) * n * n);
+	double *f = (double *)malloc(sizeof(double) * n * n);
+	double *b = (double *)malloc(sizeof(double) * n * nrhs);
+	double *x = (double *)malloc(sizeof(double) * n * nrhs);
+	blasint *ipiv = (blasint *)malloc(sizeof(blasint) * n);
+	char uplo[2] = { 'L', 'U' };
+
+	fill_sym(a, n, 70, 23);
+	utest_fill_random(b, (BLASLONG)n * nrhs, 29);
+
+	for (t = 0; t < 2; t++) {
+		for (i = 0; i < n * n; i++) f[i] = a[i];
+		for (i = 0; i < n * nrhs; i++) x[i] = b[i];
+		BLASFUNC(dsytf2)(uplo + t, &n, f, &n, ipiv, &info);
+		ASSERT_EQUAL(0, info);
+		BLASFUNC(dsytrs)(uplo + t, &n, &nrhs, f, &n, ipiv, x, &n, &info);
+		ASSERT_EQUAL(0, info);
+		ASSERT_TRUE(residual(n, nrhs, a, x, b) < 1e-13);
+	}
+
+	free(a);
+	free(f);
+	free(b);
+	free(x);
+	free(ipiv);
+}
+
+/* zero pivot: INFO is the first one, the factorization is completed */
+CTEST(sytrf, dsytrf_singular)
+{
+	blasint n = 5, lwork = 5 * 64 * 2, info;
+	double a[25] = { 0 };
+	double work[5 * 64 * 2];
+	blasint ipiv[5];
+	char uplo = 'L';
+
+	a[0] = 2.0; a[6] = 1.0;
+
+	BLASFUNC(dsytrf)(&uplo, &n, a, &n, ipiv, work, &lwork, &info);
+	ASSERT_EQUAL(3, info);
+}
+
+CTEST(sytrf, ssytrf)
+{
+	blasint n = 290, nrhs = 7, lwork = 2 * 290 * 64, info, i, j, l;
+	float *a = (float *)malloc(sizeof(float) * n * n);
+	float *f = (float *)malloc(sizeof(float) * n * n);
+	float *x = (float *)malloc(sizeof(float) * n * nrhs);
+	float *work = (float *)malloc(sizeof(float) * lwork);
+	blasint *ipiv = (blasint *)malloc(sizeof(blasint) * n);
+	double err = 0.0, xmax = 0.0;
+	char uplo = 'U';
+
+	for (j = 0; j < n; j++)
+		for (i = j; i < n; i++)
+			a[i + j * n] = a[j + i * n] = f[i + j * n] = f[j + i * n] =
+				(i >= 200 && j >= 200) ? 0.0f : (float)sin(0.7 * (i * n + j) + 0.3);
+	for (i = 0; i < n * nrhs; i++) x[i] = (float)cos(0.3 * i);
+
+	BLASFUNC(ssytrf)(&uplo, &n, f, &n, ipiv, work, &lwork, &info);
+	ASSERT_EQUAL(0, info);
+	BLASFUNC(ssytrs)(&uplo, &n, &nrhs, f, &n, ipiv, x, &n, &info);
+	ASSERT_EQUAL(0, info);
+
+	for (j = 0; j < nrhs; j++)
+		for (i = 0; i < n; i++) {
+			double d = -cos(0.3 * (i + j * n));
+			for (l = 0; l < n; l++) d += (double)a[i + l * n] * x[l + j * n];
+			if (fabs(d) > err) err = fabs(d);
+		}
+
+	for (i = 0; i < n * nrhs; i++)
+		if (fabs(x[i]) > xmax) xmax = fabs(x[i]);
+	ASSERT_TRUE(err / (n * xmax) < 1e-4);
+
+	free(a);
+	free(f);
+	free(x);
+	free(work);
+	free(ipiv);
+}
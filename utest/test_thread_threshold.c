@@ -0,0 +1,97 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <stdio.h>
+
+static int threaded(void)
+{
+	return openblas_get_parallel() != OPENBLAS_SEQUENTIAL;
+}
+
+CTEST(thread_threshold, names)
+{
+	ASSERT_DBL_NEAR_TOL(-1.0, openblas_get_thread_threshold(NULL), 0.0);
+	ASSERT_DBL_NEAR_TOL(-1.0, openblas_get_thread_threshold(""), 0.0);
+	ASSERT_DBL_NEAR_TOL(-1.0, openblas_get_thread_threshold("daxp"), 0.0);
+	ASSERT_DBL_NEAR_TOL(-1.0, openblas_get_thread_threshold("xgemv"), 0.0);
+	ASSERT_DBL_NEAR_TOL(-1.0, openblas_get_thread_threshold("dgemm"), 0.0);
+
+	if (threaded()) {
+		ASSERT_TRUE(openblas_get_thread_threshold("saxpy") > 0.0);
+		ASSERT_TRUE(openblas_get_thread_threshold("zgemv") > 0.0);
+		ASSERT_TRUE(openblas_get_thread_threshold("ctrsm") > 0.0);
+		ASSERT_TRUE(openblas_get_thread_threshold("ztrsv") > 0.0);
+	} else {
+		ASSERT_DBL_NEAR_TOL(-1.0, openblas_get_thread_threshold("dgemv"), 0.0);
+	}
+}
+
+#if !defined(_WIN32)
+#include <unistd.h>
+
+/* Calibration replaces the table and writes the cache file, whose first
+   line after the comment names the core and thread count. */
+CTEST(thread_threshold, calibrate)
+{
+	char path[] = "/tmp/openblas_thresholdsXXXXXX", line[256];
+	FILE *fp;
+	int fd, ret, lines = 0;
+
+	fd = mkstemp(path);
+	ASSERT_TRUE(fd >= 0);
+	close(fd);
+	setenv("OPENBLAS_THRESHOLD_FILE", path, 1);
+
+	ret = openblas_calibrate_threading();
+	if (!threaded() || openblas_get_num_threads() == 1) {
+		ASSERT_EQUAL(-1, ret);
+	} else {
+		ASSERT_EQUAL(0, ret);
+		ASSERT_TRUE(openblas_get_thread_threshold("daxpy") > 0.0);
+		ASSERT_TRUE(openblas_get_thread_threshold("dtrsm") > 0.0);
+
+		fp = fopen(path, "r");
+		ASSERT_TRUE(fp != NULL);
+		while (fgets(line, sizeof(line), fp))
+			lines++;
+		fclose(fp);
+		/* comment, core and threads, 4 routines in 4 precisions */
+		ASSERT_EQUAL(18, lines);
+	}
+
+	unsetenv("OPENBLAS_THRESHOLD_FILE");
+	remove(path);
+}
+#endif
@@ -0,0 +1,191 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include <pthread.h>
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* Two callers, each bound to its own pool, run threaded dgemm at the
+   same time and must get the same result as a run on the shared pool. */
+
+#define POOL_N     300
+#define POOL_LOOPS 10
+
+typedef struct {
+	double *a, *b, *expected;
+	double err;
+	int unsupported;
+	int max_threads, policy;
+} pool_job_t;
+
+static void pool_dgemm(pool_job_t *job)
+{
+	double *c;
+	int i, loop;
+
+	c = (double *)malloc(sizeof(double) * POOL_N * POOL_N);
+	job->err = 0.0;
+	for (loop = 0; loop < POOL_LOOPS; loop++) {
+		cblas_dgemm(CblasColMajor, CblasNoTrans, CblasTrans, POOL_N, POOL_N, POOL_N,
+			    1.0, job->a, POOL_N, job->b, POOL_N, 0.0, c, POOL_N);
+		for (i = 0; i < POOL_N * POOL_N; i++)
+			if (fabs(c[i] - job->expected[i]) > job->err)
+				job->err = fabs(c[i] - job->expected[i]);
+	}
+	free(c);
+}
+
+static void *pool_caller(void *arg)
+{
+	pool_job_t *job = (pool_job_t *)arg;
+	openblas_threadpool_t *pool;
+
+	pool = openblas_threadpool_create(2, NULL);
+	if (pool == NULL) {
+		job->unsupported = 1;
+		return NULL;
+	}
+	openblas_threadpool_bind(pool);
+
+	pool_dgemm(job);
+
+	openblas_threadpool_bind(NULL);
+	openblas_threadpool_destroy(pool);
+	return NULL;
+}
+
+CTEST(threadpool, concurrent_dgemm)
+{
+	pool_job_t job[2];
+	pthread_t thread[2];
+	double *a, *b, *expected;
+	int i;
+
+	a = (double *)malloc(sizeof(double) * POOL_N * POOL_N);
+	b = (double *)malloc(sizeof(double) * POOL_N * POOL_N);
+	expected = (double *)malloc(sizeof(double) * POOL_N * POOL_N);
+
+	for (i = 0; i < POOL_N * POOL_N; i++) {
+		a[i] = (double)((i * 7) % 13) - 6.0;
+		b[i] = (double)((i * 5) % 11) - 5.0;
+	}
+	cblas_dgemm(CblasColMajor, CblasNoTrans, CblasTrans, POOL_N, POOL_N, POOL_N,
+		    1.0, a, POOL_N, b, POOL_N, 0.0, expected, POOL_N);
+
+	for (i = 0; i < 2; i++) {
+		job[i].a = a;
+		job[i].b = b;
+		job[i].expected = expected;
+		job[i].err = 0.0;
+		job[i].unsupported = 0;
+		pthread_create(&thread[i], NULL, pool_caller, &job[i]);
+	}
+	for (i = 0; i < 2; i++)
+		pthread_join(thread[i], NULL);
+
+	for (i = 0; i < 2; i++) {
+		if (job[i].unsupported)
+			continue;
+		/* integer data, so every path must be exact */
+		ASSERT_DBL_NEAR_TOL(0.0, job[i].err, 0.0);
+	}
+
+	free(a);
+	free(b);
+	free(expected);
+}
+
+/* Callers with different thread contexts share the global threads; each
+   gets its own thread cap and the global count is left alone. */
+static void *context_caller(void *arg)
+{
+	pool_job_t *job = (pool_job_t *)arg;
+	int cpu = 0;
+
+	if (openblas_set_thread_context(job->max_threads, &cpu, 1, job->policy)) {
+		job->unsupported = 1;
+		return NULL;
+	}
+
+	pool_dgemm(job);
+
+	openblas_clear_thread_context();
+	return NULL;
+}
+
+CTEST(threadpool, thread_context)
+{
+	pool_job_t job[2];
+	pthread_t thread[2];
+	double *a, *b, *expected;
+	int i, nthreads = openblas_get_num_threads();
+
+	ASSERT_EQUAL(-1, openblas_set_thread_context(-1, NULL, 0, OPENBLAS_POLICY_DEFAULT));
+	ASSERT_EQUAL(-1, openblas_set_thread_context(2, NULL, 1, OPENBLAS_POLICY_DEFAULT));
+	ASSERT_EQUAL(-1, openblas_set_thread_context(2, NULL, 0, 42));
+
+	a = (double *)malloc(sizeof(double) * POOL_N * POOL_N);
+	b = (double *)malloc(sizeof(double) * POOL_N * POOL_N);
+	expected = (double *)malloc(sizeof(double) * POOL_N * POOL_N);
+
+	for (i = 0; i < POOL_N * POOL_N; i++) {
+		a[i] = (double)((i * 3) % 17) - 8.0;
+		b[i] = (double)((i * 11) % 7) - 3.0;
+	}
+	cblas_dgemm(CblasColMajor, CblasNoTrans, CblasTrans, POOL_N, POOL_N, POOL_N,
+		    1.0, a, POOL_N, b, POOL_N, 0.0, expected, POOL_N);
+
+	for (i = 0; i < 2; i++) {
+		job[i].a = a;
+		job[i].b = b;
+		job[i].expected = expected;
+		job[i].err = 0.0;
+		job[i].unsupported = 0;
+		job[i].max_threads = 2;
+		job[i].policy = i ? OPENBLAS_POLICY_SEQUENTIAL : OPENBLAS_POLICY_EAGER;
+		pthread_create(&thread[i], NULL, context_caller, &job[i]);
+	}
+	for (i = 0; i < 2; i++)
+		pthread_join(thread[i], NULL);
+
+	for (i = 0; i < 2; i++) {
+		if (job[i].unsupported)
+			continue;
+		ASSERT_DBL_NEAR_TOL(0.0, job[i].err, 0.0);
+	}
+	ASSERT_EQUAL(nthreads, openblas_get_num_threads());
+
+	free(a);
+	free(b);
+	free(expected);
+}
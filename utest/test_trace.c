@@ -0,0 +1,169 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+#include <stdio.h>
+#include <string.h>
+
+/* Trace records through the callback and both stream formats.  A gemm
+   large enough for the level 3 driver must report packing and kernel
+   time, and the streams must hold exactly the calls made while on. */
+
+#define MAX_RECORDS 8
+
+static openblas_trace_record seen[MAX_RECORDS];
+static int nseen;
+
+static void collect(const openblas_trace_record *record, void *data)
+{
+	if (nseen < MAX_RECORDS)
+		seen[nseen] = *record;
+	nseen++;
+	(*(int *)data)++;
+}
+
+static void run_calls(double *a, double *b, double *c, blasint n)
+{
+	cblas_dgemm(CblasColMajor, CblasNoTrans, CblasTrans, n, n - 1, n - 2,
+		    1.0, a, n, b, n, 0.0, c, n);
+	cblas_daxpy(n, 2.0, a, 1, b, 1);
+	cblas_dtrsm(CblasColMajor, CblasLeft, CblasUpper, CblasNoTrans, CblasUnit,
+		    4, 3, 1.0, a, n, c, n);
+}
+
+CTEST(trace, callback)
+{
+	blasint n = 200, i;
+	double *a = (double *)malloc(sizeof(double) * n * n);
+	double *b = (double *)malloc(sizeof(double) * n * n);
+	double *c = (double *)malloc(sizeof(double) * n * n);
+	int calls = 0;
+
+	for (i = 0; i < n * n; i++)
+		a[i] = b[i] = 1.0 / (i + 1);
+
+	nseen = 0;
+	openblas_set_trace_callback(collect, &calls);
+	run_calls(a, b, c, n);
+	openblas_set_trace_callback(NULL, NULL);
+	run_calls(a, b, c, n);
+
+	ASSERT_EQUAL(3, calls);
+	ASSERT_EQUAL(3, nseen);
+
+	ASSERT_STR("dgemm", seen[0].routine);
+	ASSERT_STR("NT", seen[0].options);
+	ASSERT_EQUAL(n, seen[0].m);
+	ASSERT_EQUAL(n - 1, seen[0].n);
+	ASSERT_EQUAL(n - 2, seen[0].k);
+	ASSERT_TRUE(seen[0].threads >= 1);
+	ASSERT_TRUE(seen[0].start_ns > 0);
+	ASSERT_TRUE(seen[0].wall_ns > 0);
+	ASSERT_TRUE(seen[0].kernel_ns > 0);
+	ASSERT_TRUE(seen[0].pack_ns + seen[0].kernel_ns <= seen[0].wall_ns * seen[0].threads);
+
+	ASSERT_STR("daxpy", seen[1].routine);
+	ASSERT_STR("", seen[1].options);
+	ASSERT_EQUAL(n, seen[1].m);
+
+	ASSERT_STR("dtrsm", seen[2].routine);
+	ASSERT_STR("LUNU", seen[2].options);
+	ASSERT_EQUAL(4, seen[2].m);
+	ASSERT_EQUAL(3, seen[2].n);
+
+	free(a);
+	free(b);
+	free(c);
+}
+
+#if !defined(_WIN32)
+#include <unistd.h>
+
+CTEST(trace, streams)
+{
+	char path[] = "/tmp/openblas_traceXXXXXX", line[512];
+	double a[16], b[16], c[16];
+	openblas_trace_record record;
+	unsigned int size;
+	FILE *fp;
+	int fd, lines = 0, i;
+
+	for (i = 0; i < 16; i++)
+		a[i] = b[i] = c[i] = 1.0;
+
+	fd = mkstemp(path);
+	ASSERT_TRUE(fd >= 0);
+	close(fd);
+
+	ASSERT_EQUAL(-1, openblas_set_trace(3, path));
+	ASSERT_EQUAL(-1, openblas_set_trace(OPENBLAS_TRACE_BINARY, NULL));
+
+	ASSERT_EQUAL(0, openblas_set_trace(OPENBLAS_TRACE_JSON, path));
+	run_calls(a, b, c, 4);
+	openblas_trace_flush();
+	ASSERT_EQUAL(0, openblas_set_trace(OPENBLAS_TRACE_OFF, NULL));
+	run_calls(a, b, c, 4);
+
+	fp = fopen(path, "r");
+	ASSERT_TRUE(fp != NULL);
+	while (fgets(line, sizeof(line), fp)) {
+		ASSERT_TRUE(line[0] == '{' && strstr(line, "}\n") != NULL);
+		ASSERT_TRUE(strstr(line, "\"wall_ns\":") != NULL);
+		lines++;
+	}
+	fclose(fp);
+	ASSERT_EQUAL(3, lines);
+
+	ASSERT_EQUAL(0, openblas_set_trace(OPENBLAS_TRACE_BINARY, path));
+	run_calls(a, b, c, 4);
+	ASSERT_EQUAL(0, openblas_set_trace(OPENBLAS_TRACE_OFF, NULL));
+
+	fp = fopen(path, "rb");
+	ASSERT_TRUE(fp != NULL);
+	ASSERT_EQUAL(16, (int)fread(line, 1, 16, fp));
+	ASSERT_EQUAL(0, memcmp(line, "OBTRACE1", 8));
+	ASSERT_EQUAL(1, (int)fread(&size, sizeof(size), 1, fp));
+	ASSERT_EQUAL((int)sizeof(openblas_trace_record), (int)size);
+	ASSERT_EQUAL(1, (int)fread(&record, sizeof(record), 1, fp));
+	ASSERT_STR("dgemm", record.routine);
+	ASSERT_EQUAL(4, record.m);
+	ASSERT_EQUAL(1, (int)fread(&record, sizeof(record), 1, fp));
+	ASSERT_EQUAL(1, (int)fread(&record, sizeof(record), 1, fp));
+	ASSERT_STR("dtrsm", record.routine);
+	ASSERT_EQUAL(0, (int)fread(&record, sizeof(record), 1, fp));
+	fclose(fp);
+
+	remove(path);
+}
+#endif
@@ -0,0 +1,157 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* ?trsm is checked through the residual op(A) * X - alpha * B for every
+   side / uplo / trans / diag combination.  The sizes straddle the unroll
+   factors so both full and partial register tiles of the solve kernels
+   are used, and the larger ones also go through the GEMM update. */
+
+static void check_trsm(int single, enum CBLAS_SIDE side, enum CBLAS_UPLO uplo,
+		       enum CBLAS_TRANSPOSE trans, enum CBLAS_DIAG diag, blasint m, blasint n)
+{
+	blasint k = (side == CblasLeft) ? m : n;
+	blasint lda = k + 1, ldb = m + 2, i, j, l;
+	double alpha = 1.5, tol = single ? 1e-4 : 1e-12;
+	double *a, *b, *x, aij, sum;
+	float *fa, *fx;
+
+	a = (double *)malloc((size_t)lda * k * sizeof(double));
+	b = (double *)malloc((size_t)ldb * n * sizeof(double));
+	x = (double *)malloc((size_t)ldb * n * sizeof(double));
+
+	/* a well conditioned triangle: small off-diagonal, diagonal near one */
+	utest_fill_pattern(a, lda * k, 1);
+	for (i = 0; i < lda * k; i++)
+		a[i] /= k;
+	for (i = 0; i < k; i++)
+		a[i + i * lda] = 1.0 + a[i + i * lda];
+	utest_fill_pattern(b, ldb * n, 2);
+	if (single)
+		for (i = 0; i < ldb * n; i++)
+			b[i] = (float)b[i];
+	memcpy(x, b, (size_t)ldb * n * sizeof(double));
+
+	if (single) {
+		fa = (float *)malloc((size_t)lda * k * sizeof(float));
+		fx = (float *)malloc((size_t)ldb * n * sizeof(float));
+		for (i = 0; i < lda * k; i++)
+			fa[i] = (float)a[i];
+		for (i = 0; i < ldb * n; i++)
+			fx[i] = (float)x[i];
+		for (i = 0; i < lda * k; i++)
+			a[i] = fa[i];
+		cblas_strsm(CblasColMajor, side, uplo, trans, diag, m, n, (float)alpha, fa, lda, fx, ldb);
+		for (i = 0; i < ldb * n; i++)
+			x[i] = fx[i];
+		free(fa);
+		free(fx);
+	} else {
+		cblas_dtrsm(CblasColMajor, side, uplo, trans, diag, m, n, alpha, a, lda, x, ldb);
+	}
+
+	for (j = 0; j < n; j++) {
+		for (i = 0; i < m; i++) {
+			sum = 0.0;
+			for (l = 0; l < k; l++) {
+				blasint r, c;
+
+				/* element (r, c) of op(A) used by this term */
+				if (side == CblasLeft) {
+					r = i;
+					c = l;
+				} else {
+					r = l;
+					c = j;
+				}
+				if (trans != CblasNoTrans) {
+					blasint t = r;
+					r = c;
+					c = t;
+				}
+				if ((uplo == CblasUpper) ? (r > c) : (r < c))
+					continue;
+				aij = (r == c && diag == CblasUnit) ? 1.0 : a[r + c * lda];
+				sum += aij * ((side == CblasLeft) ? x[l + j * ldb] : x[i + l * ldb]);
+			}
+			ASSERT_DBL_NEAR_TOL(alpha * b[i + j * ldb], sum, tol);
+		}
+		/* rows past m belong to the caller */
+		for (i = m; i < ldb; i++)
+			ASSERT_DBL_NEAR_TOL(b[i + j * ldb], x[i + j * ldb], 0.0);
+	}
+
+	free(a);
+	free(b);
+	free(x);
+}
+
+static void check_all(int single, enum CBLAS_SIDE side)
+{
+	static const blasint sizes[][2] = {
+		{1, 1}, {3, 17}, {17, 3}, {33, 50}, {50, 33}, {131, 97}
+	};
+	int s, u, t, d;
+
+	for (s = 0; s < (int)(sizeof(sizes) / sizeof(sizes[0])); s++)
+		for (u = 0; u < 2; u++)
+			for (t = 0; t < 2; t++)
+				for (d = 0; d < 2; d++)
+					check_trsm(single, side,
+						   u ? CblasLower : CblasUpper,
+						   t ? CblasTrans : CblasNoTrans,
+						   d ? CblasUnit : CblasNonUnit,
+						   sizes[s][0], sizes[s][1]);
+}
+
+CTEST(trsm, strsm_left)
+{
+	check_all(1, CblasLeft);
+}
+
+CTEST(trsm, strsm_right)
+{
+	check_all(1, CblasRight);
+}
+
+CTEST(trsm, dtrsm_left)
+{
+	check_all(0, CblasLeft);
+}
+
+CTEST(trsm, dtrsm_right)
+{
+	check_all(0, CblasRight);
+}
@@ -0,0 +1,214 @@
+/*****************************************************************************
+Copyright (c) 2020, The OpenBLAS Project
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+   1. Redistributions of source code must retain the above copyright
+      notice, this list of conditions and the following disclaimer.
+
+   2. Redistributions in binary form must reproduce the above copyright
+      notice, this list of conditions and the following disclaimer in
+      the documentation and/or other materials provided with the
+      distribution.
+   3. Neither the name of the OpenBLAS project nor the names of 
+      its contributors may be used to endorse or promote products 
+      derived from this software without specific prior written 
+      permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE
+USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+**********************************************************************************/
+
+#include "openblas_utest.h"
+#include <cblas.h>
+
+/* The threaded ?trsv, ?tpsv and ?tbsv drivers against the single threaded
+   ones.  The thread context asks for threads at any size, so the orders
+   only need to span a good number of substitution steps. */
+
+#define SOLVE_THREADS 4
+
+static int saved_threads;
+
+static void threaded(int on)
+{
+	if (on) {
+		saved_threads = openblas_get_num_threads();
+		openblas_set_num_threads(SOLVE_THREADS);
+		openblas_set_thread_context(0, NULL, 0, OPENBLAS_POLICY_EAGER);
+	} else {
+		openblas_clear_thread_context();
+		openblas_set_num_threads(saved_threads);
+	}
+}
+
+/* a well conditioned triangle: small off-diagonal, diagonal near one */
+static void fill(double *a, blasint len, blasint n, blasint lda, blasint seed)
+{
+	blasint i;
+
+	for (i = 0; i < len; i++)
+		a[i] = ((double)(((i + seed) * 7) % 23) / 23.0 - 0.5) / n;
+	for (i = 0; i < n; i++)
+		a[i + i * lda] += 1.0;
+}
+
+static double difference(blasint len, double *x, double *y)
+{
+	blasint i;
+	double err = 0.0;
+
+	for (i = 0; i < len; i++)
+		if (fabs(x[i] - y[i]) > err) err = fabs(x[i] - y[i]);
+	return err;
+}
+
+static void check_trsv(char uplo, char trans, char diag, blasint n, blasint incx)
+{
+	blasint lda = n + 3, len = n * incx;
+	double *a = (double *)malloc(sizeof(double) * lda * n);
+	double *x = (double *)malloc(sizeof(double) * len);
+	double *y = (double *)malloc(sizeof(double) * len);
+
+	fill(a, lda * n, n, lda, 1);
+	fill(x, len, len, 0, 2);
+	memcpy(y, x, sizeof(double) * len);
+
+	BLASFUNC(dtrsv)(&uplo, &trans, &diag, &n, a, &lda, x, &incx);
+	threaded(1);
+	BLASFUNC(dtrsv)(&uplo, &trans, &diag, &n, a, &lda, y, &incx);
+	threaded(0);
+
+	ASSERT_TRUE(difference(len, x, y) < 1e-12);
+
+	free(a);
+	free(x);
+	free(y);
+}
+
+static void check_tpsv(char uplo, char trans, char diag, blasint n)
+{
+	blasint one = 1, i, j, l = 0;
+	double *a  = (double *)malloc(sizeof(double) * n * n);
+	double *ap = (double *)malloc(sizeof(double) * n * (n + 1) / 2);
+	double *x  = (double *)malloc(sizeof(double) * n);
+	double *y  = (double *)malloc(sizeof(double) * n);
+
+	fill(a, n * n, n, n, 3);
+	for (j = 0; j < n; j++)
+		for (i = (uplo == 'U') ? 0 : j; i < ((uplo == 'U') ? j + 1 : n); i++)
+			ap[l++] = a[i + j * n];
+	fill(x, n, n, 0, 4);
+	memcpy(y, x, sizeof(double) * n);
+
+	BLASFUNC(dtpsv)(&uplo, &trans, &diag, &n, ap, x, &one);
+	threaded(1);
+	BLASFUNC(dtpsv)(&uplo, &trans, &diag, &n, ap, y, &one);
+	threaded(0);
+
+	ASSERT_TRUE(difference(n, x, y) < 1e-12);
+
+	free(a);
+	free(ap);
+	free(x);
+	free(y);
+}
+
+static void check_tbsv(char uplo, char trans, char diag, blasint n, blasint k)
+{
+	blasint one = 1, lda = k + 1, j;
+	double *ab = (double *)malloc(sizeof(double) * lda * n);
+	double *x  = (double *)malloc(sizeof(double) * n);
+	double *y  = (double *)malloc(sizeof(double) * n);
+
+	/* the diagonal is row k of the upper band, row 0 of the lower one */
+	fill(ab, lda * n, k + 1, 0, 5);
+	for (j = 0; j < n; j++)
+		ab[((uplo == 'U') ? k : 0) + j * lda] += 1.0;
+	fill(x, n, n, 0, 6);
+	memcpy(y, x, sizeof(double) * n);
+
+	BLASFUNC(dtbsv)(&uplo, &trans, &diag, &n, &k, ab, &lda, x, &one);
+	threaded(1);
+	BLASFUNC(dtbsv)(&uplo, &trans, &diag, &n, &k, ab, &lda, y, &one);
+	threaded(0);
+
+	ASSERT_TRUE(difference(n, x, y) < 1e-12);
+
+	free(ab);
+	free(x);
+	free(y);
+}
+
+static void check_ztrsv(char uplo, char trans, char diag, blasint n)
+{
+	blasint lda = n, one = 1;
+	double *a = (double *)malloc(sizeof(double) * 2 * lda * n);
+	double *x = (double *)malloc(sizeof(double) * 2 * n);
+	double *y = (double *)malloc(sizeof(double) * 2 * n);
+	blasint i;
+
+	/* real and imaginary parts interleaved, one on the diagonal */
+	fill(a, 2 * lda * n, n, 0, 7);
+	for (i = 0; i < n; i++)
+		a[2 * (i + i * lda)] += 1.0;
+	fill(x, 2 * n, n, 0, 8);
+	memcpy(y, x, sizeof(double) * 2 * n);
+
+	BLASFUNC(ztrsv)(&uplo, &trans, &diag, &n, a, &lda, x, &one);
+	threaded(1);
+	BLASFUNC(ztrsv)(&uplo, &trans, &diag, &n, a, &lda, y, &one);
+	threaded(0);
+
+	ASSERT_TRUE(difference(2 * n, x, y) < 1e-12);
+
+	free(a);
+	free(x);
+	free(y);
+}
+
+CTEST(trsv_thread, dtrsv)
+{
+	check_trsv('L', 'N', 'N', 777, 1);
+	check_trsv('L', 'T', 'U', 777, 1);
+	check_trsv('U', 'N', 'U', 777, 1);
+	check_trsv('U', 'T', 'N', 777, 1);
+	check_trsv('L', 'N', 'N', 530, 3);
+	check_trsv('U', 'T', 'N', 530, 2);
+}
+
+CTEST(trsv_thread, dtpsv)
+{
+	check_tpsv('L', 'N', 'N', 640);
+	check_tpsv('L', 'T', 'N', 640);
+	check_tpsv('U', 'N', 'N', 640);
+	check_tpsv('U', 'T', 'U', 640);
+}
+
+CTEST(trsv_thread, dtbsv)
+{
+	check_tbsv('L', 'N', 'N', 900, 150);
+	check_tbsv('L', 'T', 'N', 900, 150);
+	check_tbsv('U', 'N', 'U', 900, 150);
+	check_tbsv('U', 'T', 'N', 900, 150);
+}
+
+CTEST(trsv_thread, ztrsv)
+{
+	check_ztrsv('L', 'N', 'N', 600);
+	check_ztrsv('L', 'C', 'N', 600);
+	check_ztrsv('U', 'T', 'N', 600);
+	check_ztrsv('U', 'C', 'U', 600);
+}